@@ -35,6 +35,7 @@
 
 #include <H5Support/H5Lite.h>
 
+#include <algorithm>
 #include <cstring>
 
 #if defined(H5Support_NAMESPACE)
@@ -382,6 +383,97 @@ std::string H5Lite::StringForHDFType(hid_t dataTypeIdentifier)
   return "Unknown";
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<hsize_t> H5Lite::ComputeChunkDimensions(int32_t rank, const hsize_t* dims, size_t typeSize, size_t targetChunkBytes)
+{
+  std::vector<hsize_t> chunkDims(static_cast<size_t>(rank), 1);
+  hsize_t chunkBytes = std::max<hsize_t>(typeSize, 1);
+  // Grow the chunk from the fastest dimension outwards until it holds about targetChunkBytes
+  for(int32_t i = rank - 1; i >= 0; i--)
+  {
+    hsize_t fit = std::max<hsize_t>(targetChunkBytes / chunkBytes, 1);
+    chunkDims[i] = std::max<hsize_t>(std::min(dims[i], fit), 1);
+    chunkBytes *= chunkDims[i];
+  }
+  return chunkDims;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5Lite::CreateDatasetCreationPropertyList(const H5DatasetCreationOptions& options, int32_t rank, const hsize_t* dims, size_t typeSize)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!options.needsChunking() || rank <= 0)
+  {
+    return H5P_DEFAULT;
+  }
+  hsize_t totalBytes = typeSize;
+  for(int32_t i = 0; i < rank; i++)
+  {
+    // Chunk sizes have to be positive, so empty datasets stay contiguous
+    if(dims[i] == 0)
+    {
+      return H5P_DEFAULT;
+    }
+    totalBytes *= dims[i];
+  }
+  if(totalBytes < options.minimumChunkedBytes)
+  {
+    return H5P_DEFAULT;
+  }
+
+  std::vector<hsize_t> chunkDims = options.chunkDimensions;
+  if(chunkDims.size() != static_cast<size_t>(rank))
+  {
+    chunkDims = ComputeChunkDimensions(rank, dims, typeSize, options.targetChunkBytes);
+  }
+  // A dataset with fixed dimensions can not have chunks larger than the dataset
+  for(int32_t i = 0; i < rank; i++)
+  {
+    chunkDims[i] = std::max<hsize_t>(std::min(chunkDims[i], dims[i]), 1);
+  }
+
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if(dcpl < 0)
+  {
+    return dcpl;
+  }
+  herr_t err = H5Pset_chunk(dcpl, rank, chunkDims.data());
+  if(err >= 0 && options.shuffle && H5Zfilter_avail(H5Z_FILTER_SHUFFLE) > 0)
+  {
+    err = H5Pset_shuffle(dcpl);
+  }
+  if(err >= 0 && options.filterId != H5Z_FILTER_NONE)
+  {
+    // Asking for a filter that is not compiled in tries to load it as a plugin
+    HDF_ERROR_HANDLER_OFF
+    htri_t available = H5Zfilter_avail(options.filterId);
+    HDF_ERROR_HANDLER_ON
+    if(available > 0)
+    {
+      err = H5Pset_filter(dcpl, options.filterId, H5Z_FLAG_OPTIONAL, options.filterParameters.size(), options.filterParameters.data());
+    }
+    else
+    {
+      std::cout << "HDF5 filter " << options.filterId << " is not available. The dataset is written without it." << std::endl;
+    }
+  }
+  if(err >= 0 && options.deflateLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+  {
+    err = H5Pset_deflate(dcpl, static_cast<unsigned>(std::min(options.deflateLevel, 9)));
+  }
+  if(err < 0)
+  {
+    H5Pclose(dcpl);
+    return err;
+  }
+  return dcpl;
+}
+
 // -----------------------------------------------------------------------------
 //  Finds an Attribute given an object to look in
 // -----------------------------------------------------------------------------
@@ -468,11 +560,23 @@ herr_t H5Lite::writeStringDataset(hid_t loc_id, const std::string& dsetName, siz
 //
 // -----------------------------------------------------------------------------
 herr_t H5Lite::writeVectorOfStringsDataset(hid_t loc_id, const std::string& dsetName, const std::vector<std::string>& data)
+{
+  std::vector<const char*> strings(data.size());
+  for(size_t i = 0; i < data.size(); i++)
+  {
+    strings[i] = data[i].c_str();
+  }
+  return writeVectorOfCStringsDataset(loc_id, dsetName, strings);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+herr_t H5Lite::writeVectorOfCStringsDataset(hid_t loc_id, const std::string& dsetName, const std::vector<const char*>& data)
 {
   H5SUPPORT_MUTEX_LOCK()
 
   hid_t sid = -1;
-  hid_t memspace = -1;
   hid_t datatype = -1;
   hid_t did = -1;
   herr_t err = -1;
@@ -481,43 +585,24 @@ herr_t H5Lite::writeVectorOfStringsDataset(hid_t loc_id, const std::string& dset
   hsize_t dims[1] = {data.size()};
   if((sid = H5Screate_simple(sizeof(dims) / sizeof(*dims), dims, nullptr)) >= 0)
   {
-    dims[0] = 1;
+    datatype = H5Tcopy(H5T_C_S1);
+    H5Tset_size(datatype, H5T_VARIABLE);
 
-    if((memspace = H5Screate_simple(sizeof(dims) / sizeof(*dims), dims, nullptr)) >= 0)
+    if((did = H5Dcreate(loc_id, dsetName.c_str(), datatype, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) >= 0)
     {
-
-      datatype = H5Tcopy(H5T_C_S1);
-      H5Tset_size(datatype, H5T_VARIABLE);
-
-      if((did = H5Dcreate(loc_id, dsetName.c_str(), datatype, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) >= 0)
+      // All of the strings go out in one write instead of one hyperslab selection per string
+      if(!data.empty())
       {
-
-        //
-        // Select the "memory" to be written out - just 1 record.
-        hsize_t offset[] = {0};
-        hsize_t count[] = {1};
-        H5Sselect_hyperslab(memspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
-        hsize_t m_pos = 0;
-        for(auto v : data)
+        err = H5Dwrite(did, datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        if(err < 0)
         {
-          // Select the file position, 1 record at position 'pos'
-          hsize_t count[] = {1};
-          hsize_t offset[] = {m_pos++};
-          H5Sselect_hyperslab(sid, H5S_SELECT_SET, offset, nullptr, count, nullptr);
-          const char* s = v.c_str();
-          err = H5Dwrite(did, datatype, memspace, sid, H5P_DEFAULT, &s);
-          if(err < 0)
-          {
-            std::cout << "Error Writing String Data: " __FILE__ << "(" << __LINE__ << ")" << std::endl;
-            retErr = err;
-          }
+          std::cout << "Error Writing String Data: " __FILE__ << "(" << __LINE__ << ")" << std::endl;
+          retErr = err;
         }
-        CloseH5D(did, err, retErr);
       }
-      H5Tclose(datatype);
-      CloseH5S(memspace, err, retErr);
+      CloseH5D(did, err, retErr);
     }
-
+    H5Tclose(datatype);
     CloseH5S(sid, err, retErr);
   }
   return retErr;
@@ -966,6 +1051,79 @@ herr_t H5Lite::readVectorOfStringDataset(hid_t loc_id, const std::string& dsetNa
   return retErr;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+herr_t H5Lite::readPackedStringDataset(hid_t loc_id, const std::string& dsetName, std::vector<char>& buffer, std::vector<size_t>& offsets)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t did; // dataset id
+  herr_t err = 0;
+  herr_t retErr = 0;
+
+  did = H5Dopen(loc_id, dsetName.c_str(), H5P_DEFAULT);
+  if(did < 0)
+  {
+    std::cout << "H5Lite.cpp::readPackedStringDataset(" << __LINE__ << ") Error opening Dataset at loc_id (" << loc_id << ") with object name (" << dsetName << ")" << std::endl;
+    return -1;
+  }
+
+  hsize_t dims[1] = {0};
+  hid_t sid = H5Dget_space(did);
+  int ndims = H5Sget_simple_extent_dims(sid, dims, nullptr);
+  if(ndims != 1)
+  {
+    CloseH5S(sid, err, retErr);
+    CloseH5D(did, err, retErr);
+    std::cout << "H5Lite.cpp::readPackedStringDataset(" << __LINE__ << ") Number of dims should be 1 but it was " << ndims << ". Returning early. Is your data file correct?" << std::endl;
+    return -2;
+  }
+
+  std::vector<char*> rdata(dims[0], nullptr);
+  hid_t memtype = H5Tcopy(H5T_C_S1);
+  H5Tset_size(memtype, H5T_VARIABLE);
+
+  if(dims[0] > 0 && H5Dread(did, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata.data()) < 0)
+  {
+    H5Dvlen_reclaim(memtype, sid, H5P_DEFAULT, rdata.data());
+    CloseH5T(memtype, err, retErr);
+    CloseH5S(sid, err, retErr);
+    CloseH5D(did, err, retErr);
+    std::cout << "H5Lite.cpp::readPackedStringDataset(" << __LINE__ << ") Error reading Dataset at loc_id (" << loc_id << ") with object name (" << dsetName << ")" << std::endl;
+    return -3;
+  }
+
+  // Size the packed buffer once, then copy each string in behind its null terminator
+  offsets.resize(dims[0] + 1);
+  offsets[0] = 0;
+  for(hsize_t i = 0; i < dims[0]; i++)
+  {
+    size_t length = (nullptr == rdata[i]) ? 0 : ::strlen(rdata[i]);
+    offsets[i + 1] = offsets[i] + length + 1;
+  }
+  buffer.resize(offsets.back());
+  for(hsize_t i = 0; i < dims[0]; i++)
+  {
+    size_t length = offsets[i + 1] - offsets[i] - 1;
+    if(length > 0)
+    {
+      ::memcpy(buffer.data() + offsets[i], rdata[i], length);
+    }
+    buffer[offsets[i] + length] = '\0';
+  }
+
+  if(dims[0] > 0)
+  {
+    H5Dvlen_reclaim(memtype, sid, H5P_DEFAULT, rdata.data());
+  }
+  CloseH5T(memtype, err, retErr);
+  CloseH5S(sid, err, retErr);
+  CloseH5D(did, err, retErr);
+
+  return retErr;
+}
+
 // -----------------------------------------------------------------------------
 //  Reads a string Attribute from the HDF file
 // -----------------------------------------------------------------------------
@@ -51,6 +51,41 @@ namespace H5Support_NAMESPACE
 {
 #endif
 
+  /**
+   * @brief Layout and filters used when H5Lite creates a dataset. The default values create a contiguous dataset
+   * without any filters. Deflate, shuffle and extra filters need a chunked layout, so any of them turns chunking on.
+   * Deflate and shuffle are built into every HDF5 library, so files written with them stay readable by stock tools.
+   */
+  struct H5DatasetCreationOptions
+  {
+    //! Stores the dataset in chunks
+    bool chunked = false;
+    //! Chunk shape in HDF5 (slowest to fastest) order. Empty lets H5Lite::ComputeChunkDimensions() pick the shape.
+    std::vector<hsize_t> chunkDimensions;
+    //! Approximate number of bytes in a computed chunk
+    size_t targetChunkBytes = 1024 * 1024;
+    //! Datasets with fewer bytes than this are written contiguous because chunk indexing would only add overhead
+    size_t minimumChunkedBytes = 64 * 1024;
+    //! gzip level from 1 to 9. 0 disables deflate.
+    int32_t deflateLevel = 0;
+    //! Shuffles the bytes of each value before compressing, which helps multi byte integer and float values
+    bool shuffle = false;
+    //! Additional filter, for example one loaded from a plugin at runtime. It is optional, so writing still
+    //! succeeds without it if the filter is not available.
+    H5Z_filter_t filterId = H5Z_FILTER_NONE;
+    //! Client data values for filterId
+    std::vector<uint32_t> filterParameters;
+
+    /**
+     * @brief Returns true if these options need a chunked layout
+     * @return
+     */
+    bool needsChunking() const
+    {
+      return chunked || deflateLevel > 0 || shuffle || filterId != H5Z_FILTER_NONE;
+    }
+  };
+
   /**
    * @brief Class to bring together some high level methods to read/write data to HDF5 files.
    * @class H5Lite
@@ -109,6 +144,29 @@ namespace H5Support_NAMESPACE
        */
       static H5Support_EXPORT std::string StringForHDFType(hid_t dataTypeIdentifier);
 
+      /**
+       * @brief Picks a chunk shape of roughly targetChunkBytes. The fastest dimensions are kept whole as long as they
+       * fit, so for DataArrays a chunk holds complete tuples and, for ImageGeom arrays, complete rows or slices.
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension in HDF5 (slowest to fastest) order
+       * @param typeSize The number of bytes of one value
+       * @param targetChunkBytes
+       * @return The chunk size of each dimension
+       */
+      static H5Support_EXPORT std::vector<hsize_t> ComputeChunkDimensions(int32_t rank, const hsize_t* dims, size_t typeSize, size_t targetChunkBytes);
+
+      /**
+       * @brief Creates the dataset creation property list for options. Filters that are not available in the
+       * running HDF5 library are skipped.
+       * @param options
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param typeSize The number of bytes of one value
+       * @return H5P_DEFAULT if the dataset should be contiguous, otherwise a property list that the caller has to
+       * close with H5Pclose(). Negative on error.
+       */
+      static H5Support_EXPORT hid_t CreateDatasetCreationPropertyList(const H5DatasetCreationOptions& options, int32_t rank, const hsize_t* dims, size_t typeSize);
+
       /**
       * @brief Returns the HDF Type for a given primitive value.
        * @param value A value to use. Can be anything. Just used to get the type info
@@ -333,6 +391,27 @@ namespace H5Support_NAMESPACE
                                          int32_t   rank,
                                          hsize_t* dims,
                                          T* data)
+      {
+        return writePointerDataset(loc_id, dsetName, rank, dims, data, H5DatasetCreationOptions());
+      }
+
+      /**
+       * @brief Writes the data of a pointer to an HDF5 file using a chunked and/or compressed layout
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to write to. This can be a name of Path
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param data The data to be written.
+       * @param options The layout and filters of the new dataset
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t writePointerDataset (hid_t loc_id,
+                                         const std::string& dsetName,
+                                         int32_t   rank,
+                                         hsize_t* dims,
+                                         T* data,
+                                         const H5DatasetCreationOptions& options)
       {
         H5SUPPORT_MUTEX_LOCK()
 
@@ -361,9 +440,19 @@ namespace H5Support_NAMESPACE
         {
           return sid;
         }
+        hid_t dcpl = H5Lite::CreateDatasetCreationPropertyList(options, rank, dims, sizeof(T));
+        if (dcpl < 0)
+        {
+          H5Sclose(sid);
+          return dcpl;
+        }
         // Create the Dataset
         // This will fail if dsetName contains a "/"!
-        did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        if (dcpl != H5P_DEFAULT)
+        {
+          H5Pclose(dcpl);
+        }
         if ( did >= 0 )
         {
           err = H5Dwrite( did, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data );
@@ -418,6 +507,27 @@ namespace H5Support_NAMESPACE
                                            int32_t   rank,
                                            hsize_t* dims,
                                            T* data)
+      {
+        return replacePointerDataset(loc_id, dsetName, rank, dims, data, H5DatasetCreationOptions());
+      }
+
+      /**
+       * @brief replacePointerDataset
+       * @param loc_id
+       * @param dsetName
+       * @param rank
+       * @param dims
+       * @param data
+       * @param options The layout and filters used if the dataset has to be created
+       * @return
+       */
+      template <typename T>
+      static herr_t replacePointerDataset (hid_t loc_id,
+                                           const std::string& dsetName,
+                                           int32_t   rank,
+                                           hsize_t* dims,
+                                           T* data,
+                                           const H5DatasetCreationOptions& options)
       {
         H5SUPPORT_MUTEX_LOCK()
 
@@ -451,7 +561,17 @@ namespace H5Support_NAMESPACE
         HDF_ERROR_HANDLER_ON
         if ( did < 0 ) // dataset does not exist so create it
         {
-          did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+          hid_t dcpl = H5Lite::CreateDatasetCreationPropertyList(options, rank, dims, sizeof(T));
+          if (dcpl < 0)
+          {
+            H5Sclose(sid);
+            return dcpl;
+          }
+          did = H5Dcreate (loc_id, dsetName.c_str(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+          if (dcpl != H5P_DEFAULT)
+          {
+            H5Pclose(dcpl);
+          }
         }
         if ( did >= 0 )
         {
@@ -662,6 +782,18 @@ namespace H5Support_NAMESPACE
       static H5Support_EXPORT herr_t writeVectorOfStringsDataset(hid_t loc_id,
                                                                  const std::string& dsetName,
                                                                  const std::vector<std::string>& data);
+
+      /**
+      * @brief Writes a 1D dataset of variable length strings in a single H5Dwrite call. The strings
+      * are not copied; each pointer must reference a null terminated string.
+      * @param loc_id
+      * @param dsetName
+      * @param data
+      * @return
+      */
+      static H5Support_EXPORT herr_t writeVectorOfCStringsDataset(hid_t loc_id,
+                                                                  const std::string& dsetName,
+                                                                  const std::vector<const char*>& data);
       /**
        * @brief Writes an Attribute to an HDF5 Object
        * @param loc_id The Parent Location of the HDFobject that is getting the attribute
@@ -1118,6 +1250,117 @@ namespace H5Support_NAMESPACE
         return retErr;
       }
 
+      /**
+       * @brief Reads a rectangular block (hyperslab) of a dataset into a preallocated array. Only the selected
+       * elements are read from the file so this is much cheaper than reading the whole dataset when just a
+       * part of it is needed.
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param offset The starting index of the block in each dimension of the dataset (slowest to fastest)
+       * @param count The number of elements of the block in each dimension of the dataset (slowest to fastest)
+       * @param data A Pointer to the PreAllocated Array that will hold the product of count elements
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const std::string& dsetName,
+                                                const std::vector<hsize_t>& offset,
+                                                const std::vector<hsize_t>& count,
+                                                T* data)
+      {
+        H5SUPPORT_MUTEX_LOCK()
+
+        herr_t err = 0;
+        herr_t retErr = 0;
+        T test = 0x00;
+        hid_t dataType = H5Lite::HDFTypeForPrimitive(test);
+        if (dataType == -1)
+        {
+          std::cout  << "dataType was not supported." << std::endl;
+          return -10;
+        }
+        if (loc_id < 0)
+        {
+          std::cout  << "loc_id was Negative: This is not allowed." << std::endl;
+          return -2;
+        }
+        if (nullptr == data)
+        {
+          std::cout  << "The Pointer to hold the data is nullptr. This is NOT allowed." << std::endl;
+          return -3;
+        }
+        if (offset.size() != count.size())
+        {
+          std::cout  << "The offset and count of the hyperslab must have the same rank." << std::endl;
+          return -4;
+        }
+        hid_t did = H5Dopen( loc_id, dsetName.c_str(), H5P_DEFAULT );
+        if ( did < 0 )
+        {
+          std::cout  << " Error opening Dataset: " << did << std::endl;
+          return -1;
+        }
+        hid_t spaceId = H5Dget_space(did);
+        if (spaceId < 0)
+        {
+          std::cout  << "Error Getting the Dataspace of " << dsetName << std::endl;
+          H5Dclose(did);
+          return -1;
+        }
+        int32_t rank = H5Sget_simple_extent_ndims(spaceId);
+        std::vector<hsize_t> dims(rank > 0 ? rank : 0, 0);
+        if (rank > 0)
+        {
+          H5Sget_simple_extent_dims(spaceId, dims.data(), nullptr);
+        }
+        bool validSelection = (rank == static_cast<int32_t>(offset.size()));
+        for (size_t i = 0; validSelection && i < dims.size(); ++i)
+        {
+          validSelection = (offset[i] + count[i] <= dims[i]);
+        }
+        if (!validSelection)
+        {
+          std::cout  << "The hyperslab does not fit inside the dimensions of dataset " << dsetName << std::endl;
+          retErr = -5;
+        }
+        else
+        {
+          hsize_t numElements = 1;
+          for (const auto& c : count)
+          {
+            numElements *= c;
+          }
+          err = H5Sselect_hyperslab(spaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr);
+          hid_t memSpaceId = H5Screate_simple(1, &numElements, nullptr);
+          if (err < 0 || memSpaceId < 0)
+          {
+            std::cout  << "Error Selecting the Hyperslab of " << dsetName << std::endl;
+            retErr = -1;
+          }
+          else if (numElements > 0)
+          {
+            err = H5Dread(did, dataType, memSpaceId, spaceId, H5P_DEFAULT, data);
+            if (err < 0)
+            {
+              std::cout  << "Error Reading Data." << std::endl;
+              retErr = err;
+            }
+          }
+          if (memSpaceId >= 0)
+          {
+            H5Sclose(memSpaceId);
+          }
+        }
+        H5Sclose(spaceId);
+        err = H5Dclose( did );
+        if (err < 0 )
+        {
+          std::cout  << "Error Closing Dataset id" << std::endl;
+          retErr = err;
+        }
+        return retErr;
+      }
+
       /**
        * @brief Reads data from the HDF5 File into an std::vector<T> object. If the dataset
        * is very large this can be an expensive method to use. It is here for convenience
@@ -1302,6 +1545,21 @@ namespace H5Support_NAMESPACE
       static H5Support_EXPORT herr_t readVectorOfStringDataset(hid_t loc_id,
                                                                const std::string& dsetName,
                                                                std::vector<std::string>& data);
+
+      /**
+        * @brief Reads a 1D dataset of variable length strings into a single packed buffer. Each string
+        * is stored null terminated and string i starts at buffer[offsets[i]]. The offsets vector has one
+        * more entry than the number of strings so the length of string i is offsets[i + 1] - offsets[i] - 1.
+        * @param loc_id
+        * @param dsetName
+        * @param buffer
+        * @param offsets
+        * @return
+        */
+      static H5Support_EXPORT herr_t readPackedStringDataset(hid_t loc_id,
+                                                             const std::string& dsetName,
+                                                             std::vector<char>& buffer,
+                                                             std::vector<size_t>& offsets);
       /**
        * @brief Reads an Attribute from an HDF5 Object.
        *
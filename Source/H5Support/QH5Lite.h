@@ -222,6 +222,27 @@ namespace H5Support_NAMESPACE
         return H5Lite::writePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data);
       }
 
+      /**
+       * @brief Writes the data of a pointer to an HDF5 file using a chunked and/or compressed layout
+       * @param loc_id The hdf5 object id of the parent
+       * @param dsetName The name of the dataset to write to. This can be a name of Path
+       * @param rank The number of dimensions
+       * @param dims The sizes of each dimension
+       * @param data The data to be written.
+       * @param options The layout and filters of the new dataset
+       * @return Standard hdf5 error condition.
+       */
+      template <typename T>
+      static herr_t writePointerDataset (hid_t loc_id,
+                                         const QString& dsetName,
+                                         int32_t   rank,
+                                         hsize_t* dims,
+                                         T* data,
+                                         const H5DatasetCreationOptions& options)
+      {
+        return H5Lite::writePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data, options);
+      }
+
       /**
        * @brief replacePointerDataset
        * @param loc_id
@@ -241,6 +262,27 @@ namespace H5Support_NAMESPACE
         return H5Lite::replacePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data);
       }
 
+      /**
+       * @brief replacePointerDataset
+       * @param loc_id
+       * @param dsetName
+       * @param rank
+       * @param dims
+       * @param data
+       * @param options The layout and filters used if the dataset has to be created
+       * @return
+       */
+      template <typename T>
+      static herr_t replacePointerDataset (hid_t loc_id,
+                                           const QString& dsetName,
+                                           int32_t   rank,
+                                           hsize_t* dims,
+                                           T* data,
+                                           const H5DatasetCreationOptions& options)
+      {
+        return H5Lite::replacePointerDataset(loc_id, dsetName.toStdString(), rank, dims, data, options);
+      }
+
 
       /**
        * @brief Creates a Dataset with the given name at the location defined by loc_id
@@ -458,6 +500,25 @@ namespace H5Support_NAMESPACE
         return H5Lite::readPointerDataset(loc_id, dsetName.toStdString(), data);
       }
 
+      /**
+       * @brief Reads a rectangular block (hyperslab) of a dataset into a preallocated array.
+       * @param loc_id The parent location that contains the dataset to read
+       * @param dsetName The name of the dataset to read
+       * @param offset The starting index of the block in each dimension of the dataset (slowest to fastest)
+       * @param count The number of elements of the block in each dimension of the dataset (slowest to fastest)
+       * @param data A Pointer to the PreAllocated Array that will hold the product of count elements
+       * @return Standard HDF error condition
+       */
+      template <typename T>
+      static herr_t readPointerDatasetHyperslab(hid_t loc_id,
+                                                const QString& dsetName,
+                                                const std::vector<hsize_t>& offset,
+                                                const std::vector<hsize_t>& count,
+                                                T* data)
+      {
+        return H5Lite::readPointerDatasetHyperslab(loc_id, dsetName.toStdString(), offset, count, data);
+      }
+
 
       /**
        * @brief Reads data from the HDF5 File into an QVector<T> object. If the dataset
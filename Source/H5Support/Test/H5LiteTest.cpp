@@ -12,6 +12,7 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 #include <QtCore/QByteArray>
 #include <QtCore/QFile>
@@ -1068,6 +1069,152 @@ public:
     // qDebug() << logTime() << "Testing Complete" << "\n";
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDatasetCreationOptions()
+  {
+    // Chunks keep whole rows and stack as many of them as fit
+    hsize_t dims[3] = {100, 200, 300};
+    std::vector<hsize_t> chunkDims = H5Lite::ComputeChunkDimensions(3, dims, 4, 1024 * 1024);
+    DREAM3D_REQUIRE_EQUAL(chunkDims[2], 300)
+    DREAM3D_REQUIRE_EQUAL(chunkDims[1], 200)
+    DREAM3D_REQUIRE_EQUAL(chunkDims[0], 4)
+    chunkDims = H5Lite::ComputeChunkDimensions(3, dims, 4, 1000);
+    DREAM3D_REQUIRE_EQUAL(chunkDims[2], 250)
+    DREAM3D_REQUIRE_EQUAL(chunkDims[1], 1)
+    DREAM3D_REQUIRE_EQUAL(chunkDims[0], 1)
+
+    hid_t file_id = H5Fcreate(UnitTest::H5LiteTest::FileName.toLatin1().data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    DREAM3D_REQUIRE(file_id > 0);
+
+    // Large runs of repeated values, like a feature id array
+    std::vector<int32_t> data(64 * 64 * 64);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<int32_t>(i / 1000);
+    }
+    hsize_t dataDims[3] = {64, 64, 64};
+
+    H5DatasetCreationOptions options;
+    options.deflateLevel = 5;
+    options.shuffle = true;
+    options.targetChunkBytes = 64 * 1024;
+    herr_t err = H5Lite::writePointerDataset(file_id, "Compressed", 3, dataDims, data.data(), options);
+    DREAM3D_REQUIRE(err >= 0);
+    err = H5Lite::writePointerDataset(file_id, "Contiguous", 3, dataDims, data.data());
+    DREAM3D_REQUIRE(err >= 0);
+    // Too small to be worth chunking
+    hsize_t smallDims[1] = {16};
+    err = H5Lite::writePointerDataset(file_id, "Small", 1, smallDims, data.data(), options);
+    DREAM3D_REQUIRE(err >= 0);
+    // Filters that are not available are skipped
+    H5DatasetCreationOptions missingFilter;
+    missingFilter.filterId = 32000;
+    missingFilter.minimumChunkedBytes = 0;
+    err = H5Lite::writePointerDataset(file_id, "MissingFilter", 3, dataDims, data.data(), missingFilter);
+    DREAM3D_REQUIRE(err >= 0);
+
+    hid_t did = H5Dopen(file_id, "Compressed", H5P_DEFAULT);
+    hid_t dcpl = H5Dget_create_plist(did);
+    DREAM3D_REQUIRE_EQUAL(H5Pget_layout(dcpl), H5D_CHUNKED)
+    DREAM3D_REQUIRE_EQUAL(H5Pget_nfilters(dcpl), 2)
+    hsize_t fileChunkDims[3] = {0, 0, 0};
+    H5Pget_chunk(dcpl, 3, fileChunkDims);
+    DREAM3D_REQUIRE_EQUAL(fileChunkDims[0], 4)
+    DREAM3D_REQUIRE_EQUAL(fileChunkDims[2], 64)
+    hsize_t compressedBytes = H5Dget_storage_size(did);
+    H5Pclose(dcpl);
+    H5Dclose(did);
+    DREAM3D_REQUIRE(compressedBytes < data.size() * sizeof(int32_t) / 10)
+
+    did = H5Dopen(file_id, "Small", H5P_DEFAULT);
+    dcpl = H5Dget_create_plist(did);
+    DREAM3D_REQUIRE_EQUAL(H5Pget_layout(dcpl), H5D_CONTIGUOUS)
+    H5Pclose(dcpl);
+    H5Dclose(did);
+
+    did = H5Dopen(file_id, "MissingFilter", H5P_DEFAULT);
+    dcpl = H5Dget_create_plist(did);
+    DREAM3D_REQUIRE_EQUAL(H5Pget_layout(dcpl), H5D_CHUNKED)
+    DREAM3D_REQUIRE_EQUAL(H5Pget_nfilters(dcpl), 0)
+    H5Pclose(dcpl);
+    H5Dclose(did);
+
+    // Compressed datasets read back like any other dataset
+    std::vector<int32_t> readBack;
+    err = H5Lite::readVectorDataset(file_id, "Compressed", readBack);
+    DREAM3D_REQUIRE(err >= 0);
+    DREAM3D_REQUIRE(readBack == data)
+
+    err = H5Fclose(file_id);
+    DREAM3D_REQUIRE(err >= 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestHyperslabRead()
+  {
+    hid_t file_id = H5Fcreate(UnitTest::H5LiteTest::FileName.toLatin1().data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    DREAM3D_REQUIRE(file_id > 0);
+
+    // A 4 x 5 x 6 volume with 2 components per voxel stored slowest to fastest
+    hsize_t dims[4] = {4, 5, 6, 2};
+    std::vector<int32_t> data(4 * 5 * 6 * 2);
+    for(size_t i = 0; i < data.size(); i++)
+    {
+      data[i] = static_cast<int32_t>(i);
+    }
+    herr_t err = H5Lite::writePointerDataset(file_id, "Volume", 4, dims, data.data());
+    DREAM3D_REQUIRE(err >= 0);
+    // The same data chunked so the selection spans several chunks
+    H5DatasetCreationOptions options;
+    options.chunked = true;
+    options.chunkDimensions = {2, 2, 3, 2};
+    options.minimumChunkedBytes = 0;
+    err = H5Lite::writePointerDataset(file_id, "ChunkedVolume", 4, dims, data.data(), options);
+    DREAM3D_REQUIRE(err >= 0);
+
+    std::vector<hsize_t> offset = {1, 2, 3, 0};
+    std::vector<hsize_t> count = {2, 3, 2, 2};
+    for(const std::string& name : {std::string("Volume"), std::string("ChunkedVolume")})
+    {
+      std::vector<int32_t> block(2 * 3 * 2 * 2, -1);
+      err = H5Lite::readPointerDatasetHyperslab(file_id, name, offset, count, block.data());
+      DREAM3D_REQUIRE(err >= 0);
+      size_t index = 0;
+      for(hsize_t z = 0; z < count[0]; z++)
+      {
+        for(hsize_t y = 0; y < count[1]; y++)
+        {
+          for(hsize_t x = 0; x < count[2]; x++)
+          {
+            for(hsize_t c = 0; c < count[3]; c++)
+            {
+              size_t fileIndex = (((z + offset[0]) * dims[1] + (y + offset[1])) * dims[2] + (x + offset[2])) * dims[3] + c;
+              DREAM3D_REQUIRE_EQUAL(block[index], data[fileIndex])
+              index++;
+            }
+          }
+        }
+      }
+    }
+
+    // Blocks outside of the dataset or of the wrong rank are rejected
+    std::vector<int32_t> block(64, 0);
+    std::vector<hsize_t> badOffset = {3, 0, 0, 0};
+    err = H5Lite::readPointerDatasetHyperslab(file_id, "Volume", badOffset, count, block.data());
+    DREAM3D_REQUIRE(err < 0);
+    std::vector<hsize_t> shortOffset = {0, 0};
+    std::vector<hsize_t> shortCount = {1, 1};
+    err = H5Lite::readPointerDatasetHyperslab(file_id, "Volume", shortOffset, shortCount, block.data());
+    DREAM3D_REQUIRE(err < 0);
+
+    err = H5Fclose(file_id);
+    DREAM3D_REQUIRE(err >= 0);
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -1344,6 +1491,8 @@ public:
     DREAM3D_REGISTER_TEST(TestVLengStringReadWrite())
 
     DREAM3D_REGISTER_TEST(TestTypeDetection())
+    DREAM3D_REGISTER_TEST(TestDatasetCreationOptions())
+    DREAM3D_REGISTER_TEST(TestHyperslabRead())
     DREAM3D_REGISTER_TEST(QH5LiteTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
@@ -47,10 +47,14 @@
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerReaderFilterParameter.h"
 #include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/Utilities/SIMPLH5DataReader.h"
 #include "SIMPLib/Utilities/SIMPLH5DataReaderRequirements.h"
+#include "SIMPLib/Utilities/SIMPLH5StructureCache.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -60,6 +64,10 @@ DataContainerReader::DataContainerReader()
 , m_OverwriteExistingDataContainers(false)
 , m_LastFileRead("")
 , m_LastRead(QDateTime::currentDateTime())
+, m_ReadRegionOfInterest(false)
+, m_RegionOfInterestMin(0, 0, 0)
+, m_RegionOfInterestMax(0, 0, 0)
+, m_ReadArraysOnDemand(false)
 {
   m_PipelineFromFile = FilterPipeline::New();
 }
@@ -87,6 +95,13 @@ void DataContainerReader::setupFilterParameters()
     parameter->setFilter(this);
     parameters.push_back(parameter);
   }
+  QStringList linkedProps;
+  linkedProps << "RegionOfInterestMin"
+              << "RegionOfInterestMax";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Read Region of Interest", ReadRegionOfInterest, FilterParameter::Parameter, DataContainerReader, linkedProps));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Region of Interest Minimum (Voxels)", RegionOfInterestMin, FilterParameter::Parameter, DataContainerReader));
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Region of Interest Maximum (Voxels)", RegionOfInterestMax, FilterParameter::Parameter, DataContainerReader));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Read Arrays On Demand", ReadArraysOnDemand, FilterParameter::Parameter, DataContainerReader));
 
   setFilterParameters(parameters);
 }
@@ -101,6 +116,10 @@ void DataContainerReader::readFilterParameters(AbstractFilterParametersReader* r
   setInputFileDataContainerArrayProxy(reader->readDataContainerArrayProxy("InputFileDataContainerArrayProxy", getInputFileDataContainerArrayProxy()));
   syncProxies(); // Sync the file proxy and currently cached proxy together into one proxy
   setOverwriteExistingDataContainers(reader->readValue("OverwriteExistingDataContainers", getOverwriteExistingDataContainers()));
+  setReadRegionOfInterest(reader->readValue("ReadRegionOfInterest", getReadRegionOfInterest()));
+  setRegionOfInterestMin(reader->readIntVec3("RegionOfInterestMin", getRegionOfInterestMin()));
+  setRegionOfInterestMax(reader->readIntVec3("RegionOfInterestMax", getRegionOfInterestMax()));
+  setReadArraysOnDemand(reader->readValue("ReadArraysOnDemand", getReadArraysOnDemand()));
   reader->closeFilterGroup();
 }
 
@@ -163,6 +182,25 @@ void DataContainerReader::dataCheck()
     setErrorCondition(-388, ss);
   }
 
+  if(getReadRegionOfInterest())
+  {
+    for(size_t i = 0; i < 3; i++)
+    {
+      if(m_RegionOfInterestMin[i] < 0)
+      {
+        ss = QObject::tr("The minimum of the region of interest can not be negative");
+        setErrorCondition(-391, ss);
+        break;
+      }
+      if(m_RegionOfInterestMax[i] < m_RegionOfInterestMin[i])
+      {
+        ss = QObject::tr("The maximum of the region of interest must be greater than or equal to its minimum");
+        setErrorCondition(-392, ss);
+        break;
+      }
+    }
+  }
+
   if(getErrorCode() != 0)
   {
     // something has gone wrong and errors were logged already so just return
@@ -253,8 +291,11 @@ DataContainerArray::Pointer DataContainerReader::readData(DataContainerArrayProx
   {
     return DataContainerArray::New();
   }
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
 
-  DataContainerArray::Pointer dca = simplReader->readSIMPLDataUsingProxy(proxy, getInPreflight());
+  // With m_ReadArraysOnDemand the arrays only remember where their values are stored and read them when they are first accessed
+  DataContainerArray::Pointer dca = simplReader->readSIMPLDataUsingProxy(proxy, getInPreflight(), getRegionOfInterest(), m_ReadArraysOnDemand);
   if(dca == DataContainerArray::NullPointer())
   {
     return DataContainerArray::New();
@@ -283,11 +324,37 @@ DataContainerArray::Pointer DataContainerReader::readData(DataContainerArrayProx
   return dca;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5DataArrayReader::ReadRegion DataContainerReader::getRegionOfInterest() const
+{
+  if(!m_ReadRegionOfInterest)
+  {
+    return H5DataArrayReader::ReadRegion();
+  }
+  std::vector<size_t> min(3);
+  std::vector<size_t> max(3);
+  for(size_t i = 0; i < 3; i++)
+  {
+    min[i] = static_cast<size_t>(m_RegionOfInterestMin[i]);
+    max[i] = static_cast<size_t>(m_RegionOfInterestMax[i]);
+  }
+  return H5DataArrayReader::ReadRegion::Box(min, max);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 DataContainerArrayProxy DataContainerReader::readDataContainerArrayStructure(const QString& path)
 {
+  SIMPLH5DataReaderRequirements req(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Any, IGeometry::Type::Any);
+  DataContainerArrayProxy proxy;
+  if(SIMPLH5StructureCache::Instance()->find(path, &req, proxy))
+  {
+    return proxy;
+  }
+
   SIMPLH5DataReader::Pointer h5Reader = SIMPLH5DataReader::New();
   if(!h5Reader->openFile(path))
   {
@@ -295,8 +362,7 @@ DataContainerArrayProxy DataContainerReader::readDataContainerArrayStructure(con
   }
 
   int err = 0;
-  SIMPLH5DataReaderRequirements req(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Any, IGeometry::Type::Any);
-  DataContainerArrayProxy proxy = h5Reader->readDataContainerArrayStructure(&req, err);
+  proxy = h5Reader->readDataContainerArrayStructure(&req, err);
   if(err < 0)
   {
     return DataContainerArrayProxy();
@@ -404,24 +470,29 @@ bool DataContainerReader::syncProxies()
 {
   SIMPLH5DataReaderRequirements req(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Any, IGeometry::Type::Any);
 
-  SIMPLH5DataReader::Pointer simplReader = SIMPLH5DataReader::New();
-  connect(simplReader.get(), &SIMPLH5DataReader::errorGenerated, [=](const QString& title, const QString& msg, const int& code) { setErrorCondition(code, msg); });
-
-  if(!simplReader->openFile(getInputFile()))
+  // Preflights read the structure over and over. It is only read from the file when the file changed.
+  DataContainerArrayProxy fileProxy;
+  if(!SIMPLH5StructureCache::Instance()->find(getInputFile(), &req, fileProxy))
   {
-    return false;
-  }
+    SIMPLH5DataReader::Pointer simplReader = SIMPLH5DataReader::New();
+    connect(simplReader.get(), &SIMPLH5DataReader::errorGenerated, [=](const QString& title, const QString& msg, const int& code) { setErrorCondition(code, msg); });
+
+    if(!simplReader->openFile(getInputFile()))
+    {
+      return false;
+    }
 
-  // If there is something in the cached proxy...
-  if(!m_InputFileDataContainerArrayProxy.getDataContainers().empty())
-  {
     int err = 0;
-    DataContainerArrayProxy fileProxy = simplReader->readDataContainerArrayStructure(&req, err);
+    fileProxy = simplReader->readDataContainerArrayStructure(&req, err);
     if(err < 0)
     {
       return false;
     }
+  }
 
+  // If there is something in the cached proxy...
+  if(!m_InputFileDataContainerArrayProxy.getDataContainers().empty())
+  {
     DataContainerArrayProxy cacheProxy = getInputFileDataContainerArrayProxy();
 
     // Mesh proxies together into one proxy
@@ -430,13 +501,6 @@ bool DataContainerReader::syncProxies()
   }
   else
   {
-    int err = 0;
-    DataContainerArrayProxy fileProxy = simplReader->readDataContainerArrayStructure(&req, err);
-    if(err < 0)
-    {
-      return false;
-    }
-
     setInputFileDataContainerArrayProxy(fileProxy);
   }
 
@@ -38,10 +38,12 @@
 
 #include <QtCore/QDateTime>
 
+#include "SIMPLib/Common/SIMPLArray.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/Utilities/SIMPLH5DataReader.h"
 #include "SIMPLib/SIMPLib.h"
 
@@ -59,6 +61,10 @@ class SIMPLib_EXPORT DataContainerReader : public AbstractFilter
     PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
     PYB11_PROPERTY(bool OverwriteExistingDataContainers READ getOverwriteExistingDataContainers WRITE setOverwriteExistingDataContainers)
     PYB11_PROPERTY(DataContainerArrayProxy InputFileDataContainerArrayProxy READ getInputFileDataContainerArrayProxy WRITE setInputFileDataContainerArrayProxy)
+    PYB11_PROPERTY(bool ReadRegionOfInterest READ getReadRegionOfInterest WRITE setReadRegionOfInterest)
+    PYB11_PROPERTY(IntVec3Type RegionOfInterestMin READ getRegionOfInterestMin WRITE setRegionOfInterestMin)
+    PYB11_PROPERTY(IntVec3Type RegionOfInterestMax READ getRegionOfInterestMax WRITE setRegionOfInterestMax)
+    PYB11_PROPERTY(bool ReadArraysOnDemand READ getReadArraysOnDemand WRITE setReadArraysOnDemand)
 
     PYB11_METHOD(DataContainerArrayProxy readDataContainerArrayStructure ARGS path)
   
@@ -84,6 +90,28 @@ class SIMPLib_EXPORT DataContainerReader : public AbstractFilter
     SIMPL_FILTER_PARAMETER(DataContainerArrayProxy, InputFileDataContainerArrayProxy)
     Q_PROPERTY(DataContainerArrayProxy InputFileDataContainerArrayProxy READ getInputFileDataContainerArrayProxy WRITE setInputFileDataContainerArrayProxy)
 
+    SIMPL_FILTER_PARAMETER(bool, ReadRegionOfInterest)
+    Q_PROPERTY(bool ReadRegionOfInterest READ getReadRegionOfInterest WRITE setReadRegionOfInterest)
+
+    SIMPL_FILTER_PARAMETER(IntVec3Type, RegionOfInterestMin)
+    Q_PROPERTY(IntVec3Type RegionOfInterestMin READ getRegionOfInterestMin WRITE setRegionOfInterestMin)
+
+    SIMPL_FILTER_PARAMETER(IntVec3Type, RegionOfInterestMax)
+    Q_PROPERTY(IntVec3Type RegionOfInterestMax READ getRegionOfInterestMax WRITE setRegionOfInterestMax)
+
+    /**
+     * @brief Reads the values of each DataArray from the file the first time they are accessed instead of up front
+     */
+    SIMPL_FILTER_PARAMETER(bool, ReadArraysOnDemand)
+    Q_PROPERTY(bool ReadArraysOnDemand READ getReadArraysOnDemand WRITE setReadArraysOnDemand)
+
+    /**
+     * @brief getRegionOfInterest Returns the voxel box that is read from the Cell data of ImageGeom Data Containers,
+     * or an empty region if the whole file should be read
+     * @return
+     */
+    H5DataArrayReader::ReadRegion getRegionOfInterest() const;
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
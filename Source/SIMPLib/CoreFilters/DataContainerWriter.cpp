@@ -42,12 +42,21 @@
 #include "H5Support/H5ScopedSentinel.h"
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/DataContainerBundle.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
+#include "SIMPLib/HDF5/H5DataArrayWriter.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/H5FilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/Messages/AbstractErrorMessage.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/SIMPLH5StructureCache.h"
 
 
 #ifdef _WIN32
@@ -57,6 +66,102 @@ extern Q_CORE_EXPORT int qt_ntfs_permission_lookup;
 #define APPEND_DATA_TRUE 1
 #define APPEND_DATA_FALSE 0
 
+namespace
+{
+/**
+ * @brief Queried only once so that dataCheck() does not call into HDF5 while a background write is running
+ * @return
+ */
+bool deflateAvailable()
+{
+  static const bool available = (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0);
+  return available;
+}
+
+/**
+ * @brief Copies the DataContainerArray for a background write. The DataArrays share their buffers with the
+ * original until either side modifies them. The DataContainerBundles are rebuilt to refer to the copied DataContainers.
+ * @param dca
+ * @return
+ */
+DataContainerArray::Pointer snapshotDataContainerArray(const DataContainerArray::Pointer& dca)
+{
+  DataContainerArray::Pointer snapshot = dca->createSharedCopy();
+  QMapIterator<QString, IDataContainerBundle::Pointer> iter(dca->getDataContainerBundles());
+  while(iter.hasNext())
+  {
+    iter.next();
+    IDataContainerBundle::Pointer bundle = iter.value();
+    DataContainerBundle::Pointer bundleCopy = DataContainerBundle::New(bundle->getName());
+    // Go by name so that bundles which stream their DataContainers from a file do not read them all
+    QVector<QString> dcNames = bundle->getDataContainerNames();
+    for(const QString& dcName : dcNames)
+    {
+      DataContainer::Pointer dc = snapshot->getDataContainer(dcName);
+      if(nullptr != dc.get())
+      {
+        bundleCopy->addOrReplaceDataContainer(dc);
+      }
+    }
+    DataContainerBundle::Pointer dcBundle = std::dynamic_pointer_cast<DataContainerBundle>(bundle);
+    if(nullptr != dcBundle.get())
+    {
+      bundleCopy->setMetaDataArrays(dcBundle->getMetaDataArrays());
+    }
+    snapshot->addDataContainerBundle(bundleCopy);
+  }
+  return snapshot;
+}
+
+/**
+ * @brief Writes a single DataContainer into a new file under the same group path it has in a .dream3d file. The
+ * arrays use the dataset options that are in scope on the calling thread.
+ * @param dc
+ * @param filePath
+ * @param writeXdmf
+ * @param xdmfText Receives the Xdmf for the DataContainer
+ * @return
+ */
+int writeDataContainerFile(const DataContainer::Pointer& dc, const QString& filePath, bool writeXdmf, QString& xdmfText)
+{
+  hid_t fileId = QH5Utilities::createFile(filePath);
+  if(fileId < 0)
+  {
+    return -11117;
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+  QH5Lite::writeStringAttribute(fileId, "/", SIMPL::HDF5::FileVersionName, SIMPL::HDF5::FileVersion);
+  QH5Lite::writeStringAttribute(fileId, "/", SIMPL::HDF5::DREAM3DVersion, SIMPLib::Version::Complete());
+
+  QString dcPath = SIMPL::StringConstants::DataContainerGroupName + "/" + dc->getName();
+  if(QH5Utilities::createGroupsFromPath(dcPath, fileId) < 0)
+  {
+    return -60;
+  }
+  hid_t dcGid = H5Gopen(fileId, dcPath.toLatin1().data(), H5P_DEFAULT);
+  sentinel.addGroupId(&dcGid);
+
+  if(dc->writeAttributeMatricesToHDF5(dcGid) < 0)
+  {
+    return -803;
+  }
+  if(dc->writeMeshToHDF5(dcGid, writeXdmf) < 0)
+  {
+    return -804;
+  }
+  if(writeXdmf && dc->getGeometry().get() != nullptr)
+  {
+    QTextStream xdmfOut(&xdmfText);
+    if(dc->writeXdmf(xdmfOut, QH5Utilities::fileNameFromFileId(fileId)) < 0)
+    {
+      return -805;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -66,6 +171,11 @@ DataContainerWriter::DataContainerWriter()
 , m_WriteXdmfFile(true)
 , m_WriteTimeSeries(false)
 , m_AppendToExisting(false)
+, m_CompressionLevel(0)
+, m_ShuffleBytes(true)
+, m_ChunkSize(0)
+, m_WriteInBackground(false)
+, m_WriteSeparateDataContainerFiles(false)
 , m_FileId(-1)
 {
 }
@@ -88,6 +198,11 @@ void DataContainerWriter::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output File", OutputFile, FilterParameter::Parameter, DataContainerWriter, "*.dream3d", ""));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Write Xdmf File", WriteXdmfFile, FilterParameter::Parameter, DataContainerWriter));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Include Xdmf Time Markers", WriteTimeSeries, FilterParameter::Parameter, DataContainerWriter));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Compression Level (0-9)", CompressionLevel, FilterParameter::Parameter, DataContainerWriter));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Shuffle Bytes Before Compressing", ShuffleBytes, FilterParameter::Parameter, DataContainerWriter));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Chunk Size (KiB)", ChunkSize, FilterParameter::Parameter, DataContainerWriter));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Write In Background", WriteInBackground, FilterParameter::Parameter, DataContainerWriter));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Write Each DataContainer To Its Own File", WriteSeparateDataContainerFiles, FilterParameter::Parameter, DataContainerWriter));
 
   setFilterParameters(parameters);
 }
@@ -100,6 +215,11 @@ void DataContainerWriter::readFilterParameters(AbstractFilterParametersReader* r
   reader->openFilterGroup(this, index);
   setOutputFile(reader->readString("OutputFile", getOutputFile()));
   setWriteXdmfFile(reader->readValue("WriteXdmfFile", getWriteXdmfFile()));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
+  setShuffleBytes(reader->readValue("ShuffleBytes", getShuffleBytes()));
+  setChunkSize(reader->readValue("ChunkSize", getChunkSize()));
+  setWriteInBackground(reader->readValue("WriteInBackground", getWriteInBackground()));
+  setWriteSeparateDataContainerFiles(reader->readValue("WriteSeparateDataContainerFiles", getWriteSeparateDataContainerFiles()));
   reader->closeFilterGroup();
 }
 
@@ -127,6 +247,79 @@ void DataContainerWriter::dataCheck()
   }
   FileSystemPathHelper::CheckOutputFile(this, "Output File Path", getOutputFile(), true);
 
+  if(m_CompressionLevel < 0 || m_CompressionLevel > 9)
+  {
+    ss = QObject::tr("The compression level must be between 0 (no compression) and 9");
+    setErrorCondition(-11114, ss);
+  }
+  if(m_ChunkSize < 0)
+  {
+    ss = QObject::tr("The chunk size must be 0 or larger");
+    setErrorCondition(-11115, ss);
+  }
+  if(m_CompressionLevel > 0 && !deflateAvailable())
+  {
+    ss = QObject::tr("The HDF5 library does not support deflate compression. The arrays will be written uncompressed.");
+    setWarningCondition(-11116, ss);
+  }
+
+  // Names that only differ in characters that are replaced in file names would end up in the same file
+  DataContainerArray::Pointer dca = getDataContainerArray();
+  if(m_WriteSeparateDataContainerFiles && nullptr != dca.get())
+  {
+    QMap<QString, QString> dcNamesByFile;
+    for(const QString& dcName : dca->getDataContainerNames())
+    {
+      QString filePath = getDataContainerFilePath(dcName);
+      if(dcNamesByFile.contains(filePath))
+      {
+        ss = QObject::tr("The DataContainers '%1' and '%2' would both be written to '%3'. Rename one of them.").arg(dcNamesByFile[filePath], dcName, filePath);
+        setErrorCondition(-11120, ss);
+        return;
+      }
+      dcNamesByFile.insert(filePath, dcName);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5DatasetCreationOptions DataContainerWriter::getDatasetCreationOptions() const
+{
+  H5DatasetCreationOptions options;
+  options.chunked = (m_ChunkSize > 0);
+  if(m_ChunkSize > 0)
+  {
+    options.targetChunkBytes = static_cast<size_t>(m_ChunkSize) * 1024;
+  }
+  options.deflateLevel = m_CompressionLevel;
+  options.shuffle = m_ShuffleBytes && (options.deflateLevel > 0);
+  return options;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DataContainerWriter::getDataContainerFilePath(const QString& dcName) const
+{
+  // DataContainer names may hold characters that are not allowed in file names on some platforms
+  const QString invalidChars("/\\:*?\"<>|");
+  QString safeName = dcName;
+  for(int i = 0; i < safeName.size(); i++)
+  {
+    if(safeName[i].unicode() < 0x20 || invalidChars.contains(safeName[i]))
+    {
+      safeName[i] = '_';
+    }
+  }
+  QFileInfo fi(m_OutputFile);
+  QString fileName = fi.completeBaseName() + "_" + safeName + "." + fi.suffix();
+  if(fi.path().isEmpty())
+  {
+    return fileName;
+  }
+  return fi.path() + "/" + fileName;
 }
 
 // -----------------------------------------------------------------------------
@@ -155,8 +348,86 @@ void DataContainerWriter::execute()
     return;
   }
 
+  // Arrays that were read on demand from the output file have to be read before it is overwritten
+  QStringList filePaths = {m_OutputFile};
+  if(m_WriteSeparateDataContainerFiles)
+  {
+    QList<QString> dcNames = getDataContainerArray()->getDataContainerNames();
+    for(const QString& dcName : dcNames)
+    {
+      filePaths.push_back(getDataContainerFilePath(dcName));
+    }
+  }
+  for(const QString& filePath : filePaths)
+  {
+    if(H5DataArrayReader::ReadDeferredArrays(filePath) < 0)
+    {
+      QString ss = QObject::tr("Arrays read on demand from '%1' could not be read before the file is overwritten").arg(filePath);
+      setErrorCondition(-11119, ss);
+      return;
+    }
+  }
+
+  // The filters are only walked on the pipeline thread, even when the file is written in the background
+  m_PipelineJson = createPipelineJson();
+
+  if(m_WriteInBackground)
+  {
+    writeInBackground();
+    return;
+  }
+
+  // Earlier background writes may target the same file and HDF5 may not be thread-safe
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+
+  writeFile();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataContainerWriter::writeInBackground()
+{
+  DataContainerWriter::Pointer writer = std::dynamic_pointer_cast<DataContainerWriter>(newFilterInstance(true));
+  writer->setWritePipeline(getWritePipeline());
+  writer->setAppendToExisting(getAppendToExisting());
+  writer->m_PipelineJson = m_PipelineJson;
+  writer->setDataContainerArray(snapshotDataContainerArray(getDataContainerArray()));
+
+  H5BackgroundWriter::Ticket ticket = H5BackgroundWriter::Instance()->enqueue([writer](QString& message) {
+    // The writer only lives as long as this job, so the connection can not outlive message
+    QObject::connect(writer.get(), &AbstractFilter::messageGenerated, [&message](const AbstractMessage::Pointer& msg) {
+      if(nullptr != std::dynamic_pointer_cast<AbstractErrorMessage>(msg).get())
+      {
+        message = msg->generateMessageString();
+      }
+    });
+    writer->writeFile();
+    return writer->getErrorCode();
+  });
+  m_BackgroundWrites.push_back(ticket);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<H5BackgroundWriter::Ticket> DataContainerWriter::takeBackgroundWrites()
+{
+  std::vector<H5BackgroundWriter::Ticket> tickets;
+  tickets.swap(m_BackgroundWrites);
+  return tickets;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataContainerWriter::writeFile()
+{
   int err = 0;
 
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
+
   // Make sure any directory path is also available as the user may have just typed
   // in a path without actually creating the full path
   QFileInfo fi(m_OutputFile);
@@ -178,6 +449,9 @@ void DataContainerWriter::execute()
   }
   // qDebug() << "DREAM3D File: " << m_OutputFile;
 
+  // Rewriting the file within the resolution of its modification time must not leave a stale structure behind
+  SIMPLH5StructureCache::Instance()->remove(m_OutputFile);
+
   // This will make sure if we return early from this method that the HDF5 File is properly closed.
   H5ScopedFileSentinel scopedFileSentinel(&m_FileId, true);
 
@@ -218,56 +492,70 @@ void DataContainerWriter::execute()
   hid_t dcaGid = H5Gopen(m_FileId, SIMPL::StringConstants::DataContainerGroupName.toLatin1().data(), H5P_DEFAULT);
   scopedFileSentinel.addGroupId(&dcaGid);
 
-  QList<QString> dcNames = getDataContainerArray()->getDataContainerNames();
-  for(int iter = 0; iter < getDataContainerArray()->getNumDataContainers(); iter++)
-  {
-    DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(dcNames[iter]);
-    IGeometry::Pointer geometry = dc->getGeometry();
-    err = H5Utilities::createGroupsFromPath(dcNames[iter].toLatin1().data(), dcaGid);
-    if(err < 0)
-    {
-      QString ss = QObject::tr("Error creating HDF5 Group '%1'").arg(dcNames[iter]);
-      setErrorCondition(-60, ss);
-      return;
-    }
-
-    hid_t dcGid = H5Gopen(dcaGid, dcNames[iter].toLatin1().data(), H5P_DEFAULT);
-    H5ScopedGroupSentinel groupSentinel(&dcGid, false);
-    // QString ss = QObject::tr("Writing %2 DataContainer").arg(dcNames[iter]);
+  // Every array written from here on is chunked and compressed as requested, unless it has its own write hints
+  H5DataArrayWriter::ScopedDatasetOptions scopedDatasetOptions(getDatasetCreationOptions());
 
-    // Have the DataContainer write all of its Attribute Matrices and its Mesh
-    err = dc->writeAttributeMatricesToHDF5(dcGid);
-    if(err < 0)
-    {
-      setErrorCondition(-803, "Error writing DataContainer AttributeMatrices");
-      return;
-    }
-    err = dc->writeMeshToHDF5(dcGid, m_WriteXdmfFile);
+  if(m_WriteSeparateDataContainerFiles)
+  {
+    err = writeDataContainerFiles(dcaGid, xdmfOut);
     if(err < 0)
     {
-      setErrorCondition(-804, "Error writing DataContainer Geometry");
       return;
     }
-    if(m_WriteXdmfFile && geometry.get() != nullptr)
+  }
+  else
+  {
+    QList<QString> dcNames = getDataContainerArray()->getDataContainerNames();
+    for(int iter = 0; iter < getDataContainerArray()->getNumDataContainers(); iter++)
     {
-
-      if(getWriteTimeSeries())
+      DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(dcNames[iter]);
+      IGeometry::Pointer geometry = dc->getGeometry();
+      err = H5Utilities::createGroupsFromPath(dcNames[iter].toLatin1().data(), dcaGid);
+      if(err < 0)
       {
-        dc->getGeometry()->setEnableTimeSeries(true);
-        dc->getGeometry()->setTimeValue(static_cast<float>(iter));
+        QString ss = QObject::tr("Error creating HDF5 Group '%1'").arg(dcNames[iter]);
+        setErrorCondition(-60, ss);
+        return;
       }
-#if 0
-      dc->getGeometry()->addOrReplaceAttributeMatrix(SIMPL::StringConstants::MetaData, dc->getAttributeMatrix(SIMPL::StringConstants::MetaData));
-      dc->getGeometry()->setTemporalDataPath(DataArrayPath(dc->getName(), SIMPL::StringConstants::MetaData, "Step #"));
-#endif
 
-      QString hdfFileName = QH5Utilities::fileNameFromFileId(m_FileId);
-      err = dc->writeXdmf(xdmfOut, hdfFileName);
+      hid_t dcGid = H5Gopen(dcaGid, dcNames[iter].toLatin1().data(), H5P_DEFAULT);
+      H5ScopedGroupSentinel groupSentinel(&dcGid, false);
+      // QString ss = QObject::tr("Writing %2 DataContainer").arg(dcNames[iter]);
+
+      // Have the DataContainer write all of its Attribute Matrices and its Mesh
+      err = dc->writeAttributeMatricesToHDF5(dcGid);
       if(err < 0)
       {
-        setErrorCondition(-805, "Error writing Xdmf File");
+        setErrorCondition(-803, "Error writing DataContainer AttributeMatrices");
         return;
       }
+      err = dc->writeMeshToHDF5(dcGid, m_WriteXdmfFile);
+      if(err < 0)
+      {
+        setErrorCondition(-804, "Error writing DataContainer Geometry");
+        return;
+      }
+      if(m_WriteXdmfFile && geometry.get() != nullptr)
+      {
+
+        if(getWriteTimeSeries())
+        {
+          dc->getGeometry()->setEnableTimeSeries(true);
+          dc->getGeometry()->setTimeValue(static_cast<float>(iter));
+        }
+#if 0
+        dc->getGeometry()->addOrReplaceAttributeMatrix(SIMPL::StringConstants::MetaData, dc->getAttributeMatrix(SIMPL::StringConstants::MetaData));
+        dc->getGeometry()->setTemporalDataPath(DataArrayPath(dc->getName(), SIMPL::StringConstants::MetaData, "Step #"));
+#endif
+
+        QString hdfFileName = QH5Utilities::fileNameFromFileId(m_FileId);
+        err = dc->writeXdmf(xdmfOut, hdfFileName);
+        if(err < 0)
+        {
+          setErrorCondition(-805, "Error writing Xdmf File");
+          return;
+        }
+      }
     }
   }
 
@@ -292,6 +580,51 @@ void DataContainerWriter::execute()
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DataContainerWriter::writeDataContainerFiles(hid_t dcaGid, QTextStream& xdmfOut)
+{
+  // HDF5 serializes all of its calls, so the files are written one after the other
+  QList<QString> dcNames = getDataContainerArray()->getDataContainerNames();
+  for(int i = 0; i < dcNames.size(); i++)
+  {
+    DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(dcNames[i]);
+    if(m_WriteXdmfFile && getWriteTimeSeries() && dc->getGeometry().get() != nullptr)
+    {
+      dc->getGeometry()->setEnableTimeSeries(true);
+      dc->getGeometry()->setTimeValue(static_cast<float>(i));
+    }
+    QString filePath = getDataContainerFilePath(dcNames[i]);
+    SIMPLH5StructureCache::Instance()->remove(filePath);
+    QString xdmfText;
+    int err = writeDataContainerFile(dc, filePath, m_WriteXdmfFile, xdmfText);
+    if(err < 0)
+    {
+      QString ss = QObject::tr("Error writing DataContainer '%1' to '%2'").arg(dcNames[i], filePath);
+      setErrorCondition(err, ss);
+      return err;
+    }
+
+    // The link stores the file name only, which HDF5 resolves against the directory of the OutputFile
+    QByteArray linkName = dcNames[i].toLatin1();
+    if(H5Lexists(dcaGid, linkName.data(), H5P_DEFAULT) > 0)
+    {
+      H5Ldelete(dcaGid, linkName.data(), H5P_DEFAULT);
+    }
+    QString objectPath = "/" + SIMPL::StringConstants::DataContainerGroupName + "/" + dcNames[i];
+    err = H5Lcreate_external(QFileInfo(filePath).fileName().toLocal8Bit().data(), objectPath.toLatin1().data(), dcaGid, linkName.data(), H5P_DEFAULT, H5P_DEFAULT);
+    if(err < 0)
+    {
+      QString ss = QObject::tr("Error linking DataContainer '%1' from '%2'").arg(dcNames[i], filePath);
+      setErrorCondition(-11118, ss);
+      return err;
+    }
+    xdmfOut << xdmfText;
+  }
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -363,11 +696,8 @@ void DataContainerWriter::writeXdmfFooter(QTextStream& xdmf)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int DataContainerWriter::writePipeline()
+QString DataContainerWriter::createPipelineJson()
 {
-  // WRITE THE PIPELINE TO THE HDF5 FILE
-  H5FilterParametersWriter::Pointer writer = H5FilterParametersWriter::New();
-
   // Now start walking BACKWARDS through the pipeline to find the first filter.
   AbstractFilter::Pointer previousFilter = getPreviousFilter().lock();
   while(previousFilter.get() != nullptr)
@@ -392,7 +722,17 @@ int DataContainerWriter::writePipeline()
     currentFilter = nextFilter;
   }
 
-  return writer->writePipelineToFile(pipeline, m_OutputFile, SIMPL::StringConstants::PipelineGroupName);
+  JsonFilterParametersWriter::Pointer jsonWriter = JsonFilterParametersWriter::New();
+  return jsonWriter->writePipelineToString(pipeline, SIMPL::StringConstants::PipelineGroupName);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DataContainerWriter::writePipeline()
+{
+  // WRITE THE PIPELINE TO THE HDF5 FILE
+  return H5FilterParametersWriter::WritePipelineJson(m_FileId, SIMPL::StringConstants::PipelineGroupName, m_PipelineJson);
 }
 
 // -----------------------------------------------------------------------------
@@ -36,8 +36,13 @@
 
 #pragma once
 
+#include <vector>
+
+#include "H5Support/H5Lite.h"
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
 #include "SIMPLib/SIMPLib.h"
 
 /**
@@ -52,6 +57,11 @@ class SIMPLib_EXPORT DataContainerWriter : public AbstractFilter
     PYB11_PROPERTY(QString OutputFile READ getOutputFile WRITE setOutputFile)
     PYB11_PROPERTY(bool WriteXdmfFile READ getWriteXdmfFile WRITE setWriteXdmfFile)
     PYB11_PROPERTY(bool WriteTimeSeries READ getWriteTimeSeries WRITE setWriteTimeSeries)
+    PYB11_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+    PYB11_PROPERTY(bool ShuffleBytes READ getShuffleBytes WRITE setShuffleBytes)
+    PYB11_PROPERTY(int ChunkSize READ getChunkSize WRITE setChunkSize)
+    PYB11_PROPERTY(bool WriteInBackground READ getWriteInBackground WRITE setWriteInBackground)
+    PYB11_PROPERTY(bool WriteSeparateDataContainerFiles READ getWriteSeparateDataContainerFiles WRITE setWriteSeparateDataContainerFiles)
 
   public:
     SIMPL_SHARED_POINTERS(DataContainerWriter)
@@ -73,6 +83,59 @@ class SIMPLib_EXPORT DataContainerWriter : public AbstractFilter
 
     SIMPL_INSTANCE_PROPERTY(bool, AppendToExisting)
 
+    /**
+     * @brief gzip level from 1 to 9 for every array written. 0 writes the arrays uncompressed.
+     */
+    SIMPL_FILTER_PARAMETER(int, CompressionLevel)
+    Q_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+
+    /**
+     * @brief Shuffles the bytes of each value before compressing
+     */
+    SIMPL_FILTER_PARAMETER(bool, ShuffleBytes)
+    Q_PROPERTY(bool ShuffleBytes READ getShuffleBytes WRITE setShuffleBytes)
+
+    /**
+     * @brief Approximate chunk size in KiB. 0 writes uncompressed arrays contiguous and uses 1 MiB chunks otherwise.
+     */
+    SIMPL_FILTER_PARAMETER(int, ChunkSize)
+    Q_PROPERTY(int ChunkSize READ getChunkSize WRITE setChunkSize)
+
+    /**
+     * @brief Hands a copy-on-write snapshot of the DataContainerArray to the H5BackgroundWriter and returns without
+     * waiting for the file to be written
+     */
+    SIMPL_FILTER_PARAMETER(bool, WriteInBackground)
+    Q_PROPERTY(bool WriteInBackground READ getWriteInBackground WRITE setWriteInBackground)
+
+    /**
+     * @brief Writes each DataContainer into its own file next to the OutputFile. The OutputFile links to them with
+     * HDF5 external links, so it can be read like any other .dream3d file.
+     */
+    SIMPL_FILTER_PARAMETER(bool, WriteSeparateDataContainerFiles)
+    Q_PROPERTY(bool WriteSeparateDataContainerFiles READ getWriteSeparateDataContainerFiles WRITE setWriteSeparateDataContainerFiles)
+
+    /**
+     * @brief Returns the layout and filters used for arrays that do not have their own write hints
+     * @return
+     */
+    H5DatasetCreationOptions getDatasetCreationOptions() const;
+
+    /**
+     * @brief Returns the path of the file a DataContainer is written to when WriteSeparateDataContainerFiles is set.
+     * Characters of the name that are not allowed in file names are replaced with '_'.
+     * @param dcName
+     * @return
+     */
+    QString getDataContainerFilePath(const QString& dcName) const;
+
+    /**
+     * @brief Returns the tickets of the files this filter queued on the H5BackgroundWriter since the last call
+     * and forgets them
+     * @return
+     */
+    std::vector<H5BackgroundWriter::Ticket> takeBackgroundWrites();
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -188,11 +251,37 @@ class SIMPLib_EXPORT DataContainerWriter : public AbstractFilter
     herr_t closeFile();
 
     /**
-     * @brief writePipeline Writes the existing pipeline to the HDF5 file
+     * @brief createPipelineJson Converts the pipeline this filter is part of to Json
+     * @return
+     */
+    QString createPipelineJson();
+
+    /**
+     * @brief writePipeline Writes the pipeline Json created by createPipelineJson() to the HDF5 file
      * @return
      */
     int writePipeline();
 
+    /**
+     * @brief writeFile Writes the DataContainerArray, the pipeline and the Xdmf file
+     */
+    void writeFile();
+
+    /**
+     * @brief writeInBackground Queues a copy of this filter that writes a snapshot of the DataContainerArray
+     * on the H5BackgroundWriter thread
+     */
+    void writeInBackground();
+
+    /**
+     * @brief writeDataContainerFiles Writes every DataContainer into its own file and links them into the
+     * DataContainers group of the OutputFile. The files are written one after the other.
+     * @param dcaGid Group Id of the DataContainers group
+     * @param xdmfOut QTextStream for the Xdmf output
+     * @return
+     */
+    int writeDataContainerFiles(hid_t dcaGid, QTextStream& xdmfOut);
+
     /**
      * @brief writeDataContainerBundles Writes any existing DataContainerBundles to the HDF5 file
      * @param fileId Group Id for the DataContainerBundles
@@ -214,6 +303,8 @@ class SIMPLib_EXPORT DataContainerWriter : public AbstractFilter
 
   private:
     hid_t m_FileId;
+    QString m_PipelineJson;
+    std::vector<H5BackgroundWriter::Ticket> m_BackgroundWrites;
 
   public:
     DataContainerWriter(const DataContainerWriter&) = delete; // Copy Constructor Not Implemented
@@ -71,13 +71,10 @@ public:
   , m_ControlPoints(std::move(controlPoints))
   , m_ColorArray(std::move(colorArray))
   {
-    m_ArrayMin = arrayPtr->getValue(0);
-    m_ArrayMax = arrayPtr->getValue(0);
-    for (int i=1; i<arrayPtr->getNumberOfTuples(); i++)
-    {
-      if (arrayPtr->getValue(i) < m_ArrayMin) { m_ArrayMin = arrayPtr->getValue(i); }
-      if (arrayPtr->getValue(i) > m_ArrayMax) { m_ArrayMax = arrayPtr->getValue(i); }
-    }
+    // The range comes from the statistics cached on the array, NaN values do not take part in it
+    std::vector<IDataArray::ComponentStatistics> stats = arrayPtr->getComponentStatistics();
+    m_ArrayMin = stats.empty() ? static_cast<T>(0) : static_cast<T>(stats[0].min);
+    m_ArrayMax = stats.empty() ? static_cast<T>(0) : static_cast<T>(stats[0].max);
   }
   virtual ~GenerateColorTableImpl() = default;
 
@@ -38,6 +38,9 @@
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/ImportHDF5DatasetFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 #include "SIMPLib/SIMPLibVersion.h"
 
 #include "H5Support/H5ScopedSentinel.h"
@@ -57,8 +60,8 @@ IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const
 
   ptr = DataArray<T>::CreateArray(numOfTuples, cDims, datasetPath, true);
 
-  T* data = (T*)(ptr->getVoidPointer(0));
-  err = QH5Lite::readPointerDataset(locId, datasetPath, data);
+  // The user chooses the component layout, which may differ from the one a .dream3d file stores with the data set
+  err = H5DataArrayReader::ReadIntoDataArray(locId, datasetPath, ptr.get(), 0, H5DataArrayReader::ReadRegion(), true);
   if(err < 0)
   {
     qDebug() << "readH5Data read error: " << __FILE__ << "(" << __LINE__ << ")";
@@ -158,6 +161,10 @@ void ImportHDF5Dataset::dataCheck()
     return;
   }
 
+  // The file may still be written in the background and other threads call into HDF5 as well
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+  H5LibraryLock libraryLock;
+
   hid_t fileId = H5Utilities::openFile(m_HDF5FilePath.toStdString(), true);
   if(fileId < 0)
   {
@@ -37,11 +37,15 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QVector>
 
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/QH5Utilities.h"
+
 #include "SIMPLib/SIMPLib.h"
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -62,6 +66,11 @@
 #include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5ChunkedDatasetReader.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
+#include "SIMPLib/Utilities/SIMPLH5DataReaderRequirements.h"
+#include "SIMPLib/Utilities/SIMPLH5StructureCache.h"
 
 #include "SIMPLib/Testing/SIMPLTestFileLocations.h"
 #include "SIMPLib/Testing/UnitTestSupport.hpp"
@@ -112,6 +121,36 @@ QString TestFile3()
   return TestDir() + QString::fromLatin1("/DataContainerIOTest_Subset.h5");
 }
 
+QString RegionOfInterestFile()
+{
+  return TestDir() + QString::fromLatin1("/DataContainerIOTest_RegionOfInterest.h5");
+}
+
+QString BackgroundFile()
+{
+  return TestDir() + QString::fromLatin1("/DataContainerIOTest_Background.h5");
+}
+
+QString OnDemandFile()
+{
+  return TestDir() + QString::fromLatin1("/DataContainerIOTest_OnDemand.h5");
+}
+
+QString CompressedFile()
+{
+  return TestDir() + QString::fromLatin1("/DataContainerIOTest_Compressed.h5");
+}
+
+QString SeparateFilesFile()
+{
+  return TestDir() + QString::fromLatin1("/DataContainerIOTest_SeparateFiles.dream3d");
+}
+
+QString StructureCacheFile()
+{
+  return TestDir() + QString::fromLatin1("/DataContainerIOTest_StructureCache.h5");
+}
+
 QString JsonFile()
 {
   return TestDir() + QString::fromLatin1("/DataContainerProxyTest.json");
@@ -146,6 +185,13 @@ public:
     QFile::remove(DataContainerIOTest::TestFile());
     QFile::remove(DataContainerIOTest::TestFile2());
     QFile::remove(DataContainerIOTest::TestFile3());
+    QFile::remove(DataContainerIOTest::RegionOfInterestFile());
+    QFile::remove(DataContainerIOTest::BackgroundFile());
+    QFile::remove(DataContainerIOTest::OnDemandFile());
+    QFile::remove(DataContainerIOTest::CompressedFile());
+    QFile::remove(DataContainerIOTest::SeparateFilesFile());
+    QFile::remove(DataContainerIOTest::StructureCacheFile());
+    QFile::remove(SIMPLH5StructureCache::SidecarFilePath(DataContainerIOTest::StructureCacheFile()));
     QFile::remove(DataContainerIOTest::JsonFile());
     QFile::remove(DataContainerIOTest::H5File());
 
@@ -471,6 +517,561 @@ public:
     DREAM3D_REQUIRE_EQUAL(err, 0);
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDataContainerReaderRegionOfInterest()
+  {
+    size_t nx = DataContainerIOTest::XSize;
+    size_t ny = DataContainerIOTest::YSize;
+    size_t nz = DataContainerIOTest::ZSize;
+    std::vector<size_t> tupleDims = {nx, ny, nz};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(std::make_tuple(nx, ny, nz));
+    image->setSpacing(0.5f, 1.0f, 2.0f);
+    image->setOrigin(1.0f, 2.0f, 3.0f);
+    dc->setGeometry(image);
+    dca->addOrReplaceDataContainer(dc);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    std::vector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer tupleIds = Int32ArrayType::CreateArray(tupleDims, cDims, SIMPL::CellData::FeatureIds, true);
+    StringDataArray::Pointer names = StringDataArray::CreateArray(tupleIds->getNumberOfTuples(), "Names", true);
+    for(size_t i = 0; i < tupleIds->getNumberOfTuples(); i++)
+    {
+      tupleIds->setComponent(i, 0, static_cast<int32_t>(i));
+      tupleIds->setComponent(i, 1, -static_cast<int32_t>(i));
+      names->setValue(i, QString::number(i));
+    }
+    cellAttrMat->insertOrAssign(tupleIds);
+    cellAttrMat->insertOrAssign(names);
+
+    std::vector<size_t> featureDims(1, 4);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(featureDims, getCellFeatureAttributeMatrixName(), AttributeMatrix::Type::CellFeature);
+    featureAttrMat->insertOrAssign(FloatArrayType::CreateArray(4, SIMPL::FeatureData::Volumes, true));
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(dca);
+    writer->setOutputFile(DataContainerIOTest::RegionOfInterestFile());
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), 0);
+
+    // Read the box of voxels (1,1,1) to (3,2,2)
+    DataContainerArray::Pointer dca2 = DataContainerArray::New();
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    reader->setInputFile(DataContainerIOTest::RegionOfInterestFile());
+    reader->setDataContainerArray(dca2);
+    reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(DataContainerIOTest::RegionOfInterestFile()));
+    reader->setReadRegionOfInterest(true);
+    reader->setRegionOfInterestMin(IntVec3Type(1, 1, 1));
+    reader->setRegionOfInterestMax(IntVec3Type(3, 2, 2));
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() >= 0)
+
+    DataContainer::Pointer dc2 = dca2->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    DREAM3D_REQUIRE_VALID_POINTER(dc2.get())
+    ImageGeom::Pointer image2 = dc2->getGeometryAs<ImageGeom>();
+    DREAM3D_REQUIRE_VALID_POINTER(image2.get())
+    SizeVec3Type dims = image2->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], 3)
+    DREAM3D_REQUIRE_EQUAL(dims[1], 2)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 2)
+    FloatVec3Type origin = image2->getOrigin();
+    DREAM3D_REQUIRE_EQUAL(origin[0], 1.5f)
+    DREAM3D_REQUIRE_EQUAL(origin[1], 3.0f)
+    DREAM3D_REQUIRE_EQUAL(origin[2], 5.0f)
+
+    AttributeMatrix::Pointer cellAttrMat2 = dc2->getAttributeMatrix(getCellAttributeMatrixName());
+    DREAM3D_REQUIRE_EQUAL(cellAttrMat2->getNumberOfTuples(), 12)
+    Int32ArrayType::Pointer tupleIds2 = cellAttrMat2->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    StringDataArray::Pointer names2 = cellAttrMat2->getAttributeArrayAs<StringDataArray>("Names");
+    DREAM3D_REQUIRE_VALID_POINTER(tupleIds2.get())
+    DREAM3D_REQUIRE_VALID_POINTER(names2.get())
+    size_t index = 0;
+    for(size_t z = 1; z <= 2; z++)
+    {
+      for(size_t y = 1; y <= 2; y++)
+      {
+        for(size_t x = 1; x <= 3; x++)
+        {
+          int32_t fileTuple = static_cast<int32_t>((z * ny + y) * nx + x);
+          DREAM3D_REQUIRE_EQUAL(tupleIds2->getComponent(index, 0), fileTuple)
+          DREAM3D_REQUIRE_EQUAL(tupleIds2->getComponent(index, 1), -fileTuple)
+          DREAM3D_REQUIRE(names2->getValue(index) == QString::number(fileTuple))
+          index++;
+        }
+      }
+    }
+    // Only the Cell data follows the region
+    DREAM3D_REQUIRE_EQUAL(dc2->getAttributeMatrix(getCellFeatureAttributeMatrixName())->getNumberOfTuples(), 4)
+
+    // A region that reaches past the image is reported with its own error code
+    reader->setDataContainerArray(DataContainerArray::New());
+    reader->setRegionOfInterestMax(IntVec3Type(static_cast<int>(nx), 2, 2));
+    reader->execute();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -198745605)
+
+    // A range of tuples can be read from any array
+    hid_t fileId = QH5Utilities::openFile(DataContainerIOTest::RegionOfInterestFile(), true);
+    DREAM3D_REQUIRE(fileId > 0)
+    {
+      H5ScopedFileSentinel sentinel(&fileId, true);
+      QString amPath = QString("/%1/%2/%3").arg(SIMPL::StringConstants::DataContainerGroupName, SIMPL::Defaults::ImageDataContainerName, getCellAttributeMatrixName());
+      hid_t amGid = H5Gopen(fileId, amPath.toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRE(amGid > 0)
+      sentinel.addGroupId(&amGid);
+      IDataArray::Pointer range = H5DataArrayReader::ReadIDataArray(amGid, SIMPL::CellData::FeatureIds, H5DataArrayReader::ReadRegion::TupleRange(7, 25));
+      Int32ArrayType::Pointer rangeIds = std::dynamic_pointer_cast<Int32ArrayType>(range);
+      DREAM3D_REQUIRE_VALID_POINTER(rangeIds.get())
+      DREAM3D_REQUIRE_EQUAL(rangeIds->getNumberOfTuples(), 25)
+      for(size_t i = 0; i < 25; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(rangeIds->getComponent(i, 0), static_cast<int32_t>(i + 7))
+      }
+      range = H5DataArrayReader::ReadIDataArray(amGid, SIMPL::CellData::FeatureIds, H5DataArrayReader::ReadRegion::TupleRange(50, 11));
+      DREAM3D_REQUIRE_NULL_POINTER(range.get())
+    }
+
+    // A region outside of the geometry is an error
+    DataContainerArray::Pointer dca3 = DataContainerArray::New();
+    reader->setDataContainerArray(dca3);
+    reader->setRegionOfInterestMax(IntVec3Type(3, 2, 5));
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() < 0)
+    reader->setRegionOfInterestMin(IntVec3Type(2, 1, 1));
+    reader->setRegionOfInterestMax(IntVec3Type(1, 2, 2));
+    reader->execute();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -392)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDataContainerWriterBackground()
+  {
+    size_t nx = DataContainerIOTest::XSize;
+    size_t ny = DataContainerIOTest::YSize;
+    size_t nz = DataContainerIOTest::ZSize;
+    std::vector<size_t> tupleDims = {nx, ny, nz};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(std::make_tuple(nx, ny, nz));
+    dc->setGeometry(image);
+    dca->addOrReplaceDataContainer(dc);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 1), SIMPL::CellData::FeatureIds, true);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i));
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(dca);
+    writer->setOutputFile(DataContainerIOTest::BackgroundFile());
+    writer->setWriteXdmfFile(false);
+    writer->setWriteInBackground(true);
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), 0)
+
+    // The pipeline may keep modifying its arrays while the file is written. The snapshot keeps the old values.
+    featureIds->initializeWithValue(-1);
+    cellAttrMat->removeAttributeArray(SIMPL::CellData::FeatureIds);
+
+    // Reading the file waits for the background write
+    DataContainerArray::Pointer dca2 = DataContainerArray::New();
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    reader->setInputFile(DataContainerIOTest::BackgroundFile());
+    reader->setDataContainerArray(dca2);
+    reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(DataContainerIOTest::BackgroundFile()));
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() >= 0)
+    DREAM3D_REQUIRE_EQUAL(H5BackgroundWriter::Instance()->getNumberOfPendingWrites(), 0)
+
+    // The writer hands out the ticket of its job once
+    std::vector<H5BackgroundWriter::Ticket> tickets = writer->takeBackgroundWrites();
+    DREAM3D_REQUIRE_EQUAL(tickets.size(), 1)
+    DREAM3D_REQUIRE_EQUAL(H5BackgroundWriter::Instance()->wait(tickets[0]).code, 0)
+    DREAM3D_REQUIRE_EQUAL(writer->takeBackgroundWrites().size(), 0)
+
+    DataContainer::Pointer dc2 = dca2->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    DREAM3D_REQUIRE_VALID_POINTER(dc2.get())
+    Int32ArrayType::Pointer featureIds2 = dc2->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds2.get())
+    DREAM3D_REQUIRE_EQUAL(featureIds2->getNumberOfTuples(), nx * ny * nz)
+    for(size_t i = 0; i < featureIds2->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds2->getValue(i), static_cast<int32_t>(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDataContainerReaderOnDemand()
+  {
+    size_t nx = DataContainerIOTest::XSize;
+    size_t ny = DataContainerIOTest::YSize;
+    size_t nz = DataContainerIOTest::ZSize;
+    std::vector<size_t> tupleDims = {nx, ny, nz};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(std::make_tuple(nx, ny, nz));
+    dc->setGeometry(image);
+    dca->addOrReplaceDataContainer(dc);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 2), SIMPL::CellData::FeatureIds, true);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      featureIds->setComponent(i, 0, static_cast<int32_t>(i));
+      featureIds->setComponent(i, 1, -static_cast<int32_t>(i));
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    FloatArrayType::Pointer confidence = FloatArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 1), SIMPL::CellData::ConfidenceIndex, true);
+    confidence->initializeWithValue(0.5f);
+    cellAttrMat->insertOrAssign(confidence);
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(dca);
+    writer->setOutputFile(DataContainerIOTest::OnDemandFile());
+    writer->setWriteXdmfFile(false);
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), 0)
+
+    DataContainerArray::Pointer dca2 = DataContainerArray::New();
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    reader->setInputFile(DataContainerIOTest::OnDemandFile());
+    reader->setDataContainerArray(dca2);
+    reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(DataContainerIOTest::OnDemandFile()));
+    reader->setReadArraysOnDemand(true);
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() >= 0)
+
+    // The arrays have their dimensions but no values yet
+    AttributeMatrix::Pointer cellAttrMat2 = dca2->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(getCellAttributeMatrixName());
+    Int32ArrayType::Pointer featureIds2 = cellAttrMat2->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    FloatArrayType::Pointer confidence2 = cellAttrMat2->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ConfidenceIndex);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds2.get())
+    DREAM3D_REQUIRE_VALID_POINTER(confidence2.get())
+    DREAM3D_REQUIRE_EQUAL(featureIds2->isLoadDeferred(), true)
+    DREAM3D_REQUIRE_EQUAL(confidence2->isLoadDeferred(), true)
+    DREAM3D_REQUIRE_EQUAL(featureIds2->getNumberOfTuples(), nx * ny * nz)
+    DREAM3D_REQUIRE_EQUAL(featureIds2->getNumberOfComponents(), 2)
+
+    // The first access reads the values of that array only
+    DREAM3D_REQUIRE_EQUAL(featureIds2->getComponent(7, 1), -7)
+    DREAM3D_REQUIRE_EQUAL(featureIds2->isLoadDeferred(), false)
+    DREAM3D_REQUIRE_EQUAL(confidence2->isLoadDeferred(), true)
+    for(size_t i = 0; i < featureIds2->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds2->getComponent(i, 0), static_cast<int32_t>(i))
+    }
+
+    // Overwriting the file reads the remaining arrays first
+    writer->setDataContainerArray(dca2);
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(confidence2->isLoadDeferred(), false)
+    DREAM3D_REQUIRE_EQUAL(confidence2->getValue(confidence2->getNumberOfTuples() - 1), 0.5f)
+
+    // Arrays that cannot be read any more fail the writer instead of overwriting the file with their initialization value
+    DataContainerArray::Pointer dca3 = DataContainerArray::New();
+    reader->setDataContainerArray(dca3);
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() >= 0)
+    DREAM3D_REQUIRE(QFile::remove(DataContainerIOTest::OnDemandFile()))
+    writer->setDataContainerArray(dca3);
+    writer->execute();
+    DREAM3D_REQUIRE(writer->getErrorCode() < 0)
+    IDataArray::Pointer confidence3 = dca3->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, getCellAttributeMatrixName(), ""))
+                                          ->getAttributeArray(SIMPL::CellData::ConfidenceIndex);
+    DREAM3D_REQUIRE_VALID_POINTER(confidence3.get())
+    DREAM3D_REQUIRE_EQUAL(confidence3->hasDeferredReadFailed(), true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDataContainerReaderCompressed()
+  {
+    // Large enough for each array to be split into many chunks
+    std::vector<size_t> tupleDims = {40, 30, 20};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(std::make_tuple(tupleDims[0], tupleDims[1], tupleDims[2]));
+    dc->setGeometry(image);
+    dca->addOrReplaceDataContainer(dc);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 2), SIMPL::CellData::FeatureIds, true);
+    FloatArrayType::Pointer confidence = FloatArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 1), SIMPL::CellData::ConfidenceIndex, true);
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      featureIds->setComponent(i, 0, static_cast<int32_t>(i / 7));
+      featureIds->setComponent(i, 1, -static_cast<int32_t>(i));
+      confidence->setValue(i, static_cast<float>(i % 100) * 0.01f);
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    cellAttrMat->insertOrAssign(confidence);
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(dca);
+    writer->setOutputFile(DataContainerIOTest::CompressedFile());
+    writer->setWriteXdmfFile(false);
+    writer->setCompressionLevel(5);
+    writer->setShuffleBytes(true);
+    writer->setChunkSize(16);
+    writer->execute();
+    DREAM3D_REQUIRE(writer->getErrorCode() >= 0)
+
+    DataContainerArray::Pointer dca2 = DataContainerArray::New();
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    reader->setInputFile(DataContainerIOTest::CompressedFile());
+    reader->setDataContainerArray(dca2);
+    reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(DataContainerIOTest::CompressedFile()));
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() >= 0)
+
+    AttributeMatrix::Pointer cellAttrMat2 = dca2->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(getCellAttributeMatrixName());
+    Int32ArrayType::Pointer featureIds2 = cellAttrMat2->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    FloatArrayType::Pointer confidence2 = cellAttrMat2->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ConfidenceIndex);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds2.get())
+    DREAM3D_REQUIRE_VALID_POINTER(confidence2.get())
+    DREAM3D_REQUIRE_EQUAL(featureIds2->getSize(), featureIds->getSize())
+    DREAM3D_REQUIRE_EQUAL(confidence2->getSize(), confidence->getSize())
+    for(size_t i = 0; i < featureIds->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds2->getValue(i), featureIds->getValue(i))
+    }
+    for(size_t i = 0; i < confidence->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(confidence2->getValue(i), confidence->getValue(i))
+    }
+
+    // Decoding the chunks ourselves must give the same values as letting HDF5 read the dataset
+    hid_t fileId = QH5Utilities::openFile(DataContainerIOTest::CompressedFile(), true);
+    DREAM3D_REQUIRE(fileId > 0)
+    {
+      H5ScopedFileSentinel sentinel(&fileId, true);
+      QString amPath = QString("/%1/%2/%3").arg(SIMPL::StringConstants::DataContainerGroupName, SIMPL::Defaults::ImageDataContainerName, getCellAttributeMatrixName());
+      hid_t amGid = H5Gopen(fileId, amPath.toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRE(amGid > 0)
+      sentinel.addGroupId(&amGid);
+      // The values are decoded here exactly when the build can inflate the chunks, otherwise they are left untouched
+      std::vector<int32_t> values(featureIds->getSize(), 0);
+      herr_t expectedErr = H5ChunkedDatasetReader::IsDeflateAvailable() ? 1 : 0;
+      herr_t err = H5ChunkedDatasetReader::ReadDataset(amGid, SIMPL::CellData::FeatureIds, H5T_NATIVE_INT32, values.data());
+      DREAM3D_REQUIRE_EQUAL(err, expectedErr)
+      for(size_t i = 0; i < values.size(); i++)
+      {
+        int32_t expectedValue = (err > 0) ? featureIds->getValue(i) : 0;
+        DREAM3D_REQUIRE_EQUAL(values[i], expectedValue)
+      }
+      // A type that needs more than byte swapping is left to HDF5
+      std::vector<double> doubles(featureIds->getSize(), 0.0);
+      DREAM3D_REQUIRE_EQUAL(H5ChunkedDatasetReader::ReadDataset(amGid, SIMPL::CellData::FeatureIds, H5T_NATIVE_DOUBLE, doubles.data()), 0)
+    }
+
+    // Values stored with the other byte order are swapped while decoding, with or without the shuffle filter
+    fileId = QH5Utilities::openFile(DataContainerIOTest::CompressedFile(), false);
+    DREAM3D_REQUIRE(fileId > 0)
+    {
+      H5ScopedFileSentinel sentinel(&fileId, true);
+      hid_t swappedType = H5Tcopy(H5T_NATIVE_INT32);
+      H5Tset_order(swappedType, H5Tget_order(H5T_NATIVE_INT32) == H5T_ORDER_LE ? H5T_ORDER_BE : H5T_ORDER_LE);
+      std::vector<hsize_t> dims = {17, 23, 5};
+      std::vector<hsize_t> chunkDims = {4, 7, 3};
+      std::vector<int32_t> expected(17 * 23 * 5);
+      for(size_t i = 0; i < expected.size(); i++)
+      {
+        expected[i] = static_cast<int32_t>(i * 7) - 1000;
+      }
+      for(const bool shuffle : {false, true})
+      {
+        QString name = shuffle ? "ByteSwappedShuffled" : "ByteSwapped";
+        hid_t spaceId = H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr);
+        hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(dcpl, static_cast<int>(chunkDims.size()), chunkDims.data());
+        if(shuffle)
+        {
+          H5Pset_shuffle(dcpl);
+        }
+        hid_t did = H5Dcreate(fileId, name.toLatin1().data(), swappedType, spaceId, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        DREAM3D_REQUIRE(did > 0)
+        DREAM3D_REQUIRE(H5Dwrite(did, H5T_NATIVE_INT32, H5S_ALL, H5S_ALL, H5P_DEFAULT, expected.data()) >= 0)
+        H5Dclose(did);
+        H5Pclose(dcpl);
+        H5Sclose(spaceId);
+
+        std::vector<int32_t> swapped(expected.size(), 0);
+        herr_t expectedErr = H5ChunkedDatasetReader::IsAvailable() ? 1 : 0;
+        herr_t err = H5ChunkedDatasetReader::ReadDataset(fileId, name, H5T_NATIVE_INT32, swapped.data());
+        DREAM3D_REQUIRE_EQUAL(err, expectedErr)
+        if(err > 0)
+        {
+          DREAM3D_REQUIRE(swapped == expected)
+        }
+      }
+      H5Tclose(swappedType);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDataContainerWriterSeparateFiles()
+  {
+    std::vector<size_t> tupleDims = {5, 4, 3};
+    const int numTiles = 4;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    for(int t = 0; t < numTiles; t++)
+    {
+      DataContainer::Pointer dc = DataContainer::New(QString("Tile_%1").arg(t));
+      ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+      image->setDimensions(std::make_tuple(tupleDims[0], tupleDims[1], tupleDims[2]));
+      dc->setGeometry(image);
+      AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+      dc->addOrReplaceAttributeMatrix(cellAttrMat);
+      Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 1), SIMPL::CellData::FeatureIds, true);
+      for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+      {
+        featureIds->setValue(i, static_cast<int32_t>(t * 1000 + i));
+      }
+      cellAttrMat->insertOrAssign(featureIds);
+      dca->addOrReplaceDataContainer(dc);
+    }
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(dca);
+    writer->setOutputFile(DataContainerIOTest::SeparateFilesFile());
+    writer->setWriteXdmfFile(true);
+    writer->setWriteSeparateDataContainerFiles(true);
+    writer->execute();
+    DREAM3D_REQUIRE(writer->getErrorCode() >= 0)
+    for(int t = 0; t < numTiles; t++)
+    {
+      DREAM3D_REQUIRE(QFile::exists(writer->getDataContainerFilePath(QString("Tile_%1").arg(t))))
+    }
+
+    // The DataContainers are read through the external links of the main file
+    DataContainerArray::Pointer dca2 = DataContainerArray::New();
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    reader->setInputFile(DataContainerIOTest::SeparateFilesFile());
+    reader->setDataContainerArray(dca2);
+    reader->setInputFileDataContainerArrayProxy(reader->readDataContainerArrayStructure(DataContainerIOTest::SeparateFilesFile()));
+    reader->execute();
+    DREAM3D_REQUIRE(reader->getErrorCode() >= 0)
+    DREAM3D_REQUIRE_EQUAL(dca2->getNumDataContainers(), numTiles)
+    for(int t = 0; t < numTiles; t++)
+    {
+      DataContainer::Pointer dc = dca2->getDataContainer(QString("Tile_%1").arg(t));
+      DREAM3D_REQUIRE_VALID_POINTER(dc.get())
+      Int32ArrayType::Pointer featureIds = dc->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+      DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(59), t * 1000 + 59)
+    }
+
+    // Names are turned into valid file names and must still give every DataContainer its own file
+    DREAM3D_REQUIRE(QFileInfo(writer->getDataContainerFilePath("Tile/1:a*b")).fileName().endsWith("_Tile_1_a_b.dream3d"))
+    DataContainerArray::Pointer clashing = DataContainerArray::New();
+    clashing->addOrReplaceDataContainer(DataContainer::New("Tile:1"));
+    clashing->addOrReplaceDataContainer(DataContainer::New("Tile?1"));
+    writer->setDataContainerArray(clashing);
+    writer->preflight();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), -11120)
+
+#if REMOVE_TEST_FILES
+    for(int t = 0; t < numTiles; t++)
+    {
+      QFile::remove(writer->getDataContainerFilePath(QString("Tile_%1").arg(t)));
+    }
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDataContainerArrayStructureCache()
+  {
+    QString filePath = DataContainerIOTest::StructureCacheFile();
+    std::vector<size_t> tupleDims = {DataContainerIOTest::XSize, DataContainerIOTest::YSize, DataContainerIOTest::ZSize};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(std::make_tuple(tupleDims[0], tupleDims[1], tupleDims[2]));
+    dc->setGeometry(image);
+    dca->addOrReplaceDataContainer(dc);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, getCellAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    cellAttrMat->insertOrAssign(Int32ArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 1), SIMPL::CellData::FeatureIds, true));
+
+    DataContainerWriter::Pointer writer = DataContainerWriter::New();
+    writer->setDataContainerArray(dca);
+    writer->setOutputFile(filePath);
+    writer->setWriteXdmfFile(false);
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), 0)
+
+    SIMPLH5StructureCache* cache = SIMPLH5StructureCache::Instance();
+    cache->clear();
+    SIMPLH5DataReaderRequirements req(SIMPL::Defaults::AnyPrimitive, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Any, IGeometry::Type::Any);
+    DataContainerArrayProxy cachedProxy;
+    DREAM3D_REQUIRE_EQUAL(cache->find(filePath, &req, cachedProxy), false)
+
+    // Reading the structure fills the cache
+    DataContainerReader::Pointer reader = DataContainerReader::New();
+    DataContainerArrayProxy proxy = reader->readDataContainerArrayStructure(filePath);
+    DREAM3D_REQUIRE_EQUAL(proxy.getDataContainers().size(), 1)
+    DREAM3D_REQUIRE_EQUAL(cache->getNumberOfFiles(), 1)
+    DREAM3D_REQUIRE_EQUAL(cache->find(filePath, &req, cachedProxy), true)
+    DREAM3D_REQUIRE(cachedProxy == proxy)
+    DREAM3D_REQUIRE(reader->readDataContainerArrayStructure(filePath) == proxy)
+
+    // Each set of requirements is cached separately
+    DREAM3D_REQUIRE_EQUAL(cache->find(filePath, nullptr, cachedProxy), false)
+
+    // Rewriting the file replaces the cached structure
+    cellAttrMat->insertOrAssign(FloatArrayType::CreateArray(tupleDims, std::vector<size_t>(1, 1), SIMPL::CellData::ConfidenceIndex, true));
+    writer->execute();
+    DREAM3D_REQUIRE_EQUAL(writer->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(cache->find(filePath, &req, cachedProxy), false)
+    proxy = reader->readDataContainerArrayStructure(filePath);
+    DREAM3D_REQUIRE(proxy.contains(SIMPL::Defaults::ImageDataContainerName))
+    AttributeMatrixProxy amProxy = proxy.getDataContainerProxy(SIMPL::Defaults::ImageDataContainerName).getAttributeMatricies()[getCellAttributeMatrixName()];
+    DREAM3D_REQUIRE_EQUAL(amProxy.getDataArrays().size(), 2)
+
+    // The sidecar file keeps the structure when the memory cache is lost
+    cache->setUseSidecarFiles(true);
+    cache->clear();
+    proxy = reader->readDataContainerArrayStructure(filePath);
+    DREAM3D_REQUIRE(QFile::exists(SIMPLH5StructureCache::SidecarFilePath(filePath)))
+    cache->clear();
+    DREAM3D_REQUIRE_EQUAL(cache->find(filePath, &req, cachedProxy), true)
+    DREAM3D_REQUIRE(cachedProxy == proxy)
+    cache->setUseSidecarFiles(false);
+    cache->remove(filePath);
+    DREAM3D_REQUIRE_EQUAL(QFile::exists(SIMPLH5StructureCache::SidecarFilePath(filePath)), false)
+    DREAM3D_REQUIRE_EQUAL(cache->find(filePath, &req, cachedProxy), false)
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -1197,6 +1798,12 @@ public:
     DREAM3D_REGISTER_TEST(TestDataContainerArrayProxy())
 
     DREAM3D_REGISTER_TEST(TestDataContainerReader())
+    DREAM3D_REGISTER_TEST(TestDataContainerReaderRegionOfInterest())
+    DREAM3D_REGISTER_TEST(TestDataContainerWriterBackground())
+    DREAM3D_REGISTER_TEST(TestDataContainerReaderOnDemand())
+    DREAM3D_REGISTER_TEST(TestDataContainerReaderCompressed())
+    DREAM3D_REGISTER_TEST(TestDataContainerWriterSeparateFiles())
+    DREAM3D_REGISTER_TEST(TestDataContainerArrayStructureCache())
     DREAM3D_REGISTER_TEST(TestDataArrayPath())
 
 #if REMOVE_TEST_FILES
@@ -36,19 +36,31 @@
 #pragma once
 
 // STL Includes
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include <QtCore/QStringList>
+
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArrayAllocator.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataArrays/PackedIntegerBlocks.hpp"
 #include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/HDF5/H5DataArrayWriter.hpp"
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #define mxa_bswap(s, d, t)                                                                                                                                                                             \
   t[0] = ptr[s];                                                                                                                                                                                       \
@@ -83,6 +95,7 @@ public:
 
   //========================================= SIMPL INTERFACE COMPATIBILITY =================================
   using ContainterType = std::vector<Pointer>;
+  using StorageType = DataArrayAllocator::StorageType;
 
   //========================================= Constructing DataArray Objects =================================
   DataArray() = default;
@@ -126,23 +139,21 @@ public:
    * @param compDims The number of elements in each axis dimension.
    * @param initValue The value to use when initializing each element of the array
    * @param allocate Will all the memory be allocated at time of construction
+   *
+   * Only the sizes are recorded here. The static CreateArray() functions call allocate() when requested so
+   * that the memory is not filled on the calling thread only to be thrown away again. The pages of the
+   * block are first touched by whoever initializes or writes the values.
    */
   DataArray(size_t numTuples, const QString& name, comp_dims_type compDims, T initValue, bool allocate)
   : IDataArray(name)
   , m_NumTuples(numTuples)
   , m_CompDims(std::move(compDims))
   {
+    Q_UNUSED(allocate)
     m_NumComponents = std::accumulate(m_CompDims.begin(), m_CompDims.end(), 1, std::multiplies<>());
     m_InitValue = static_cast<T>(0);
-    if(allocate)
-    {
-      resizeTuples(numTuples);
-    }
-    else
-    {
-      m_Size = m_NumTuples * m_NumComponents;
-      m_MaxId = (m_Size > 0) ? m_Size - 1 : m_Size;
-    }
+    m_Size = m_NumTuples * m_NumComponents;
+    m_MaxId = (m_Size > 0) ? m_Size - 1 : m_Size;
 #if 0
       MUD_FLAP_0 = MUD_FLAP_1 = MUD_FLAP_2 = MUD_FLAP_3 = MUD_FLAP_4 = MUD_FLAP_5 = 0xABABABABABABABABul;
 #endif
@@ -390,7 +401,8 @@ public:
   //========================================= Begin API =================================
 
   /**
-   * @brief deepCopy
+   * @brief deepCopy Creates a copy of this array with its own memory. Use createSharedCopy() to get a copy
+   * that shares the memory of this array instead.
    * @param forceNoAllocate
    * @return
    */
@@ -401,17 +413,420 @@ public:
     {
       allocate = false;
     }
+    if(allocate)
+    {
+      // The copy must not depend on the source of the values still being there
+      loadDeferredValues();
+    }
+    std::shared_ptr<const PackedIntegerBlocks<T>> blocks = compressedBlocks();
+    if(allocate && nullptr != blocks)
+    {
+      // The packed blocks are never modified, so the copy can reference them and stays compressed
+      Pointer daCopy = CreateArray(getNumberOfTuples(), getComponentDimensions(), getName(), false);
+      daCopy->m_InitValue = m_InitValue;
+      daCopy->m_StorageType = m_StorageType;
+      daCopy->m_CompressedValues.blocks = blocks;
+      daCopy->m_CompressedValues.active.store(true, std::memory_order_release);
+      daCopy->m_IsAllocated = true;
+      daCopy->copyWriteHints(*this);
+      return daCopy;
+    }
+    ensureResident();
     IDataArray::Pointer daCopy = createNewArray(getNumberOfTuples(), getComponentDimensions(), getName(), allocate);
     if(m_IsAllocated && !forceNoAllocate)
     {
-      T* src = getPointer(0);
       void* dest = daCopy->getVoidPointer(0);
       size_t totalBytes = (getNumberOfTuples() * getNumberOfComponents() * sizeof(T));
-      std::memcpy(dest, src, totalBytes);
+      std::memcpy(dest, m_Array, totalBytes);
+    }
+    daCopy->copyWriteHints(*this);
+    return daCopy;
+  }
+
+  /**
+   * @brief createSharedCopy Creates a copy-on-write copy of this array: both arrays share the same memory
+   * until either one of them hands out a pointer (getPointer(), getVoidPointer(), iterators, ...), runs a bulk
+   * write or is given prepareForWrite(), at which point only the modified array duplicates the values. The
+   * element accessors (setValue(), operator[], ...) do not check, so call prepareForWrite() before using them
+   * on either array. Taking the copy is O(1) in time and memory.
+   *
+   * Raw pointers obtained from this array before the call still point at the shared memory. Writing through
+   * them afterwards changes the copy as well, so only take a shared copy when nobody holds such a pointer,
+   * e.g. between two filters of a pipeline. Arrays that do not own their memory fall back to deepCopy().
+   * @return
+   */
+  IDataArray::Pointer createSharedCopy() override
+  {
+    if(!m_IsAllocated)
+    {
+      return deepCopy(false);
     }
+    loadDeferredValues();
+    if(nullptr != compressedBlocks())
+    {
+      return deepCopy(false);
+    }
+    ensureResident();
+    if(!m_OwnsData || nullptr == m_Array)
+    {
+      return deepCopy(false);
+    }
+    Pointer daCopy = CreateArray(getNumberOfTuples(), getComponentDimensions(), getName(), false);
+    daCopy->m_InitValue = m_InitValue;
+    daCopy->m_StorageType = m_StorageType;
+    daCopy->copyWriteHints(*this);
+    shareBuffer(*daCopy);
     return daCopy;
   }
 
+  /**
+   * @brief Returns true if the memory of this array is currently shared with one or more copy-on-write
+   * copies created by createSharedCopy().
+   * @return
+   */
+  bool isSharingData() const
+  {
+    if(!m_IsShared.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(SharedBufferMutex());
+    return (nullptr != m_SharedBuffer && m_SharedBuffer.use_count() > 1);
+  }
+
+  /**
+   * @brief Gets the array ready for writes through the element accessors (setValue(), setComponent(),
+   * initializeTuple(), operator[], at(), front() and back()). Those accessors do not check for shared memory
+   * or cached statistics, so call this once before writing to an array that may share its memory with a
+   * copy-on-write copy or whose statistics may have been queried. The accessors that hand out a pointer and
+   * the bulk writes do the same thing themselves.
+   * @return false if the shared memory could not be duplicated. The array then still shares its memory and
+   * must not be written to.
+   */
+  bool prepareForWrite() override
+  {
+    invalidateStatistics();
+    return unshareBuffer();
+  }
+
+  /**
+   * @brief Replaces the values of an integer array with a PackedIntegerBlocks copy and releases the plain
+   * memory. This is meant for large label style arrays (feature ids, phases, masks) that are kept around but
+   * rarely touched. The values can be read block by block with getBlockIterator(), and one at a time with
+   * getValue() and getComponent(), while the array stays compressed. Every accessor that hands out a pointer
+   * or a reference, getPointer() included, transparently decompresses the array first (see decompress()), so
+   * pointers obtained before compress() are invalid afterwards.
+   * @return true if the array is compressed afterwards. Floating point arrays, arrays that do not own their
+   * memory and arrays whose values do not pack smaller than the plain layout are left alone.
+   */
+  bool compress()
+  {
+    if(!std::is_integral<T>::value)
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(m_CompressedValues.mutex);
+    if(m_CompressedValues.active.load(std::memory_order_relaxed))
+    {
+      return true;
+    }
+    if(!m_IsAllocated || nullptr == m_Array || !m_OwnsData || m_Size == 0)
+    {
+      return false;
+    }
+    auto blocks = std::make_shared<PackedIntegerBlocks<T>>();
+    blocks->encode(m_Array, m_Size);
+    if(blocks->getByteSize() >= m_Size * sizeof(T))
+    {
+      return false;
+    }
+    deallocate();
+    m_CompressedValues.blocks = blocks;
+    m_CompressedValues.active.store(true, std::memory_order_release);
+    m_IsAllocated = true;
+    return true;
+  }
+
+  /**
+   * @brief Restores the plain layout of a compressed array. Does nothing if the array is not compressed.
+   * @return false if the memory for the plain layout could not be allocated. The array stays compressed in
+   * that case, so its values can still be read with getValue() and getBlockIterator(), but every accessor
+   * that hands out a pointer returns nullptr.
+   */
+  bool decompress()
+  {
+    if(!m_CompressedValues.active.load(std::memory_order_acquire))
+    {
+      return true;
+    }
+    // Several threads may read the same compressed array. Only one of them may decompress it.
+    std::lock_guard<std::mutex> lock(m_CompressedValues.mutex);
+    if(!m_CompressedValues.active.load(std::memory_order_relaxed))
+    {
+      return true;
+    }
+    T* newArray = static_cast<T*>(DataArrayAllocator::Allocate(m_Size * sizeof(T), m_StorageType));
+    if(nullptr == newArray)
+    {
+      qDebug() << "Unable to allocate " << m_Size << " elements of size " << sizeof(T) << " bytes to decompress " << getName() << ". The array stays compressed.";
+      return false;
+    }
+    m_CompressedValues.blocks->decode(newArray);
+    m_Array = newArray;
+    m_OwnsData = true;
+    m_CompressedValues.blocks.reset();
+    m_CompressedValues.active.store(false, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Returns true if the values are currently held in compressed form
+   * @return
+   */
+  bool isCompressed() const
+  {
+    return m_CompressedValues.active.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Fills all getSize() values of an array whose reading was deferred. Returns false if the values could not be read.
+   */
+  using DeferredLoader = std::function<bool(T* values)>;
+
+  /**
+   * @brief Releases the values and defers reading them until they are first accessed. The array keeps its
+   * dimensions and reports itself as allocated. Every accessor that would decompress a compressed array calls
+   * the loader instead, once. H5DataArrayReader uses this to read .dream3d files on demand.
+   * @param loader
+   */
+  void setDeferredLoader(DeferredLoader loader)
+  {
+    if(nullptr != m_Array && m_OwnsData)
+    {
+      deallocate();
+    }
+    clearCompressed();
+    m_Array = nullptr;
+    m_OwnsData = true;
+    m_DeferredValues.loader = std::move(loader);
+    m_DeferredValues.failed.store(false, std::memory_order_release);
+    m_DeferredValues.active.store(true, std::memory_order_release);
+    m_IsAllocated = true;
+  }
+
+  /**
+   * @brief Returns true if the values have not been read yet
+   * @return
+   */
+  bool isLoadDeferred() const
+  {
+    return m_DeferredValues.active.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Reads the values of an array created with setDeferredLoader(). Does nothing if they were read already.
+   * If the values cannot be allocated the array becomes unallocated. If the loader fails the array is filled with
+   * its initialization value. Either way hasDeferredReadFailed() reports the failure afterwards.
+   * @return false if the values could not be read
+   */
+  bool loadDeferredValues()
+  {
+    if(!m_DeferredValues.active.load(std::memory_order_acquire))
+    {
+      return !m_DeferredValues.failed.load(std::memory_order_acquire);
+    }
+    // Several threads may read the same array. Only one of them may load it.
+    std::lock_guard<std::mutex> lock(m_DeferredValues.mutex);
+    if(!m_DeferredValues.active.load(std::memory_order_relaxed))
+    {
+      return !m_DeferredValues.failed.load(std::memory_order_relaxed);
+    }
+    bool failed = false;
+    T* newArray = nullptr;
+    if(m_Size > 0)
+    {
+      newArray = static_cast<T*>(DataArrayAllocator::Allocate(m_Size * sizeof(T), m_StorageType));
+      if(nullptr == newArray)
+      {
+        qDebug() << "Unable to allocate " << m_Size << " elements of size " << sizeof(T) << " bytes. ";
+        m_IsAllocated = false;
+        failed = true;
+      }
+      else if(!m_DeferredValues.loader(newArray))
+      {
+        qDebug() << "Unable to read the values of " << getName() << ". The array is filled with its initialization value instead.";
+        std::fill(newArray, newArray + m_Size, m_InitValue);
+        failed = true;
+      }
+    }
+    m_Array = newArray;
+    m_OwnsData = true;
+    m_DeferredValues.loader = DeferredLoader();
+    m_DeferredValues.failed.store(failed, std::memory_order_release);
+    m_DeferredValues.active.store(false, std::memory_order_release);
+    return !failed;
+  }
+
+  /**
+   * @brief Returns true if the deferred values of this array could not be read
+   * @return
+   */
+  bool hasDeferredReadFailed() const override
+  {
+    return m_DeferredValues.failed.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns the number of bytes used by the compressed values or 0 if the array is not compressed
+   * @return
+   */
+  size_t getCompressedByteSize() const
+  {
+    std::shared_ptr<const PackedIntegerBlocks<T>> blocks = compressedBlocks();
+    return (nullptr != blocks) ? blocks->getByteSize() : 0;
+  }
+
+  /**
+   * @brief The ConstBlockIterator class walks the values of an array in blocks of PackedIntegerBlocks::k_BlockSize
+   * values without decompressing it. The blocks of a compressed array are decoded into a buffer owned by the
+   * iterator, the blocks of a plain array point straight into the array. An iterator keeps the compressed values
+   * alive even if the array is decompressed or modified meanwhile, so each thread should use its own iterator.
+   * @code
+   *   for(auto iter = featureIds->getBlockIterator(); iter.isValid(); ++iter)
+   *   {
+   *     const int32_t* values = iter.data();
+   *     for(size_t i = 0; i < iter.size(); i++) { ... values[i] is element iter.getOffset() + i ... }
+   *   }
+   * @endcode
+   */
+  class ConstBlockIterator
+  {
+  public:
+    ConstBlockIterator(const DataArray<T>* array, size_t block)
+    : m_Block(block)
+    {
+      // Deferred values are read first, a compressed array stays compressed
+      if(array->isLoadDeferred())
+      {
+        const_cast<DataArray<T>*>(array)->loadDeferredValues();
+      }
+      m_Blocks = array->compressedBlocks();
+      if(nullptr != m_Blocks)
+      {
+        m_NumValues = m_Blocks->getNumberOfValues();
+        m_Cache.reset(new T[PackedIntegerBlocks<T>::k_BlockSize]);
+      }
+      else if(nullptr != array->m_Array)
+      {
+        m_Values = array->m_Array;
+        m_NumValues = array->m_Size;
+      }
+      load();
+    }
+
+    /**
+     * @brief Returns false once the iterator has moved past the last block
+     * @return
+     */
+    bool isValid() const
+    {
+      return m_Block * PackedIntegerBlocks<T>::k_BlockSize < m_NumValues;
+    }
+
+    ConstBlockIterator& operator++()
+    {
+      m_Block++;
+      load();
+      return *this;
+    }
+
+    /**
+     * @brief Returns the index of the current block
+     * @return
+     */
+    size_t getBlockIndex() const
+    {
+      return m_Block;
+    }
+
+    /**
+     * @brief Returns the index of the first value of the current block within the array
+     * @return
+     */
+    size_t getOffset() const
+    {
+      return m_Block * PackedIntegerBlocks<T>::k_BlockSize;
+    }
+
+    /**
+     * @brief Returns the number of values in the current block
+     * @return
+     */
+    size_t size() const
+    {
+      return m_Length;
+    }
+
+    /**
+     * @brief Returns the values of the current block
+     * @return
+     */
+    const T* data() const
+    {
+      return m_Data;
+    }
+
+  private:
+    std::shared_ptr<const PackedIntegerBlocks<T>> m_Blocks;
+    std::unique_ptr<T[]> m_Cache;
+    const T* m_Values = nullptr;
+    const T* m_Data = nullptr;
+    size_t m_NumValues = 0;
+    size_t m_Block = 0;
+    size_t m_Length = 0;
+
+    void load()
+    {
+      m_Data = nullptr;
+      m_Length = 0;
+      if(!isValid())
+      {
+        return;
+      }
+      size_t offset = getOffset();
+      m_Length = std::min(m_NumValues - offset, static_cast<size_t>(PackedIntegerBlocks<T>::k_BlockSize));
+      if(nullptr != m_Blocks)
+      {
+        m_Blocks->decodeBlock(m_Block, m_Cache.get());
+        m_Data = m_Cache.get();
+      }
+      else
+      {
+        m_Data = m_Values + offset;
+      }
+    }
+  };
+
+  /**
+   * @brief Returns a ConstBlockIterator positioned at a block. Parallel algorithms can hand each thread its own
+   * range of blocks between 0 and getNumberOfValueBlocks().
+   * @param block
+   * @return
+   */
+  ConstBlockIterator getBlockIterator(size_t block = 0) const
+  {
+    return ConstBlockIterator(this, block);
+  }
+
+  /**
+   * @brief Returns the number of blocks visited by a ConstBlockIterator
+   * @return
+   */
+  size_t getNumberOfValueBlocks() const
+  {
+    return (m_Size + PackedIntegerBlocks<T>::k_BlockSize - 1) / PackedIntegerBlocks<T>::k_BlockSize;
+  }
+
   /**
    * @brief GetTypeName Returns a string representation of the type of data that is stored by this class. This
    * can be a primitive like char, float, int or the name of a class.
@@ -570,6 +985,7 @@ public:
    */
   bool copyFromArray(size_t destTupleOffset, IDataArray::Pointer sourceArray, size_t srcTupleOffset, size_t totalSrcTuples) override
   {
+    ensureResident();
     if(!m_IsAllocated)
     {
       return false;
@@ -587,7 +1003,8 @@ public:
       return false;
     }
     Self* source = dynamic_cast<Self*>(sourceArray.get());
-    if(nullptr == source->getPointer(0))
+    source->ensureResident();
+    if(nullptr == source->m_Array)
     {
       return false;
     }
@@ -607,9 +1024,13 @@ public:
       return false;
     }
 
+    if(!detach())
+    {
+      return false;
+    }
     size_t elementStart = destTupleOffset * getNumberOfComponents();
     size_t totalBytes = (totalSrcTuples * sourceArray->getNumberOfComponents()) * sizeof(T);
-    std::memcpy(m_Array + elementStart, source->getPointer(srcTupleOffset * sourceArray->getNumberOfComponents()), totalBytes);
+    std::memcpy(m_Array + elementStart, source->m_Array + srcTupleOffset * sourceArray->getNumberOfComponents(), totalBytes);
     return true;
   }
 
@@ -619,6 +1040,7 @@ public:
    */
   bool copyIntoArray(Pointer dest)
   {
+    ensureResident();
     if(m_IsAllocated && dest->isAllocated() && m_Array && dest->getPointer(0))
     {
       size_t totalBytes = m_Size * sizeof(T);
@@ -661,15 +1083,86 @@ public:
    */
   void releaseOwnership() override
   {
+    // Whoever takes over the raw pointer needs exclusive memory that it can free()
+    if(!detach())
+    {
+      // The memory is still shared, so it must not be handed over
+      return;
+    }
     m_OwnsData = false;
   }
 
+  /**
+   * @brief Returns the storage type that was requested for this array. If the array is allocated the
+   * actual backing store can be queried with getAllocatedStorageType().
+   * @return
+   */
+  StorageType getStorageType() const
+  {
+    return m_StorageType;
+  }
+
+  /**
+   * @brief Returns the storage type that is actually backing the current allocation.
+   * @return
+   */
+  StorageType getAllocatedStorageType() const
+  {
+    if(nullptr == m_Array)
+    {
+      return DataArrayAllocator::ResolveStorageType(m_StorageType, m_Size * sizeof(T));
+    }
+    return DataArrayAllocator::GetStorageType(m_Array);
+  }
+
+  /**
+   * @brief Sets where the memory for this array comes from. StorageType::Default defers the decision to
+   * the global DataArrayAllocator::MemoryPolicy. If the array is already allocated and owns its memory,
+   * the values are migrated into the new storage. Pointers previously returned from getPointer() are invalid
+   * after a migration.
+   * @param storageType
+   * @return 1 on success, -1 if the new storage could not be allocated
+   */
+  int32_t setStorageType(StorageType storageType)
+  {
+    m_StorageType = storageType;
+    // A compressed or deferred array picks up the new storage type when it is decompressed or read
+    if(isCompressed() || isLoadDeferred())
+    {
+      return 1;
+    }
+    if(nullptr == m_Array || !m_OwnsData || m_Size == 0)
+    {
+      return 1;
+    }
+    size_t numBytes = m_Size * sizeof(T);
+    if(DataArrayAllocator::ResolveStorageType(m_StorageType, numBytes) == DataArrayAllocator::GetStorageType(m_Array))
+    {
+      return 1;
+    }
+    T* newArray = static_cast<T*>(DataArrayAllocator::Allocate(numBytes, m_StorageType));
+    if(nullptr == newArray)
+    {
+      qDebug() << "Unable to allocate " << m_Size << " elements of size " << sizeof(T) << " bytes. ";
+      return -1;
+    }
+    std::memcpy(newArray, m_Array, numBytes);
+    deallocate();
+    m_Array = newArray;
+    m_IsAllocated = true;
+    return 1;
+  }
+
   /**
    * @brief Allocates the memory needed for this class
    * @return 1 on success, -1 on failure
    */
   virtual int32_t allocate()
   {
+    invalidateStatistics();
+    m_StatisticsCache.pointerHandedOut.store(false, std::memory_order_release);
+    clearCompressed();
+    clearDeferred();
     if((nullptr != m_Array) && (true == m_OwnsData))
     {
       deallocate();
@@ -684,11 +1177,7 @@ public:
     }
 
     size_t newSize = m_Size;
-#if defined(AIM_USE_SSE) && defined(__SSE2__)
-    m_Array = static_cast<T*>(_mm_malloc(newSize * sizeof(T), 16));
-#else
-    m_Array = (T*)malloc(newSize * sizeof(T));
-#endif
+    m_Array = static_cast<T*>(DataArrayAllocator::Allocate(newSize * sizeof(T), m_StorageType));
     if(!m_Array)
     {
       qDebug() << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
@@ -701,31 +1190,38 @@ public:
   }
 
   /**
-   * @brief Sets all the values to zero.
+   * @brief Sets all the values to zero. Large arrays are filled in parallel so that the pages of a freshly
+   * allocated block are first touched by the worker threads that will later process them.
    */
   void initializeWithZeros() override
   {
+    ensureResident();
     if(!m_IsAllocated || nullptr == m_Array)
     {
       return;
     }
-    size_t typeSize = sizeof(T);
-    ::memset(m_Array, 0, m_Size * typeSize);
+    if(!detach())
+    {
+      return;
+    }
+    fillValues(static_cast<T>(0), 0, true);
   }
 
   /**
-   * @brief Sets all the values to value.
+   * @brief Sets all the values starting at offset to value. Large arrays are filled in parallel.
    */
   virtual void initializeWithValue(T initValue, size_t offset = 0)
   {
+    ensureResident();
     if(!m_IsAllocated || nullptr == m_Array)
     {
       return;
     }
-    for(size_t i = offset; i < m_Size; i++)
+    if(!detach())
     {
-      m_Array[i] = initValue;
+      return;
     }
+    fillValues(initValue, offset, false);
   }
 
   /**
@@ -738,8 +1234,6 @@ public:
    */
   int eraseTuples(comp_dims_type& idxs) override
   {
-    int err = 0;
-
     // If nothing is to be erased just return
     if(idxs.empty())
     {
@@ -754,83 +1248,55 @@ public:
 
     // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
     // off the end of the array and return an error code.
-    for(size_t& idx : idxs)
+    TupleRuns runs;
+    int err = EraseListToTupleRuns(idxs, getNumberOfTuples(), runs);
+    if(err < 0)
     {
-      if(idx * m_NumComponents > m_MaxId)
-      {
-        return -100;
-      }
+      return err;
     }
+    return compactTuples(runs);
+  }
 
-    // Calculate the new size of the array to copy into
-    size_t newSize = (getNumberOfTuples() - idxs.size()) * m_NumComponents;
-
-    // Create a new m_Array to copy into
-    T* newArray = (T*)malloc(newSize * sizeof(T));
-    // Splat AB across the array so we know if we are copying the values or not
-    ::memset(newArray, 0xAB, newSize * sizeof(T));
-
-    // Keep the current Destination Pointer
-    T* currentDest = newArray;
-    size_t j = 0;
-    int k = 0;
-    // Find the first chunk to copy by walking the idxs array until we get an
-    // index that is NOT a continuous increment from the start
-    for(k = 0; k < idxs.size(); ++k)
+  /**
+   * @brief Keeps only the tuples covered by runs. The surviving tuples are copied into a new block in parallel
+   * and the old block is released.
+   * @param runs Kept runs in ascending order, for example from IDataArray::EraseListToTupleRuns()
+   * @return 0 on success, -100 if a run is out of range, -1 if the memory could not be allocated
+   */
+  int compactTuples(const TupleRuns& runs) override
+  {
+    ensureResident();
+    size_t numTuples = getNumberOfTuples();
+    size_t newNumTuples = runs.empty() ? 0 : runs.back().destTuple + runs.back().numTuples;
+    if(!runs.empty() && runs.back().srcTuple + runs.back().numTuples > numTuples)
     {
-      if(j == idxs[k])
-      {
-        ++j;
-      }
-      else
-      {
-        break;
-      }
+      return -100;
     }
-
-    if(k == idxs.size()) // Only front elements are being dropped
+    if(newNumTuples == numTuples)
     {
-      T* currentSrc = m_Array + (j * m_NumComponents);
-      std::memcpy(currentDest, currentSrc, (getNumberOfTuples() - idxs.size()) * m_NumComponents * sizeof(T));
-      deallocate(); // We are done copying - delete the current m_Array
-      m_Size = newSize;
-      m_Array = newArray;
-      m_OwnsData = true;
-      m_MaxId = newSize - 1;
-      m_IsAllocated = true;
       return 0;
     }
-
-    comp_dims_type srcIdx(idxs.size() + 1);
-    comp_dims_type destIdx(idxs.size() + 1);
-    comp_dims_type copyElements(idxs.size() + 1);
-    srcIdx[0] = 0;
-    destIdx[0] = 0;
-    copyElements[0] = (idxs[0] - 0) * m_NumComponents;
-
-    for(int i = 1; i < srcIdx.size(); ++i)
+    if(newNumTuples == 0)
     {
-      srcIdx[i] = (idxs[i - 1] + 1) * m_NumComponents;
+      resizeTuples(0);
+      return 0;
+    }
 
-      if(i < srcIdx.size() - 1)
-      {
-        copyElements[i] = (idxs[i] - idxs[i - 1] - 1) * m_NumComponents;
-      }
-      else
-      {
-        copyElements[i] = (getNumberOfTuples() - idxs[i - 1] - 1) * m_NumComponents;
-      }
-      destIdx[i] = copyElements[i - 1] + destIdx[i - 1];
+    size_t newSize = newNumTuples * m_NumComponents;
+    T* newArray = static_cast<T*>(DataArrayAllocator::Allocate(newSize * sizeof(T), m_StorageType));
+    if(nullptr == newArray)
+    {
+      qDebug() << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
+      return -1;
     }
 
-    // Copy the data
-    for(int i = 0; i < srcIdx.size(); ++i)
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, newNumTuples);
+    if(newSize * sizeof(T) < k_ParallelThreshold)
     {
-      currentDest = newArray + destIdx[i];
-      T* currentSrc = m_Array + srcIdx[i];
-      size_t bytes = copyElements[i] * sizeof(T);
-      std::memcpy(currentDest, currentSrc, bytes);
+      dataAlg.setParallelizationEnabled(false);
     }
+    dataAlg.execute(CopyTupleRunsImpl(m_Array, newArray, runs, m_NumComponents));
 
     // We are done copying - delete the current m_Array
     deallocate();
@@ -838,12 +1304,81 @@ public:
     // Allocation was successful.  Save it.
     m_Size = newSize;
     m_Array = newArray;
+    m_NumTuples = newNumTuples;
     // This object has now allocated its memory and owns it.
     m_OwnsData = true;
     m_IsAllocated = true;
     m_MaxId = newSize - 1;
 
-    return err;
+    return 0;
+  }
+
+  /**
+   * @brief Returns the statistics of every component. Large arrays are scanned in parallel. The result is cached
+   * until a bulk write or prepareForWrite(), so repeated queries on an unchanged array do not touch the values
+   * again. The element accessors do not drop the cache.
+   * Once a raw pointer has been handed out (getPointer(), getVoidPointer(), getTuplePointer(), data() or a
+   * mutable iterator) the values can change without the array noticing, so the result is not cached until the
+   * array is allocated again.
+   * @return
+   */
+  std::vector<ComponentStatistics> getComponentStatistics() override
+  {
+    std::lock_guard<std::mutex> lock(m_StatisticsCache.mutex);
+    if(m_StatisticsCache.state.load(std::memory_order_acquire) == StatisticsCache::Valid)
+    {
+      return m_StatisticsCache.values;
+    }
+    // A write that lands while the values are scanned resets the state, so the stale result is not kept
+    m_StatisticsCache.state.store(StatisticsCache::Computing, std::memory_order_release);
+    std::vector<ComponentStatistics> stats = computeComponentStatistics();
+    int computing = StatisticsCache::Computing;
+    if(!m_StatisticsCache.pointerHandedOut.load(std::memory_order_acquire) &&
+       m_StatisticsCache.state.compare_exchange_strong(computing, StatisticsCache::Valid, std::memory_order_acq_rel))
+    {
+      m_StatisticsCache.values = stats;
+    }
+    else
+    {
+      m_StatisticsCache.state.store(StatisticsCache::Invalid, std::memory_order_release);
+    }
+    return stats;
+  }
+
+  /**
+   * @brief Counts the values of one component in numBins bins of equal width between rangeMin and rangeMax
+   * @param component
+   * @param numBins
+   * @param rangeMin
+   * @param rangeMax
+   * @return The bin counts or an empty vector if the array is not allocated or the component is out of range
+   */
+  std::vector<size_t> computeHistogram(int component, size_t numBins, double rangeMin, double rangeMax) override
+  {
+    ensureResident();
+    if(!m_IsAllocated || nullptr == m_Array || component < 0 || static_cast<size_t>(component) >= m_NumComponents || numBins == 0)
+    {
+      return std::vector<size_t>();
+    }
+    size_t numBlocks = 0;
+    size_t tuplesPerBlock = 0;
+    getScanBlocks(numBlocks, tuplesPerBlock);
+    std::vector<size_t> partials(numBlocks * numBins, 0);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.setParallelizationEnabled(numBlocks > 1);
+    dataAlg.execute(ComputeHistogramImpl(m_Array, m_NumTuples, m_NumComponents, static_cast<size_t>(component), tuplesPerBlock, numBins, rangeMin, rangeMax, partials));
+
+    std::vector<size_t> histogram(numBins, 0);
+    for(size_t block = 0; block < numBlocks; block++)
+    {
+      for(size_t bin = 0; bin < numBins; bin++)
+      {
+        histogram[bin] += partials[block * numBins + bin];
+      }
+    }
+    return histogram;
   }
 
   /**
@@ -859,6 +1394,10 @@ public:
     {
       return -1;
     }
+    if(!detach())
+    {
+      return -1;
+    }
     T* src = m_Array + (currentPos * m_NumComponents);
     T* dest = m_Array + (newPos * m_NumComponents);
     size_t bytes = sizeof(T) * m_NumComponents;
@@ -927,7 +1466,10 @@ public:
     {
       return nullptr;
     }
-
+    if(!detachForPointer() || nullptr == m_Array)
+    {
+      return nullptr;
+    }
     return (void*)(&(m_Array[i]));
   }
 
@@ -937,6 +1479,7 @@ public:
    */
   std::list<T> getArray()
   {
+    ensureResident();
     return std::list<T>(m_Array, m_Array + (m_Size * sizeof(T)) / sizeof(T));
   }
 
@@ -950,6 +1493,10 @@ public:
     {
       return;
     }
+    if(!detach())
+    {
+      return;
+    }
     int i = 0;
     for(auto elem : newArray)
     {
@@ -972,9 +1519,35 @@ public:
       Q_ASSERT(i < m_Size);
     }
 #endif
+    if(!detachForPointer() || nullptr == m_Array)
+    {
+      return nullptr;
+    }
     return (T*)(&(m_Array[i]));
   }
 
+  /**
+   * @brief Returns a read-only pointer to a specific index into the array. Unlike getPointer() this never
+   * duplicates memory that is shared with a copy-on-write copy, so it should be preferred when the values
+   * are only read.
+   * @param i The index to return the pointer to.
+   * @return The pointer to the index
+   */
+  const T* getConstPointer(size_t i) const
+  {
+#ifndef NDEBUG
+    if(m_Size > 0)
+    {
+      Q_ASSERT(i < m_Size);
+    }
+#endif
+    if(!ensureResident())
+    {
+      return nullptr;
+    }
+    return m_Array + i;
+  }
+
   /**
    * @brief Returns the value for a given index
    * @param i The index to return the value at
@@ -988,11 +1561,16 @@ public:
       Q_ASSERT(i < m_Size);
     }
 #endif
+    if(nullptr == m_Array)
+    {
+      return getNonResidentValue(i);
+    }
     return m_Array[i];
   }
 
   /**
-   * @brief Sets a specific value in the array
+   * @brief Sets a specific value in the array. Memory shared with a copy-on-write copy is not duplicated
+   * here, see prepareForWrite().
    * @param i The index of the value to set
    * @param value The new value to be set at the specified index
    */
@@ -1004,6 +1582,10 @@ public:
       Q_ASSERT(i < m_Size);
     }
 #endif
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     m_Array[i] = value;
   }
 
@@ -1017,6 +1599,10 @@ public:
       Q_ASSERT(i * m_NumComponents + j < m_Size);
     }
 #endif
+    if(nullptr == m_Array)
+    {
+      return getNonResidentValue(i * m_NumComponents + j);
+    }
     return m_Array[i * m_NumComponents + j];
   }
 
@@ -1034,6 +1620,10 @@ public:
       Q_ASSERT(i * m_NumComponents + j < m_Size);
     }
 #endif
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     m_Array[i * m_NumComponents + j] = c;
   }
 
@@ -1090,6 +1680,10 @@ public:
     {
       return;
     }
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     T* c = reinterpret_cast<T*>(p);
     for(size_t j = 0; j < m_NumComponents; ++j)
     {
@@ -1109,6 +1703,10 @@ public:
       Q_ASSERT(tupleIndex * m_NumComponents < m_Size);
     }
 #endif
+    if(!detachForPointer() || nullptr == m_Array)
+    {
+      return nullptr;
+    }
     return m_Array + (tupleIndex * m_NumComponents);
   }
 
@@ -1134,6 +1732,7 @@ public:
    */
   void printTuple(QTextStream& out, size_t i, char delimiter = ',') override
   {
+    ensureResident();
     int precision = out.realNumberPrecision();
     T value = static_cast<T>(0x00);
     if(typeid(value) == typeid(float))
@@ -1164,6 +1763,7 @@ public:
    */
   void printComponent(QTextStream& out, size_t i, int j) override
   {
+    ensureResident();
     out << m_Array[i * m_NumComponents + j];
   }
 
@@ -1341,6 +1941,7 @@ public:
    */
   int writeH5Data(hid_t parentId, comp_dims_type tDims) override
   {
+    ensureResident();
     if(m_Array == nullptr)
     {
       return -85648;
@@ -1356,6 +1957,7 @@ public:
    */
   int writeXdmfAttribute(QTextStream& out, int64_t* volDims, const QString& hdfFileName, const QString& groupPath, const QString& label) override
   {
+    ensureResident();
     if(m_Array == nullptr)
     {
       return -85648;
@@ -1449,6 +2051,30 @@ public:
       ss << R"(<tr bgcolor="#FFFCEA"><th align="right">Total Elements:</th><td>)" << numStr << "</td></tr>";
       numStr = usa.toString(static_cast<qlonglong>(m_Size * sizeof(T)));
       ss << R"(<tr bgcolor="#FFFCEA"><th align="right">Total Memory Required:</th><td>)" << numStr << "</td></tr>";
+      ss << R"(<tr bgcolor="#FFFCEA"><th align="right">Storage:</th><td>)" << DataArrayAllocator::StorageTypeToString(getAllocatedStorageType()) << "</td></tr>";
+      if(isCompressed())
+      {
+        numStr = usa.toString(static_cast<qlonglong>(getCompressedByteSize()));
+        ss << R"(<tr bgcolor="#FFFCEA"><th align="right">Compressed Memory:</th><td>)" << numStr << "</td></tr>";
+      }
+      // Only report a range that is already known; building the info string must not scan the whole array
+      std::vector<ComponentStatistics> stats = getCachedComponentStatistics();
+      if(!stats.empty())
+      {
+        QStringList ranges;
+        size_t nanCount = 0;
+        for(const auto& compStats : stats)
+        {
+          ranges << QString("[%1, %2]").arg(compStats.min).arg(compStats.max);
+          nanCount += compStats.nanCount;
+        }
+        ss << R"(<tr bgcolor="#FFFCEA"><th align="right">Value Range:</th><td>)" << ranges.join(", ") << "</td></tr>";
+        if(nanCount > 0)
+        {
+          numStr = usa.toString(static_cast<qlonglong>(nanCount));
+          ss << R"(<tr bgcolor="#FFFCEA"><th align="right">NaN Values:</th><td>)" << numStr << "</td></tr>";
+        }
+      }
       ss << "</tbody></table>\n";
       ss << "</body></html>";
     }
@@ -1494,6 +2120,10 @@ public:
    */
   virtual void byteSwapElements()
   {
+    if(!detach())
+    {
+      return;
+    }
     char* ptr = (char*)(m_Array);
     char t[8];
     size_t size = getTypeSize();
@@ -1740,29 +2370,47 @@ public:
 
   template <typename IteratorType> IteratorType begin()
   {
+    if(!detachForPointer())
+    {
+      return IteratorType(nullptr, m_NumComponents);
+    }
     return IteratorType(m_Array, m_NumComponents);
   }
   iterator begin()
   {
+    if(!detachForPointer())
+    {
+      return iterator(nullptr);
+    }
     return iterator(m_Array);
   }
 
   template <typename IteratorType> IteratorType end()
   {
+    if(!detachForPointer())
+    {
+      return IteratorType(nullptr, m_NumComponents);
+    }
     return IteratorType(m_Array + m_Size, m_NumComponents);
   }
   iterator end()
   {
+    if(!detachForPointer())
+    {
+      return iterator(nullptr);
+    }
     return iterator(m_Array + m_Size);
   }
 
   const_iterator begin() const
   {
+    ensureResident();
     return const_iterator(m_Array);
   }
 
   const_iterator end() const
   {
+    ensureResident();
     return const_iterator(m_Array + m_Size);
   }
 
@@ -1805,51 +2453,88 @@ public:
   inline reference operator[](size_type index)
   {
     // assert(index < m_Size);
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     return m_Array[index];
   }
 
   inline const T& operator[](size_type index) const
   {
     // assert(index < m_Size);
+    if(nullptr == m_Array)
+    {
+      ensureResident();
+    }
     return m_Array[index];
   }
 
   inline reference at(size_type index)
   {
     assert(index < m_Size);
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     return m_Array[index];
   }
 
   inline const T& at(size_type index) const
   {
     assert(index < m_Size);
+    if(nullptr == m_Array)
+    {
+      ensureResident();
+    }
     return m_Array[index];
   }
 
   inline reference front()
   {
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     return m_Array[0];
   }
   inline const T& front() const
   {
+    if(nullptr == m_Array)
+    {
+      ensureResident();
+    }
     return m_Array[0];
   }
 
   inline reference back()
   {
+    if(nullptr == m_Array)
+    {
+      detach();
+    }
     return m_Array[m_MaxId];
   }
   inline const T& back() const
   {
+    if(nullptr == m_Array)
+    {
+      ensureResident();
+    }
     return m_Array[m_MaxId];
   }
 
   inline T* data() noexcept
   {
+    if(!detachForPointer())
+    {
+      return nullptr;
+    }
     return m_Array;
   }
   inline const T* data() const noexcept
   {
+    ensureResident();
     return m_Array;
   }
 
@@ -1930,6 +2615,8 @@ public:
    */
   void clear()
   {
+    clearCompressed();
+    clearDeferred();
     if(nullptr != m_Array && m_OwnsData)
     {
       deallocate();
@@ -1969,6 +2656,17 @@ protected:
    */
   void deallocate()
   {
+    invalidateStatistics();
+    m_StatisticsCache.pointerHandedOut.store(false, std::memory_order_release);
+    clearCompressed();
+    clearDeferred();
+    if(releaseSharedBuffer())
+    {
+      // The memory belonged to the shared buffer and is released along with its last reference
+      m_Array = nullptr;
+      m_IsAllocated = false;
+      return;
+    }
     // We are going to splat 0xABABAB across the first value of the array as a debugging aid
     auto cptr = reinterpret_cast<unsigned char*>(m_Array);
     if(nullptr != cptr)
@@ -2009,11 +2707,7 @@ protected:
       }
 #endif
 
-#if defined(AIM_USE_SSE) && defined(__SSE2__)
-    _mm_free(m_buffer);
-#else
-    free(m_Array);
-#endif
+    DataArrayAllocator::Free(m_Array);
     m_Array = nullptr;
     m_IsAllocated = false;
   }
@@ -2050,8 +2744,13 @@ protected:
     size_t newSize;
     size_t oldSize;
 
+    invalidateStatistics();
     if(size == m_Size) // Requested size is equal to current size.  Do nothing.
     {
+      if(!detach())
+      {
+        return nullptr;
+      }
       return m_Array;
     }
     newSize = size;
@@ -2063,20 +2762,21 @@ protected:
       clear();
       return m_Array;
     }
-    // OS X's realloc does not free memory if the new block is smaller.  This
-    // is a very serious problem and causes huge amount of memory to be
-    // wasted. Do not use realloc on the Mac.
-    bool dontUseRealloc = false;
-#if defined __APPLE__
-    dontUseRealloc = true;
-#endif
+    ensureResident();
+    // Memory that is shared with a copy-on-write copy has to be copied rather than resized in place
+    bool isShared = false;
+    if(m_IsShared.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(SharedBufferMutex());
+      isShared = (nullptr != m_SharedBuffer) && !reclaimSharedBuffer();
+    }
 
     // Allocate a new array if we DO NOT own the current array
-    if((nullptr != m_Array) && (false == m_OwnsData))
+    if((nullptr != m_Array) && (false == m_OwnsData || isShared))
     {
       // The old array is owned by the user so we cannot try to
       // reallocate it.  Just allocate new memory that we will own.
-      newArray = (T*)malloc(newSize * sizeof(T));
+      newArray = static_cast<T*>(DataArrayAllocator::Allocate(newSize * sizeof(T), m_StorageType));
       if(!newArray)
       {
         qDebug() << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
@@ -2085,33 +2785,18 @@ protected:
 
       // Copy the data from the old array.
       std::memcpy(newArray, m_Array, (newSize < m_Size ? newSize : m_Size) * sizeof(T));
-    }
-    else if(!dontUseRealloc)
-    {
-      // Try to reallocate with minimal memory usage and possibly avoid copying.
-      newArray = (T*)realloc(m_Array, newSize * sizeof(T));
-      if(!newArray)
-      {
-        qDebug() << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
-        return nullptr;
-      }
+      releaseSharedBuffer();
     }
     else
     {
-      newArray = (T*)malloc(newSize * sizeof(T));
+      // The allocator picks the cheapest way to resize for the backing store (realloc, mremap or
+      // allocate + copy). It never uses realloc on OS X, which does not free memory when shrinking.
+      newArray = static_cast<T*>(DataArrayAllocator::Reallocate(m_Array, oldSize * sizeof(T), newSize * sizeof(T), m_StorageType));
       if(!newArray)
       {
         qDebug() << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
         return nullptr;
       }
-
-      // Copy the data from the old array.
-      if(m_Array != nullptr)
-      {
-        std::memcpy(newArray, m_Array, (newSize < m_Size ? newSize : m_Size) * sizeof(T));
-      }
-      // Free the old array
-      deallocate();
     }
 
     // Allocation was successful.  Save it.
@@ -2133,7 +2818,627 @@ protected:
     return m_Array;
   }
 
+  /**
+   * @brief Makes sure the memory of this array is not shared with any copy-on-write copy. If it is, the
+   * values are duplicated into memory owned by this array alone. A compressed array is decompressed first.
+   * The bulk writes call this first.
+   * @return false if the values could not be duplicated. The array keeps referencing the shared memory.
+   */
+  bool detach()
+  {
+    invalidateStatistics();
+    ensureResident();
+    return unshareBuffer();
+  }
+
 private:
+  /**
+   * @brief Arrays smaller than this many bytes are filled or compacted on the calling thread
+   */
+  static const size_t k_ParallelThreshold = 1024 * 1024;
+
+  /**
+   * @brief The FillValuesImpl class fills a range of the array with a value
+   */
+  class FillValuesImpl
+  {
+  public:
+    FillValuesImpl(T* data, T value, bool zero)
+    : m_Data(data)
+    , m_Value(value)
+    , m_Zero(zero)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      if(m_Zero)
+      {
+        ::memset(m_Data + range.min(), 0, (range.max() - range.min()) * sizeof(T));
+        return;
+      }
+      std::fill(m_Data + range.min(), m_Data + range.max(), m_Value);
+    }
+
+  private:
+    T* m_Data;
+    T m_Value;
+    bool m_Zero;
+  };
+
+  /**
+   * @brief The CopyTupleRunsImpl class copies the destination tuples of a range out of the runs of a compaction.
+   * The range is over destination tuples so that the work is balanced no matter how the runs are distributed.
+   */
+  class CopyTupleRunsImpl
+  {
+  public:
+    CopyTupleRunsImpl(const T* src, T* dest, const TupleRuns& runs, size_t numComps)
+    : m_Src(src)
+    , m_Dest(dest)
+    , m_Runs(runs)
+    , m_NumComps(numComps)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      // Find the run that holds the first destination tuple of the range
+      auto run = std::upper_bound(m_Runs.begin(), m_Runs.end(), range.min(), [](size_t tuple, const TupleRun& r) { return tuple < r.destTuple; });
+      --run;
+      size_t destTuple = range.min();
+      while(destTuple < range.max())
+      {
+        size_t offset = destTuple - run->destTuple;
+        size_t count = std::min(run->numTuples - offset, range.max() - destTuple);
+        std::memcpy(m_Dest + destTuple * m_NumComps, m_Src + (run->srcTuple + offset) * m_NumComps, count * m_NumComps * sizeof(T));
+        destTuple += count;
+        ++run;
+      }
+    }
+
+  private:
+    const T* m_Src;
+    T* m_Dest;
+    const TupleRuns& m_Runs;
+    size_t m_NumComps;
+  };
+
+  /**
+   * @brief Number of values scanned by one task when computing statistics or histograms
+   */
+  static const size_t k_ScanBlockSize = 64 * 1024;
+
+  /**
+   * @brief Returns true if value is NaN. Always false for integer types, which lets the compiler drop the test.
+   */
+  template <typename U = T> static typename std::enable_if<std::is_floating_point<U>::value, bool>::type IsNaN(U value)
+  {
+    return std::isnan(value);
+  }
+  template <typename U = T> static typename std::enable_if<!std::is_floating_point<U>::value, bool>::type IsNaN(U value)
+  {
+    Q_UNUSED(value)
+    return false;
+  }
+
+  /**
+   * @brief Splits the tuples into the blocks scanned by the statistics and histogram kernels
+   * @param numBlocks
+   * @param tuplesPerBlock
+   */
+  void getScanBlocks(size_t& numBlocks, size_t& tuplesPerBlock) const
+  {
+    tuplesPerBlock = std::max<size_t>(k_ScanBlockSize / m_NumComponents, 1);
+    numBlocks = (m_NumTuples + tuplesPerBlock - 1) / tuplesPerBlock;
+    if(m_Size * sizeof(T) < k_ParallelThreshold || numBlocks == 0)
+    {
+      tuplesPerBlock = std::max<size_t>(m_NumTuples, 1);
+      numBlocks = 1;
+    }
+  }
+
+  /**
+   * @brief The ComputeStatisticsImpl class computes the statistics of every component for a range of blocks. Each
+   * block writes its own partial result so that the final sums do not depend on how the blocks were scheduled.
+   */
+  class ComputeStatisticsImpl
+  {
+  public:
+    ComputeStatisticsImpl(const T* data, size_t numTuples, size_t numComps, size_t tuplesPerBlock, std::vector<ComponentStatistics>& partials)
+    : m_Data(data)
+    , m_NumTuples(numTuples)
+    , m_NumComps(numComps)
+    , m_TuplesPerBlock(tuplesPerBlock)
+    , m_Partials(partials)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t block = range.min(); block < range.max(); block++)
+      {
+        size_t start = block * m_TuplesPerBlock;
+        size_t end = std::min(start + m_TuplesPerBlock, m_NumTuples);
+        for(size_t comp = 0; comp < m_NumComps; comp++)
+        {
+          scan(start, end, comp, m_Partials[block * m_NumComps + comp]);
+        }
+      }
+    }
+
+  private:
+    const T* m_Data;
+    size_t m_NumTuples;
+    size_t m_NumComps;
+    size_t m_TuplesPerBlock;
+    std::vector<ComponentStatistics>& m_Partials;
+
+    void scan(size_t start, size_t end, size_t comp, ComponentStatistics& stats) const
+    {
+      // Plain min/max selects over a constant stride with no calls in the loop. For integer types the NaN test
+      // compiles away and the loop vectorizes.
+      T lo = std::numeric_limits<T>::max();
+      T hi = std::numeric_limits<T>::lowest();
+      double sum = 0.0;
+      size_t nanCount = 0;
+      const T* ptr = m_Data + start * m_NumComps + comp;
+      const size_t count = end - start;
+      for(size_t i = 0; i < count; i++)
+      {
+        T value = ptr[i * m_NumComps];
+        if(IsNaN(value))
+        {
+          nanCount++;
+          continue;
+        }
+        lo = (value < lo) ? value : lo;
+        hi = (value > hi) ? value : hi;
+        sum += static_cast<double>(value);
+      }
+      stats.min = static_cast<double>(lo);
+      stats.max = static_cast<double>(hi);
+      stats.sum = sum;
+      stats.count = count - nanCount;
+      stats.nanCount = nanCount;
+    }
+  };
+
+  /**
+   * @brief The ComputeHistogramImpl class bins one component for a range of blocks into per block counts
+   */
+  class ComputeHistogramImpl
+  {
+  public:
+    ComputeHistogramImpl(const T* data, size_t numTuples, size_t numComps, size_t comp, size_t tuplesPerBlock, size_t numBins, double rangeMin, double rangeMax, std::vector<size_t>& partials)
+    : m_Data(data)
+    , m_NumTuples(numTuples)
+    , m_NumComps(numComps)
+    , m_Comp(comp)
+    , m_TuplesPerBlock(tuplesPerBlock)
+    , m_NumBins(numBins)
+    , m_RangeMin(rangeMin)
+    , m_RangeMax(rangeMax)
+    , m_Partials(partials)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      const double width = m_RangeMax - m_RangeMin;
+      const double scale = (width > 0.0) ? static_cast<double>(m_NumBins) / width : 0.0;
+      for(size_t block = range.min(); block < range.max(); block++)
+      {
+        size_t* bins = m_Partials.data() + block * m_NumBins;
+        size_t start = block * m_TuplesPerBlock;
+        size_t end = std::min(start + m_TuplesPerBlock, m_NumTuples);
+        for(size_t i = start; i < end; i++)
+        {
+          auto value = static_cast<double>(m_Data[i * m_NumComps + m_Comp]);
+          // Also rejects NaN
+          if(!(value >= m_RangeMin && value <= m_RangeMax))
+          {
+            continue;
+          }
+          auto bin = static_cast<size_t>((value - m_RangeMin) * scale);
+          bins[std::min(bin, m_NumBins - 1)]++;
+        }
+      }
+    }
+
+  private:
+    const T* m_Data;
+    size_t m_NumTuples;
+    size_t m_NumComps;
+    size_t m_Comp;
+    size_t m_TuplesPerBlock;
+    size_t m_NumBins;
+    double m_RangeMin;
+    double m_RangeMax;
+    std::vector<size_t>& m_Partials;
+  };
+
+  /**
+   * @brief Scans the values and merges the per block results in block order
+   * @return
+   */
+  std::vector<ComponentStatistics> computeComponentStatistics() const
+  {
+    if(isLoadDeferred())
+    {
+      const_cast<DataArray<T>*>(this)->loadDeferredValues();
+    }
+    if(isCompressed())
+    {
+      return computeCompressedStatistics();
+    }
+    if(!m_IsAllocated || nullptr == m_Array)
+    {
+      return std::vector<ComponentStatistics>();
+    }
+    size_t numBlocks = 0;
+    size_t tuplesPerBlock = 0;
+    getScanBlocks(numBlocks, tuplesPerBlock);
+    std::vector<ComponentStatistics> partials(numBlocks * m_NumComponents);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.setParallelizationEnabled(numBlocks > 1);
+    dataAlg.execute(ComputeStatisticsImpl(m_Array, m_NumTuples, m_NumComponents, tuplesPerBlock, partials));
+
+    std::vector<ComponentStatistics> stats(m_NumComponents);
+    for(size_t block = 0; block < numBlocks; block++)
+    {
+      for(size_t comp = 0; comp < m_NumComponents; comp++)
+      {
+        const ComponentStatistics& partial = partials[block * m_NumComponents + comp];
+        ComponentStatistics& total = stats[comp];
+        if(partial.count > 0)
+        {
+          total.min = (total.count == 0 || partial.min < total.min) ? partial.min : total.min;
+          total.max = (total.count == 0 || partial.max > total.max) ? partial.max : total.max;
+        }
+        total.sum += partial.sum;
+        total.count += partial.count;
+        total.nanCount += partial.nanCount;
+      }
+    }
+    return stats;
+  }
+
+  /**
+   * @brief Scans a compressed array block by block so that querying its statistics does not decompress it.
+   * Compressed arrays hold integers only, so there are no NaN values to count.
+   * @return
+   */
+  std::vector<ComponentStatistics> computeCompressedStatistics() const
+  {
+    std::vector<ComponentStatistics> stats(m_NumComponents);
+    for(ConstBlockIterator iter = getBlockIterator(); iter.isValid(); ++iter)
+    {
+      const T* values = iter.data();
+      size_t comp = iter.getOffset() % m_NumComponents;
+      for(size_t i = 0; i < iter.size(); i++)
+      {
+        auto value = static_cast<double>(values[i]);
+        ComponentStatistics& total = stats[comp];
+        total.min = (total.count == 0 || value < total.min) ? value : total.min;
+        total.max = (total.count == 0 || value > total.max) ? value : total.max;
+        total.sum += value;
+        total.count++;
+        comp = (comp + 1 == m_NumComponents) ? 0 : comp + 1;
+      }
+    }
+    return stats;
+  }
+
+  /**
+   * @brief Drops the cached statistics. This is called by every bulk write, so it only writes the state if needed.
+   */
+  void invalidateStatistics()
+  {
+    if(m_StatisticsCache.state.load(std::memory_order_relaxed) != StatisticsCache::Invalid)
+    {
+      m_StatisticsCache.state.store(StatisticsCache::Invalid, std::memory_order_release);
+    }
+  }
+
+  /**
+   * @brief Returns the cached statistics without scanning the values
+   * @return An empty vector if nothing is cached
+   */
+  std::vector<ComponentStatistics> getCachedComponentStatistics()
+  {
+    std::lock_guard<std::mutex> lock(m_StatisticsCache.mutex);
+    if(m_StatisticsCache.state.load(std::memory_order_acquire) == StatisticsCache::Valid)
+    {
+      return m_StatisticsCache.values;
+    }
+    return std::vector<ComponentStatistics>();
+  }
+
+  /**
+   * @brief detach() for the accessors that hand out a raw pointer. Writes through the pointer are not seen by the
+   * array, so the statistics are no longer cached after this.
+   * @return false if no pointer may be handed out because the memory is still shared
+   */
+  bool detachForPointer()
+  {
+    if(!detach())
+    {
+      return false;
+    }
+    if(!m_StatisticsCache.pointerHandedOut.load(std::memory_order_relaxed))
+    {
+      m_StatisticsCache.pointerHandedOut.store(true, std::memory_order_release);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Holds the cached statistics. Copies of an array start without a cache.
+   */
+  struct StatisticsCache
+  {
+    StatisticsCache() = default;
+    StatisticsCache(const StatisticsCache&)
+    {
+    }
+    StatisticsCache& operator=(const StatisticsCache&) = delete;
+
+    enum State
+    {
+      Invalid = 0,
+      Computing = 1,
+      Valid = 2
+    };
+
+    std::mutex mutex;
+    std::atomic<int> state{Invalid};
+    std::atomic<bool> pointerHandedOut{false};
+    std::vector<ComponentStatistics> values;
+  };
+
+  /**
+   * @brief Fills the values from offset to the end of the array
+   * @param value
+   * @param offset
+   * @param zero Clear the bytes instead of copying value
+   */
+  void fillValues(T value, size_t offset, bool zero)
+  {
+    if(offset >= m_Size)
+    {
+      return;
+    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(offset, m_Size);
+    if((m_Size - offset) * sizeof(T) < k_ParallelThreshold)
+    {
+      dataAlg.setParallelizationEnabled(false);
+    }
+    dataAlg.execute(FillValuesImpl(m_Array, value, zero));
+  }
+
+  /**
+   * @brief Holds the compressed values. The blocks are immutable once created, so copies of the array and
+   * ConstBlockIterators share them.
+   */
+  struct CompressedValues
+  {
+    CompressedValues() = default;
+    CompressedValues(const CompressedValues& other)
+    : active(other.active.load())
+    , blocks(other.blocks)
+    {
+    }
+    CompressedValues& operator=(const CompressedValues&) = delete;
+
+    std::mutex mutex;
+    std::atomic<bool> active{false};
+    std::shared_ptr<const PackedIntegerBlocks<T>> blocks;
+  };
+
+  /**
+   * @brief Returns the compressed values or nullptr if the array is not compressed
+   * @return
+   */
+  std::shared_ptr<const PackedIntegerBlocks<T>> compressedBlocks() const
+  {
+    if(!m_CompressedValues.active.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_CompressedValues.mutex);
+    return m_CompressedValues.blocks;
+  }
+
+  /**
+   * @brief Reads deferred values or decompresses the values before they are accessed. Neither changes any
+   * value, so this is also done from const accessors. The accessors that hand out pointers call this; the
+   * element accessors only fall back to it when there is no plain layout.
+   * @return false if the plain layout could not be restored
+   */
+  bool ensureResident() const
+  {
+    if(m_DeferredValues.active.load(std::memory_order_acquire))
+    {
+      const_cast<DataArray<T>*>(this)->loadDeferredValues();
+    }
+    if(m_CompressedValues.active.load(std::memory_order_acquire))
+    {
+      return const_cast<DataArray<T>*>(this)->decompress();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads element i of an array that has no plain layout. A compressed value is decoded without
+   * decompressing the whole array, deferred values are read first.
+   * @param i
+   * @return
+   */
+  T getNonResidentValue(size_t i) const
+  {
+    std::shared_ptr<const PackedIntegerBlocks<T>> blocks = compressedBlocks();
+    if(nullptr != blocks)
+    {
+      return blocks->getValue(i);
+    }
+    ensureResident();
+    Q_ASSERT(nullptr != m_Array);
+    return m_Array[i];
+  }
+
+  /**
+   * @brief Drops the compressed values when the array is cleared or reallocated
+   */
+  void clearCompressed()
+  {
+    m_CompressedValues.blocks.reset();
+    m_CompressedValues.active.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief Holds the loader of an array whose values have not been read yet
+   */
+  struct DeferredValues
+  {
+    DeferredValues() = default;
+    DeferredValues(const DeferredValues& other)
+    : active(other.active.load())
+    , failed(other.failed.load())
+    , loader(other.loader)
+    {
+    }
+    DeferredValues& operator=(const DeferredValues&) = delete;
+
+    std::mutex mutex;
+    std::atomic<bool> active{false};
+    std::atomic<bool> failed{false};
+    DeferredLoader loader;
+  };
+
+  /**
+   * @brief Drops the loader when the array is cleared or reallocated
+   */
+  void clearDeferred()
+  {
+    m_DeferredValues.loader = DeferredLoader();
+    m_DeferredValues.failed.store(false, std::memory_order_release);
+    m_DeferredValues.active.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief Owns memory that is shared between an array and its copy-on-write copies.
+   */
+  struct SharedBuffer
+  {
+    explicit SharedBuffer(T* data)
+    : m_Data(data)
+    {
+    }
+    ~SharedBuffer()
+    {
+      DataArrayAllocator::Free(m_Data);
+    }
+    SharedBuffer(const SharedBuffer&) = delete;
+    SharedBuffer& operator=(const SharedBuffer&) = delete;
+
+    T* m_Data = nullptr;
+  };
+
+  /**
+   * @brief Hands the memory of this array to a SharedBuffer and lets the copy reference it.
+   * @param copy
+   */
+  void shareBuffer(DataArray<T>& copy)
+  {
+    std::lock_guard<std::mutex> lock(SharedBufferMutex());
+    if(nullptr == m_SharedBuffer)
+    {
+      m_SharedBuffer = std::make_shared<SharedBuffer>(m_Array);
+      m_IsShared.store(true, std::memory_order_release);
+    }
+    copy.m_SharedBuffer = m_SharedBuffer;
+    copy.m_IsShared.store(true, std::memory_order_release);
+    copy.m_Array = m_Array;
+    copy.m_Size = m_Size;
+    copy.m_MaxId = m_MaxId;
+    copy.m_OwnsData = true;
+    copy.m_IsAllocated = true;
+  }
+
+  /**
+   * @brief If this array holds the last reference to its shared memory, takes the memory back without copying.
+   * Must be called with the SharedBufferMutex held.
+   * @return true if this array exclusively owns m_Array afterwards
+   */
+  bool reclaimSharedBuffer()
+  {
+    if(m_SharedBuffer.use_count() != 1)
+    {
+      return false;
+    }
+    m_SharedBuffer->m_Data = nullptr;
+    m_SharedBuffer.reset();
+    m_IsShared.store(false, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Duplicates the values if the memory of this array is shared with a copy-on-write copy
+   * @return false if the duplicate could not be allocated. The shared memory is kept in that case.
+   */
+  bool unshareBuffer()
+  {
+    // m_IsShared is only set under the mutex, so the shared state itself is never read without it
+    if(!m_IsShared.load(std::memory_order_acquire))
+    {
+      return true;
+    }
+    // Several threads may write through the same array. Only one of them may duplicate the memory.
+    std::lock_guard<std::mutex> lock(SharedBufferMutex());
+    if(nullptr == m_SharedBuffer || reclaimSharedBuffer())
+    {
+      return true;
+    }
+    T* newArray = static_cast<T*>(DataArrayAllocator::Allocate(m_Size * sizeof(T), m_StorageType));
+    if(nullptr == newArray)
+    {
+      qDebug() << "Unable to allocate " << m_Size << " elements of size " << sizeof(T) << " bytes. ";
+      return false;
+    }
+    std::memcpy(newArray, m_Array, m_Size * sizeof(T));
+    m_Array = newArray;
+    m_SharedBuffer.reset();
+    m_IsShared.store(false, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Drops the reference of this array to its shared memory, if it has one
+   * @return true if this array referenced shared memory
+   */
+  bool releaseSharedBuffer()
+  {
+    if(!m_IsShared.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(SharedBufferMutex());
+    bool wasShared = (nullptr != m_SharedBuffer);
+    m_SharedBuffer.reset();
+    m_IsShared.store(false, std::memory_order_release);
+    return wasShared;
+  }
+
+  static std::mutex& SharedBufferMutex()
+  {
+    static std::mutex s_Mutex;
+    return s_Mutex;
+  }
+
   T* m_Array = nullptr;
   size_t m_Size = 0;
   size_t m_MaxId = 0;
@@ -2143,6 +3448,12 @@ private:
   comp_dims_type m_CompDims = {1};
   bool m_IsAllocated = false;
   bool m_OwnsData = true;
+  StorageType m_StorageType = StorageType::Default;
+  std::shared_ptr<SharedBuffer> m_SharedBuffer;
+  std::atomic<bool> m_IsShared = {false};
+  StatisticsCache m_StatisticsCache;
+  mutable CompressedValues m_CompressedValues;
+  DeferredValues m_DeferredValues;
 };
 
 // -----------------------------------------------------------------------------
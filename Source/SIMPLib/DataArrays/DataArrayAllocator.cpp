@@ -0,0 +1,568 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DataArrayAllocator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include "SIMPLib/DataArrays/DataArrayMemoryPool.h"
+
+#if !defined(_MSC_VER) && defined(MAP_ANONYMOUS)
+#define SIMPL_HAVE_MMAP_STORAGE 1
+#endif
+
+namespace
+{
+struct MappedRegion
+{
+  size_t numBytes = 0;
+  DataArrayAllocator::StorageType storageType = DataArrayAllocator::StorageType::Heap;
+};
+
+std::mutex& RegistryMutex()
+{
+  static std::mutex s_Mutex;
+  return s_Mutex;
+}
+
+std::map<const void*, MappedRegion>& Registry()
+{
+  static std::map<const void*, MappedRegion> s_Registry;
+  return s_Registry;
+}
+
+// Lets Free()/GetStorageType() skip the registry lock entirely when nothing is mapped
+std::atomic<size_t> s_MappedCount(0);
+
+std::mutex& PolicyMutex()
+{
+  static std::mutex s_Mutex;
+  return s_Mutex;
+}
+
+// The full policy is only read and written under the PolicyMutex. Allocations resolve StorageType::Default
+// through the atomic copies of the storage type and the threshold instead.
+DataArrayAllocator::MemoryPolicy s_Policy;
+std::atomic<bool> s_PolicyInitialized(false);
+std::atomic<int> s_PolicyStorageType(static_cast<int>(DataArrayAllocator::StorageType::Heap));
+std::atomic<size_t> s_PolicyMappedThreshold(0);
+
+thread_local bool s_SkipInitialization = false;
+
+// -----------------------------------------------------------------------------
+// Must be called with the PolicyMutex held
+// -----------------------------------------------------------------------------
+void PublishPolicy()
+{
+  s_PolicyStorageType.store(static_cast<int>(s_Policy.storageType), std::memory_order_relaxed);
+  s_PolicyMappedThreshold.store(s_Policy.mappedThreshold, std::memory_order_relaxed);
+  s_PolicyInitialized.store(true, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// Must be called with the PolicyMutex held
+// -----------------------------------------------------------------------------
+void InitializePolicyFromEnvironment()
+{
+  if(s_PolicyInitialized.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  QByteArray storage = qgetenv("SIMPL_ARRAY_STORAGE");
+  if(!storage.isEmpty())
+  {
+    bool ok = false;
+    DataArrayAllocator::StorageType type = DataArrayAllocator::StorageTypeFromString(QString::fromLatin1(storage), ok);
+    if(ok && type != DataArrayAllocator::StorageType::Default)
+    {
+      s_Policy.storageType = type;
+    }
+    else
+    {
+      qDebug() << "SIMPL_ARRAY_STORAGE has an unknown value" << storage << ". Using Heap storage.";
+    }
+  }
+
+  QByteArray threshold = qgetenv("SIMPL_ARRAY_STORAGE_THRESHOLD");
+  if(!threshold.isEmpty())
+  {
+    bool ok = false;
+    qulonglong value = threshold.toULongLong(&ok);
+    if(ok)
+    {
+      s_Policy.mappedThreshold = static_cast<size_t>(value);
+    }
+  }
+
+  QByteArray scratchDir = qgetenv("SIMPL_SCRATCH_DIR");
+  if(!scratchDir.isEmpty())
+  {
+    s_Policy.scratchDirectory = QString::fromLocal8Bit(scratchDir);
+  }
+  PublishPolicy();
+}
+
+// -----------------------------------------------------------------------------
+// The environment is only read once, every later call is a single atomic load
+// -----------------------------------------------------------------------------
+void EnsurePolicyInitialized()
+{
+  if(!s_PolicyInitialized.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(PolicyMutex());
+    InitializePolicyFromEnvironment();
+  }
+}
+
+#if defined(SIMPL_HAVE_MMAP_STORAGE)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* MapAnonymous(size_t numBytes)
+{
+  void* ptr = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if(ptr == MAP_FAILED)
+  {
+    return nullptr;
+  }
+#if defined(MADV_HUGEPAGE)
+  // Advisory only. Kernels without transparent huge pages simply ignore this.
+  madvise(ptr, numBytes, MADV_HUGEPAGE);
+#endif
+  return ptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* MapScratchFile(size_t numBytes)
+{
+  QString dirPath;
+  {
+    std::lock_guard<std::mutex> lock(PolicyMutex());
+    InitializePolicyFromEnvironment();
+    dirPath = s_Policy.scratchDirectory;
+  }
+  if(dirPath.isEmpty())
+  {
+    dirPath = QDir::tempPath();
+  }
+  QByteArray pathTemplate = QFile::encodeName(QDir(dirPath).filePath("SIMPL_DataArray_XXXXXX"));
+
+  int fd = mkstemp(pathTemplate.data());
+  if(fd < 0)
+  {
+    qDebug() << "DataArrayAllocator: Could not create a scratch file in" << dirPath;
+    return nullptr;
+  }
+  // The file disappears from the directory right away. The mapping keeps the storage alive.
+  unlink(pathTemplate.constData());
+
+  if(ftruncate(fd, static_cast<off_t>(numBytes)) != 0)
+  {
+    qDebug() << "DataArrayAllocator: Could not size the scratch file to" << numBytes << "bytes";
+    close(fd);
+    return nullptr;
+  }
+
+  void* ptr = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if(ptr == MAP_FAILED)
+  {
+    return nullptr;
+  }
+  return ptr;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RegisterRegion(const void* ptr, size_t numBytes, DataArrayAllocator::StorageType storageType)
+{
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  MappedRegion region;
+  region.numBytes = numBytes;
+  region.storageType = storageType;
+  Registry()[ptr] = region;
+  s_MappedCount = Registry().size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool UnregisterRegion(const void* ptr, MappedRegion& region)
+{
+  if(s_MappedCount == 0)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  auto iter = Registry().find(ptr);
+  if(iter == Registry().end())
+  {
+    return false;
+  }
+  region = iter->second;
+  Registry().erase(iter);
+  s_MappedCount = Registry().size();
+  return true;
+}
+} // namespace
+
+const size_t DataArrayAllocator::Alignment;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::DataArrayAllocator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::~DataArrayAllocator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataArrayAllocator::SetMemoryPolicy(const MemoryPolicy& policy)
+{
+  std::lock_guard<std::mutex> lock(PolicyMutex());
+  s_Policy = policy;
+  if(s_Policy.storageType == StorageType::Default)
+  {
+    s_Policy.storageType = StorageType::Heap;
+  }
+  PublishPolicy();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::MemoryPolicy DataArrayAllocator::GetMemoryPolicy()
+{
+  std::lock_guard<std::mutex> lock(PolicyMutex());
+  InitializePolicyFromEnvironment();
+  return s_Policy;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::StorageType DataArrayAllocator::ResolveStorageType(StorageType storageType, size_t numBytes)
+{
+  if(storageType == StorageType::Default)
+  {
+    EnsurePolicyInitialized();
+    bool mapped = (numBytes >= s_PolicyMappedThreshold.load(std::memory_order_relaxed));
+    storageType = mapped ? static_cast<StorageType>(s_PolicyStorageType.load(std::memory_order_relaxed)) : StorageType::Heap;
+  }
+#if !defined(SIMPL_HAVE_MMAP_STORAGE)
+  storageType = StorageType::Heap;
+#endif
+  return storageType;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* DataArrayAllocator::Allocate(size_t numBytes, StorageType storageType)
+{
+  if(numBytes == 0)
+  {
+    return nullptr;
+  }
+  storageType = ResolveStorageType(storageType, numBytes);
+
+#if defined(SIMPL_HAVE_MMAP_STORAGE)
+  void* ptr = nullptr;
+  if(storageType == StorageType::AnonymousMapped)
+  {
+    ptr = MapAnonymous(numBytes);
+  }
+  else if(storageType == StorageType::FileMapped)
+  {
+    ptr = MapScratchFile(numBytes);
+  }
+  if(nullptr != ptr)
+  {
+    RegisterRegion(ptr, numBytes, storageType);
+    return ptr;
+  }
+  if(storageType != StorageType::Heap)
+  {
+    qDebug() << "DataArrayAllocator: Mapping" << numBytes << "bytes as" << StorageTypeToString(storageType) << "failed. Falling back to Heap storage.";
+  }
+#endif
+
+  void* pooled = DataArrayMemoryPool::AllocateFromActivePool(numBytes);
+  if(nullptr != pooled)
+  {
+    return pooled;
+  }
+  return AllocateHeap(numBytes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* DataArrayAllocator::AllocateHeap(size_t numBytes)
+{
+  if(numBytes == 0)
+  {
+    return nullptr;
+  }
+#if defined(_MSC_VER)
+  // _aligned_malloc() blocks can not be released with free(). The 64 bit CRT malloc() already aligns to 16 bytes.
+  static_assert(sizeof(void*) < 8 || Alignment <= 16, "The MSVC heap only guarantees 16 byte alignment");
+  return malloc(numBytes);
+#else
+  void* ptr = nullptr;
+  if(posix_memalign(&ptr, Alignment, numBytes) != 0)
+  {
+    return nullptr;
+  }
+  return ptr;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* DataArrayAllocator::Reallocate(void* ptr, size_t oldNumBytes, size_t newNumBytes, StorageType storageType)
+{
+  if(nullptr == ptr)
+  {
+    return Allocate(newNumBytes, storageType);
+  }
+  if(newNumBytes == 0)
+  {
+    Free(ptr);
+    return nullptr;
+  }
+
+  StorageType currentType = GetStorageType(ptr);
+  StorageType newType = ResolveStorageType(storageType, newNumBytes);
+
+  // Pooled blocks must not be handed to realloc(). A resize that stays inside the size class of the
+  // block is free, anything else moves the data into a new block below.
+  size_t pooledCapacity = DataArrayMemoryPool::GetBlockCapacity(ptr);
+  if(pooledCapacity > 0)
+  {
+    if(newType == StorageType::Heap && DataArrayMemoryPool::SizeClass(newNumBytes) == pooledCapacity)
+    {
+      return ptr;
+    }
+    currentType = StorageType::Default;
+  }
+
+#if !defined(__APPLE__)
+  if(currentType == StorageType::Heap && newType == StorageType::Heap)
+  {
+    void* newPtr = realloc(ptr, newNumBytes);
+    if(nullptr == newPtr || reinterpret_cast<uintptr_t>(newPtr) % Alignment == 0)
+    {
+      return newPtr;
+    }
+    // realloc() only promises malloc() alignment. Move the block once more if it landed off the boundary.
+    void* alignedPtr = AllocateHeap(newNumBytes);
+    if(nullptr == alignedPtr)
+    {
+      free(newPtr);
+      return nullptr;
+    }
+    ::memcpy(alignedPtr, newPtr, newNumBytes);
+    free(newPtr);
+    return alignedPtr;
+  }
+#endif
+
+#if defined(SIMPL_HAVE_MMAP_STORAGE) && defined(MREMAP_MAYMOVE)
+  if(currentType == StorageType::AnonymousMapped && newType == StorageType::AnonymousMapped)
+  {
+    MappedRegion region;
+    UnregisterRegion(ptr, region);
+    void* newPtr = mremap(ptr, region.numBytes, newNumBytes, MREMAP_MAYMOVE);
+    if(newPtr == MAP_FAILED)
+    {
+      RegisterRegion(ptr, region.numBytes, region.storageType);
+      return nullptr;
+    }
+#if defined(MADV_HUGEPAGE)
+    madvise(newPtr, newNumBytes, MADV_HUGEPAGE);
+#endif
+    RegisterRegion(newPtr, newNumBytes, StorageType::AnonymousMapped);
+    return newPtr;
+  }
+#endif
+
+  void* newPtr = Allocate(newNumBytes, newType);
+  if(nullptr == newPtr)
+  {
+    return nullptr;
+  }
+  ::memcpy(newPtr, ptr, (oldNumBytes < newNumBytes) ? oldNumBytes : newNumBytes);
+  Free(ptr);
+  return newPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataArrayAllocator::Free(void* ptr)
+{
+  if(nullptr == ptr)
+  {
+    return;
+  }
+  if(DataArrayMemoryPool::Release(ptr))
+  {
+    return;
+  }
+  MappedRegion region;
+  if(UnregisterRegion(ptr, region))
+  {
+#if defined(SIMPL_HAVE_MMAP_STORAGE)
+    munmap(ptr, region.numBytes);
+#endif
+    return;
+  }
+  free(ptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::StorageType DataArrayAllocator::GetStorageType(const void* ptr)
+{
+  if(nullptr == ptr || s_MappedCount == 0)
+  {
+    return StorageType::Heap;
+  }
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  auto iter = Registry().find(ptr);
+  if(iter == Registry().end())
+  {
+    return StorageType::Heap;
+  }
+  return iter->second.storageType;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DataArrayAllocator::StorageTypeToString(StorageType storageType)
+{
+  switch(storageType)
+  {
+  case StorageType::Default:
+    return QString("Default");
+  case StorageType::Heap:
+    return QString("Heap");
+  case StorageType::FileMapped:
+    return QString("FileMapped");
+  case StorageType::AnonymousMapped:
+    return QString("AnonymousMapped");
+  }
+  return QString("Unknown");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::StorageType DataArrayAllocator::StorageTypeFromString(const QString& str, bool& ok)
+{
+  ok = true;
+  QString value = str.trimmed();
+  if(value.compare("Default", Qt::CaseInsensitive) == 0)
+  {
+    return StorageType::Default;
+  }
+  if(value.compare("Heap", Qt::CaseInsensitive) == 0)
+  {
+    return StorageType::Heap;
+  }
+  if(value.compare("FileMapped", Qt::CaseInsensitive) == 0)
+  {
+    return StorageType::FileMapped;
+  }
+  if(value.compare("AnonymousMapped", Qt::CaseInsensitive) == 0)
+  {
+    return StorageType::AnonymousMapped;
+  }
+  ok = false;
+  return StorageType::Default;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DataArrayAllocator::IsInitializationSkipped()
+{
+  return s_SkipInitialization;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::ScopedSkipInitialization::ScopedSkipInitialization()
+: m_Previous(s_SkipInitialization)
+{
+  s_SkipInitialization = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayAllocator::ScopedSkipInitialization::~ScopedSkipInitialization()
+{
+  s_SkipInitialization = m_Previous;
+}
@@ -0,0 +1,200 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The DataArrayAllocator class provides the backing storage for DataArray<T>. Memory can come
+ * from the heap (malloc/realloc/free), from a shared mapping of an unlinked scratch file, or from an
+ * anonymous mapping that is advised to use transparent huge pages. Every storage type hands out a plain
+ * contiguous pointer so getPointer(), iterators and raw pointer arithmetic keep working unchanged.
+ *
+ * Mapped blocks are recorded in an internal registry so that Free() and Reallocate() can be called on
+ * any pointer without knowing where it came from. This is what allows a DataArray to take ownership of
+ * the memory of another DataArray (readH5Data(), WrapPointer()) regardless of the storage type.
+ *
+ * The global MemoryPolicy decides which storage type is used for arrays that request StorageType::Default.
+ * The initial policy can be set through the following environment variables:
+ * @li SIMPL_ARRAY_STORAGE: "Heap", "FileMapped" or "AnonymousMapped"
+ * @li SIMPL_ARRAY_STORAGE_THRESHOLD: Minimum number of bytes an array needs before the policy storage type is used
+ * @li SIMPL_SCRATCH_DIR: Directory that holds the scratch files of FileMapped arrays
+ */
+class SIMPLib_EXPORT DataArrayAllocator
+{
+public:
+  enum class StorageType : int32_t
+  {
+    Default = 0,        //!< Resolved through the global MemoryPolicy at allocation time
+    Heap = 1,           //!< malloc/realloc/free
+    FileMapped = 2,     //!< Shared mapping of an unlinked scratch file. Pages are streamed through the page cache
+    AnonymousMapped = 3 //!< Private anonymous mapping advised with MADV_HUGEPAGE where available
+  };
+
+  /**
+   * @brief The MemoryPolicy struct describes how StorageType::Default is resolved.
+   */
+  struct MemoryPolicy
+  {
+    StorageType storageType = StorageType::Heap;
+    size_t mappedThreshold = 0;
+    QString scratchDirectory;
+  };
+
+  /**
+   * @brief Alignment in bytes of every block returned by Allocate() and Reallocate(). This is the guarantee
+   * the old _mm_malloc() path of DataArray gave. Mapped blocks are page aligned.
+   */
+  static const size_t Alignment = 16;
+
+  virtual ~DataArrayAllocator();
+
+  /**
+   * @brief Sets the global memory policy. Arrays that are already allocated are not affected.
+   * @param policy
+   */
+  static void SetMemoryPolicy(const MemoryPolicy& policy);
+
+  /**
+   * @brief Returns a copy of the current global memory policy
+   * @return
+   */
+  static MemoryPolicy GetMemoryPolicy();
+
+  /**
+   * @brief Resolves the storage type that will actually be used for an allocation of numBytes.
+   * @param storageType The requested storage type
+   * @param numBytes The size of the allocation
+   * @return Heap, FileMapped or AnonymousMapped. Never Default.
+   */
+  static StorageType ResolveStorageType(StorageType storageType, size_t numBytes);
+
+  /**
+   * @brief Allocates numBytes of uninitialized memory
+   * @param numBytes
+   * @param storageType
+   * @return Pointer to the memory or nullptr on failure
+   */
+  static void* Allocate(size_t numBytes, StorageType storageType);
+
+  /**
+   * @brief Allocates numBytes of uninitialized heap memory aligned to Alignment. The block can be released
+   * with plain free(), so it may be handed to code that does not know about the allocator.
+   * @param numBytes
+   * @return Pointer to the memory or nullptr on failure
+   */
+  static void* AllocateHeap(size_t numBytes);
+
+  /**
+   * @brief Resizes a block previously returned from Allocate() (or plain malloc()). The contents up to the
+   * smaller of the two sizes are preserved. On failure nullptr is returned and the original block is untouched.
+   * @param ptr
+   * @param oldNumBytes
+   * @param newNumBytes
+   * @param storageType The requested storage type of the resized block
+   * @return
+   */
+  static void* Reallocate(void* ptr, size_t oldNumBytes, size_t newNumBytes, StorageType storageType);
+
+  /**
+   * @brief Releases a block previously returned from Allocate()/Reallocate() or from plain malloc()
+   * @param ptr
+   */
+  static void Free(void* ptr);
+
+  /**
+   * @brief Returns the storage type of a block. Blocks that are not known to the allocator are reported as Heap.
+   * @param ptr
+   * @return
+   */
+  static StorageType GetStorageType(const void* ptr);
+
+  /**
+   * @brief Returns a human readable name for the storage type
+   * @param storageType
+   * @return
+   */
+  static QString StorageTypeToString(StorageType storageType);
+
+  /**
+   * @brief Converts a string produced by StorageTypeToString back into the storage type
+   * @param str
+   * @param ok Set to false if the string is not a known storage type
+   * @return
+   */
+  static StorageType StorageTypeFromString(const QString& str, bool& ok);
+
+  /**
+   * @brief Returns true if a ScopedSkipInitialization is alive on the calling thread
+   * @return
+   */
+  static bool IsInitializationSkipped();
+
+  /**
+   * @brief The ScopedSkipInitialization class lets a filter opt out of the initialization of the arrays it
+   * creates on the calling thread. It is honored by AttributeMatrix::createAndAddAttributeArray(), which
+   * AttributeMatrix::createNonPrereqArray() and both createNonPrereqArrayFromPath() helpers (DataContainerArray
+   * and DataStructureUtilities) go through. Arrays created directly with CreateArray() and then initialized
+   * by the caller are not affected. The memory is allocated but left untouched, so a filter that writes every
+   * element anyway saves a full pass over the array and the pages are first touched by the threads that
+   * compute the values.
+   */
+  class SIMPLib_EXPORT ScopedSkipInitialization
+  {
+  public:
+    ScopedSkipInitialization();
+    ~ScopedSkipInitialization();
+
+    ScopedSkipInitialization(const ScopedSkipInitialization&) = delete;
+    ScopedSkipInitialization& operator=(const ScopedSkipInitialization&) = delete;
+
+  private:
+    bool m_Previous = false;
+  };
+
+protected:
+  DataArrayAllocator();
+
+public:
+  DataArrayAllocator(const DataArrayAllocator&) = delete;            // Copy Constructor Not Implemented
+  DataArrayAllocator(DataArrayAllocator&&) = delete;                 // Move Constructor Not Implemented
+  DataArrayAllocator& operator=(const DataArrayAllocator&) = delete; // Copy Assignment Not Implemented
+  DataArrayAllocator& operator=(DataArrayAllocator&&) = delete;      // Move Assignment Not Implemented
+};
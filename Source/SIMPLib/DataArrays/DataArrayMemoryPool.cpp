@@ -0,0 +1,364 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "DataArrayMemoryPool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#include "SIMPLib/DataArrays/DataArrayAllocator.h"
+
+namespace
+{
+struct PooledBlock
+{
+  DataArrayMemoryPool* pool = nullptr;
+  size_t capacity = 0;
+};
+
+// A single lock guards the block registry and the caches of every pool. Only blocks of at least the minimum
+// block size ever come through here, so contention is not a concern.
+std::mutex& PoolMutex()
+{
+  static std::mutex s_Mutex;
+  return s_Mutex;
+}
+
+std::unordered_map<const void*, PooledBlock>& BlockRegistry()
+{
+  static std::unordered_map<const void*, PooledBlock> s_Registry;
+  return s_Registry;
+}
+
+// Each thread has its own active pool so pipelines that execute at the same time never share one
+thread_local DataArrayMemoryPool::Pointer s_ActivePool;
+
+// Let the allocator skip the lock entirely when pooling is not in use
+std::atomic<size_t> s_PooledCount(0);
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayMemoryPool::DataArrayMemoryPool()
+: m_MinimumBlockSize(1024 * 1024)
+, m_MaximumCachedBytes(static_cast<size_t>(1024) * 1024 * 1024)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayMemoryPool::~DataArrayMemoryPool()
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  trimLocked();
+
+  // Blocks that are still in use become ordinary heap blocks
+  auto& registry = BlockRegistry();
+  for(auto iter = registry.begin(); iter != registry.end();)
+  {
+    if(iter->second.pool == this)
+    {
+      iter = registry.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+  s_PooledCount = registry.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataArrayMemoryPool::setMinimumBlockSize(size_t numBytes)
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  m_MinimumBlockSize = numBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t DataArrayMemoryPool::getMinimumBlockSize() const
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  return m_MinimumBlockSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataArrayMemoryPool::setMaximumCachedBytes(size_t numBytes)
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  m_MaximumCachedBytes = numBytes;
+  if(m_Statistics.cachedBytes > m_MaximumCachedBytes)
+  {
+    trimLocked();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t DataArrayMemoryPool::getMaximumCachedBytes() const
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  return m_MaximumCachedBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t DataArrayMemoryPool::trim()
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  return trimLocked();
+}
+
+// -----------------------------------------------------------------------------
+// Must be called with the PoolMutex held
+// -----------------------------------------------------------------------------
+size_t DataArrayMemoryPool::trimLocked()
+{
+  size_t released = 0;
+  for(auto& sizeClass : m_Cache)
+  {
+    for(void* ptr : sizeClass.second)
+    {
+      free(ptr);
+      released += sizeClass.first;
+    }
+  }
+  m_Cache.clear();
+  m_Statistics.cachedBytes = 0;
+  return released;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayMemoryPool::Statistics DataArrayMemoryPool::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  return m_Statistics;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t DataArrayMemoryPool::SizeClass(size_t numBytes)
+{
+  const size_t k_PageSize = 4096;
+  if(numBytes <= k_PageSize)
+  {
+    return k_PageSize;
+  }
+  // Largest power of two strictly below numBytes. Each power of two is split into four classes which
+  // bounds the wasted space of a block to 20% of its size.
+  size_t power = 1;
+  while(power < (numBytes - 1) / 2 + 1)
+  {
+    power <<= 1;
+  }
+  size_t step = power / 4;
+  if(step < k_PageSize)
+  {
+    step = k_PageSize;
+  }
+  return ((numBytes + step - 1) / step) * step;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DataArrayMemoryPool::SetActivePool(const Pointer& pool)
+{
+  // If this was the last reference to the previous pool, it is destroyed when 'previous' goes out of scope.
+  // Swapping first means s_ActivePool already refers to the new pool and never to one that is being destroyed.
+  Pointer previous = pool;
+  s_ActivePool.swap(previous);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayMemoryPool::Pointer DataArrayMemoryPool::GetActivePool()
+{
+  return s_ActivePool;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* DataArrayMemoryPool::AllocateFromActivePool(size_t numBytes)
+{
+  DataArrayMemoryPool* pool = s_ActivePool.get();
+  if(nullptr == pool || numBytes == 0)
+  {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  if(numBytes < pool->m_MinimumBlockSize)
+  {
+    return nullptr;
+  }
+  return pool->allocateBlock(numBytes);
+}
+
+// -----------------------------------------------------------------------------
+// Must be called with the PoolMutex held
+// -----------------------------------------------------------------------------
+void* DataArrayMemoryPool::allocateBlock(size_t numBytes)
+{
+  size_t capacity = SizeClass(numBytes);
+  void* ptr = nullptr;
+
+  auto iter = m_Cache.find(capacity);
+  if(iter != m_Cache.end() && !iter->second.empty())
+  {
+    ptr = iter->second.back();
+    iter->second.pop_back();
+    m_Statistics.cachedBytes -= capacity;
+    m_Statistics.reuses++;
+  }
+  else
+  {
+    ptr = DataArrayAllocator::AllocateHeap(capacity);
+    if(nullptr == ptr)
+    {
+      // Give the cached memory back and try once more before reporting the failure
+      trimLocked();
+      ptr = DataArrayAllocator::AllocateHeap(capacity);
+    }
+    if(nullptr == ptr)
+    {
+      return nullptr;
+    }
+  }
+
+  PooledBlock block;
+  block.pool = this;
+  block.capacity = capacity;
+  BlockRegistry()[ptr] = block;
+  s_PooledCount = BlockRegistry().size();
+
+  m_Statistics.allocations++;
+  m_Statistics.outstandingBytes += capacity;
+  size_t total = m_Statistics.outstandingBytes + m_Statistics.cachedBytes;
+  if(total > m_Statistics.peakBytes)
+  {
+    m_Statistics.peakBytes = total;
+  }
+  return ptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DataArrayMemoryPool::Release(void* ptr)
+{
+  if(nullptr == ptr || s_PooledCount == 0)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  auto& registry = BlockRegistry();
+  auto iter = registry.find(ptr);
+  if(iter == registry.end())
+  {
+    return false;
+  }
+  PooledBlock block = iter->second;
+  registry.erase(iter);
+  s_PooledCount = registry.size();
+  block.pool->releaseBlock(ptr, block.capacity);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Must be called with the PoolMutex held
+// -----------------------------------------------------------------------------
+void DataArrayMemoryPool::releaseBlock(void* ptr, size_t capacity)
+{
+  m_Statistics.outstandingBytes -= capacity;
+  if(m_Statistics.cachedBytes + capacity > m_MaximumCachedBytes)
+  {
+    free(ptr);
+    return;
+  }
+  m_Cache[capacity].push_back(ptr);
+  m_Statistics.cachedBytes += capacity;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t DataArrayMemoryPool::GetBlockCapacity(const void* ptr)
+{
+  if(nullptr == ptr || s_PooledCount == 0)
+  {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(PoolMutex());
+  auto iter = BlockRegistry().find(ptr);
+  if(iter == BlockRegistry().end())
+  {
+    return 0;
+  }
+  return iter->second.capacity;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayMemoryPool::ScopedActivation::ScopedActivation(const Pointer& pool)
+: m_Previous(DataArrayMemoryPool::GetActivePool())
+{
+  DataArrayMemoryPool::SetActivePool(pool);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayMemoryPool::ScopedActivation::~ScopedActivation()
+{
+  DataArrayMemoryPool::SetActivePool(m_Previous);
+}
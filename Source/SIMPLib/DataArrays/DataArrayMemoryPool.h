@@ -0,0 +1,188 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The DataArrayMemoryPool class caches large heap blocks so that arrays which are repeatedly created
+ * and removed during a pipeline (CreateDataArray, RemoveArrays, temporary arrays inside filters) can reuse
+ * memory instead of going back to malloc/free every time. Requests are rounded up to a size class (four
+ * classes per power of two) so a released block can be handed to any later request of a similar size.
+ *
+ * A pool only serves allocations while it is the active pool (see ScopedActivation). The active pool is
+ * per thread: allocations made on other threads, such as the workers of a ParallelDataAlgorithm, are not
+ * pooled. DataArrayAllocator routes Heap allocations of at least getMinimumBlockSize() bytes to the active
+ * pool of the calling thread and hands every released block back to the pool that created it, on whichever
+ * thread it is released and whether or not that pool is still active. Blocks that outlive their pool are
+ * ordinary malloc() memory and are released with free().
+ *
+ * Cached blocks are only returned to the system by trim() or when the pool is destroyed. FilterPipeline
+ * owns a pool, activates it on the executing thread and trims it once the last filter has finished.
+ */
+class SIMPLib_EXPORT DataArrayMemoryPool
+{
+public:
+  SIMPL_SHARED_POINTERS(DataArrayMemoryPool)
+  SIMPL_STATIC_NEW_MACRO(DataArrayMemoryPool)
+  SIMPL_TYPE_MACRO(DataArrayMemoryPool)
+
+  virtual ~DataArrayMemoryPool();
+
+  /**
+   * @brief The Statistics struct is a snapshot of the pool counters
+   */
+  struct Statistics
+  {
+    size_t allocations = 0;      //!< Number of blocks served by the pool
+    size_t reuses = 0;           //!< Number of blocks that were served from the cache
+    size_t outstandingBytes = 0; //!< Bytes currently handed out to arrays
+    size_t cachedBytes = 0;      //!< Bytes held in the cache waiting to be reused
+    size_t peakBytes = 0;        //!< Highest value of outstandingBytes + cachedBytes
+  };
+
+  /**
+   * @brief Allocations smaller than this are not pooled and go straight to malloc(). The default is 1 MiB.
+   * @param numBytes
+   */
+  void setMinimumBlockSize(size_t numBytes);
+  size_t getMinimumBlockSize() const;
+
+  /**
+   * @brief Released blocks that would push the cache above this limit are freed instead of being cached.
+   * A value of 0 disables caching. The default is 1 GiB.
+   * @param numBytes
+   */
+  void setMaximumCachedBytes(size_t numBytes);
+  size_t getMaximumCachedBytes() const;
+
+  /**
+   * @brief Frees every cached block. Blocks that are still in use are not affected.
+   * @return The number of bytes that were returned to the system
+   */
+  size_t trim();
+
+  /**
+   * @brief Returns a snapshot of the pool counters
+   * @return
+   */
+  Statistics getStatistics() const;
+
+  /**
+   * @brief Returns the size class that an allocation of numBytes is rounded up to
+   * @param numBytes
+   * @return
+   */
+  static size_t SizeClass(size_t numBytes);
+
+  /**
+   * @brief Makes pool the active pool of the calling thread. Passing a null pointer disables pooling.
+   * @param pool
+   */
+  static void SetActivePool(const Pointer& pool);
+
+  /**
+   * @brief Returns the active pool of the calling thread or a null pointer
+   * @return
+   */
+  static Pointer GetActivePool();
+
+  /**
+   * @brief Allocates numBytes from the active pool of the calling thread.
+   * @param numBytes
+   * @return nullptr if no pool is active, the request is below the minimum block size or malloc() fails
+   */
+  static void* AllocateFromActivePool(size_t numBytes);
+
+  /**
+   * @brief Hands a block back to the pool that allocated it.
+   * @param ptr
+   * @return false if the block was not allocated by a pool. The caller still owns it in that case.
+   */
+  static bool Release(void* ptr);
+
+  /**
+   * @brief Returns the usable size of a pooled block or 0 if the block was not allocated by a pool
+   * @param ptr
+   * @return
+   */
+  static size_t GetBlockCapacity(const void* ptr);
+
+  /**
+   * @brief The ScopedActivation class makes a pool the active pool of the calling thread for its lifetime and
+   * restores the previously active pool when it goes out of scope.
+   */
+  class SIMPLib_EXPORT ScopedActivation
+  {
+  public:
+    explicit ScopedActivation(const Pointer& pool);
+    ~ScopedActivation();
+
+    ScopedActivation(const ScopedActivation&) = delete;
+    ScopedActivation& operator=(const ScopedActivation&) = delete;
+
+  private:
+    Pointer m_Previous;
+  };
+
+protected:
+  DataArrayMemoryPool();
+
+private:
+  size_t m_MinimumBlockSize;
+  size_t m_MaximumCachedBytes;
+  std::map<size_t, std::vector<void*>> m_Cache;
+  Statistics m_Statistics;
+
+  void* allocateBlock(size_t numBytes);
+  void releaseBlock(void* ptr, size_t capacity);
+  size_t trimLocked();
+
+public:
+  DataArrayMemoryPool(const DataArrayMemoryPool&) = delete;            // Copy Constructor Not Implemented
+  DataArrayMemoryPool(DataArrayMemoryPool&&) = delete;                 // Move Constructor Not Implemented
+  DataArrayMemoryPool& operator=(const DataArrayMemoryPool&) = delete; // Copy Assignment Not Implemented
+  DataArrayMemoryPool& operator=(DataArrayMemoryPool&&) = delete;      // Move Assignment Not Implemented
+};
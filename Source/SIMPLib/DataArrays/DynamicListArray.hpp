@@ -35,8 +35,11 @@
 
 #pragma once
 
+#include <cstring>
 #include <vector>
 
+#include <QtCore/QVector>
+
 //-- DREAM3D Includes
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/SIMPLib.h"
@@ -44,6 +47,9 @@
 /**
  * @brief The MeshFaceNeighbors class contains arrays of Faces for each Node in the mesh. This allows quick query to the node
  * to determine what Cells the node is a part of.
+ *
+ * All of the lists are stored in a compressed sparse row layout: a single buffer of cell indices plus an offsets array
+ * with one entry per list and a trailing total, so the list for ptId is indices[offsets[ptId]] to indices[offsets[ptId + 1]].
  */
 template <typename T, typename K> class DynamicListArray
 {
@@ -62,22 +68,7 @@ public:
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
-  virtual ~DynamicListArray()
-  {
-    // This makes sure we deallocate any lists that have been created
-    for(size_t i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "NeighborLists" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-  }
+  virtual ~DynamicListArray() = default;
 
   /**
    * @brief size
@@ -96,26 +87,16 @@ public:
   Pointer deepCopy(bool forceNoAllocate = false)
   {
     DynamicListArray::Pointer copy = DynamicListArray::New();
-    std::vector<T> linkCounts(m_Size, 0);
     if(forceNoAllocate)
     {
+      std::vector<T> linkCounts(m_Size, 0);
       copy->allocateLists(linkCounts);
       return copy;
     }
 
-    // Figure out how many entries, and for each entry, how many cells
-    for(size_t ptId = 0; ptId < m_Size; ptId++)
-    {
-      linkCounts[ptId] = this->m_Array[ptId].ncells;
-    }
-    // Allocate all that in the copy
-    copy->allocateLists(linkCounts);
-    // Copy the data from the original to the new
-    for(size_t ptId = 0; ptId < m_Size; ptId++)
-    {
-      ElementList& elementList = getElementList(ptId);
-      copy->setElementList(ptId, elementList);
-    }
+    copy->m_Offsets = m_Offsets;
+    copy->m_Indices = m_Indices;
+    copy->m_Size = m_Size;
     return copy;
   }
 
@@ -127,21 +108,25 @@ public:
    */
   inline void insertCellReference(size_t ptId, size_t pos, size_t cellId)
   {
-    this->m_Array[ptId].cells[pos] = cellId;
+    m_Indices[m_Offsets[ptId] + pos] = static_cast<K>(cellId);
   }
 
   /**
-   * @brief Get a link structure given a point id.
+   * @brief Get a link structure given a point id. The returned structure points into the shared index buffer and is
+   * invalidated by any call that changes the size of a list.
    * @param ptId
    * @return
    */
-  ElementList& getElementList(size_t ptId)
+  ElementList getElementList(size_t ptId)
   {
-    return this->m_Array[ptId];
+    ElementList list = {getNumberOfElements(ptId), getElementListPointer(ptId)};
+    return list;
   }
 
   /**
-   * @brief setElementList
+   * @brief setElementList Copies the data into the list for ptId. Replacing a list with one of the same length is done
+   * in place; changing the length has to shift every list that follows, so build the whole array with allocateLists()
+   * or setLists() when many lists change size.
    * @param ptId
    * @param nCells
    * @param data
@@ -153,15 +138,28 @@ public:
     {
       return false;
     }
-    if(nullptr != m_Array[ptId].cells && m_Array[ptId].ncells > 0)
+    size_t oldCount = m_Offsets[ptId + 1] - m_Offsets[ptId];
+    size_t newCount = static_cast<size_t>(nCells);
+    if(newCount != oldCount)
+    {
+      auto first = m_Indices.begin() + static_cast<std::ptrdiff_t>(m_Offsets[ptId]);
+      if(newCount > oldCount)
+      {
+        m_Indices.insert(first + static_cast<std::ptrdiff_t>(oldCount), newCount - oldCount, 0);
+      }
+      else
+      {
+        m_Indices.erase(first + static_cast<std::ptrdiff_t>(newCount), first + static_cast<std::ptrdiff_t>(oldCount));
+      }
+      for(size_t i = ptId + 1; i <= m_Size; i++)
+      {
+        m_Offsets[i] = m_Offsets[i] + newCount - oldCount;
+      }
+    }
+    if(newCount > 0)
     {
-      m_Array[ptId].cells = nullptr;
-      m_Array[ptId].ncells = 0;
+      ::memcpy(m_Indices.data() + m_Offsets[ptId], data, sizeof(K) * newCount);
     }
-    m_Array[ptId].ncells = nCells;
-    // If nCells is huge then there could be problems with this
-    this->m_Array[ptId].cells = new K[nCells];
-    ::memcpy(m_Array[ptId].cells, data, sizeof(K) * nCells);
     return true;
   }
 
@@ -173,21 +171,25 @@ public:
    */
   bool setElementList(size_t ptId, ElementList& list)
   {
-    T nCells = list.ncells;
-    K* data = list.cells;
-    if(ptId >= m_Size)
+    return setElementList(ptId, list.ncells, list.cells);
+  }
+
+  /**
+   * @brief setLists Replaces all of the lists with the given compressed sparse row buffers. The vectors are swapped
+   * into this object so they are left holding the previous contents.
+   * @param offsets Must hold one entry per list plus a trailing total equal to the size of indices
+   * @param indices
+   * @return False if the offsets do not describe the indices
+   */
+  bool setLists(std::vector<size_t>& offsets, std::vector<K>& indices)
+  {
+    if(offsets.empty() || offsets.front() != 0 || offsets.back() != indices.size())
     {
       return false;
     }
-    if(nullptr != m_Array[ptId].cells && m_Array[ptId].ncells > 0)
-    {
-      m_Array[ptId].cells = nullptr;
-      m_Array[ptId].ncells = 0;
-    }
-    m_Array[ptId].ncells = nCells;
-    // If nCells is huge then there could be problems with this
-    this->m_Array[ptId].cells = new K[nCells];
-    ::memcpy(m_Array[ptId].cells, data, sizeof(K) * nCells);
+    m_Offsets.swap(offsets);
+    m_Indices.swap(indices);
+    m_Size = m_Offsets.size() - 1;
     return true;
   }
 
@@ -198,7 +200,7 @@ public:
    */
   T getNumberOfElements(size_t ptId)
   {
-    return this->m_Array[ptId].ncells;
+    return static_cast<T>(m_Offsets[ptId + 1] - m_Offsets[ptId]);
   }
 
   /**
@@ -208,7 +210,25 @@ public:
    */
   K* getElementListPointer(size_t ptId)
   {
-    return this->m_Array[ptId].cells;
+    return m_Indices.data() + m_Offsets[ptId];
+  }
+
+  /**
+   * @brief getOffsets Returns the offsets of each list into the index buffer
+   * @return
+   */
+  const std::vector<size_t>& getOffsets() const
+  {
+    return m_Offsets;
+  }
+
+  /**
+   * @brief getIndices Returns the buffer that holds every list back to back
+   * @return
+   */
+  const std::vector<K>& getIndices() const
+  {
+    return m_Indices;
   }
 
   /**
@@ -218,21 +238,7 @@ public:
    */
   void deserializeLinks(QVector<uint8_t>& buffer, size_t nElements)
   {
-    size_t offset = 0;
-    allocate(nElements); // Allocate all the links with 0 and nullptr;
-    uint8_t* bufPtr = buffer.data();
-
-    // Walk the array and allocate all the array links to Zero and nullptr
-    T* ncells = nullptr;
-    for(size_t i = 0; i < nElements; ++i)
-    {
-      ncells = reinterpret_cast<T*>(bufPtr + offset);
-      this->m_Array[i].ncells = *ncells; // Set the number of cells in this link
-      offset += 2;
-      this->m_Array[i].cells = new K[(*ncells)];                                // Allocate a new chunk of memory to store the list
-      ::memcpy(this->m_Array[i].cells, bufPtr + offset, (*ncells) * sizeof(K)); // Copy from the buffer into the new list memory
-      offset += (*ncells) * sizeof(K);                                          // Increment the offset
-    }
+    deserializeLinks(buffer.data(), static_cast<size_t>(buffer.size()), nElements);
   }
 
   /**
@@ -242,21 +248,35 @@ public:
    */
   void deserializeLinks(std::vector<uint8_t>& buffer, size_t nElements)
   {
-    size_t offset = 0;
-    allocate(nElements); // Allocate all the links with 0 and nullptr;
-    uint8_t* bufPtr = &(buffer.front());
+    deserializeLinks(buffer.data(), buffer.size(), nElements);
+  }
 
-    // Walk the array and allocate all the array links to Zero and nullptr
-    T* ncells = nullptr;
-    // int32_t* cells = nullptr;
+  /**
+   * @brief serializeLinks Writes the first nElements lists into the interleaved layout used in the HDF5 files: for
+   * each list the number of cells as a T followed by the cell indices.
+   * @param buffer
+   * @param nElements
+   */
+  void serializeLinks(std::vector<uint8_t>& buffer, size_t nElements)
+  {
+    if(nElements > m_Size)
+    {
+      nElements = m_Size;
+    }
+    buffer.resize(nElements * sizeof(T) + m_Offsets[nElements] * sizeof(K));
+    uint8_t* bufPtr = buffer.data();
+    size_t offset = 0;
     for(size_t i = 0; i < nElements; ++i)
     {
-      ncells = reinterpret_cast<T*>(bufPtr + offset);
-      this->m_Array[i].ncells = *ncells; // Set the number of cells in this link
-      offset += 2;
-      this->m_Array[i].cells = new K[(*ncells)];                                // Allocate a new chunk of memory to store the list
-      ::memcpy(this->m_Array[i].cells, bufPtr + offset, (*ncells) * sizeof(K)); // Copy from the buffer into the new list memory
-      offset += (*ncells) * sizeof(K);                                          // Increment the offset
+      T ncells = getNumberOfElements(i);
+      ::memcpy(bufPtr + offset, &ncells, sizeof(T));
+      offset += sizeof(T);
+      size_t nBytes = (m_Offsets[i + 1] - m_Offsets[i]) * sizeof(K);
+      if(nBytes > 0)
+      {
+        ::memcpy(bufPtr + offset, m_Indices.data() + m_Offsets[i], nBytes);
+      }
+      offset += nBytes;
     }
   }
 
@@ -266,12 +286,7 @@ public:
    */
   void allocateLists(QVector<T>& linkCounts)
   {
-    allocate(linkCounts.size());
-    for(typename std::vector<T>::size_type i = 0; i < linkCounts.size(); i++)
-    {
-      this->m_Array[i].ncells = linkCounts[i];
-      this->m_Array[i].cells = new K[this->m_Array[i].ncells];
-    }
+    allocateLists(linkCounts.data(), static_cast<size_t>(linkCounts.size()));
   }
 
   /**
@@ -280,55 +295,85 @@ public:
    */
   void allocateLists(std::vector<T>& linkCounts)
   {
-    allocate(linkCounts.size());
-    for(typename std::vector<T>::size_type i = 0; i < linkCounts.size(); i++)
-    {
-      this->m_Array[i].ncells = linkCounts[i];
-      this->m_Array[i].cells = new K[this->m_Array[i].ncells];
-    }
+    allocateLists(linkCounts.data(), linkCounts.size());
   }
 
 protected:
   DynamicListArray() = default;
 
   //----------------------------------------------------------------------------
-  // This will allocate memory to hold all the NeighborList structures where each
-  // structure is initialized to Zero Entries and a nullptr Pointer
-  void allocate(size_t sz, size_t ext = 1000)
+  // This will allocate memory to hold sz lists where each list is initialized
+  // to Zero Entries
+  void allocate(size_t sz)
   {
-    static typename DynamicListArray<T, K>::ElementList linkInit = {0, nullptr};
+    m_Size = sz;
+    m_Offsets.assign(sz + 1, 0);
+    std::vector<K>().swap(m_Indices);
+  }
 
-    // This makes sure we deallocate any lists that have been created
-    for(size_t i = 0; i < this->m_Size; i++)
+  /**
+   * @brief allocateLists Sizes each list from the counts with a prefix sum and allocates the index buffer once
+   * @param linkCounts
+   * @param count
+   */
+  void allocateLists(const T* linkCounts, size_t count)
+  {
+    allocate(count);
+    for(size_t i = 0; i < count; i++)
     {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
+      m_Offsets[i + 1] = m_Offsets[i] + static_cast<size_t>(linkCounts[i]);
     }
-    // Now delete all the "NeighborLists" structures
-    if(this->m_Array != nullptr)
+    m_Indices.resize(m_Offsets[count], 0);
+  }
+
+  /**
+   * @brief deserializeLinks Reads the interleaved HDF5 layout straight into the offsets and index buffers
+   * @param buffer
+   * @param bufferSize
+   * @param nElements
+   */
+  void deserializeLinks(const uint8_t* buffer, size_t bufferSize, size_t nElements)
+  {
+    allocate(nElements);
+
+    // First pass walks the counts to build the offsets so the index buffer is allocated exactly once
+    size_t offset = 0;
+    size_t i = 0;
+    for(; i < nElements && offset + sizeof(T) <= bufferSize; ++i)
     {
-      delete[] this->m_Array;
+      T ncells = 0;
+      ::memcpy(&ncells, buffer + offset, sizeof(T));
+      m_Offsets[i + 1] = m_Offsets[i] + static_cast<size_t>(ncells);
+      offset += sizeof(T) + static_cast<size_t>(ncells) * sizeof(K);
     }
+    // A truncated buffer leaves the array empty rather than reading past its end
+    if(i != nElements || offset > bufferSize)
+    {
+      allocate(0);
+      return;
+    }
+    m_Indices.resize(m_Offsets[nElements]);
 
-    this->m_Size = sz;
-    // Allocate a whole new set of structures
-    this->m_Array = new typename DynamicListArray<T, K>::ElementList[sz];
-
-    // Initialize each structure to have 0 entries and nullptr pointer.
-    for(size_t i = 0; i < sz; i++)
+    // Second pass copies each list into place
+    offset = 0;
+    for(i = 0; i < nElements; ++i)
     {
-      this->m_Array[i] = linkInit;
+      offset += sizeof(T);
+      size_t nBytes = (m_Offsets[i + 1] - m_Offsets[i]) * sizeof(K);
+      if(nBytes > 0)
+      {
+        ::memcpy(m_Indices.data() + m_Offsets[i], buffer + offset, nBytes);
+      }
+      offset += nBytes;
     }
   }
 
 private:
-  ElementList* m_Array = nullptr; // pointer to data
+  std::vector<size_t> m_Offsets = {0};
+  std::vector<K> m_Indices;
   size_t m_Size = 0;
 };
 
 typedef DynamicListArray<int32_t, int32_t> Int32Int32DynamicListArray;
 typedef DynamicListArray<uint16_t, int64_t> UInt16Int64DynamicListArray;
 typedef DynamicListArray<int64_t, int64_t> Int64Int64DynamicListArray;
-
@@ -11,6 +11,10 @@
 
 #include "IDataArray.h"
 
+#include <algorithm>
+
+#include "H5Support/H5Lite.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -23,6 +27,59 @@ IDataArray::IDataArray(const QString& name)
 // -----------------------------------------------------------------------------
 IDataArray::~IDataArray() = default;
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer IDataArray::createSharedCopy()
+{
+  return deepCopy(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IDataArray::setWriteHints(const H5DatasetCreationOptions& hints)
+{
+  m_WriteHints.reset(new H5DatasetCreationOptions(hints));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5DatasetCreationOptions IDataArray::getWriteHints() const
+{
+  return (nullptr != m_WriteHints) ? *m_WriteHints : H5DatasetCreationOptions();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool IDataArray::hasWriteHints() const
+{
+  return (nullptr != m_WriteHints);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IDataArray::clearWriteHints()
+{
+  m_WriteHints.reset();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IDataArray::copyWriteHints(const IDataArray& other)
+{
+  if(nullptr == other.m_WriteHints)
+  {
+    m_WriteHints.reset();
+    return;
+  }
+  m_WriteHints.reset(new H5DatasetCreationOptions(*other.m_WriteHints));
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -40,3 +97,99 @@ DataArrayPath IDataArray::getDataArrayPath() const
   path.setDataArrayName(getName());
   return path;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int IDataArray::EraseListToTupleRuns(const std::vector<size_t>& idxs, size_t numTuples, TupleRuns& runs)
+{
+  runs.clear();
+  const std::vector<size_t>* sortedIdxs = &idxs;
+  std::vector<size_t> sortedCopy;
+  if(!std::is_sorted(idxs.begin(), idxs.end()))
+  {
+    sortedCopy = idxs;
+    std::sort(sortedCopy.begin(), sortedCopy.end());
+    sortedIdxs = &sortedCopy;
+  }
+  if(!sortedIdxs->empty() && sortedIdxs->back() >= numTuples)
+  {
+    return -100;
+  }
+
+  size_t srcTuple = 0;
+  size_t destTuple = 0;
+  for(const auto& idx : *sortedIdxs)
+  {
+    if(idx < srcTuple)
+    {
+      continue; // Duplicate index
+    }
+    if(idx > srcTuple)
+    {
+      TupleRun run;
+      run.srcTuple = srcTuple;
+      run.destTuple = destTuple;
+      run.numTuples = idx - srcTuple;
+      runs.push_back(run);
+      destTuple += run.numTuples;
+    }
+    srcTuple = idx + 1;
+  }
+  if(srcTuple < numTuples)
+  {
+    TupleRun run;
+    run.srcTuple = srcTuple;
+    run.destTuple = destTuple;
+    run.numTuples = numTuples - srcTuple;
+    runs.push_back(run);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int IDataArray::compactTuples(const TupleRuns& runs)
+{
+  size_t numTuples = getNumberOfTuples();
+  std::vector<size_t> idxs;
+  size_t srcTuple = 0;
+  for(const auto& run : runs)
+  {
+    for(size_t i = srcTuple; i < run.srcTuple; i++)
+    {
+      idxs.push_back(i);
+    }
+    srcTuple = run.srcTuple + run.numTuples;
+  }
+  for(size_t i = srcTuple; i < numTuples; i++)
+  {
+    idxs.push_back(i);
+  }
+  if(idxs.empty())
+  {
+    return 0;
+  }
+  return eraseTuples(idxs);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<IDataArray::ComponentStatistics> IDataArray::getComponentStatistics()
+{
+  return std::vector<ComponentStatistics>();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> IDataArray::computeHistogram(int component, size_t numBins, double rangeMin, double rangeMax)
+{
+  Q_UNUSED(component)
+  Q_UNUSED(numBins)
+  Q_UNUSED(rangeMin)
+  Q_UNUSED(rangeMax)
+  return std::vector<size_t>();
+}
@@ -12,6 +12,7 @@
 
 
 //-- C++
+#include <memory>
 #include <vector>
 
 #include <hdf5.h>
@@ -26,6 +27,7 @@
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/IDataStructureNode.h"
 
+struct H5DatasetCreationOptions;
 
 /**
 * @class IDataArray IDataArray.h PathToHeader/IDataArray.h
@@ -95,6 +97,25 @@ class SIMPLib_EXPORT IDataArray : public IDataStructureNode
      */
     virtual bool isAllocated() = 0;
 
+    /**
+     * @brief Returns true if the values of an array that was read on demand could not be read. Such an array
+     * is either unallocated or holds its initialization value.
+     */
+    virtual bool hasDeferredReadFailed() const
+    {
+      return false;
+    }
+
+    /**
+     * @brief Gets the array ready for writes through its element accessors, which do not check whether the
+     * memory is shared with a copy-on-write copy. See DataArray::prepareForWrite().
+     * @return false if the array must not be written to
+     */
+    virtual bool prepareForWrite()
+    {
+      return true;
+    }
+
     /**
      * @brief Makes this class responsible for freeing the memory.
      */
@@ -154,6 +175,75 @@ class SIMPLib_EXPORT IDataArray : public IDataStructureNode
      */
     virtual int eraseTuples(std::vector<size_t>& idxs) = 0;
 
+    /**
+     * @brief The TupleRun struct describes a block of consecutive tuples that is kept by compactTuples().
+     * srcTuple is the index of the first tuple of the block before the compaction and destTuple its index afterwards.
+     */
+    struct TupleRun
+    {
+      size_t srcTuple = 0;
+      size_t destTuple = 0;
+      size_t numTuples = 0;
+    };
+    using TupleRuns = std::vector<TupleRun>;
+
+    /**
+     * @brief Converts a list of tuple indices to erase into the runs of tuples that are kept. The runs can be built
+     * once and then applied to any number of arrays with the same number of tuples.
+     * @param idxs The indices to erase. Duplicates are ignored.
+     * @param numTuples The number of tuples before erasing
+     * @param runs Receives the kept runs in ascending order
+     * @return 0 on success or -100 if an index is out of range
+     */
+    static int EraseListToTupleRuns(const std::vector<size_t>& idxs, size_t numTuples, TupleRuns& runs);
+
+    /**
+     * @brief Keeps only the tuples covered by runs and moves them to their destTuple positions. The runs must be in
+     * ascending order and cover the destination without gaps. The default implementation converts the runs back into
+     * an erase list for eraseTuples(). Subclasses should override this with a direct copy.
+     * @param runs
+     * @return 0 on success
+     */
+    virtual int compactTuples(const TupleRuns& runs);
+
+    /**
+     * @brief The ComponentStatistics struct summarizes the values of one component of an array. NaN values are only
+     * counted in nanCount and do not take part in any of the other values. Values are converted to double.
+     */
+    struct ComponentStatistics
+    {
+      double min = 0.0;
+      double max = 0.0;
+      double sum = 0.0;
+      size_t count = 0; //!< Number of values that are not NaN
+      size_t nanCount = 0;
+
+      double mean() const
+      {
+        return (count > 0) ? sum / static_cast<double>(count) : 0.0;
+      }
+    };
+
+    /**
+     * @brief Returns the statistics of every component of the array. The result is cached on the array until the
+     * values may have changed, which is any call to a non-const accessor. Arrays that have handed out a raw pointer
+     * are scanned again on every call. Arrays that do not hold numeric values return an empty vector.
+     * @return
+     */
+    virtual std::vector<ComponentStatistics> getComponentStatistics();
+
+    /**
+     * @brief Counts the values of one component in numBins bins of equal width between rangeMin and rangeMax. A value
+     * equal to rangeMax lands in the last bin. Values outside of the range and NaN values are not counted. Arrays that
+     * do not hold numeric values return an empty vector.
+     * @param component
+     * @param numBins
+     * @param rangeMin
+     * @param rangeMax
+     * @return
+     */
+    virtual std::vector<size_t> computeHistogram(int component, size_t numBins, double rangeMin, double rangeMax);
+
     /**
      * @brief Copies a Tuple from one position to another.
      * @param currentPos The index of the source data
@@ -254,6 +344,13 @@ class SIMPLib_EXPORT IDataArray : public IDataStructureNode
      */
     virtual IDataArray::Pointer deepCopy(bool forceNoAllocate = false) = 0;
 
+    /**
+     * @brief createSharedCopy Creates a copy that may share its memory with this array until either one of
+     * them is modified. Arrays that can not share their memory return a deepCopy().
+     * @return
+     */
+    virtual IDataArray::Pointer createSharedCopy();
+
     /**
      * @brief writeH5Data
      * @param parentId
@@ -269,6 +366,37 @@ class SIMPLib_EXPORT IDataArray : public IDataStructureNode
      */
     virtual int readH5Data(hid_t parentId) = 0;
 
+    /**
+     * @brief Sets how writeH5Data() lays this array out in the file. Write hints take precedence over the options
+     * of the writer (see H5DataArrayWriter::ScopedDatasetOptions), for example to keep a lookup table contiguous
+     * or to compress one large array harder than the rest.
+     * @param hints
+     */
+    void setWriteHints(const H5DatasetCreationOptions& hints);
+
+    /**
+     * @brief Returns the write hints of this array or default options if none are set
+     * @return
+     */
+    H5DatasetCreationOptions getWriteHints() const;
+
+    /**
+     * @brief Returns true if setWriteHints() was called since the last clearWriteHints()
+     * @return
+     */
+    bool hasWriteHints() const;
+
+    /**
+     * @brief Removes the write hints so that the options of the writer apply again
+     */
+    void clearWriteHints();
+
+    /**
+     * @brief Gives this array the same write hints as other. Every deepCopy() and createSharedCopy() calls this.
+     * @param other
+     */
+    void copyWriteHints(const IDataArray& other);
+
     /**
      * @brief writeXdmfAttribute
      * @param out
@@ -296,6 +424,8 @@ class SIMPLib_EXPORT IDataArray : public IDataStructureNode
   protected:
 
   private:
+    std::unique_ptr<H5DatasetCreationOptions> m_WriteHints;
+
     IDataArray (const IDataArray&);    //Not Implemented
     void operator=(const IDataArray&); //Not Implemented
 
@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include <QtCore/QString>
@@ -249,6 +252,133 @@ class NeighborList : public IDataArray
     using VectorType = std::vector<T>;
     using SharedVectorType = std::shared_ptr<VectorType>;
 
+    /**
+     * @brief The ConstListView class is a read-only view of a single list. When the NeighborList is
+     * using the flat storage layout the view points directly into the contiguous values buffer so no
+     * copies or reference counting are involved. A view stays valid until the NeighborList is resized,
+     * erased, cleared, read or packed. A view taken from the flat layout does not see values written
+     * through the legacy accessors that return a mutable VectorType, and those accessors free the flat
+     * layout unless a FlatListsHandle from retainFlatLists() is held.
+     */
+    class ConstListView
+    {
+    public:
+      ConstListView() = default;
+      ConstListView(const T* data, size_t size)
+      : m_Data(data)
+      , m_Size(size)
+      {
+      }
+
+      const T* begin() const
+      {
+        return m_Data;
+      }
+      const T* end() const
+      {
+        return m_Data + m_Size;
+      }
+      const T* data() const
+      {
+        return m_Data;
+      }
+      size_t size() const
+      {
+        return m_Size;
+      }
+      bool empty() const
+      {
+        return m_Size == 0;
+      }
+      const T& operator[](size_t index) const
+      {
+        return m_Data[index];
+      }
+
+    private:
+      const T* m_Data = nullptr;
+      size_t m_Size = 0;
+    };
+
+    /**
+     * @brief The FlatLists struct holds the lists in the compressed sparse row (CSR) layout: one contiguous
+     * array of values plus an offsets array with one entry per list and a trailing total.
+     */
+    struct FlatLists
+    {
+      std::vector<T> values;
+      std::vector<size_t> offsets;
+    };
+    using FlatListsHandle = std::shared_ptr<const FlatLists>;
+
+    /**
+     * @brief The FlatListBuilder class assembles lists in the compressed sparse row (CSR) layout: one
+     * contiguous array of values plus an offsets array with one entry per list and a trailing total.
+     * Lists are appended in order; call finishList() after the values of each list have been appended
+     * and then hand the builder to NeighborList::setFlatLists().
+     */
+    class FlatListBuilder
+    {
+    public:
+      FlatListBuilder(size_t numListsHint = 0, size_t numValuesHint = 0)
+      {
+        m_Offsets.reserve(numListsHint + 1);
+        m_Offsets.push_back(0);
+        m_Values.reserve(numValuesHint);
+      }
+
+      /**
+       * @brief appendValue Appends a value to the list that is currently being built
+       * @param value
+       */
+      void appendValue(T value)
+      {
+        m_Values.push_back(value);
+      }
+
+      /**
+       * @brief finishList Closes the current list. The next appended value starts a new list.
+       */
+      void finishList()
+      {
+        m_Offsets.push_back(m_Values.size());
+      }
+
+      /**
+       * @brief appendList Appends a complete list in a single call
+       * @param values
+       * @param count
+       */
+      void appendList(const T* values, size_t count)
+      {
+        m_Values.insert(m_Values.end(), values, values + count);
+        finishList();
+      }
+
+      /**
+       * @brief getNumberOfLists Returns the number of finished lists
+       * @return
+       */
+      size_t getNumberOfLists() const
+      {
+        return m_Offsets.size() - 1;
+      }
+
+      /**
+       * @brief getNumberOfValues Returns the total number of values appended so far
+       * @return
+       */
+      size_t getNumberOfValues() const
+      {
+        return m_Values.size();
+      }
+
+    private:
+      friend class NeighborList<T>;
+      std::vector<T> m_Values;
+      std::vector<size_t> m_Offsets;
+    };
+
     // -----------------------------------------------------------------------------
     ~NeighborList() override = default;
 
@@ -351,6 +481,11 @@ class NeighborList : public IDataArray
         return 0;
       }
 
+      if(isFlat())
+      {
+        return eraseFlatTuples(idxs);
+      }
+
       size_t arraySize = m_Array.size();
       // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
       // off the end of the array and return an error code.
@@ -389,6 +524,7 @@ class NeighborList : public IDataArray
      */
     int copyTuple(size_t currentPos, size_t newPos) override
     {
+      unpackFlatLists();
       m_Array[newPos] = m_Array[currentPos];
       return 0;
     }
@@ -419,6 +555,7 @@ class NeighborList : public IDataArray
     bool copyFromArray(size_t destTupleOffset, IDataArray::Pointer sourceArray, size_t srcTupleOffset, size_t totalSrcTuples) override
     {
       if(!m_IsAllocated) { return false; }
+      unpackFlatLists();
       if(destTupleOffset >= m_Array.size() ) { return false; }
       if(!sourceArray->isAllocated()) { return false; }
       Self* source = dynamic_cast<Self*>(sourceArray.get());
@@ -492,6 +629,10 @@ class NeighborList : public IDataArray
      */
     size_t getSize() override
     {
+      if(isFlat())
+      {
+        return m_FlatLists->values.size();
+      }
       size_t total = 0;
       for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
       {
@@ -545,6 +686,7 @@ class NeighborList : public IDataArray
      */
     void initializeWithZeros() override {
       m_Array.clear();
+      clearFlatLists();
       m_IsAllocated = false;
     }
 
@@ -562,7 +704,13 @@ class NeighborList : public IDataArray
 
       typename NeighborList<T>::Pointer daCopyPtr = NeighborList<T>::CreateArray(getNumberOfTuples(), getName(), allocate);
 
-      if(m_IsAllocated && !forceNoAllocate)
+      if(isFlat() && allocate)
+      {
+        daCopyPtr->m_Array.clear();
+        daCopyPtr->publishFlatLists(std::make_shared<FlatLists>(*m_FlatLists));
+        daCopyPtr->m_NumTuples = m_NumTuples;
+      }
+      else if(m_IsAllocated && !forceNoAllocate)
       {
         size_t count = (m_IsAllocated ? getNumberOfTuples(): 0);
         for(size_t i = 0; i < count; i++)
@@ -571,6 +719,7 @@ class NeighborList : public IDataArray
           daCopyPtr->setList(static_cast<int>(i), sharedNeiLst);
         }
       }
+      daCopyPtr->copyWriteHints(*this);
       return daCopyPtr;
     }
 
@@ -582,6 +731,24 @@ class NeighborList : public IDataArray
     int32_t resizeTotalElements(size_t size) override
     {
       //std::cout << "NeighborList::resizeTotalElements(" << size << ")" << std::endl;
+      if(isFlat())
+      {
+        // Shrinking drops whole lists off the end, growing appends empty lists
+        std::vector<size_t>& offsets = m_FlatLists->offsets;
+        size_t numLists = offsets.size() - 1;
+        if(size < numLists)
+        {
+          offsets.resize(size + 1);
+          m_FlatLists->values.resize(offsets.back());
+        }
+        else
+        {
+          offsets.resize(size + 1, offsets.back());
+        }
+        m_NumTuples = size;
+        m_IsAllocated = (size != 0);
+        return 1;
+      }
       size_t old = m_Array.size();
       m_Array.resize(size);
       m_NumTuples = size;
@@ -607,13 +774,12 @@ class NeighborList : public IDataArray
     //FIXME: These need to be implemented
     void printTuple(QTextStream& out, size_t i, char delimiter = ',') override
     {
-      SharedVectorType sharedVec = m_Array[i];
-      VectorType* vec = sharedVec.get();
-      size_t size = vec->size();
+      ConstListView list = getListView(i);
+      size_t size = list.size();
       out << size;
       for(size_t j = 0; j < size; j++)
       {
-        out << delimiter << vec->at(j);
+        out << delimiter << list[j];
       }
     }
 
@@ -646,13 +812,15 @@ class NeighborList : public IDataArray
       {
         m_NumNeighborsArrayName = getName() + "_NumNeighbors";
       }
-      Int32ArrayType::Pointer numNeighborsPtr = Int32ArrayType::CreateArray(m_Array.size(), m_NumNeighborsArrayName, true);
+      size_t numLists = static_cast<size_t>(getNumberOfLists());
+      Int32ArrayType::Pointer numNeighborsPtr = Int32ArrayType::CreateArray(numLists, m_NumNeighborsArrayName, true);
       int32_t* numNeighbors = numNeighborsPtr->getPointer(0);
       size_t total = 0;
-      for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
+      for(size_t dIdx = 0; dIdx < numLists; ++dIdx)
       {
-        numNeighbors[dIdx] = static_cast<int32_t>(m_Array[dIdx]->size());
-        total += m_Array[dIdx]->size();
+        size_t nEle = getListView(dIdx).size();
+        numNeighbors[dIdx] = static_cast<int32_t>(nEle);
+        total += nEle;
       }
 
       // Check to see if the NumNeighbors is already written to the file
@@ -666,7 +834,7 @@ class NeighborList : public IDataArray
       {
         // The NumNeighbors array is in the dream3d file so read it up into memory and compare with what
         // we have in memory.
-        std::vector<int32_t> fileNumNeigh(m_Array.size());
+        std::vector<int32_t> fileNumNeigh(numLists);
         err = QH5Lite::readVectorDataset(parentId, m_NumNeighborsArrayName, fileNumNeigh);
         if (err < 0)
         {
@@ -694,24 +862,30 @@ class NeighborList : public IDataArray
         numNeighborsPtr->writeH5Data(parentId, tDims);
       }
 
-      // Allocate an array of the proper size so we can concatenate all the arrays together into a single array that
-      // can be written to the HDF5 File. This operation can ballon the memory size temporarily until this operation
-      // is complete.
-      QVector<T> flat (total);
-      size_t currentStart = 0;
-      for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
+      // The flat layout is already a single contiguous array and can be written as is. Otherwise allocate an array
+      // of the proper size so we can concatenate all the arrays together into a single array that can be written to
+      // the HDF5 File. This operation can ballon the memory size temporarily until this operation is complete.
+      QVector<T> flat;
+      const T* flatData = isFlat() ? m_FlatLists->values.data() : nullptr;
+      if(!isFlat())
       {
-        size_t nEle = m_Array[dIdx]->size();
-        if(nEle == 0)
+        flat.resize(static_cast<int>(total));
+        size_t currentStart = 0;
+        for(size_t dIdx = 0; dIdx < m_Array.size(); ++dIdx)
         {
-          continue;
-        }
-        T* start = m_Array[dIdx]->data(); // get the pointer to the front of the array
-        //    T* end = start + nEle; // get the pointer to the end of the array
-        T* dst = flat.data() + currentStart;
-        ::memcpy(dst, start, nEle * sizeof(T));
+          size_t nEle = m_Array[dIdx]->size();
+          if(nEle == 0)
+          {
+            continue;
+          }
+          T* start = m_Array[dIdx]->data(); // get the pointer to the front of the array
+          //    T* end = start + nEle; // get the pointer to the end of the array
+          T* dst = flat.data() + currentStart;
+          ::memcpy(dst, start, nEle * sizeof(T));
 
-        currentStart += m_Array[dIdx]->size();
+          currentStart += m_Array[dIdx]->size();
+        }
+        flatData = flat.data();
       }
 
       // Now we can actually write the actual array data.
@@ -719,7 +893,7 @@ class NeighborList : public IDataArray
       hsize_t dims[1] = { total };
       if (total > 0)
       {
-        err = QH5Lite::writePointerDataset(parentId, getName(), rank, dims, flat.data());
+        err = QH5Lite::writePointerDataset(parentId, getName(), rank, dims, flatData, H5DataArrayWriter::GetDatasetOptions(this));
         if(err < 0)
         {
           return -605;
@@ -830,6 +1004,7 @@ class NeighborList : public IDataArray
     {
       int err = 0;
 
+      // The values are read straight into the flat storage; the NumNeighbors array becomes the offsets
       std::vector<T> flat;
       err = QH5Lite::readVectorDataset(parentId, getName(), flat);
       if(err < 0)
@@ -861,32 +1036,28 @@ class NeighborList : public IDataArray
         return -703;
       }
 
-      // int32_t totalElements = std::accumulate(numNeighbors.begin(), numNeighbors.end(), 0);
-
-      // Loop over all the entries and make new Vectors to hold the incoming data
-      m_Array.resize(numNeighbors.size());
-      m_IsAllocated = true;
-      size_t currentStart = 0;
-      qint32 count = static_cast<qint32>(numNeighbors.size());
-      for(QVector<int32_t>::size_type dIdx = 0; dIdx < count; ++dIdx)
+      // Convert the list sizes into offsets and make sure they agree with the number of values in the file
+      std::vector<size_t> offsets(numNeighbors.size() + 1, 0);
+      for(size_t dIdx = 0; dIdx < numNeighbors.size(); ++dIdx)
       {
-        size_t nEle = numNeighbors[dIdx];
-        if(nEle > 0)
-        {
-          m_Array[dIdx] = SharedVectorType(new VectorType(numNeighbors[dIdx]));
-
-          T* dst = m_Array[dIdx]->data(); // get the pointer to the front of the array
-          //    T* end = start + nEle; // get the pointer to the end of the array
-          T* start = flat.data() + currentStart;
-          ::memcpy(dst, start, nEle * sizeof(T));
-          currentStart += nEle;
-        }
-        else
+        if(numNeighbors[dIdx] < 0)
         {
-          m_Array[dIdx] = SharedVectorType(new VectorType(0));
+          return -704;
         }
+        offsets[dIdx + 1] = offsets[dIdx] + static_cast<size_t>(numNeighbors[dIdx]);
       }
-      m_NumTuples = m_Array.size(); // Sync up the numTuples property with the size of the internal array
+      if(offsets.back() != flat.size())
+      {
+        return -704;
+      }
+
+      m_Array.clear();
+      std::shared_ptr<FlatLists> flatLists = std::make_shared<FlatLists>();
+      flatLists->values.swap(flat);
+      flatLists->offsets.swap(offsets);
+      publishFlatLists(flatLists);
+      m_IsAllocated = true;
+      m_NumTuples = numNeighbors.size(); // Sync up the numTuples property with the number of lists
       return err;
     }
 
@@ -897,6 +1068,7 @@ class NeighborList : public IDataArray
      */
     void addEntry(int grainId, T value)
     {
+      unpackFlatLists();
       if(grainId >= static_cast<int>(m_Array.size()) )
       {
         size_t old = m_Array.size();
@@ -918,9 +1090,99 @@ class NeighborList : public IDataArray
     void clearAllLists()
     {
       m_Array.clear();
+      clearFlatLists();
       m_IsAllocated = false;
     }
 
+    /**
+     * @brief isFlat Returns true if the lists are currently held in the flat (CSR) layout
+     * @return
+     */
+    bool isFlat() const
+    {
+      return nullptr != m_FlatView.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief retainFlatLists Keeps the flat buffers alive while the returned handle is held. The accessors that
+     * return a mutable VectorType unpack the lists and free the flat buffers, so a thread that walks
+     * getListView() views while other threads may call those accessors holds a handle for as long as it uses
+     * the views.
+     * @return An empty handle if the lists are not in the flat layout
+     */
+    FlatListsHandle retainFlatLists() const
+    {
+      std::lock_guard<std::mutex> lock(m_UnpackMutex);
+      return m_FlatLists;
+    }
+
+    /**
+     * @brief setFlatLists Replaces the contents of this NeighborList with the lists assembled by the builder. The
+     * builder's buffers are moved into this object and the builder is left empty. Values appended after the last
+     * call to finishList() are treated as one more list.
+     * @param builder
+     */
+    void setFlatLists(FlatListBuilder& builder)
+    {
+      if(builder.m_Values.size() != builder.m_Offsets.back())
+      {
+        builder.finishList();
+      }
+      m_Array.clear();
+      std::shared_ptr<FlatLists> flatLists = std::make_shared<FlatLists>();
+      flatLists->values.swap(builder.m_Values);
+      flatLists->offsets.swap(builder.m_Offsets);
+      builder.m_Offsets.push_back(0);
+      m_NumTuples = flatLists->offsets.size() - 1;
+      m_IsAllocated = (m_NumTuples != 0);
+      publishFlatLists(flatLists);
+    }
+
+    /**
+     * @brief packLists Converts the lists into the flat (CSR) layout, releasing the per list allocations.
+     */
+    void packLists()
+    {
+      if(isFlat())
+      {
+        return;
+      }
+      FlatListBuilder builder(m_Array.size(), getSize());
+      for(const SharedVectorType& list : m_Array)
+      {
+        builder.appendList(list->data(), list->size());
+      }
+      size_t numTuples = m_NumTuples;
+      setFlatLists(builder);
+      // Keep any tuples that were declared but never had a list created for them
+      resizeTotalElements(numTuples > m_NumTuples ? numTuples : m_NumTuples);
+    }
+
+    /**
+     * @brief getListView Returns a read-only view of a list. This does not copy the list and does not force the flat
+     * layout to be unpacked, so it is the preferred way to traverse the lists.
+     * @param grainId
+     * @return
+     */
+    ConstListView getListView(size_t grainId) const
+    {
+      // The lists are fully built before unpackFlatLists() publishes them by clearing m_FlatView
+      const FlatLists* flat = m_FlatView.load(std::memory_order_acquire);
+      if(nullptr != flat)
+      {
+        Q_ASSERT(grainId + 1 < flat->offsets.size());
+        size_t start = flat->offsets[grainId];
+        return ConstListView(flat->values.data() + start, flat->offsets[grainId + 1] - start);
+      }
+      Q_ASSERT(grainId < m_Array.size());
+      const SharedVectorType& list = m_Array[grainId];
+      if(nullptr == list)
+      {
+        return ConstListView();
+      }
+      return ConstListView(list->data(), list->size());
+    }
+
 
     /**
      * @brief setList
@@ -929,6 +1191,7 @@ class NeighborList : public IDataArray
      */
     void setList(int grainId, SharedVectorType neighborList)
     {
+      unpackFlatLists();
       if(grainId >= static_cast<int>(m_Array.size()) )
       {
         size_t old = m_Array.size();
@@ -952,16 +1215,13 @@ class NeighborList : public IDataArray
      */
     T getValue(int grainId, int index, bool& ok)
     {
-#ifndef NDEBUG
-      if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
-#endif
-      SharedVectorType vec = m_Array[grainId];
-      if(index < 0 || static_cast<size_t>(index) >= vec->size())
+      ConstListView list = getListView(static_cast<size_t>(grainId));
+      if(index < 0 || static_cast<size_t>(index) >= list.size())
       {
         ok = false;
         return -1;
       }
-      return (*vec)[index];
+      return list[index];
     }
 
     /**
@@ -970,6 +1230,10 @@ class NeighborList : public IDataArray
      */
     int getNumberOfLists()
     {
+      if(isFlat())
+      {
+        return static_cast<int>(m_FlatLists->offsets.size() - 1);
+      }
       return static_cast<int>(m_Array.size());
     }
 
@@ -980,14 +1244,12 @@ class NeighborList : public IDataArray
      */
     int getListSize(int grainId)
     {
-#ifndef NDEBUG
-      if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
-#endif
-      return static_cast<int>(m_Array[grainId]->size());
+      return static_cast<int>(getListView(static_cast<size_t>(grainId)).size());
     }
 
     VectorType& getListReference(int grainId)
     {
+      unpackFlatLists();
 #ifndef NDEBUG
       if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
 #endif
@@ -1001,6 +1263,7 @@ class NeighborList : public IDataArray
      */
     SharedVectorType getList(int grainId)
     {
+      unpackFlatLists();
 #ifndef NDEBUG
       if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
 #endif
@@ -1014,11 +1277,8 @@ class NeighborList : public IDataArray
      */
     VectorType copyOfList(int grainId)
     {
-#ifndef NDEBUG
-      if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
-#endif
-
-      VectorType copy(*(m_Array[grainId]));
+      ConstListView list = getListView(static_cast<size_t>(grainId));
+      VectorType copy(list.begin(), list.end());
       return copy;
     }
 
@@ -1029,6 +1289,7 @@ class NeighborList : public IDataArray
      */
     VectorType& operator[](int grainId)
     {
+      unpackFlatLists();
 #ifndef NDEBUG
       if (m_Array.size() > 0u) { Q_ASSERT(grainId < static_cast<int>(m_Array.size()));}
 #endif
@@ -1042,6 +1303,7 @@ class NeighborList : public IDataArray
      */
     VectorType& operator[](size_t grainId)
     {
+      unpackFlatLists();
 #ifndef NDEBUG
       if (m_Array.size() > 0ul) { Q_ASSERT(grainId < m_Array.size());}
 #endif
@@ -1063,7 +1325,104 @@ class NeighborList : public IDataArray
     }
 
   private:
+    /**
+     * @brief unpackFlatLists Converts the flat layout back into one vector per list. This is done lazily the first
+     * time one of the accessors that hands out a mutable VectorType is called. Concurrent callers are serialized so
+     * the conversion only happens once. The flat buffers are freed right away unless a getListView() reader holds
+     * them through retainFlatLists().
+     */
+    void unpackFlatLists()
+    {
+      if(nullptr == m_FlatView.load(std::memory_order_acquire))
+      {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(m_UnpackMutex);
+      if(nullptr == m_FlatView.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+      const std::vector<T>& values = m_FlatLists->values;
+      const std::vector<size_t>& offsets = m_FlatLists->offsets;
+      size_t numLists = offsets.size() - 1;
+      std::vector<SharedVectorType> lists(numLists);
+      for(size_t i = 0; i < numLists; i++)
+      {
+        lists[i] = SharedVectorType(new VectorType(values.begin() + offsets[i], values.begin() + offsets[i + 1]));
+      }
+      m_Array.swap(lists);
+      m_FlatView.store(nullptr, std::memory_order_release);
+      m_FlatLists.reset();
+    }
+
+    /**
+     * @brief publishFlatLists Switches to the flat layout
+     * @param flatLists
+     */
+    void publishFlatLists(std::shared_ptr<FlatLists> flatLists)
+    {
+      m_FlatLists = flatLists;
+      m_FlatView.store(m_FlatLists.get(), std::memory_order_release);
+    }
+
+    /**
+     * @brief clearFlatLists Releases the flat storage and switches back to the per list layout
+     */
+    void clearFlatLists()
+    {
+      m_FlatView.store(nullptr, std::memory_order_release);
+      m_FlatLists.reset();
+    }
+
+    /**
+     * @brief eraseFlatTuples Removes lists from the flat layout by compacting the values and offsets in place
+     * @param idxs
+     * @return
+     */
+    int eraseFlatTuples(const std::vector<size_t>& idxs)
+    {
+      std::vector<T>& values = m_FlatLists->values;
+      std::vector<size_t>& offsets = m_FlatLists->offsets;
+      size_t numLists = offsets.size() - 1;
+      std::vector<bool> removeList(numLists, false);
+      for(size_t idx : idxs)
+      {
+        if(idx >= numLists)
+        {
+          return -100;
+        }
+        removeList[idx] = true;
+      }
+
+      size_t dstList = 0;
+      size_t dstValue = 0;
+      for(size_t srcList = 0; srcList < numLists; ++srcList)
+      {
+        if(removeList[srcList])
+        {
+          continue;
+        }
+        size_t start = offsets[srcList];
+        size_t end = offsets[srcList + 1];
+        if(dstValue != start)
+        {
+          std::copy(values.begin() + start, values.begin() + end, values.begin() + dstValue);
+        }
+        offsets[dstList] = dstValue;
+        dstValue += end - start;
+        ++dstList;
+      }
+      offsets[dstList] = dstValue;
+      offsets.resize(dstList + 1);
+      values.resize(dstValue);
+      m_NumTuples = dstList;
+      return 0;
+    }
+
     std::vector<SharedVectorType> m_Array;
+    std::shared_ptr<FlatLists> m_FlatLists;
+    std::atomic<const FlatLists*> m_FlatView = {nullptr};
+    mutable std::mutex m_UnpackMutex;
     size_t m_NumTuples;
     bool m_IsAllocated;
     T m_InitValue;
@@ -0,0 +1,346 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The PackedIntegerBlocks class is a compact, immutable copy of an array of integer values. The values
+ * are split into blocks of k_BlockSize values and every block is stored as its minimum plus the offsets from
+ * that minimum, packed with just as many bits as the largest offset of the block needs. Blocks holding a single
+ * repeated value (background voxels, unassigned feature ids, masks) take no bits at all, so long runs cost one
+ * block header per k_BlockSize values.
+ *
+ * Every block starts on a 64 bit word boundary, which lets blocks be encoded and decoded independently and in
+ * parallel. Single values can be read without decoding their block.
+ */
+template <typename T> class PackedIntegerBlocks
+{
+public:
+  /**
+   * @brief Number of values in each block
+   */
+  static const size_t k_BlockSize = 4096;
+
+  PackedIntegerBlocks() = default;
+  ~PackedIntegerBlocks() = default;
+
+  /**
+   * @brief Packs count values. Large arrays are packed in parallel.
+   * @param data
+   * @param count
+   */
+  void encode(const T* data, size_t count)
+  {
+    m_NumValues = count;
+    size_t numBlocks = getNumberOfBlocks();
+    m_Blocks.assign(numBlocks, BlockHeader());
+    m_Words.clear();
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.setParallelizationEnabled(numBlocks > 1);
+    dataAlg.execute(FindBlockRangesImpl(data, count, m_Blocks));
+
+    size_t numWords = 0;
+    for(size_t block = 0; block < numBlocks; block++)
+    {
+      m_Blocks[block].wordOffset = numWords;
+      numWords += (getBlockLength(block) * m_Blocks[block].bitWidth + 63) / 64;
+    }
+    m_Words.assign(numWords, 0);
+
+    dataAlg.execute(PackBlocksImpl(this, data));
+  }
+
+  /**
+   * @brief Unpacks every value into out, which has to hold getNumberOfValues() values. Large arrays are
+   * unpacked in parallel.
+   * @param out
+   */
+  void decode(T* out) const
+  {
+    size_t numBlocks = getNumberOfBlocks();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.setParallelizationEnabled(numBlocks > 1);
+    dataAlg.execute(UnpackBlocksImpl(this, out));
+  }
+
+  /**
+   * @brief Unpacks one block into out, which has to hold getBlockLength(block) values
+   * @param block
+   * @param out
+   */
+  void decodeBlock(size_t block, T* out) const
+  {
+    const BlockHeader& header = m_Blocks[block];
+    size_t length = getBlockLength(block);
+    if(header.bitWidth == 0)
+    {
+      std::fill(out, out + length, static_cast<T>(header.base));
+      return;
+    }
+    for(size_t i = 0; i < length; i++)
+    {
+      out[i] = static_cast<T>(header.base + readBits(header, i));
+    }
+  }
+
+  /**
+   * @brief Returns a single value without unpacking its block
+   * @param index
+   * @return
+   */
+  T getValue(size_t index) const
+  {
+    const BlockHeader& header = m_Blocks[index / k_BlockSize];
+    if(header.bitWidth == 0)
+    {
+      return static_cast<T>(header.base);
+    }
+    return static_cast<T>(header.base + readBits(header, index % k_BlockSize));
+  }
+
+  /**
+   * @brief Returns the number of packed values
+   * @return
+   */
+  size_t getNumberOfValues() const
+  {
+    return m_NumValues;
+  }
+
+  /**
+   * @brief Returns the number of blocks
+   * @return
+   */
+  size_t getNumberOfBlocks() const
+  {
+    return (m_NumValues + k_BlockSize - 1) / k_BlockSize;
+  }
+
+  /**
+   * @brief Returns the number of values in a block. Only the last block can be shorter than k_BlockSize.
+   * @param block
+   * @return
+   */
+  size_t getBlockLength(size_t block) const
+  {
+    size_t start = block * k_BlockSize;
+    return (m_NumValues - start < k_BlockSize) ? m_NumValues - start : k_BlockSize;
+  }
+
+  /**
+   * @brief Returns the number of bits used for each value of a block
+   * @param block
+   * @return
+   */
+  int getBlockBitWidth(size_t block) const
+  {
+    return m_Blocks[block].bitWidth;
+  }
+
+  /**
+   * @brief Returns the number of bytes held by the packed representation
+   * @return
+   */
+  size_t getByteSize() const
+  {
+    return m_Blocks.size() * sizeof(BlockHeader) + m_Words.size() * sizeof(uint64_t);
+  }
+
+private:
+  struct BlockHeader
+  {
+    uint64_t base = 0;
+    size_t wordOffset = 0;
+    int bitWidth = 0;
+  };
+
+  std::vector<BlockHeader> m_Blocks;
+  std::vector<uint64_t> m_Words;
+  size_t m_NumValues = 0;
+
+  /**
+   * @brief Values are stored as unsigned offsets from the block minimum. The conversion to uint64_t sign extends
+   * signed types, so the subtraction gives the right offset for negative values as well.
+   * @param value
+   * @return
+   */
+  static uint64_t ToBits(T value)
+  {
+    return static_cast<uint64_t>(value);
+  }
+
+  uint64_t readBits(const BlockHeader& header, size_t i) const
+  {
+    size_t bitPos = i * header.bitWidth;
+    const uint64_t* words = m_Words.data() + header.wordOffset + bitPos / 64;
+    size_t shift = bitPos % 64;
+    uint64_t bits = words[0] >> shift;
+    if(shift + header.bitWidth > 64)
+    {
+      bits |= words[1] << (64 - shift);
+    }
+    return (header.bitWidth == 64) ? bits : bits & ((uint64_t(1) << header.bitWidth) - 1);
+  }
+
+  /**
+   * @brief The FindBlockRangesImpl class finds the minimum and the offset bit width of a range of blocks
+   */
+  class FindBlockRangesImpl
+  {
+  public:
+    FindBlockRangesImpl(const T* data, size_t count, std::vector<BlockHeader>& blocks)
+    : m_Data(data)
+    , m_Count(count)
+    , m_Blocks(blocks)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t block = range.min(); block < range.max(); block++)
+      {
+        const T* values = m_Data + block * k_BlockSize;
+        size_t length = std::min(m_Count - block * k_BlockSize, static_cast<size_t>(k_BlockSize));
+        T lo = values[0];
+        T hi = values[0];
+        for(size_t i = 1; i < length; i++)
+        {
+          lo = (values[i] < lo) ? values[i] : lo;
+          hi = (values[i] > hi) ? values[i] : hi;
+        }
+        uint64_t span = ToBits(hi) - ToBits(lo);
+        int bitWidth = 0;
+        while(bitWidth < 64 && (span >> bitWidth) != 0)
+        {
+          bitWidth++;
+        }
+        m_Blocks[block].base = ToBits(lo);
+        m_Blocks[block].bitWidth = bitWidth;
+      }
+    }
+
+  private:
+    const T* m_Data;
+    size_t m_Count;
+    std::vector<BlockHeader>& m_Blocks;
+  };
+
+  /**
+   * @brief The PackBlocksImpl class writes the offsets of a range of blocks into their words
+   */
+  class PackBlocksImpl
+  {
+  public:
+    PackBlocksImpl(PackedIntegerBlocks* packed, const T* data)
+    : m_Packed(packed)
+    , m_Data(data)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t block = range.min(); block < range.max(); block++)
+      {
+        const BlockHeader& header = m_Packed->m_Blocks[block];
+        if(header.bitWidth == 0)
+        {
+          continue;
+        }
+        const T* values = m_Data + block * k_BlockSize;
+        uint64_t* words = m_Packed->m_Words.data() + header.wordOffset;
+        size_t length = m_Packed->getBlockLength(block);
+        for(size_t i = 0; i < length; i++)
+        {
+          uint64_t bits = ToBits(values[i]) - header.base;
+          size_t bitPos = i * header.bitWidth;
+          size_t shift = bitPos % 64;
+          words[bitPos / 64] |= bits << shift;
+          if(shift + header.bitWidth > 64)
+          {
+            words[bitPos / 64 + 1] |= bits >> (64 - shift);
+          }
+        }
+      }
+    }
+
+  private:
+    PackedIntegerBlocks* m_Packed;
+    const T* m_Data;
+  };
+
+  /**
+   * @brief The UnpackBlocksImpl class decodes a range of blocks into a plain array
+   */
+  class UnpackBlocksImpl
+  {
+  public:
+    UnpackBlocksImpl(const PackedIntegerBlocks* packed, T* out)
+    : m_Packed(packed)
+    , m_Out(out)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t block = range.min(); block < range.max(); block++)
+      {
+        m_Packed->decodeBlock(block, m_Out + block * k_BlockSize);
+      }
+    }
+
+  private:
+    const PackedIntegerBlocks* m_Packed;
+    T* m_Out;
+  };
+
+public:
+  PackedIntegerBlocks(const PackedIntegerBlocks&) = default;            // Copy Constructor default Implemented
+  PackedIntegerBlocks(PackedIntegerBlocks&&) = default;                 // Move Constructor default Implemented
+  PackedIntegerBlocks& operator=(const PackedIntegerBlocks&) = default; // Copy Assignment default Implemented
+  PackedIntegerBlocks& operator=(PackedIntegerBlocks&&) = default;      // Move Assignment default Implemented
+};
+
+template <typename T> const size_t PackedIntegerBlocks<T>::k_BlockSize;
@@ -389,6 +389,7 @@ IDataArray::Pointer StatsDataArray::deepCopy(bool forceNoAllocate)
       daCopyPtr->setStatsData(i, StatsData::NullPointer());
     }
   }
+  daCopyPtr->copyWriteHints(*this);
 
   return daCopyPtr;
 }
@@ -34,9 +34,76 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "StringDataArray.h"
 
+#include <cstring>
+#include <unordered_map>
+
 #include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/HDF5/H5DataArrayWriter.hpp"
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StringDataArray::Utf8View::Utf8View(const char* data, size_t size)
+: m_Data(data)
+, m_Size(size)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* StringDataArray::Utf8View::data() const
+{
+  return m_Data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t StringDataArray::Utf8View::size() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StringDataArray::Utf8View::empty() const
+{
+  return m_Size == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString StringDataArray::Utf8View::toQString() const
+{
+  return QString::fromUtf8(m_Data, static_cast<int>(m_Size));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::string StringDataArray::Utf8View::toStdString() const
+{
+  return std::string(m_Data, m_Size);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StringDataArray::Utf8View::operator==(const Utf8View& other) const
+{
+  return m_Size == other.m_Size && ::memcmp(m_Data, other.m_Data, m_Size) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StringDataArray::Utf8View::operator!=(const Utf8View& other) const
+{
+  return !(*this == other);
+}
 
 // -----------------------------------------------------------------------------
 //
@@ -177,6 +244,7 @@ void StringDataArray::releaseOwnership()
 // -----------------------------------------------------------------------------
 void* StringDataArray::getVoidPointer(size_t i)
 {
+  unpack();
   return static_cast<void*>(&(m_Array[i]));
 }
 
@@ -185,6 +253,10 @@ void* StringDataArray::getVoidPointer(size_t i)
 // -----------------------------------------------------------------------------
 size_t StringDataArray::getNumberOfTuples()
 {
+  if(m_IsPacked)
+  {
+    return getNumberOfPackedTuples();
+  }
   return m_Array.size();
 }
 
@@ -193,7 +265,7 @@ size_t StringDataArray::getNumberOfTuples()
 // -----------------------------------------------------------------------------
 size_t StringDataArray::getSize()
 {
-  return m_Array.size();
+  return getNumberOfTuples();
 }
 
 // -----------------------------------------------------------------------------
@@ -259,14 +331,60 @@ int StringDataArray::eraseTuples(std::vector<size_t>& idxs)
   // Sanity Check the Indices in the vector to make sure we are not trying to remove any indices that are
   // off the end of the array and return an error code.
   // for(std::vector<size_t>::size_type i = 0; i < idxs.size(); ++i)
+  size_t numTuples = getNumberOfTuples();
   for(auto& value : idxs)
   {
-    if(value >= static_cast<size_t>(m_Array.size()))
+    if(value >= numTuples)
     {
       return -100;
     }
   }
 
+  if(m_IsPacked)
+  {
+    std::vector<bool> removeTuple(numTuples, false);
+    for(auto& value : idxs)
+    {
+      removeTuple[value] = true;
+    }
+    size_t dstTuple = 0;
+    if(m_IsDictionaryEncoded)
+    {
+      // Only the indices move, the dictionary itself is left as is
+      for(size_t srcTuple = 0; srcTuple < numTuples; ++srcTuple)
+      {
+        if(!removeTuple[srcTuple])
+        {
+          m_DictionaryIndices[dstTuple++] = m_DictionaryIndices[srcTuple];
+        }
+      }
+      m_DictionaryIndices.resize(dstTuple);
+      return err;
+    }
+    // Compact the packed strings in place
+    size_t dstByte = 0;
+    for(size_t srcTuple = 0; srcTuple < numTuples; ++srcTuple)
+    {
+      if(removeTuple[srcTuple])
+      {
+        continue;
+      }
+      size_t start = m_PackedOffsets[srcTuple];
+      size_t end = m_PackedOffsets[srcTuple + 1];
+      if(dstByte != start)
+      {
+        ::memmove(m_PackedBuffer.data() + dstByte, m_PackedBuffer.data() + start, end - start);
+      }
+      m_PackedOffsets[dstTuple++] = dstByte;
+      dstByte += end - start;
+    }
+    m_PackedOffsets[dstTuple] = dstByte;
+    m_PackedOffsets.resize(dstTuple + 1);
+    m_PackedBuffer.resize(dstByte);
+    return err;
+  }
+
+  releaseStalePacked();
   // Create a new Array to copy into
   std::vector<QString> newArray;
   std::vector<size_t>::size_type start = 0;
@@ -295,14 +413,21 @@ int StringDataArray::eraseTuples(std::vector<size_t>& idxs)
 // -----------------------------------------------------------------------------
 int StringDataArray::copyTuple(size_t currentPos, size_t newPos)
 {
-  if(currentPos >= m_Array.size())
+  size_t numTuples = getNumberOfTuples();
+  if(currentPos >= numTuples)
   {
     return -1;
   }
-  if(newPos >= m_Array.size())
+  if(newPos >= numTuples)
   {
     return -1;
   }
+  if(m_IsPacked && m_IsDictionaryEncoded)
+  {
+    m_DictionaryIndices[newPos] = m_DictionaryIndices[currentPos];
+    return 0;
+  }
+  unpack();
   // QString s = m_Array[currentPos];
   m_Array[newPos] = m_Array[currentPos];
   return 0;
@@ -313,6 +438,7 @@ int StringDataArray::copyTuple(size_t currentPos, size_t newPos)
 // -----------------------------------------------------------------------------
 bool StringDataArray::copyFromArray(size_t destTupleOffset, IDataArray::Pointer sourceArray, size_t srcTupleOffset, size_t totalSrcTuples)
 {
+  unpack();
   if(destTupleOffset >= m_Array.size())
   {
     return false;
@@ -345,6 +471,7 @@ bool StringDataArray::copyFromArray(size_t destTupleOffset, IDataArray::Pointer
 // -----------------------------------------------------------------------------
 void StringDataArray::initializeTuple(size_t pos, void* value)
 {
+  unpack();
   m_Array[pos] = *(reinterpret_cast<QString*>(value));
 }
 
@@ -353,7 +480,9 @@ void StringDataArray::initializeTuple(size_t pos, void* value)
 // -----------------------------------------------------------------------------
 void StringDataArray::initializeWithZeros()
 {
-  m_Array.assign(m_Array.size(), QString(""));
+  size_t numTuples = getNumberOfTuples();
+  clearPacked();
+  m_Array.assign(numTuples, QString(""));
 }
 
 // -----------------------------------------------------------------------------
@@ -361,7 +490,9 @@ void StringDataArray::initializeWithZeros()
 // -----------------------------------------------------------------------------
 void StringDataArray::initializeWithValue(const QString& value)
 {
-  m_Array.assign(m_Array.size(), value);
+  size_t numTuples = getNumberOfTuples();
+  clearPacked();
+  m_Array.assign(numTuples, value);
 }
 
 // -----------------------------------------------------------------------------
@@ -369,7 +500,9 @@ void StringDataArray::initializeWithValue(const QString& value)
 // -----------------------------------------------------------------------------
 void StringDataArray::initializeWithValue(const std::string& value)
 {
-  m_Array.assign(m_Array.size(), QString::fromStdString(value));
+  size_t numTuples = getNumberOfTuples();
+  clearPacked();
+  m_Array.assign(numTuples, QString::fromStdString(value));
 }
 
 // -----------------------------------------------------------------------------
@@ -378,13 +511,23 @@ void StringDataArray::initializeWithValue(const std::string& value)
 IDataArray::Pointer StringDataArray::deepCopy(bool forceNoAllocate)
 {
   StringDataArray::Pointer daCopy = StringDataArray::CreateArray(getNumberOfTuples(), getName(), true);
-  if(!forceNoAllocate)
+  if(!forceNoAllocate && m_IsPacked)
+  {
+    daCopy->m_Array.clear();
+    daCopy->m_PackedBuffer = m_PackedBuffer;
+    daCopy->m_PackedOffsets = m_PackedOffsets;
+    daCopy->m_DictionaryIndices = m_DictionaryIndices;
+    daCopy->m_IsDictionaryEncoded = m_IsDictionaryEncoded;
+    daCopy->m_IsPacked = true;
+  }
+  else if(!forceNoAllocate)
   {
     for(std::vector<QString>::size_type i = 0; i < m_Array.size(); ++i)
     {
       daCopy->setValue(i, m_Array[i]);
     }
   }
+  daCopy->copyWriteHints(*this);
   return daCopy;
 }
 
@@ -393,6 +536,12 @@ IDataArray::Pointer StringDataArray::deepCopy(bool forceNoAllocate)
 // -----------------------------------------------------------------------------
 int32_t StringDataArray::resizeTotalElements(size_t size)
 {
+  if(m_IsPacked)
+  {
+    resizePacked(size);
+    return 1;
+  }
+  releaseStalePacked();
   m_Array.resize(size);
   return 1;
 }
@@ -402,7 +551,7 @@ int32_t StringDataArray::resizeTotalElements(size_t size)
 // -----------------------------------------------------------------------------
 void StringDataArray::resizeTuples(size_t numTuples)
 {
-  m_Array.resize(numTuples);
+  resizeTotalElements(numTuples);
 }
 
 // -----------------------------------------------------------------------------
@@ -410,6 +559,7 @@ void StringDataArray::resizeTuples(size_t numTuples)
 // -----------------------------------------------------------------------------
 void StringDataArray::initialize()
 {
+  clearPacked();
   if(!m_Array.empty())
   {
     m_Array.clear();
@@ -422,7 +572,7 @@ void StringDataArray::initialize()
 // -----------------------------------------------------------------------------
 void StringDataArray::printTuple(QTextStream& out, size_t i, char delimiter)
 {
-  out << m_Array[i];
+  out << getValue(i);
 }
 
 // -----------------------------------------------------------------------------
@@ -430,7 +580,7 @@ void StringDataArray::printTuple(QTextStream& out, size_t i, char delimiter)
 // -----------------------------------------------------------------------------
 void StringDataArray::printComponent(QTextStream& out, size_t i, int j)
 {
-  out << m_Array[i];
+  out << getValue(i);
 }
 
 // -----------------------------------------------------------------------------
@@ -446,7 +596,26 @@ QString StringDataArray::getFullNameOfClass()
 // -----------------------------------------------------------------------------
 int StringDataArray::writeH5Data(hid_t parentId, std::vector<size_t> tDims)
 {
-  return H5DataArrayWriter::writeStringDataArray<StringDataArray>(parentId, this);
+  if(!m_IsPacked.load(std::memory_order_acquire))
+  {
+    return H5DataArrayWriter::writeStringDataArray<StringDataArray>(parentId, this);
+  }
+
+  // Copy each value by its length so embedded null characters are handled the same as in the QString layout
+  size_t numTuples = getNumberOfPackedTuples();
+  std::vector<std::string> strings(numTuples);
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    strings[i] = packedView(i).toStdString();
+  }
+  int err = H5Lite::writeVectorOfStringsDataset(parentId, getName().toStdString(), strings);
+  if(err < 0)
+  {
+    return err;
+  }
+  std::vector<size_t> stringTDims(1, numTuples);
+  std::vector<size_t> cDims(1, 1);
+  return H5DataArrayWriter::writeDataArrayAttributes<StringDataArray>(parentId, this, stringTDims, cDims);
 }
 
 // -----------------------------------------------------------------------------
@@ -494,14 +663,20 @@ int StringDataArray::readH5Data(hid_t parentId)
 {
   int err = 0;
   this->resizeTuples(0);
-  std::vector<std::string> strings;
-  err = H5Lite::readVectorOfStringDataset(parentId, getName().toStdString(), strings);
+  clearPacked();
 
-  m_Array.resize(strings.size());
-  for(std::vector<QString>::size_type i = 0; i < strings.size(); i++)
+  // Read straight into the packed layout; the values are only converted to QString if someone asks for one
+  std::vector<char> buffer;
+  std::vector<size_t> offsets;
+  err = H5Lite::readPackedStringDataset(parentId, getName().toStdString(), buffer, offsets);
+  if(err < 0)
   {
-    m_Array[i] = QString::fromStdString(strings[i]);
+    return err;
   }
+  m_Array.clear();
+  m_PackedBuffer.swap(buffer);
+  m_PackedOffsets.swap(offsets);
+  m_IsPacked = true;
 #if 0
   IDataArray::Pointer p = H5DataArrayReader::ReadStringDataArray(parentId, getName());
   if (p.get() == nullptr)
@@ -523,6 +698,7 @@ int StringDataArray::readH5Data(hid_t parentId)
 // -----------------------------------------------------------------------------
 void StringDataArray::setValue(size_t i, const QString& value)
 {
+  unpack();
   m_Array[i] = value;
 }
 
@@ -531,5 +707,232 @@ void StringDataArray::setValue(size_t i, const QString& value)
 // -----------------------------------------------------------------------------
 QString StringDataArray::getValue(size_t i)
 {
+  // The QStrings are fully built before unpack() publishes them by clearing m_IsPacked
+  if(m_IsPacked.load(std::memory_order_acquire))
+  {
+    return packedView(i).toQString();
+  }
   return m_Array.at(i);
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StringDataArray::pack(bool dictionaryEncode)
+{
+  if(m_IsPacked)
+  {
+    if(m_IsDictionaryEncoded == dictionaryEncode)
+    {
+      return;
+    }
+    unpack();
+  }
+
+  std::lock_guard<std::mutex> lock(m_PackMutex);
+  std::vector<char> buffer;
+  std::vector<size_t> offsets(1, 0);
+  std::vector<int32_t> indices;
+  if(dictionaryEncode)
+  {
+    indices.resize(m_Array.size());
+  }
+  else
+  {
+    offsets.reserve(m_Array.size() + 1);
+  }
+
+  std::unordered_map<std::string, int32_t> dictionary;
+  for(size_t i = 0; i < m_Array.size(); i++)
+  {
+    QByteArray utf8 = m_Array[i].toUtf8();
+    if(dictionaryEncode)
+    {
+      std::string key(utf8.constData(), static_cast<size_t>(utf8.size()));
+      auto iter = dictionary.find(key);
+      if(iter != dictionary.end())
+      {
+        indices[i] = iter->second;
+        continue;
+      }
+      int32_t entry = static_cast<int32_t>(offsets.size() - 1);
+      dictionary.emplace(std::move(key), entry);
+      indices[i] = entry;
+    }
+    buffer.insert(buffer.end(), utf8.constData(), utf8.constData() + utf8.size());
+    buffer.push_back('\0');
+    offsets.push_back(buffer.size());
+  }
+
+  std::vector<QString>().swap(m_Array);
+  m_PackedBuffer.swap(buffer);
+  m_PackedOffsets.swap(offsets);
+  m_DictionaryIndices.swap(indices);
+  m_IsDictionaryEncoded = dictionaryEncode;
+  m_IsPacked.store(true, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StringDataArray::isPacked() const
+{
+  return m_IsPacked;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StringDataArray::isDictionaryEncoded() const
+{
+  return m_IsPacked && m_IsDictionaryEncoded;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t StringDataArray::getNumberOfUniqueValues()
+{
+  if(isDictionaryEncoded())
+  {
+    return m_PackedOffsets.size() - 1;
+  }
+  return getNumberOfTuples();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StringDataArray::Utf8View StringDataArray::getUtf8View(size_t i)
+{
+  if(!m_IsPacked.load(std::memory_order_acquire))
+  {
+    pack();
+  }
+  return packedView(i);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StringDataArray::Utf8View StringDataArray::packedView(size_t i) const
+{
+  size_t entry = m_IsDictionaryEncoded ? static_cast<size_t>(m_DictionaryIndices[i]) : i;
+  size_t start = m_PackedOffsets[entry];
+  return Utf8View(m_PackedBuffer.data() + start, m_PackedOffsets[entry + 1] - start - 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t StringDataArray::getNumberOfPackedTuples() const
+{
+  if(m_IsDictionaryEncoded)
+  {
+    return m_DictionaryIndices.size();
+  }
+  return m_PackedOffsets.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StringDataArray::resizePacked(size_t numTuples)
+{
+  size_t oldNumTuples = getNumberOfPackedTuples();
+  if(m_IsDictionaryEncoded)
+  {
+    if(numTuples > oldNumTuples)
+    {
+      // New tuples all point at a single empty dictionary entry
+      int32_t emptyEntry = static_cast<int32_t>(m_PackedOffsets.size() - 1);
+      m_PackedBuffer.push_back('\0');
+      m_PackedOffsets.push_back(m_PackedBuffer.size());
+      m_DictionaryIndices.resize(numTuples, emptyEntry);
+    }
+    else
+    {
+      m_DictionaryIndices.resize(numTuples);
+    }
+    return;
+  }
+
+  if(numTuples > oldNumTuples)
+  {
+    m_PackedBuffer.resize(m_PackedBuffer.size() + (numTuples - oldNumTuples), '\0');
+    m_PackedOffsets.reserve(numTuples + 1);
+    for(size_t i = oldNumTuples; i < numTuples; i++)
+    {
+      m_PackedOffsets.push_back(m_PackedOffsets.back() + 1);
+    }
+  }
+  else
+  {
+    m_PackedOffsets.resize(numTuples + 1);
+    m_PackedBuffer.resize(m_PackedOffsets.back());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StringDataArray::unpack()
+{
+  if(!m_IsPacked.load(std::memory_order_acquire))
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_PackMutex);
+  if(!m_IsPacked.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  // Each dictionary entry is converted once and then shared between the tuples that use it
+  size_t numEntries = m_PackedOffsets.size() - 1;
+  std::vector<QString> entries(numEntries);
+  for(size_t entry = 0; entry < numEntries; entry++)
+  {
+    size_t start = m_PackedOffsets[entry];
+    entries[entry] = QString::fromUtf8(m_PackedBuffer.data() + start, static_cast<int>(m_PackedOffsets[entry + 1] - start - 1));
+  }
+  if(m_IsDictionaryEncoded)
+  {
+    std::vector<QString> values(m_DictionaryIndices.size());
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      values[i] = entries[m_DictionaryIndices[i]];
+    }
+    m_Array.swap(values);
+  }
+  else
+  {
+    m_Array.swap(entries);
+  }
+  // getValue() readers on other threads may still be using the packed buffers, so they are only released by the
+  // next call that invalidates every Utf8View anyway
+  m_IsPacked.store(false, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StringDataArray::releaseStalePacked()
+{
+  if(!m_IsPacked.load(std::memory_order_acquire))
+  {
+    clearPacked();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StringDataArray::clearPacked()
+{
+  std::vector<char>().swap(m_PackedBuffer);
+  std::vector<size_t>().swap(m_PackedOffsets);
+  std::vector<int32_t>().swap(m_DictionaryIndices);
+  m_IsDictionaryEncoded = false;
+  m_IsPacked.store(false, std::memory_order_release);
+}
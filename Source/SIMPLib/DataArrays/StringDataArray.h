@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -67,6 +69,32 @@ class SIMPLib_EXPORT StringDataArray : public IDataArray
   // clang-format on
 
 public:
+  /**
+   * @brief The Utf8View class is a read-only view of a single UTF-8 encoded value in the packed storage. The
+   * pointed to bytes are always null terminated. A view stays valid until the array is resized, erased, cleared,
+   * read or packed again. It does not see values written after the array was converted back to QStrings.
+   */
+  class SIMPLib_EXPORT Utf8View
+  {
+  public:
+    Utf8View() = default;
+    Utf8View(const char* data, size_t size);
+
+    const char* data() const;
+    size_t size() const;
+    bool empty() const;
+
+    QString toQString() const;
+    std::string toStdString() const;
+
+    bool operator==(const Utf8View& other) const;
+    bool operator!=(const Utf8View& other) const;
+
+  private:
+    const char* m_Data = "";
+    size_t m_Size = 0;
+  };
+
   SIMPL_SHARED_POINTERS(StringDataArray)
   SIMPL_STATIC_NEW_MACRO(StringDataArray)
   SIMPL_TYPE_MACRO_SUPER_OVERRIDE(StringDataArray, IDataArray)
@@ -366,6 +394,40 @@ public:
    */
   QString getValue(size_t i);
 
+  /**
+   * @brief pack Converts the values into the packed layout: one buffer of null terminated UTF-8 strings plus an
+   * offsets array. When dictionaryEncode is true each distinct value is stored once and every tuple holds an index
+   * into that dictionary, which is much smaller for low-cardinality columns such as phase names.
+   * @param dictionaryEncode
+   */
+  void pack(bool dictionaryEncode = false);
+
+  /**
+   * @brief isPacked
+   * @return True if the values are held in the packed layout
+   */
+  bool isPacked() const;
+
+  /**
+   * @brief isDictionaryEncoded
+   * @return True if the values are held in the packed layout with dictionary encoding
+   */
+  bool isDictionaryEncoded() const;
+
+  /**
+   * @brief getNumberOfUniqueValues
+   * @return The number of dictionary entries when dictionary encoded, otherwise the number of tuples
+   */
+  size_t getNumberOfUniqueValues();
+
+  /**
+   * @brief getUtf8View Returns a view of the value without converting it to a QString. The array is packed
+   * first if it is not already.
+   * @param i
+   * @return
+   */
+  Utf8View getUtf8View(size_t i);
+
 protected:
   /**
    * @brief Protected Constructor
@@ -377,10 +439,53 @@ protected:
   StringDataArray();
 
 private:
+  /**
+   * @brief packedView Returns the view of tuple i. Only valid while the array is packed.
+   * @param i
+   * @return
+   */
+  Utf8View packedView(size_t i) const;
+
+  /**
+   * @brief getNumberOfPackedTuples Returns the number of tuples held in the packed layout
+   * @return
+   */
+  size_t getNumberOfPackedTuples() const;
+
+  /**
+   * @brief resizePacked Resizes the packed layout, appending empty values when growing
+   * @param numTuples
+   */
+  void resizePacked(size_t numTuples);
+
+  /**
+   * @brief unpack Converts the packed layout back into one QString per tuple. Called lazily by every method that
+   * needs to hand out or modify a QString in place. The packed buffers are kept for concurrent readers.
+   */
+  void unpack();
+
+  /**
+   * @brief releaseStalePacked Frees the packed buffers that unpack() left behind. Only call this from methods that
+   * invalidate every Utf8View anyway.
+   */
+  void releaseStalePacked();
+
+  /**
+   * @brief clearPacked Releases the packed buffers and switches back to the QString layout
+   */
+  void clearPacked();
+
   QString m_InitValue;
   std::vector<QString> m_Array;
   bool _ownsData;
 
+  std::atomic<bool> m_IsPacked = {false};
+  std::vector<char> m_PackedBuffer;
+  std::vector<size_t> m_PackedOffsets;
+  std::vector<int32_t> m_DictionaryIndices;
+  bool m_IsDictionaryEncoded = false;
+  std::mutex m_PackMutex;
+
 public:
   StringDataArray(const StringDataArray&) = delete;            // Copy Constructor Not Implemented
   StringDataArray(StringDataArray&&) = delete;                 // Move Constructor Not Implemented
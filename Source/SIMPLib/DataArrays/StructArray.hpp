@@ -577,6 +577,7 @@ class StructArray : public IDataArray
         size_t totalBytes = (getNumberOfTuples() * getNumberOfComponents() * sizeof(T));
         ::memcpy(dest, src, totalBytes);
       }
+      daCopy->copyWriteHints(*this);
       return daCopy;
     }
 
@@ -33,10 +33,15 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 #include <QtCore/QDir>
@@ -44,13 +49,22 @@
 #include <QtCore/QString>
 #include <QtCore/QVector>
 
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/DataArrayAllocator.h"
+#include "SIMPLib/DataArrays/DataArrayMemoryPool.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataArrays/PackedIntegerBlocks.hpp"
 #include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SIMPLib/Testing/SIMPLTestFileLocations.h"
 #include "SIMPLib/Testing/UnitTestSupport.hpp"
@@ -102,6 +116,57 @@ template <typename T> void print(const T& v)
 {
   std::cout << v << " ";
 }
+/**
+ * @brief The NeighborListReadersImpl class walks a flat NeighborList from several threads. Every fourth task uses a
+ * legacy accessor, which unpacks the lists while the other tasks are still reading the flat buffers they retained.
+ */
+template <typename T> class NeighborListReadersImpl
+{
+public:
+  NeighborListReadersImpl(NeighborList<T>* neiList, std::atomic<size_t>& mismatches)
+  : m_NeighborList(neiList)
+  , m_Mismatches(mismatches)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numLists = static_cast<size_t>(m_NeighborList->getNumberOfLists());
+    for(size_t task = range.min(); task < range.max(); task++)
+    {
+      if(task % 4 == 0)
+      {
+        typename NeighborList<T>::SharedVectorType list = m_NeighborList->getList(static_cast<int>(task % numLists));
+        if(list->size() != (task % numLists) % 7)
+        {
+          m_Mismatches++;
+        }
+        continue;
+      }
+      typename NeighborList<T>::FlatListsHandle flatLists = m_NeighborList->retainFlatLists();
+      for(size_t i = 0; i < numLists; i++)
+      {
+        typename NeighborList<T>::ConstListView view = m_NeighborList->getListView(i);
+        if(view.size() != i % 7)
+        {
+          m_Mismatches++;
+          continue;
+        }
+        for(size_t j = 0; j < view.size(); j++)
+        {
+          if(view[j] != static_cast<T>(j))
+          {
+            m_Mismatches++;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  NeighborList<T>* m_NeighborList;
+  std::atomic<size_t>& m_Mismatches;
+};
 //======================================================================================================================
 
 class DataArrayTest
@@ -369,6 +434,111 @@ public:
     TestEraseElementsForType<double>();
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestCompactTuplesForType()
+  {
+    // Large enough to take the parallel path. Every third tuple is removed.
+    const size_t numTuples = 300000;
+    std::vector<size_t> cDims = {2};
+    typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(numTuples, cDims, "Compact", true);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      array->setComponent(i, 0, static_cast<T>(i % 100));
+      array->setComponent(i, 1, static_cast<T>((i + 1) % 100));
+    }
+    std::vector<size_t> eraseElements;
+    for(size_t i = 0; i < numTuples; i += 3)
+    {
+      eraseElements.push_back(i);
+    }
+    DREAM3D_REQUIRE_EQUAL(array->eraseTuples(eraseElements), 0)
+    DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), numTuples - eraseElements.size())
+    DREAM3D_REQUIRE_EQUAL(array->getSize(), (numTuples - eraseElements.size()) * 2)
+    for(size_t i = 0; i < array->getNumberOfTuples(); i++)
+    {
+      size_t srcTuple = (i / 2) * 3 + 1 + (i % 2);
+      DREAM3D_REQUIRE_EQUAL(array->getComponent(i, 0), static_cast<T>(srcTuple % 100))
+      DREAM3D_REQUIRE_EQUAL(array->getComponent(i, 1), static_cast<T>((srcTuple + 1) % 100))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCompactTuples()
+  {
+    // Unsorted indices with duplicates become ascending runs
+    IDataArray::TupleRuns runs;
+    std::vector<size_t> idxs = {7, 2, 3, 2, 9};
+    DREAM3D_REQUIRE_EQUAL(IDataArray::EraseListToTupleRuns(idxs, 10, runs), 0)
+    DREAM3D_REQUIRE_EQUAL(runs.size(), 3)
+    DREAM3D_REQUIRE_EQUAL(runs[0].srcTuple, 0)
+    DREAM3D_REQUIRE_EQUAL(runs[0].numTuples, 2)
+    DREAM3D_REQUIRE_EQUAL(runs[1].srcTuple, 4)
+    DREAM3D_REQUIRE_EQUAL(runs[1].destTuple, 2)
+    DREAM3D_REQUIRE_EQUAL(runs[1].numTuples, 3)
+    DREAM3D_REQUIRE_EQUAL(runs[2].srcTuple, 8)
+    DREAM3D_REQUIRE_EQUAL(runs[2].destTuple, 5)
+    DREAM3D_REQUIRE_EQUAL(runs[2].numTuples, 1)
+    idxs = {10};
+    DREAM3D_REQUIRE_EQUAL(IDataArray::EraseListToTupleRuns(idxs, 10, runs), -100)
+
+    TestCompactTuplesForType<uint8_t>();
+    TestCompactTuplesForType<int32_t>();
+    TestCompactTuplesForType<double>();
+
+    // The same runs applied to every array of a feature matrix, along with the feature ids
+    const size_t numFeatures = 1000;
+    std::vector<size_t> tDims = {numFeatures};
+    std::vector<size_t> cDims = {1};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, "CellFeatureData", AttributeMatrix::Type::CellFeature);
+    Int32ArrayType::Pointer ids = Int32ArrayType::CreateArray(numFeatures, "Ids", true);
+    FloatArrayType::Pointer values = FloatArrayType::CreateArray(numFeatures, std::vector<size_t>(1, 3), "Values", true);
+    StringDataArray::Pointer names = StringDataArray::CreateArray(numFeatures, "Names", true);
+    NeighborList<int32_t>::Pointer neighbors = NeighborList<int32_t>::CreateArray(numFeatures, "Neighbors", true);
+    QVector<bool> activeObjects(static_cast<int>(numFeatures), true);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      ids->setValue(i, static_cast<int32_t>(i));
+      values->setComponent(i, 2, static_cast<float>(i));
+      names->setValue(i, QString::number(i));
+      activeObjects[static_cast<int>(i)] = (i % 4 != 1);
+    }
+    am->addOrReplaceAttributeArray(ids);
+    am->addOrReplaceAttributeArray(values);
+    am->addOrReplaceAttributeArray(names);
+    am->addOrReplaceAttributeArray(neighbors);
+
+    const size_t numCells = 5000;
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(numCells, "FeatureIds", true);
+    for(size_t i = 0; i < numCells; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i % numFeatures));
+    }
+
+    DREAM3D_REQUIRE_EQUAL(am->removeInactiveObjects(activeObjects, featureIds.get()), true)
+    const size_t numKept = numFeatures - numFeatures / 4;
+    DREAM3D_REQUIRE_EQUAL(am->getNumberOfTuples(), numKept)
+    DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Neighbors"), false)
+    DREAM3D_REQUIRE_EQUAL(ids->getNumberOfTuples(), numKept)
+    DREAM3D_REQUIRE_EQUAL(names->getNumberOfTuples(), numKept)
+    for(size_t i = 0; i < numCells; i++)
+    {
+      size_t oldId = i % numFeatures;
+      int32_t newId = featureIds->getValue(i);
+      if(oldId % 4 == 1)
+      {
+        DREAM3D_REQUIRE_EQUAL(newId, 0)
+        continue;
+      }
+      DREAM3D_REQUIRE_EQUAL(ids->getValue(newId), static_cast<int32_t>(oldId))
+      DREAM3D_REQUIRE_EQUAL(values->getComponent(newId, 2), static_cast<float>(oldId))
+      DREAM3D_REQUIRE_EQUAL(names->getValue(newId), QString::number(oldId))
+    }
+  }
+
   template <typename T> QString TypeToString(T v)
   {
 
@@ -655,6 +825,144 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void ValidateFlatNeighborList(typename NeighborList<T>::Pointer neiList, const std::vector<int>& listIds)
+  {
+    DREAM3D_REQUIRE_EQUAL(neiList->getNumberOfLists(), static_cast<int>(listIds.size()))
+    DREAM3D_REQUIRE_EQUAL(neiList->getNumberOfTuples(), listIds.size())
+    size_t total = 0;
+    for(size_t i = 0; i < listIds.size(); ++i)
+    {
+      int id = listIds[i];
+      typename NeighborList<T>::ConstListView view = neiList->getListView(i);
+      DREAM3D_REQUIRE_EQUAL(view.size(), static_cast<size_t>(id % 4))
+      DREAM3D_REQUIRE_EQUAL(neiList->getListSize(static_cast<int>(i)), id % 4)
+      for(size_t j = 0; j < view.size(); ++j)
+      {
+        DREAM3D_REQUIRE_EQUAL(view[j], static_cast<T>(id + j))
+      }
+      total += view.size();
+    }
+    DREAM3D_REQUIRE_EQUAL(neiList->getSize(), total)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestNeighborListFlatForType()
+  {
+    // List i holds (i % 4) values; the empty lists make sure zero length rows are handled
+    const int numLists = 10;
+    typename NeighborList<T>::FlatListBuilder builder(numLists);
+    std::vector<int> listIds(numLists);
+    for(int i = 0; i < numLists; ++i)
+    {
+      for(int j = 0; j < i % 4; ++j)
+      {
+        builder.appendValue(static_cast<T>(i + j));
+      }
+      builder.finishList();
+      listIds[i] = i;
+    }
+    DREAM3D_REQUIRE_EQUAL(builder.getNumberOfLists(), static_cast<size_t>(numLists))
+
+    typename NeighborList<T>::Pointer neiList = NeighborList<T>::CreateArray(0, "FlatNeighborList", false);
+    neiList->setFlatLists(builder);
+    DREAM3D_REQUIRE_EQUAL(neiList->isFlat(), true)
+    DREAM3D_REQUIRE_EQUAL(builder.getNumberOfLists(), static_cast<size_t>(0))
+    ValidateFlatNeighborList<T>(neiList, listIds);
+
+    bool ok = true;
+    DREAM3D_REQUIRE_EQUAL(neiList->getValue(3, 2, ok), static_cast<T>(5))
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    neiList->getValue(4, 0, ok);
+    DREAM3D_REQUIRE_EQUAL(ok, false)
+
+    // The deep copy keeps the flat layout and is independent of the original
+    typename NeighborList<T>::Pointer copy = std::dynamic_pointer_cast<NeighborList<T>>(neiList->deepCopy());
+    DREAM3D_REQUIRE_EQUAL(copy->isFlat(), true)
+    ValidateFlatNeighborList<T>(copy, listIds);
+    DREAM3D_REQUIRED(copy->getListView(1).data(), !=, neiList->getListView(1).data())
+
+    // Write and read back through HDF5 without leaving the flat layout
+    hid_t fileId = QH5Utilities::createFile(UnitTest::DataArrayTest::TestFile);
+    DREAM3D_REQUIRE(fileId > 0)
+    std::vector<size_t> tDims = {static_cast<size_t>(numLists)};
+    DREAM3D_REQUIRE(neiList->writeH5Data(fileId, tDims) >= 0)
+    typename NeighborList<T>::Pointer readList = NeighborList<T>::CreateArray(0, "FlatNeighborList", false);
+    DREAM3D_REQUIRE(readList->readH5Data(fileId) >= 0)
+    QH5Utilities::closeFile(fileId);
+    DREAM3D_REQUIRE_EQUAL(readList->isFlat(), true)
+    ValidateFlatNeighborList<T>(readList, listIds);
+
+    // Erasing compacts the flat buffers in place
+    std::vector<size_t> eraseElements = {1, 3, 4};
+    DREAM3D_REQUIRE_EQUAL(neiList->eraseTuples(eraseElements), 0)
+    listIds = {0, 2, 5, 6, 7, 8, 9};
+    DREAM3D_REQUIRE_EQUAL(neiList->isFlat(), true)
+    ValidateFlatNeighborList<T>(neiList, listIds);
+
+    // Growing appends empty lists, shrinking drops lists off the end
+    neiList->resizeTuples(9);
+    DREAM3D_REQUIRE_EQUAL(neiList->getListSize(8), 0)
+    neiList->resizeTuples(3);
+    listIds = {0, 2, 5};
+    ValidateFlatNeighborList<T>(neiList, listIds);
+
+    // The legacy mutable accessors unpack the lists, keep the values and free the flat buffers
+    typename NeighborList<T>::FlatListsHandle flatLists = neiList->retainFlatLists();
+    DREAM3D_REQUIRE(nullptr != flatLists.get())
+    typename NeighborList<T>::SharedVectorType list = neiList->getList(2);
+    DREAM3D_REQUIRE_EQUAL(neiList->isFlat(), false)
+    DREAM3D_REQUIRE(nullptr == neiList->retainFlatLists().get())
+    DREAM3D_REQUIRE_EQUAL(flatLists.use_count(), 1)
+    flatLists.reset();
+    DREAM3D_REQUIRE_EQUAL(list->size(), static_cast<size_t>(1))
+    DREAM3D_REQUIRE_EQUAL(list->at(0), static_cast<T>(5))
+    neiList->addEntry(2, static_cast<T>(6));
+    DREAM3D_REQUIRE_EQUAL(neiList->getListSize(2), 2)
+
+    // Packing an unpacked list returns it to the flat layout
+    neiList->packLists();
+    DREAM3D_REQUIRE_EQUAL(neiList->isFlat(), true)
+    DREAM3D_REQUIRE_EQUAL(neiList->getNumberOfLists(), 3)
+    DREAM3D_REQUIRE_EQUAL(neiList->getValue(2, 1, ok), static_cast<T>(6))
+    DREAM3D_REQUIRE_EQUAL(copy->getListSize(2), 2)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestNeighborListConcurrentReadsForType()
+  {
+    const size_t numLists = 2000;
+    size_t totalValues = 0;
+    typename NeighborList<T>::FlatListBuilder builder(numLists);
+    for(size_t i = 0; i < numLists; ++i)
+    {
+      totalValues += i % 7;
+      for(size_t j = 0; j < i % 7; ++j)
+      {
+        builder.appendValue(static_cast<T>(j));
+      }
+      builder.finishList();
+    }
+    typename NeighborList<T>::Pointer neiList = NeighborList<T>::CreateArray(0, "ConcurrentNeighborList", false);
+    neiList->setFlatLists(builder);
+    DREAM3D_REQUIRE_EQUAL(neiList->isFlat(), true)
+
+    // Views and legacy accessors may be mixed between threads while the lists are unpacked underneath them
+    std::atomic<size_t> mismatches(0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, 64);
+    dataAlg.execute(NeighborListReadersImpl<T>(neiList.get(), mismatches));
+    DREAM3D_REQUIRE_EQUAL(mismatches.load(), 0)
+    DREAM3D_REQUIRE_EQUAL(neiList->isFlat(), false)
+    DREAM3D_REQUIRE_EQUAL(neiList->getSize(), totalValues)
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -672,6 +980,16 @@ public:
     TestNeighborListForType<double>();
 
     TestNeighborListDeepCopyForType<int8_t>();
+
+    TestNeighborListFlatForType<int8_t>();
+    TestNeighborListFlatForType<uint16_t>();
+    TestNeighborListFlatForType<int32_t>();
+    TestNeighborListFlatForType<int64_t>();
+    TestNeighborListFlatForType<float>();
+    TestNeighborListFlatForType<double>();
+
+    TestNeighborListConcurrentReadsForType<int32_t>();
+    TestNeighborListConcurrentReadsForType<float>();
   }
 
   // -----------------------------------------------------------------------------
@@ -995,6 +1313,107 @@ true);
     TestDeepCopyDataArrayForType<int64_t>();
     TestDeepCopyDataArrayForType<float>();
     TestDeepCopyDataArrayForType<double>();
+
+    // Write hints travel with every kind of copy
+    H5DatasetCreationOptions hints;
+    hints.chunked = true;
+    hints.deflateLevel = 7;
+    FloatArrayType::Pointer floats = FloatArrayType::CreateArray(10, "Floats", true);
+    floats->setWriteHints(hints);
+    IDataArray::Pointer floatsCopy = floats->deepCopy();
+    DREAM3D_REQUIRE_EQUAL(floatsCopy->hasWriteHints(), true)
+    DREAM3D_REQUIRE_EQUAL(floatsCopy->getWriteHints().deflateLevel, 7)
+    DREAM3D_REQUIRE_EQUAL(floats->createSharedCopy()->getWriteHints().deflateLevel, 7)
+    DREAM3D_REQUIRE_EQUAL(floats->deepCopy(true)->hasWriteHints(), true)
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(10, "Strings", true);
+    strings->setWriteHints(hints);
+    DREAM3D_REQUIRE_EQUAL(strings->deepCopy()->getWriteHints().chunked, true)
+    NeighborList<int32_t>::Pointer neighbors = NeighborList<int32_t>::CreateArray(10, "Neighbors", true);
+    neighbors->setWriteHints(hints);
+    DREAM3D_REQUIRE_EQUAL(neighbors->deepCopy()->hasWriteHints(), true)
+    floats->clearWriteHints();
+    DREAM3D_REQUIRE_EQUAL(floats->deepCopy()->hasWriteHints(), false)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestCopyOnWriteForType()
+  {
+    size_t numTuples = 10;
+    std::vector<size_t> cDims(1, 5);
+    typename DataArray<T>::Pointer src = DataArray<T>::CreateArray(numTuples, cDims, "Source Array", true);
+    for(size_t i = 0; i < src->getSize(); i++)
+    {
+      src->setValue(i, static_cast<T>(i));
+    }
+
+    // deepCopy() always duplicates the values, so pointers taken before the copy stay private to the source
+    T* cached = src->getPointer(0);
+    typename DataArray<T>::Pointer eager = std::dynamic_pointer_cast<DataArray<T>>(src->deepCopy());
+    DREAM3D_REQUIRE(eager->isSharingData() == false)
+    DREAM3D_REQUIRE(eager->getConstPointer(0) != cached)
+    cached[7] = static_cast<T>(42);
+    DREAM3D_REQUIRE_EQUAL(eager->getValue(7), static_cast<T>(7))
+    cached[7] = static_cast<T>(7);
+
+    // The shared copy references the same memory until it is written to
+    typename DataArray<T>::Pointer copy = std::dynamic_pointer_cast<DataArray<T>>(src->createSharedCopy());
+    DREAM3D_REQUIRE(copy->isSharingData())
+    DREAM3D_REQUIRE(src->isSharingData())
+    DREAM3D_REQUIRE(copy->getConstPointer(0) == src->getConstPointer(0))
+    DREAM3D_REQUIRE_EQUAL(copy->getValue(7), static_cast<T>(7))
+
+    // The element accessors do not check for shared memory, so element writes start with prepareForWrite()
+    DREAM3D_REQUIRE(copy->prepareForWrite())
+    DREAM3D_REQUIRE(src->isSharingData() == false)
+    copy->setValue(7, static_cast<T>(99));
+    DREAM3D_REQUIRE(copy->isSharingData() == false)
+    DREAM3D_REQUIRE(copy->getConstPointer(0) != src->getConstPointer(0))
+    DREAM3D_REQUIRE_EQUAL(copy->getValue(7), static_cast<T>(99))
+    DREAM3D_REQUIRE_EQUAL(src->getValue(7), static_cast<T>(7))
+    DREAM3D_REQUIRE_EQUAL(copy->getValue(8), static_cast<T>(8))
+
+    // Once the last copy is gone the original takes its memory back without copying
+    copy = std::dynamic_pointer_cast<DataArray<T>>(src->createSharedCopy());
+    const T* shared = src->getConstPointer(0);
+    copy = typename DataArray<T>::Pointer();
+    DREAM3D_REQUIRE(src->getPointer(0) == shared)
+
+    // Resizing a shared array must not touch the other array
+    copy = std::dynamic_pointer_cast<DataArray<T>>(src->createSharedCopy());
+    copy->resizeTuples(numTuples * 2);
+    DREAM3D_REQUIRE_EQUAL(src->getNumberOfTuples(), numTuples)
+    DREAM3D_REQUIRE_EQUAL(copy->getValue(src->getSize() - 1), src->getValue(src->getSize() - 1))
+
+    // Erasing from a shared array
+    copy = std::dynamic_pointer_cast<DataArray<T>>(src->createSharedCopy());
+    std::vector<size_t> idxs = {1, 3};
+    DREAM3D_REQUIRE_EQUAL(copy->eraseTuples(idxs), 0)
+    DREAM3D_REQUIRE_EQUAL(src->getNumberOfTuples(), numTuples)
+    DREAM3D_REQUIRE_EQUAL(src->getValue(5), static_cast<T>(5))
+
+    // Ownership transfers must hand out exclusive memory
+    copy = std::dynamic_pointer_cast<DataArray<T>>(src->createSharedCopy());
+    T* ptr = copy->getPointer(0);
+    copy->releaseOwnership();
+    typename DataArray<T>::Pointer wrapped = DataArray<T>::WrapPointer(ptr, numTuples, cDims, "Wrapped", true);
+    copy = typename DataArray<T>::Pointer();
+    wrapped = typename DataArray<T>::Pointer();
+    DREAM3D_REQUIRE_EQUAL(src->getValue(5), static_cast<T>(5))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCopyOnWrite()
+  {
+    TestCopyOnWriteForType<uint8_t>();
+    TestCopyOnWriteForType<int16_t>();
+    TestCopyOnWriteForType<int32_t>();
+    TestCopyOnWriteForType<int64_t>();
+    TestCopyOnWriteForType<float>();
+    TestCopyOnWriteForType<double>();
   }
 
   // -----------------------------------------------------------------------------
@@ -1389,6 +1808,592 @@ true);
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestStorageTypeForType(DataArrayAllocator::StorageType storageType)
+  {
+    std::vector<size_t> cDims = {3};
+    typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(TEST_SIZE, cDims, "Storage Array", false);
+    array->setStorageType(storageType);
+    DREAM3D_REQUIRE_EQUAL(array->allocate(), 1)
+    DREAM3D_REQUIRE_VALID_POINTER(array->getPointer(0))
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(array->getPointer(0)) % DataArrayAllocator::Alignment, 0)
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      array->setValue(i, static_cast<T>(i % 100));
+    }
+
+    // Growing must keep the existing values and initialize the new tuples
+    array->setInitValue(static_cast<T>(7));
+    array->resizeTuples(TEST_SIZE * 4);
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<uintptr_t>(array->getPointer(0)) % DataArrayAllocator::Alignment, 0)
+    for(size_t i = 0; i < TEST_SIZE * 3; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(array->getValue(i), static_cast<T>(i % 100))
+    }
+    DREAM3D_REQUIRE_EQUAL(array->getValue(TEST_SIZE * 3), static_cast<T>(7))
+
+    // Shrinking and erasing go through the same allocator. eraseTuples() does not update the tuple count.
+    array->resizeTuples(TEST_SIZE);
+    std::vector<size_t> idxs = {0, 5, TEST_SIZE - 1};
+    DREAM3D_REQUIRE_EQUAL(array->eraseTuples(idxs), 0)
+    DREAM3D_REQUIRE_EQUAL(array->getSize(), (TEST_SIZE - 3) * 3)
+    DREAM3D_REQUIRE_EQUAL(array->getValue(0), static_cast<T>(3 % 100))
+
+    // The memory must still be released correctly after an ownership transfer
+    T* ptr = array->getPointer(0);
+    array->releaseOwnership();
+    typename DataArray<T>::Pointer wrapped = DataArray<T>::WrapPointer(ptr, TEST_SIZE - 3, cDims, "Wrapped Storage", true);
+    DREAM3D_REQUIRE(wrapped->getAllocatedStorageType() == array->getAllocatedStorageType())
+    array = typename DataArray<T>::Pointer();
+    wrapped->resizeTuples(TEST_SIZE * 2);
+    DREAM3D_REQUIRE_EQUAL(wrapped->getValue(0), static_cast<T>(3 % 100))
+
+    // Migrate the values into heap memory
+    DREAM3D_REQUIRE(wrapped->setStorageType(DataArrayAllocator::StorageType::Heap) == 1)
+    DREAM3D_REQUIRE(wrapped->getAllocatedStorageType() == DataArrayAllocator::StorageType::Heap)
+    DREAM3D_REQUIRE_EQUAL(wrapped->getValue(0), static_cast<T>(3 % 100))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestStorageType()
+  {
+    QVector<DataArrayAllocator::StorageType> storageTypes = {DataArrayAllocator::StorageType::Heap, DataArrayAllocator::StorageType::FileMapped, DataArrayAllocator::StorageType::AnonymousMapped};
+    for(const auto& storageType : storageTypes)
+    {
+      TestStorageTypeForType<uint8_t>(storageType);
+      TestStorageTypeForType<int32_t>(storageType);
+      TestStorageTypeForType<int64_t>(storageType);
+      TestStorageTypeForType<float>(storageType);
+      TestStorageTypeForType<double>(storageType);
+    }
+
+    // The global policy only applies to arrays that do not request a storage type
+    DataArrayAllocator::MemoryPolicy savedPolicy = DataArrayAllocator::GetMemoryPolicy();
+    DataArrayAllocator::MemoryPolicy policy;
+    policy.storageType = DataArrayAllocator::StorageType::AnonymousMapped;
+    policy.mappedThreshold = 1024 * sizeof(float);
+    DataArrayAllocator::SetMemoryPolicy(policy);
+
+    FloatArrayType::Pointer small = FloatArrayType::CreateArray(16, "Small", true);
+    DREAM3D_REQUIRE(small->getAllocatedStorageType() == DataArrayAllocator::StorageType::Heap)
+    FloatArrayType::Pointer large = FloatArrayType::CreateArray(4096, "Large", true);
+    DREAM3D_REQUIRE(large->getAllocatedStorageType() == DataArrayAllocator::ResolveStorageType(DataArrayAllocator::StorageType::AnonymousMapped, 4096 * sizeof(float)))
+    large->initializeWithValue(1.0f);
+    DREAM3D_REQUIRE_EQUAL(large->getValue(4095), 1.0f)
+
+    DataArrayAllocator::SetMemoryPolicy(savedPolicy);
+
+    bool ok = false;
+    DREAM3D_REQUIRE(DataArrayAllocator::StorageTypeFromString(DataArrayAllocator::StorageTypeToString(DataArrayAllocator::StorageType::FileMapped), ok) == DataArrayAllocator::StorageType::FileMapped)
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+    DataArrayAllocator::StorageTypeFromString("Bogus", ok);
+    DREAM3D_REQUIRE_EQUAL(ok, false)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestInitializationForType()
+  {
+    // Large enough to take the parallel path
+    const size_t numTuples = 1000000;
+    std::vector<size_t> cDims = {3};
+    typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(numTuples, cDims, "Initialized", true);
+    DREAM3D_REQUIRE_VALID_POINTER(array->getPointer(0))
+    DREAM3D_REQUIRE_EQUAL(array->getSize(), numTuples * 3)
+
+    array->initializeWithZeros();
+    DREAM3D_REQUIRE_EQUAL(std::count(array->getPointer(0), array->getPointer(0) + array->getSize(), static_cast<T>(0)), static_cast<std::ptrdiff_t>(numTuples * 3))
+
+    array->initializeWithValue(static_cast<T>(5), numTuples);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(numTuples - 1), static_cast<T>(0))
+    DREAM3D_REQUIRE_EQUAL(std::count(array->getPointer(0), array->getPointer(0) + array->getSize(), static_cast<T>(5)), static_cast<std::ptrdiff_t>(numTuples * 2))
+
+    // Growing initializes only the new tuples
+    array->setInitValue(static_cast<T>(9));
+    array->resizeTuples(numTuples * 2);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(numTuples * 3 - 1), static_cast<T>(5))
+    DREAM3D_REQUIRE_EQUAL(std::count(array->getPointer(0), array->getPointer(0) + array->getSize(), static_cast<T>(9)), static_cast<std::ptrdiff_t>(numTuples * 3))
+
+    // Filling a copy-on-write copy leaves the original alone
+    typename DataArray<T>::Pointer copy = std::dynamic_pointer_cast<DataArray<T>>(array->createSharedCopy());
+    copy->initializeWithZeros();
+    DREAM3D_REQUIRE_EQUAL(array->getValue(0), static_cast<T>(0))
+    DREAM3D_REQUIRE_EQUAL(array->getValue(numTuples * 3), static_cast<T>(9))
+    DREAM3D_REQUIRE_EQUAL(copy->getValue(numTuples * 3), static_cast<T>(0))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestInitialization()
+  {
+    TestInitializationForType<uint8_t>();
+    TestInitializationForType<int32_t>();
+    TestInitializationForType<float>();
+    TestInitializationForType<double>();
+
+    std::vector<size_t> tDims = {100000};
+    std::vector<size_t> cDims = {1};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, "AttributeMatrix", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer initialized = am->createNonPrereqArray<Int32ArrayType, AbstractFilter, int32_t>(nullptr, "Initialized", 3, cDims);
+    DREAM3D_REQUIRE_VALID_POINTER(initialized.get())
+    DREAM3D_REQUIRE_EQUAL(std::count(initialized->getPointer(0), initialized->getPointer(0) + initialized->getSize(), 3), 100000)
+
+    DREAM3D_REQUIRE_EQUAL(DataArrayAllocator::IsInitializationSkipped(), false)
+    {
+      DataArrayAllocator::ScopedSkipInitialization skipInit;
+      DREAM3D_REQUIRE_EQUAL(DataArrayAllocator::IsInitializationSkipped(), true)
+      Int32ArrayType::Pointer uninitialized = am->createNonPrereqArray<Int32ArrayType, AbstractFilter, int32_t>(nullptr, "Uninitialized", 3, cDims);
+      DREAM3D_REQUIRE_VALID_POINTER(uninitialized.get())
+      DREAM3D_REQUIRE_VALID_POINTER(uninitialized->getPointer(0))
+      DREAM3D_REQUIRE_EQUAL(uninitialized->getNumberOfTuples(), 100000)
+      // The init value is still recorded for later resizes
+      uninitialized->resizeTuples(100001);
+      DREAM3D_REQUIRE_EQUAL(uninitialized->getValue(100000), 3)
+    }
+    DREAM3D_REQUIRE_EQUAL(DataArrayAllocator::IsInitializationSkipped(), false)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestStatisticsForType(size_t numTuples)
+  {
+    std::vector<size_t> cDims = {2};
+    typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(numTuples, cDims, "Statistics", true);
+    double sum0 = 0.0;
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      array->setComponent(i, 0, static_cast<T>(i % 100));
+      array->setComponent(i, 1, static_cast<T>(7));
+      sum0 += static_cast<double>(i % 100);
+    }
+
+    std::vector<IDataArray::ComponentStatistics> stats = array->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats.size(), 2)
+    DREAM3D_REQUIRE_EQUAL(stats[0].min, 0.0)
+    DREAM3D_REQUIRE_EQUAL(stats[0].max, 99.0)
+    DREAM3D_REQUIRE_EQUAL(stats[0].sum, sum0)
+    DREAM3D_REQUIRE_EQUAL(stats[0].count, numTuples)
+    DREAM3D_REQUIRE_EQUAL(stats[0].nanCount, 0)
+    DREAM3D_REQUIRE_EQUAL(stats[1].min, 7.0)
+    DREAM3D_REQUIRE_EQUAL(stats[1].max, 7.0)
+    DREAM3D_REQUIRE_EQUAL(stats[1].mean(), 7.0)
+
+    // Preparing the array for element writes drops the cached result
+    array->prepareForWrite();
+    array->setComponent(numTuples / 2, 1, static_cast<T>(9));
+    stats = array->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats[1].max, 9.0)
+
+    // Writes through a raw pointer that was handed out before the statistics were computed are still seen
+    T* values = array->getPointer(0);
+    stats = array->getComponentStatistics();
+    values[1] = static_cast<T>(50);
+    stats = array->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats[1].max, 50.0)
+
+    // The info string only reports a range that is already known
+    typename DataArray<T>::Pointer fresh = DataArray<T>::CreateArray(numTuples, cDims, "Fresh", true);
+    fresh->initializeWithValue(static_cast<T>(3));
+    DREAM3D_REQUIRE_EQUAL(fresh->getInfoString(SIMPL::HtmlFormat).contains("Value Range"), false)
+    fresh->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(fresh->getInfoString(SIMPL::HtmlFormat).contains("Value Range"), true)
+
+    // Ten bins of width 10 over component 0, values outside the range are not counted
+    std::vector<size_t> histogram = array->computeHistogram(0, 10, 0.0, 99.0);
+    DREAM3D_REQUIRE_EQUAL(histogram.size(), 10)
+    DREAM3D_REQUIRE_EQUAL(std::accumulate(histogram.begin(), histogram.end(), static_cast<size_t>(0)), numTuples)
+    histogram = array->computeHistogram(0, 2, 0.0, 49.0);
+    DREAM3D_REQUIRE_EQUAL(histogram[0] + histogram[1], numTuples / 2)
+    DREAM3D_REQUIRE_EQUAL(array->computeHistogram(2, 10, 0.0, 1.0).size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestStatistics()
+  {
+    // Both the serial and the parallel block layout
+    TestStatisticsForType<uint8_t>(1000);
+    TestStatisticsForType<int32_t>(500000);
+    TestStatisticsForType<int64_t>(1000);
+    TestStatisticsForType<float>(500000);
+    TestStatisticsForType<double>(1000);
+
+    // NaN values are counted but do not take part in the range
+    FloatArrayType::Pointer floats = FloatArrayType::CreateArray(300000, "Floats", true);
+    floats->initializeWithValue(1.0f);
+    floats->setValue(10, std::numeric_limits<float>::quiet_NaN());
+    floats->setValue(200000, -3.0f);
+    std::vector<IDataArray::ComponentStatistics> stats = floats->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats[0].nanCount, 1)
+    DREAM3D_REQUIRE_EQUAL(stats[0].count, 299999)
+    DREAM3D_REQUIRE_EQUAL(stats[0].min, -3.0)
+    DREAM3D_REQUIRE_EQUAL(stats[0].max, 1.0)
+    std::vector<size_t> histogram = floats->computeHistogram(0, 4, -3.0, 1.0);
+    DREAM3D_REQUIRE_EQUAL(histogram[0], 1)
+    DREAM3D_REQUIRE_EQUAL(histogram[3], 299998)
+
+    // Copies and unallocated arrays
+    FloatArrayType::Pointer copy = std::dynamic_pointer_cast<FloatArrayType>(floats->deepCopy());
+    DREAM3D_REQUIRE_EQUAL(copy->getComponentStatistics()[0].min, -3.0)
+    FloatArrayType::Pointer empty = FloatArrayType::CreateArray(10, "Empty", false);
+    DREAM3D_REQUIRE_EQUAL(empty->getComponentStatistics().size(), 0)
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(10, "Strings", true);
+    DREAM3D_REQUIRE_EQUAL(strings->getComponentStatistics().size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestCompressionForType(size_t numTuples, int numComps)
+  {
+    // Long runs of a few labels with the extremes of the type mixed in
+    typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(numTuples, {static_cast<size_t>(numComps)}, "Labels", true);
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      array->setValue(i, static_cast<T>((i / 5000) % 7));
+    }
+    array->setValue(3, std::numeric_limits<T>::lowest());
+    array->setValue(array->getSize() - 1, std::numeric_limits<T>::max());
+    std::vector<T> expected(array->getPointer(0), array->getPointer(0) + array->getSize());
+
+    DREAM3D_REQUIRE_EQUAL(array->compress(), true)
+    DREAM3D_REQUIRE_EQUAL(array->isCompressed(), true)
+    DREAM3D_REQUIRE(array->getCompressedByteSize() < array->getSize() * sizeof(T))
+
+    // Blocks and statistics are read without decompressing the array
+    size_t numValues = 0;
+    for(auto iter = array->getBlockIterator(); iter.isValid(); ++iter)
+    {
+      DREAM3D_REQUIRE_EQUAL(iter.getOffset(), numValues)
+      DREAM3D_REQUIRE(std::equal(iter.data(), iter.data() + iter.size(), expected.begin() + iter.getOffset()))
+      numValues += iter.size();
+    }
+    DREAM3D_REQUIRE_EQUAL(numValues, expected.size())
+    std::vector<IDataArray::ComponentStatistics> stats = array->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats.size(), numComps)
+    DREAM3D_REQUIRE_EQUAL(stats[3 % numComps].min, static_cast<double>(std::numeric_limits<T>::lowest()))
+    DREAM3D_REQUIRE_EQUAL(stats[(expected.size() - 1) % numComps].max, static_cast<double>(std::numeric_limits<T>::max()))
+    DREAM3D_REQUIRE_EQUAL(array->isCompressed(), true)
+
+    // Copies share the compressed values
+    typename DataArray<T>::Pointer copy = std::dynamic_pointer_cast<DataArray<T>>(array->deepCopy());
+    DREAM3D_REQUIRE_EQUAL(copy->isCompressed(), true)
+
+    // Single values are decoded in place, acquiring a pointer decompresses
+    DREAM3D_REQUIRE_EQUAL(array->getValue(3), std::numeric_limits<T>::lowest())
+    DREAM3D_REQUIRE_EQUAL(array->getComponent(expected.size() / numComps - 1, numComps - 1), std::numeric_limits<T>::max())
+    DREAM3D_REQUIRE_EQUAL(array->isCompressed(), true)
+    DREAM3D_REQUIRE(std::equal(expected.begin(), expected.end(), array->getConstPointer(0)))
+    DREAM3D_REQUIRE_EQUAL(array->isCompressed(), false)
+    copy->setValue(0, static_cast<T>(1));
+    DREAM3D_REQUIRE_EQUAL(copy->isCompressed(), false)
+    DREAM3D_REQUIRE(std::equal(expected.begin() + 1, expected.end(), copy->getConstPointer(1)))
+    DREAM3D_REQUIRE_EQUAL(array->getValue(0), expected[0])
+
+    // Resizing and reallocating a compressed array
+    DREAM3D_REQUIRE_EQUAL(array->compress(), true)
+    array->resizeTuples(numTuples + 10);
+    DREAM3D_REQUIRE_EQUAL(array->isCompressed(), false)
+    DREAM3D_REQUIRE(std::equal(expected.begin(), expected.end(), array->getConstPointer(0)))
+    DREAM3D_REQUIRE_EQUAL(array->compress(), true)
+    array->resizeTuples(0);
+    DREAM3D_REQUIRE_EQUAL(array->isCompressed(), false)
+    DREAM3D_REQUIRE_EQUAL(array->isAllocated(), false)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCompression()
+  {
+    TestCompressionForType<int8_t>(100000, 1);
+    TestCompressionForType<uint16_t>(30000, 3);
+    TestCompressionForType<int32_t>(500000, 1);
+    TestCompressionForType<uint64_t>(20000, 2);
+    TestCompressionForType<int64_t>(20000, 1);
+
+    // Every bit width round trips, including values that straddle words
+    std::vector<int64_t> values(3 * PackedIntegerBlocks<int64_t>::k_BlockSize + 17);
+    uint64_t state = 12345;
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      int bits = static_cast<int>(i / 50 % 64);
+      values[i] = static_cast<int64_t>(state >> (63 - bits)) - 7;
+    }
+    PackedIntegerBlocks<int64_t> packed;
+    packed.encode(values.data(), values.size());
+    std::vector<int64_t> decoded(values.size());
+    packed.decode(decoded.data());
+    DREAM3D_REQUIRE(decoded == values)
+    DREAM3D_REQUIRE_EQUAL(packed.getValue(values.size() - 1), values.back())
+
+    // Arrays that would not shrink, floating point arrays and wrapped pointers stay as they are
+    Int64ArrayType::Pointer noise = Int64ArrayType::CreateArray(values.size(), "Noise", true);
+    std::copy(values.begin(), values.end(), noise->getPointer(0));
+    noise->setValue(0, std::numeric_limits<int64_t>::lowest());
+    noise->setValue(1, std::numeric_limits<int64_t>::max());
+    DREAM3D_REQUIRE_EQUAL(noise->compress(), false)
+    FloatArrayType::Pointer floats = FloatArrayType::CreateArray(10000, "Floats", true);
+    floats->initializeWithZeros();
+    DREAM3D_REQUIRE_EQUAL(floats->compress(), false)
+    std::vector<int32_t> external(10000, 1);
+    Int32ArrayType::Pointer wrapped = Int32ArrayType::WrapPointer(external.data(), external.size(), {1}, "Wrapped", false);
+    DREAM3D_REQUIRE_EQUAL(wrapped->compress(), false)
+
+    // A mask compresses to one header per block
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(100000, "Mask", true);
+    mask->initializeWithValue(true);
+    DREAM3D_REQUIRE_EQUAL(mask->compress(), true)
+    DREAM3D_REQUIRE(mask->getCompressedByteSize() < 1000)
+    DREAM3D_REQUIRE_EQUAL(mask->getValue(99999), true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDeferredLoading()
+  {
+    int numLoads = 0;
+    Int32ArrayType::Pointer array = Int32ArrayType::CreateArray(1000, {2}, "Deferred", false);
+    array->setDeferredLoader([&numLoads](int32_t* values) {
+      numLoads++;
+      std::iota(values, values + 2000, 0);
+      return true;
+    });
+    DREAM3D_REQUIRE_EQUAL(array->isLoadDeferred(), true)
+    DREAM3D_REQUIRE_EQUAL(array->isAllocated(), true)
+    DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 1000)
+    DREAM3D_REQUIRE_EQUAL(numLoads, 0)
+
+    // Copies read the values once and then share them
+    Int32ArrayType::Pointer copy = std::dynamic_pointer_cast<Int32ArrayType>(array->createSharedCopy());
+    DREAM3D_REQUIRE_EQUAL(numLoads, 1)
+    DREAM3D_REQUIRE_EQUAL(array->isLoadDeferred(), false)
+    DREAM3D_REQUIRE_EQUAL(copy->getComponent(999, 1), 1999)
+    DREAM3D_REQUIRE_EQUAL(array->getValue(5), 5)
+    DREAM3D_REQUIRE_EQUAL(numLoads, 1)
+
+    // The first accessor reads the values
+    array->setDeferredLoader([&numLoads](int32_t* values) {
+      numLoads++;
+      std::fill(values, values + 2000, 7);
+      return true;
+    });
+    DREAM3D_REQUIRE_EQUAL(array->getValue(1999), 7)
+    DREAM3D_REQUIRE_EQUAL(numLoads, 2)
+    DREAM3D_REQUIRE_EQUAL(copy->getValue(1999), 1999)
+
+    // Statistics read the values too
+    array->setDeferredLoader([](int32_t* values) {
+      std::fill(values, values + 2000, 3);
+      return true;
+    });
+    std::vector<IDataArray::ComponentStatistics> stats = array->getComponentStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats.size(), 2)
+    DREAM3D_REQUIRE_EQUAL(stats[0].max, 3.0)
+
+    // Block iterators read the values as well
+    array->setDeferredLoader([](int32_t* values) {
+      std::iota(values, values + 2000, 1);
+      return true;
+    });
+    int64_t sum = 0;
+    for(auto iter = array->getBlockIterator(); iter.isValid(); ++iter)
+    {
+      sum += std::accumulate(iter.data(), iter.data() + iter.size(), static_cast<int64_t>(0));
+    }
+    DREAM3D_REQUIRE_EQUAL(array->isLoadDeferred(), false)
+    DREAM3D_REQUIRE_EQUAL(sum, 2001000)
+
+    // A loader that fails leaves the initialization value behind and reports the failure
+    array->setInitValue(-4);
+    array->setDeferredLoader([](int32_t* values) { return false; });
+    DREAM3D_REQUIRE_EQUAL(array->hasDeferredReadFailed(), false)
+    DREAM3D_REQUIRE_EQUAL(array->loadDeferredValues(), false)
+    DREAM3D_REQUIRE_EQUAL(array->getValue(10), -4)
+    DREAM3D_REQUIRE_EQUAL(array->hasDeferredReadFailed(), true)
+    DREAM3D_REQUIRE_EQUAL(array->loadDeferredValues(), false)
+
+    // Resizing drops the pending read
+    array->setDeferredLoader([&numLoads](int32_t* values) {
+      numLoads++;
+      return true;
+    });
+    array->resizeTuples(0);
+    DREAM3D_REQUIRE_EQUAL(array->isLoadDeferred(), false)
+    DREAM3D_REQUIRE_EQUAL(numLoads, 2)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestReadIntoDataArray()
+  {
+    Int32ArrayType::Pointer source = Int32ArrayType::CreateArray(10, {2}, "Source", true);
+    std::iota(source->begin(), source->end(), 0);
+
+    hid_t fileId = QH5Utilities::createFile(UnitTest::DataArrayTest::TestFile);
+    DREAM3D_REQUIRE(fileId > 0)
+    std::vector<size_t> tDims = {10};
+    DREAM3D_REQUIRE(source->writeH5Data(fileId, tDims) >= 0)
+
+    // The values are converted to float while they are read, starting at tuple 5 of the destination
+    FloatArrayType::Pointer dest = FloatArrayType::CreateArray(20, {2}, "Dest", true);
+    dest->initializeWithValue(-1.0f);
+    int err = H5DataArrayReader::ReadIntoDataArray(fileId, "Source", dest.get(), 5);
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(4, 1), -1.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(5, 0), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(14, 1), 19.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(15, 0), -1.0f)
+
+    // A range of tuples lands at the front of the destination
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Source", dest.get(), 0, H5DataArrayReader::ReadRegion::TupleRange(7, 3));
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(0, 0), 14.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(2, 1), 19.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(3, 0), -1.0f)
+
+    // Reads that would run past the end of the destination are rejected and leave it untouched
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Source", dest.get(), 15);
+    DREAM3D_REQUIRED(err, <, 0)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(19, 1), -1.0f)
+
+    // Component counts have to match
+    FloatArrayType::Pointer scalars = FloatArrayType::CreateArray(20, {1}, "Scalars", true);
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Source", scalars.get());
+    DREAM3D_REQUIRED(err, <, 0)
+
+    // unless the dimension attributes are ignored and the values are read as they are stored
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Source", scalars.get(), 0, H5DataArrayReader::ReadRegion(), true);
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    DREAM3D_REQUIRE_EQUAL(scalars->getValue(0), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(scalars->getValue(19), 19.0f)
+
+    // A plain data set of another application keeps its own rank. The fastest dimension holds the components.
+    std::vector<int32_t> plainValues(40);
+    std::iota(plainValues.begin(), plainValues.end(), 0);
+    hsize_t plainDims[3] = {4, 5, 2};
+    DREAM3D_REQUIRE(QH5Lite::writePointerDataset(fileId, "Plain", 3, plainDims, plainValues.data()) >= 0)
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Plain", dest.get(), 0, H5DataArrayReader::ReadRegion::TupleRange(3, 6));
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(0, 0), 6.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(5, 1), 17.0f)
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Plain", dest.get(), 0, H5DataArrayReader::ReadRegion::Box({1, 2}, {2, 3}));
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(0, 0), 22.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(1, 1), 25.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(2, 0), 32.0f)
+    DREAM3D_REQUIRE_EQUAL(dest->getComponent(3, 1), 35.0f)
+
+    // Regions need a split of the data set into tuples and components
+    FloatArrayType::Pointer triples = FloatArrayType::CreateArray(20, {4}, "Triples", true);
+    err = H5DataArrayReader::ReadIntoDataArray(fileId, "Plain", triples.get(), 0, H5DataArrayReader::ReadRegion::TupleRange(0, 2));
+    DREAM3D_REQUIRED(err, <, 0)
+
+    QH5Utilities::closeFile(fileId);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMemoryPool()
+  {
+    // Size classes never shrink a request and exact powers of two are their own class
+    DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::SizeClass(1024 * 1024), 1024 * 1024)
+    DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::SizeClass(1024 * 1024 + 1), 1280 * 1024)
+    DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::SizeClass(1500 * 1024), 1536 * 1024)
+    DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::SizeClass(1), 4096)
+
+    DataArrayMemoryPool::Pointer pool = DataArrayMemoryPool::New();
+    pool->setMinimumBlockSize(64 * 1024);
+    const size_t numTuples = 100000;
+    {
+      DataArrayMemoryPool::ScopedActivation activation(pool);
+      DREAM3D_REQUIRE(DataArrayMemoryPool::GetActivePool() == pool)
+
+      // Small arrays are not pooled
+      FloatArrayType::Pointer small = FloatArrayType::CreateArray(16, "Small", true);
+      DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::GetBlockCapacity(small->getVoidPointer(0)), 0)
+
+      // The pool is only active on the thread that activated it
+      FloatArrayType::Pointer otherThread;
+      bool otherHasPool = true;
+      std::thread worker([&] {
+        otherHasPool = (DataArrayMemoryPool::GetActivePool() != DataArrayMemoryPool::NullPointer());
+        otherThread = FloatArrayType::CreateArray(numTuples, "OtherThread", true);
+      });
+      worker.join();
+      DREAM3D_REQUIRE_EQUAL(otherHasPool, false)
+      DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::GetBlockCapacity(otherThread->getVoidPointer(0)), 0)
+      otherThread = FloatArrayType::NullPointer();
+
+      FloatArrayType::Pointer first = FloatArrayType::CreateArray(numTuples, "First", true);
+      DREAM3D_REQUIRE_VALID_POINTER(first->getPointer(0))
+      void* firstPtr = first->getVoidPointer(0);
+      DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::GetBlockCapacity(firstPtr), DataArrayMemoryPool::SizeClass(numTuples * sizeof(float)))
+      first = FloatArrayType::NullPointer();
+      DREAM3D_REQUIRE_EQUAL(pool->getStatistics().cachedBytes, DataArrayMemoryPool::SizeClass(numTuples * sizeof(float)))
+
+      // A request in the same size class reuses the released block
+      size_t reuses = pool->getStatistics().reuses;
+      Int32ArrayType::Pointer second = Int32ArrayType::CreateArray(numTuples - 10, "Second", true);
+      DREAM3D_REQUIRE(second->getVoidPointer(0) == firstPtr)
+      DREAM3D_REQUIRE(pool->getStatistics().reuses > reuses)
+      DREAM3D_REQUIRE_EQUAL(pool->getStatistics().cachedBytes, 0)
+
+      // Resizing moves the values into a block of the new size class
+      second->initializeWithValue(42);
+      second->resizeTuples(numTuples * 3);
+      DREAM3D_REQUIRE_EQUAL(second->getValue(numTuples - 11), 42)
+      DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::GetBlockCapacity(second->getVoidPointer(0)), DataArrayMemoryPool::SizeClass(numTuples * 3 * sizeof(int32_t)))
+
+      // Copy-on-write copies share the block until one of them writes
+      Int32ArrayType::Pointer copy = std::dynamic_pointer_cast<Int32ArrayType>(second->createSharedCopy());
+      copy->prepareForWrite();
+      copy->setValue(0, 7);
+      DREAM3D_REQUIRE_EQUAL(second->getValue(0), 42)
+      copy = Int32ArrayType::NullPointer();
+
+      // Erasing tuples keeps the data intact
+      std::vector<size_t> idxs = {0, 1, 2};
+      DREAM3D_REQUIRE_EQUAL(second->eraseTuples(idxs), 0)
+      DREAM3D_REQUIRE_EQUAL(second->getValue(0), 42)
+    }
+    DREAM3D_REQUIRE(DataArrayMemoryPool::GetActivePool() == DataArrayMemoryPool::NullPointer())
+
+    // Allocations made without an active pool are plain heap blocks
+    FloatArrayType::Pointer unpooled = FloatArrayType::CreateArray(numTuples, "Unpooled", true);
+    DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::GetBlockCapacity(unpooled->getVoidPointer(0)), 0)
+
+    DataArrayMemoryPool::Statistics stats = pool->getStatistics();
+    DREAM3D_REQUIRE_EQUAL(stats.outstandingBytes, 0)
+    DREAM3D_REQUIRE(stats.cachedBytes > 0)
+    DREAM3D_REQUIRE(stats.peakBytes >= stats.cachedBytes)
+    DREAM3D_REQUIRE_EQUAL(pool->trim(), stats.cachedBytes)
+    DREAM3D_REQUIRE_EQUAL(pool->getStatistics().cachedBytes, 0)
+
+    // Blocks that outlive their pool are released with free()
+    {
+      DataArrayMemoryPool::ScopedActivation activation(pool);
+      unpooled = FloatArrayType::CreateArray(numTuples, "Pooled", true);
+    }
+    DREAM3D_REQUIRE(DataArrayMemoryPool::GetBlockCapacity(unpooled->getVoidPointer(0)) > 0)
+    pool = DataArrayMemoryPool::NullPointer();
+    DREAM3D_REQUIRE_EQUAL(DataArrayMemoryPool::GetBlockCapacity(unpooled->getVoidPointer(0)), 0)
+    unpooled->resizeTuples(numTuples * 2);
+    unpooled = FloatArrayType::NullPointer();
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -1407,12 +2412,21 @@ true);
     DREAM3D_REGISTER_TEST(TestArrayCreation())
     DREAM3D_REGISTER_TEST(TestDataArray())
     DREAM3D_REGISTER_TEST(TestEraseElements())
+    DREAM3D_REGISTER_TEST(TestCompactTuples())
     DREAM3D_REGISTER_TEST(TestcopyTuples())
     DREAM3D_REGISTER_TEST(TestDeepCopyArray())
+    DREAM3D_REGISTER_TEST(TestCopyOnWrite())
     DREAM3D_REGISTER_TEST(TestNeighborList())
     DREAM3D_REGISTER_TEST(TestWrapPointer())
     DREAM3D_REGISTER_TEST(TestPrintDataArray())
     DREAM3D_REGISTER_TEST(TestSetTuple())
+    DREAM3D_REGISTER_TEST(TestStorageType())
+    DREAM3D_REGISTER_TEST(TestMemoryPool())
+    DREAM3D_REGISTER_TEST(TestInitialization())
+    DREAM3D_REGISTER_TEST(TestStatistics())
+    DREAM3D_REGISTER_TEST(TestCompression())
+    DREAM3D_REGISTER_TEST(TestDeferredLoading())
+    DREAM3D_REGISTER_TEST(TestReadIntoDataArray())
 
 #if REMOVE_TEST_FILES
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
@@ -35,13 +35,20 @@
 
 #include <stdlib.h>
 
+#include <atomic>
 #include <iostream>
 #include <string>
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include "H5Support/QH5Utilities.h"
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/StringDataArray.h"
 #include "SIMPLib/Geometry/MeshStructs.h"
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "SIMPLib/Testing/SIMPLTestFileLocations.h"
 #include "SIMPLib/Testing/UnitTestSupport.hpp"
@@ -87,6 +94,44 @@ static const QString _9("nine");
 
 const QString kArrayName("Test Strings");
 
+/**
+ * @brief The PackedReadersImpl class reads a packed StringDataArray from several threads. Every fourth task asks for
+ * a pointer, which unpacks the array while the other tasks are still reading the packed buffers.
+ */
+class PackedReadersImpl
+{
+public:
+  PackedReadersImpl(StringDataArray* strings, std::atomic<size_t>& mismatches)
+  : m_Strings(strings)
+  , m_Mismatches(mismatches)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numTuples = m_Strings->getNumberOfTuples();
+    for(size_t task = range.min(); task < range.max(); task++)
+    {
+      if(task % 4 == 0)
+      {
+        m_Strings->getVoidPointer(task % numTuples);
+        continue;
+      }
+      for(size_t i = 0; i < numTuples; i++)
+      {
+        if(m_Strings->getValue(i) != QString::number(i % 13))
+        {
+          m_Mismatches++;
+        }
+      }
+    }
+  }
+
+private:
+  StringDataArray* m_Strings;
+  std::atomic<size_t>& m_Mismatches;
+};
+
 class StringDataArrayTest
 {
 public:
@@ -103,6 +148,9 @@ public:
   // -----------------------------------------------------------------------------
   void RemoveTestFiles()
   {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::StringDataArrayTest::TestFile);
+#endif
   }
 
   // -----------------------------------------------------------------------------
@@ -379,6 +427,123 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPackedStorage()
+  {
+    StringDataArray::Pointer data = initializeStringDataArray();
+    data->setValue(3, QString::fromUtf8("\xc3\xa9t\xc3\xa9"));
+    data->setValue(4, "");
+
+    StringDataArray::Pointer packed = std::dynamic_pointer_cast<StringDataArray>(data->deepCopy());
+    packed->pack();
+    DREAM3D_REQUIRE_EQUAL(packed->isPacked(), true)
+    DREAM3D_REQUIRE_EQUAL(packed->isDictionaryEncoded(), false)
+    DREAM3D_REQUIRE_EQUAL(packed->getNumberOfTuples(), k_ArraySize)
+    for(size_t i = 0; i < k_ArraySize; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(packed->getValue(i), data->getValue(i))
+    }
+    StringDataArray::Utf8View view = packed->getUtf8View(3);
+    DREAM3D_REQUIRE_EQUAL(view.size(), static_cast<size_t>(5))
+    DREAM3D_REQUIRE_EQUAL(view.data()[view.size()], '\0')
+    DREAM3D_REQUIRE_EQUAL(view.toQString(), data->getValue(3))
+    DREAM3D_REQUIRE_EQUAL(packed->getUtf8View(4).empty(), true)
+
+    // Erasing and resizing stay in the packed layout
+    std::vector<size_t> eraseTuples = {0, 5};
+    DREAM3D_REQUIRE_EQUAL(packed->eraseTuples(eraseTuples), 0)
+    DREAM3D_REQUIRE_EQUAL(packed->isPacked(), true)
+    DREAM3D_REQUIRE_EQUAL(packed->getNumberOfTuples(), k_ArraySize - 2)
+    DREAM3D_REQUIRE_EQUAL(packed->getValue(0), ::_1)
+    DREAM3D_REQUIRE_EQUAL(packed->getValue(4), ::_6)
+    packed->resizeTuples(k_ArraySize);
+    DREAM3D_REQUIRE_EQUAL(packed->getValue(k_ArraySize - 1), QString(""))
+    packed->resizeTuples(k_ResizeSmaller);
+    DREAM3D_REQUIRE_EQUAL(packed->getSize(), k_ResizeSmaller)
+    DREAM3D_REQUIRE_EQUAL(packed->getValue(4), ::_6)
+
+    // Setting a value converts back to one QString per tuple
+    packed->setValue(0, ::_9);
+    DREAM3D_REQUIRE_EQUAL(packed->isPacked(), false)
+    DREAM3D_REQUIRE_EQUAL(packed->getValue(0), ::_9)
+    DREAM3D_REQUIRE_EQUAL(packed->getValue(2), data->getValue(3))
+
+    // A low cardinality column only stores each distinct value once
+    StringDataArray::Pointer phases = StringDataArray::CreateArray(100, "Phases", true);
+    for(size_t i = 0; i < phases->getNumberOfTuples(); i++)
+    {
+      phases->setValue(i, (i % 3 == 0) ? ::_0 : ::_1);
+    }
+    phases->pack(true);
+    DREAM3D_REQUIRE_EQUAL(phases->isDictionaryEncoded(), true)
+    DREAM3D_REQUIRE_EQUAL(phases->getNumberOfUniqueValues(), static_cast<size_t>(2))
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(3), ::_0)
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(4), ::_1)
+    DREAM3D_REQUIRE_EQUAL(phases->copyTuple(3, 4), 0)
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(4), ::_0)
+    eraseTuples = {0, 1, 2};
+    DREAM3D_REQUIRE_EQUAL(phases->eraseTuples(eraseTuples), 0)
+    DREAM3D_REQUIRE_EQUAL(phases->getNumberOfTuples(), static_cast<size_t>(97))
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(0), ::_0)
+    DREAM3D_REQUIRE(phases->getUtf8View(0) == phases->getUtf8View(1))
+
+    // HDF5 reads land directly in the packed layout
+    QDir dir(UnitTest::StringDataArrayTest::TestDir);
+    dir.mkpath(".");
+    hid_t fileId = QH5Utilities::createFile(UnitTest::StringDataArrayTest::TestFile);
+    DREAM3D_REQUIRE(fileId > 0)
+    std::vector<size_t> tDims = {k_ArraySize};
+    DREAM3D_REQUIRE(data->writeH5Data(fileId, tDims) >= 0)
+    DREAM3D_REQUIRE(phases->writeH5Data(fileId, tDims) >= 0)
+    StringDataArray::Pointer readData = StringDataArray::CreateArray(0, kArrayName, true);
+    DREAM3D_REQUIRE(readData->readH5Data(fileId) >= 0)
+    StringDataArray::Pointer readPhases = StringDataArray::CreateArray(0, "Phases", true);
+    DREAM3D_REQUIRE(readPhases->readH5Data(fileId) >= 0)
+    QH5Utilities::closeFile(fileId);
+
+    DREAM3D_REQUIRE_EQUAL(readData->isPacked(), true)
+    DREAM3D_REQUIRE_EQUAL(readData->getNumberOfTuples(), k_ArraySize)
+    for(size_t i = 0; i < k_ArraySize; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(readData->getValue(i), data->getValue(i))
+    }
+    DREAM3D_REQUIRE_EQUAL(readPhases->getNumberOfTuples(), static_cast<size_t>(97))
+    for(size_t i = 0; i < readPhases->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(readPhases->getValue(i), phases->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestConcurrentPackedReads()
+  {
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(1000, "ConcurrentStrings", true);
+    for(size_t i = 0; i < strings->getNumberOfTuples(); i++)
+    {
+      strings->setValue(i, QString::number(i % 13));
+    }
+    strings->pack(true);
+    DREAM3D_REQUIRE_EQUAL(strings->isPacked(), true)
+
+    // Reads may be mixed with calls that unpack the array underneath them
+    std::atomic<size_t> mismatches(0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, 64);
+    dataAlg.execute(PackedReadersImpl(strings.get(), mismatches));
+    DREAM3D_REQUIRE_EQUAL(mismatches.load(), 0)
+    DREAM3D_REQUIRE_EQUAL(strings->isPacked(), false)
+    DREAM3D_REQUIRE_EQUAL(strings->getValue(27), QString::number(1))
+
+    // Resizing releases the packed buffers that were kept for the readers
+    strings->resizeTuples(500);
+    DREAM3D_REQUIRE_EQUAL(strings->isDictionaryEncoded(), false)
+    DREAM3D_REQUIRE_EQUAL(strings->getValue(499), QString::number(499 % 13))
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -397,6 +562,8 @@ public:
     DREAM3D_REGISTER_TEST(TestTupleCopy())
     DREAM3D_REGISTER_TEST(TestTupleErase())
     DREAM3D_REGISTER_TEST(TestDeepCopyArray())
+    DREAM3D_REGISTER_TEST(TestPackedStorage())
+    DREAM3D_REGISTER_TEST(TestConcurrentPackedReads())
 
 #if REMOVE_TEST_FILES
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
@@ -39,7 +39,9 @@
 
 // C++ Includes
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <numeric>
 
 // HDF5 Includes
 #include "H5Support/H5ScopedSentinel.h"
@@ -49,13 +51,92 @@
 // DREAM3D Includes
 #include "SIMPLib/DataArrays/StatsDataArray.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/DataArrayAllocator.h"
+#include "SIMPLib/Geometry/GridLayout.h"
 #include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/HDF5/VTKH5Constants.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/DataContainers/AttributeMatrixProxy.h"
 #include "SIMPLib/DataContainers/DataContainerProxy.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/SIMPLH5DataReaderRequirements.h"
 
+/**
+ * @brief The CompactArraysImpl class applies the same tuple runs to a list of arrays. Each array is
+ * compacted by one task, which in turn copies its tuples in parallel.
+ */
+class CompactArraysImpl
+{
+public:
+  CompactArraysImpl(const std::vector<IDataArray::Pointer>& arrays, const IDataArray::TupleRuns& runs)
+  : m_Arrays(arrays)
+  , m_Runs(runs)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      m_Arrays[i]->compactTuples(m_Runs);
+    }
+  }
+
+private:
+  const std::vector<IDataArray::Pointer>& m_Arrays;
+  const IDataArray::TupleRuns& m_Runs;
+};
+
+/**
+ * @brief The RenumberFeatureIdsImpl class maps every feature id to its id after the compaction
+ */
+class RenumberFeatureIdsImpl
+{
+public:
+  RenumberFeatureIdsImpl(int32_t* featureIds, const std::vector<int32_t>& newNames)
+  : m_FeatureIds(featureIds)
+  , m_NewNames(newNames)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const auto numNames = static_cast<int64_t>(m_NewNames.size());
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      int32_t featureId = m_FeatureIds[i];
+      if(featureId >= 0 && featureId < numNames)
+      {
+        m_FeatureIds[i] = m_NewNames[featureId];
+      }
+    }
+  }
+
+private:
+  int32_t* m_FeatureIds;
+  const std::vector<int32_t>& m_NewNames;
+};
+
+namespace
+{
+/**
+ * @brief Returns the tuple dimensions padded to 3 entries, or false if there are more than 3
+ */
+bool GetGridDimensions(const std::vector<size_t>& tDims, SizeVec3Type& dims)
+{
+  if(tDims.size() > 3)
+  {
+    return false;
+  }
+  dims = SizeVec3Type(1, 1, 1);
+  for(size_t i = 0; i < tDims.size(); i++)
+  {
+    dims[i] = tDims[i];
+  }
+  return true;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -63,6 +144,7 @@ AttributeMatrix::AttributeMatrix(const std::vector<size_t>& tDims, const QString
 : IDataStructureContainerNode(name)
 , m_Type(attrType)
 , m_TupleDims(tDims)
+, m_CellLayout(GridLayout::Type::RowMajor)
 {
 }
 
@@ -415,26 +497,38 @@ bool AttributeMatrix::removeInactiveObjects(const QVector<bool> &activeObjects,
   size_t totalTuples = getNumberOfTuples();
   if(static_cast<size_t>(activeObjects.size()) == totalTuples && acceptableMatrix)
   {
-    size_t goodcount = 1;
-    std::vector<size_t> newNames(totalTuples, 0);
-    std::vector<size_t> removeList;
-
-    for(qint32 i = 1; i < activeObjects.size(); i++)
+    // Build the map from old to new feature ids and the runs of kept tuples in a single pass. Feature 0 is always kept.
+    std::vector<int32_t> newNames(totalTuples, 0);
+    IDataArray::TupleRuns runs;
+    IDataArray::TupleRun run;
+    run.numTuples = 1;
+    int32_t goodcount = 1;
+    for(size_t i = 1; i < totalTuples; i++)
     {
-      if(!activeObjects[i])
+      if(!activeObjects[static_cast<int>(i)])
+      {
+        continue;
+      }
+      newNames[i] = goodcount;
+      if(run.srcTuple + run.numTuples == i)
       {
-        removeList.push_back(i);
-        newNames[i] = 0;
+        run.numTuples++;
       }
       else
       {
-        newNames[i] = goodcount;
-        goodcount++;
+        runs.push_back(run);
+        run.srcTuple = i;
+        run.destTuple = static_cast<size_t>(goodcount);
+        run.numTuples = 1;
       }
+      goodcount++;
     }
+    runs.push_back(run);
 
-    if(!removeList.empty())
+    auto numKept = static_cast<size_t>(goodcount);
+    if(numKept < totalTuples)
     {
+      std::vector<IDataArray::Pointer> arrays;
       QList<QString> headers = getAttributeArrayNames();
       for(const auto& header : headers)
       {
@@ -446,22 +540,22 @@ bool AttributeMatrix::removeInactiveObjects(const QVector<bool> &activeObjects,
         }
         else
         {
-          p->eraseTuples(removeList);
+          arrays.push_back(p);
         }
       }
-      std::vector<size_t> tDims(1, (totalTuples - removeList.size()));
+
+      // Every array is compacted with the same runs, all arrays at once
+      ParallelDataAlgorithm arrayAlg;
+      arrayAlg.setRange(0, arrays.size());
+      arrayAlg.execute(CompactArraysImpl(arrays, runs));
+
+      std::vector<size_t> tDims(1, numKept);
       setTupleDimensions(tDims);
 
       // Loop over all the points and correct all the feature names
-      size_t totalPoints = featureIds->getNumberOfTuples();
-      int32_t* featureIdPtr = featureIds->getPointer(0);
-      for(size_t i = 0; i < totalPoints; i++)
-      {
-        if(featureIdPtr[i] >= 0 && featureIdPtr[i] < newNames.size())
-        {
-          featureIdPtr[i] = static_cast<int32_t>(newNames[featureIdPtr[i]]);
-        }
-      }
+      ParallelDataAlgorithm featureIdsAlg;
+      featureIdsAlg.setRange(0, featureIds->getNumberOfTuples());
+      featureIdsAlg.execute(RenumberFeatureIdsImpl(featureIds->getPointer(0), newNames));
     }
   }
   else
@@ -476,6 +570,11 @@ bool AttributeMatrix::removeInactiveObjects(const QVector<bool> &activeObjects,
 // -----------------------------------------------------------------------------
 void AttributeMatrix::resizeAttributeArrays(const std::vector<size_t>& tDims)
 {
+  // Resizing keeps the leading tuples, which only stay in place for the RowMajor layout
+  if(tDims != m_TupleDims)
+  {
+    resetCellLayout();
+  }
   m_TupleDims = tDims;
   size_t numTuples = m_TupleDims[0];
   for(int i = 1; i < m_TupleDims.size(); i++)
@@ -490,6 +589,87 @@ void AttributeMatrix::resizeAttributeArrays(const std::vector<size_t>& tDims)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AttributeMatrix::setCellLayout(GridLayout::Type layout)
+{
+  if(layout == m_CellLayout)
+  {
+    return 0;
+  }
+  SizeVec3Type dims;
+  if(!GetGridDimensions(m_TupleDims, dims))
+  {
+    return -1;
+  }
+  const AttributeMatrix::Container_t& dataArrays = getChildren();
+  for(const auto& dataArray : dataArrays)
+  {
+    if(!GridLayout::CanConvertArray(dataArray, dims))
+    {
+      return -2;
+    }
+  }
+  for(const auto& dataArray : dataArrays)
+  {
+    GridLayout::ConvertArray(dataArray, dims, m_CellLayout, layout);
+  }
+  m_CellLayout = layout;
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AttributeMatrix::resetCellLayout()
+{
+  if(m_CellLayout == GridLayout::Type::RowMajor)
+  {
+    return;
+  }
+  SizeVec3Type dims;
+  if(GetGridDimensions(m_TupleDims, dims))
+  {
+    const AttributeMatrix::Container_t& dataArrays = getChildren();
+    for(const auto& dataArray : dataArrays)
+    {
+      // Arrays that can not be converted were never reordered
+      GridLayout::ConvertArray(dataArray, dims, m_CellLayout, GridLayout::Type::RowMajor);
+    }
+  }
+  m_CellLayout = GridLayout::Type::RowMajor;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GridLayout::Type AttributeMatrix::getCellLayout() const
+{
+  return m_CellLayout;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GridLayout AttributeMatrix::getGridLayout() const
+{
+  SizeVec3Type dims;
+  if(!GetGridDimensions(m_TupleDims, dims))
+  {
+    return GridLayout();
+  }
+  return GridLayout(dims, m_CellLayout);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AttributeMatrix::IsInitializationSkipped()
+{
+  return DataArrayAllocator::IsInitializationSkipped();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -523,6 +703,29 @@ AttributeMatrix::Pointer AttributeMatrix::deepCopy(bool forceNoAllocate)
     }
     newAttrMat->insertOrAssign(new_d);
   }
+  newAttrMat->m_CellLayout = m_CellLayout;
+
+  return newAttrMat;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AttributeMatrix::Pointer AttributeMatrix::createSharedCopy()
+{
+  AttributeMatrix::Pointer newAttrMat = AttributeMatrix::New(getTupleDimensions(), getName(), getType());
+
+  const auto& dataArrays = getChildren();
+  for(const auto& d : dataArrays)
+  {
+    IDataArray::Pointer new_d = d->createSharedCopy();
+    if(new_d.get() == nullptr)
+    {
+      return AttributeMatrix::NullPointer();
+    }
+    newAttrMat->insertOrAssign(new_d);
+  }
+  newAttrMat->m_CellLayout = m_CellLayout;
 
   return newAttrMat;
 }
@@ -533,10 +736,24 @@ int AttributeMatrix::writeAttributeArraysToHDF5(hid_t parentId)
 {
   int err = 0;
 
+  // Files always hold the RowMajor layout. Each bricked array is written through a RowMajor copy that only
+  // lives for its own write, so the arrays in memory are never touched.
+  SizeVec3Type dims;
+  bool bricked = m_CellLayout != GridLayout::Type::RowMajor && GetGridDimensions(m_TupleDims, dims);
+
   const auto& dataArrays = getChildren();
   for(const auto& d : dataArrays)
   {
-    err = d->writeH5Data(parentId, m_TupleDims);
+    IDataArray::Pointer rowMajor = d;
+    if(bricked && GridLayout::CanConvertArray(d, dims))
+    {
+      rowMajor = GridLayout::CreateRowMajorCopy(d, dims, m_CellLayout);
+      if(nullptr == rowMajor.get())
+      {
+        return -1;
+      }
+    }
+    err = rowMajor->writeH5Data(parentId, m_TupleDims);
     if(err < 0)
     {
       return err;
@@ -555,6 +772,8 @@ int AttributeMatrix::addAttributeArrayFromHDF5Path(hid_t gid, const QString& nam
   QH5Lite::readStringAttribute(gid, name, SIMPL::HDF5::ObjectType, classType);
   //   qDebug() << groupName << " Array: " << *iter << " with C++ ClassType of " << classType << "\n";
   IDataArray::Pointer dPtr = IDataArray::NullPointer();
+  // The arrays in the file are RowMajor
+  resetCellLayout();
 
   if(classType.startsWith("DataArray"))
   {
@@ -607,8 +826,31 @@ int AttributeMatrix::addAttributeArrayFromHDF5Path(hid_t gid, const QString& nam
 //
 // -----------------------------------------------------------------------------
 int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy* attrMatProxy)
+{
+  return readAttributeArraysFromHDF5(amGid, preflight, attrMatProxy, H5DataArrayReader::ReadRegion());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy* attrMatProxy, const H5DataArrayReader::ReadRegion& region, bool deferReading)
 {
   int err = 0;
+  if(!region.fitsInside(m_TupleDims))
+  {
+    H5Gclose(amGid);
+    return -1;
+  }
+  // The arrays in the file are RowMajor, and cropping to the region only works on RowMajor arrays
+  resetCellLayout();
+  // The arrays are added with the dimensions of the region so the AttributeMatrix takes them on up front
+  std::vector<size_t> fileTDims = m_TupleDims;
+  if(!region.isEmpty())
+  {
+    m_TupleDims = region.getTupleDimensions();
+  }
+  size_t regionTuples = std::accumulate(m_TupleDims.begin(), m_TupleDims.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  IDataArray::TupleRuns regionRuns;
   AttributeMatrixProxy::StorageType dasToRead = attrMatProxy->getDataArrays();
   QString classType;
   for(const auto& daToRead : dasToRead)
@@ -623,7 +865,7 @@ int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, At
 
     if(classType.startsWith("DataArray"))
     {
-      dPtr = H5DataArrayReader::ReadIDataArray(amGid, daToRead.getName(), preflight);
+      dPtr = H5DataArrayReader::ReadIDataArray(amGid, daToRead.getName(), region, preflight, deferReading);
     }
     else if(classType.compare("StringDataArray") == 0)
     {
@@ -644,6 +886,23 @@ int AttributeMatrix::readAttributeArraysFromHDF5(hid_t amGid, bool preflight, At
       dPtr = statsData;
     }
 
+    // Arrays that can not be read partially are cropped after reading them completely
+    if(nullptr != dPtr.get() && !region.isEmpty() && dPtr->getNumberOfTuples() != regionTuples)
+    {
+      if(preflight)
+      {
+        dPtr->resizeTuples(regionTuples);
+      }
+      else
+      {
+        if(regionRuns.empty())
+        {
+          regionRuns = region.getTupleRuns(fileTDims);
+        }
+        dPtr->compactTuples(regionRuns);
+      }
+    }
+
     if(nullptr != dPtr.get())
     {
       addOrReplaceAttributeArray(dPtr);
@@ -61,9 +61,12 @@
 #include "SIMPLib/SIMPLib.h"
 
 class AttributeMatrixProxy;
+class GridLayout;
+class H5ReadRegion;
 class DataContainerProxy;
 class SIMPLH5DataReaderRequirements;
 template<class T> class DataArray;
+enum class GridLayoutType : uint8_t;
 
 enum RenameErrorCodes
 {
@@ -321,6 +324,28 @@ public:
     */
     void resizeAttributeArrays(const std::vector<size_t>& tDims);
 
+    /**
+     * @brief Reorders the arrays of a cell AttributeMatrix to the given GridLayout, using the tuple dimensions as
+     * the grid dimensions. Arrays added afterwards are expected to be in the new layout already. Resizing the
+     * matrix or reading arrays into it from a file converts the arrays back to RowMajor first.
+     * @param layout
+     * @return 0 on success. A negative value if the tuple dimensions have more than 3 entries or an array can not
+     * be reordered, in which case nothing is changed.
+     */
+    int setCellLayout(GridLayoutType layout);
+
+    /**
+     * @brief Returns the GridLayout type of the arrays
+     * @return
+     */
+    GridLayoutType getCellLayout() const;
+
+    /**
+     * @brief Returns a GridLayout that maps cell coordinates to tuple indices of the arrays in their current layout
+     * @return
+     */
+    GridLayout getGridLayout() const;
+
     /**
      * @brief Returns bool of whether a named array exists
      * @param name The name of the data array
@@ -432,7 +457,8 @@ public:
      * method to work properly is the name of the attribute array is not empty
      * @param filter The instance of the filter the filter that is requesting the new array
      * @param attributeArrayName The name of the AttributeArray to create
-     * @param initValue The initial value of all the elements of the array
+     * @param initValue The initial value of all the elements of the array. The elements are left uninitialized
+     * while a DataArrayAllocator::ScopedSkipInitialization is alive on the calling thread (see createAndAddAttributeArray).
      * @param size The number of tuples in the Array
      * @param dims The dimensions of the components of the AttributeArray
      * @return A Shared Pointer to the newly created array
@@ -487,7 +513,8 @@ public:
     }
 
     /**
-    * @brief Creates and Adds the data for a named array
+    * @brief Creates and Adds the data for a named array. The values are set to initValue unless a
+    * DataArrayAllocator::ScopedSkipInitialization is alive on the calling thread.
     * @param name The name that the array will be known by
     * @param dims The size the data on each tuple
     */
@@ -500,7 +527,7 @@ public:
       typename ArrayType::Pointer attributeArray = ArrayType::CreateArray(getNumberOfTuples(), compDims, name, allocateData);
       if(attributeArray.get() != nullptr)
       {
-        if(allocateData)
+        if(allocateData && !IsInitializationSkipped())
         {
           attributeArray->initializeWithValue(initValue);
         }
@@ -610,6 +637,13 @@ public:
     */
     virtual AttributeMatrix::Pointer deepCopy(bool forceNoAllocate = false);
 
+    /**
+     * @brief creates a copy of the attribute matrix whose arrays share their memory with the arrays of this
+     * matrix until either side modifies them. See DataArray::createSharedCopy() for the rules on raw pointers.
+     * @return On error, will return a null pointer.
+     */
+    virtual AttributeMatrix::Pointer createSharedCopy();
+
     /**
      * @brief writeAttributeArraysToHDF5
      * @param parentId
@@ -635,6 +669,19 @@ public:
      */
     virtual int readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy* attrMatProxy);
 
+    /**
+     * @brief readAttributeArraysFromHDF5 Reads only the tuples selected by region from each array. The tuple
+     * dimensions of the AttributeMatrix must be those stored in the file and become the dimensions of the region.
+     * @param amGid
+     * @param preflight
+     * @param attrMatProxy
+     * @param region
+     * @param deferReading The DataArrays only remember where their values are stored and read them when they are
+     * first accessed
+     * @return
+     */
+    int readAttributeArraysFromHDF5(hid_t amGid, bool preflight, AttributeMatrixProxy* attrMatProxy, const H5ReadRegion& region, bool deferReading = false);
+
     /**
      * @brief generateXdmfText
      * @param centering
@@ -685,6 +732,17 @@ public:
 
   private:
     std::vector<size_t> m_TupleDims;
+    GridLayoutType m_CellLayout;
+
+    /**
+     * @brief Converts the arrays back to the RowMajor layout, if they are in another one
+     */
+    void resetCellLayout();
+
+    /**
+     * @brief Returns true if a DataArrayAllocator::ScopedSkipInitialization is alive on the calling thread
+     */
+    static bool IsInitializationSkipped();
 
     AttributeMatrix(const AttributeMatrix&);
     void operator =(const AttributeMatrix&);
@@ -35,6 +35,7 @@
 
 #include "DataContainer.h"
 
+#include <QtCore/QDebug>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/AttributeMatrix.h"
@@ -51,11 +52,47 @@
 #include "SIMPLib/Geometry/TetrahedralGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/Utilities/SIMPLH5DataReaderRequirements.h"
 
 #include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/QH5Utilities.h"
 
+namespace
+{
+// -----------------------------------------------------------------------------
+// Returns true if the region of interest applies to the Cell data of an ImageGeom
+// -----------------------------------------------------------------------------
+bool isImageRegion(const H5DataArrayReader::ReadRegion& region)
+{
+  return !region.isEmpty() && !region.isTupleRange() && region.getTupleDimensions().size() == 3;
+}
+
+// -----------------------------------------------------------------------------
+// Shrinks the image to the box of the region and moves its origin to the first voxel of the box
+// -----------------------------------------------------------------------------
+int cropImageToRegion(const ImageGeom::Pointer& image, const H5DataArrayReader::ReadRegion& region)
+{
+  SizeVec3Type dims = image->getDimensions();
+  // DataContainerArray::readDataContainersFromHDF5() reports this case with the dimensions of the image
+  if(!region.fitsInside({dims[0], dims[1], dims[2]}))
+  {
+    return -1;
+  }
+  std::vector<size_t> offset = region.getOffset();
+  std::vector<size_t> extent = region.getTupleDimensions();
+  FloatVec3Type origin = image->getOrigin();
+  FloatVec3Type spacing = image->getSpacing();
+  for(size_t i = 0; i < 3; i++)
+  {
+    origin[i] += static_cast<float>(offset[i]) * spacing[i];
+  }
+  image->setOrigin(origin);
+  image->setDimensions(SizeVec3Type(extent[0], extent[1], extent[2]));
+  return 0;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -273,12 +310,14 @@ int DataContainer::writeAttributeMatricesToHDF5(hid_t parentId)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, DataContainerProxy& dcProxy)
+int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, DataContainerProxy& dcProxy, const H5DataArrayReader::ReadRegion& region, bool deferReading)
 {
   int err = 0;
   std::vector<size_t> tDims;
 
   DataContainerProxy::StorageType& attrMatsToRead = dcProxy.getAttributeMatricies();
+  // A region of interest only restricts the Cell data of an ImageGeom, the geometry was already cropped when it was read
+  bool imageRegion = isImageRegion(region) && nullptr != std::dynamic_pointer_cast<ImageGeom>(m_Geometry);
   AttributeMatrix::Type amType = AttributeMatrix::Type::Unknown;
   QString amName;
   for(QMap<QString, AttributeMatrixProxy>::iterator iter = attrMatsToRead.begin(); iter != attrMatsToRead.end(); ++iter)
@@ -316,7 +355,14 @@ int DataContainer::readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, Da
     }
 
     AttributeMatrixProxy amProxy = iter.value();
-    err = getAttributeMatrix(amName)->readAttributeArraysFromHDF5(amGid, preflight, &amProxy);
+    if(imageRegion && amTypeTmp == static_cast<uint32_t>(AttributeMatrix::Type::Cell))
+    {
+      err = getAttributeMatrix(amName)->readAttributeArraysFromHDF5(amGid, preflight, &amProxy, region, deferReading);
+    }
+    else
+    {
+      err = getAttributeMatrix(amName)->readAttributeArraysFromHDF5(amGid, preflight, &amProxy, H5DataArrayReader::ReadRegion(), deferReading);
+    }
     if(err < 0)
     {
       err |= H5Gclose(dcGid);
@@ -353,6 +399,30 @@ DataContainer::Pointer DataContainer::deepCopy(bool forceNoAllocate)
   return dcCopy;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainer::Pointer DataContainer::createSharedCopy()
+{
+  DataContainer::Pointer dcCopy = DataContainer::New(getName());
+  dcCopy->setName(getName());
+
+  if(m_Geometry.get() != nullptr)
+  {
+    IGeometry::Pointer geomCopy = m_Geometry->deepCopy(false);
+    dcCopy->setGeometry(geomCopy);
+  }
+
+  const auto attrMatrices = getChildren();
+  for(const auto& am : attrMatrices)
+  {
+    AttributeMatrix::Pointer attrMat = am->createSharedCopy();
+    dcCopy->addOrReplaceAttributeMatrix(attrMat);
+  }
+
+  return dcCopy;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -626,7 +696,7 @@ void DataContainer::writeXdmfFooter(QTextStream& xdmf)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int DataContainer::readMeshDataFromHDF5(hid_t dcGid, bool preflight)
+int DataContainer::readMeshDataFromHDF5(hid_t dcGid, bool preflight, const H5DataArrayReader::ReadRegion& region)
 {
   herr_t err = 0;
   QString geometryTypeName = SIMPL::Geometry::UnknownGeometry;
@@ -653,6 +723,10 @@ int DataContainer::readMeshDataFromHDF5(hid_t dcGid, bool preflight)
       ImageGeom::Pointer image = ImageGeom::New();
       err = image->readGeometryFromHDF5(geometryId, preflight);
       err = GeometryHelpers::GeomIO::ReadMetaDataFromHDF5(dcGid, image);
+      if(err >= 0 && isImageRegion(region))
+      {
+        err = cropImageToRegion(image, region);
+      }
       setGeometry(image);
     }
     else if(geometryTypeName.compare(SIMPL::Geometry::RectGridGeometry) == 0)
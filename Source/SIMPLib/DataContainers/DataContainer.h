@@ -48,6 +48,7 @@
 #include "SIMPLib/DataContainers/IDataStructureContainerNode.hpp"
 #include "SIMPLib/DataContainers/RenameDataPath.h"
 #include "SIMPLib/Geometry/IGeometry.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/SIMPLib.h"
 
 class QTextStream;
@@ -370,9 +371,12 @@ public:
 
   /**
    * @brief Reads desired Attribute Matrices from HDF5 file
+   * @param region The region of interest of the Cell data of an ImageGeom. An empty region reads everything.
+   * @param deferReading Read the values of the DataArrays when they are first accessed
    * @return
    */
-  virtual int readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, DataContainerProxy& dcProxy);
+  virtual int readAttributeMatricesFromHDF5(bool preflight, hid_t dcGid, DataContainerProxy& dcProxy, const H5DataArrayReader::ReadRegion& region = H5DataArrayReader::ReadRegion(),
+                                            bool deferReading = false);
 
   /**
    * @brief creates copy of dataContainer
@@ -380,6 +384,13 @@ public:
    */
   virtual DataContainer::Pointer deepCopy(bool forceNoAllocate = false);
 
+  /**
+   * @brief creates a copy of dataContainer whose attribute arrays share their memory with this dataContainer
+   * until either side modifies them. The geometry is deep copied.
+   * @return
+   */
+  virtual DataContainer::Pointer createSharedCopy();
+
   /**
    * @brief writeMeshToHDF5
    * @param dcGid
@@ -399,9 +410,10 @@ public:
    * @brief readMeshDataFromHDF5
    * @param dcGid
    * @param preflight
+   * @param region The region of interest an ImageGeom is cropped to. An empty region reads everything.
    * @return
    */
-  virtual int readMeshDataFromHDF5(hid_t dcGid, bool preflight);
+  virtual int readMeshDataFromHDF5(hid_t dcGid, bool preflight, const H5DataArrayReader::ReadRegion& region = H5DataArrayReader::ReadRegion());
 
 protected:
   virtual void writeXdmfFooter(QTextStream& xdmf);
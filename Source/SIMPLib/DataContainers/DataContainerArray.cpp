@@ -36,6 +36,7 @@
 
 #include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
 #include "SIMPLib/DataContainers/DataContainerProxy.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -231,7 +232,7 @@ void DataContainerArray::printDataContainerNames(QTextStream& out)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int DataContainerArray::readDataContainersFromHDF5(bool preflight, hid_t dcaGid, DataContainerArrayProxy& dcaProxy, Observable* obs)
+int DataContainerArray::readDataContainersFromHDF5(bool preflight, hid_t dcaGid, DataContainerArrayProxy& dcaProxy, Observable* obs, const H5DataArrayReader::ReadRegion& region, bool deferReading)
 {
   int err = 0;
 
@@ -269,7 +270,34 @@ int DataContainerArray::readDataContainersFromHDF5(bool preflight, hid_t dcaGid,
       return -198745602;
     }
 
-    err = this->getDataContainer(dcProxy.getName())->readMeshDataFromHDF5(dcGid, preflight);
+    err = this->getDataContainer(dcProxy.getName())->readMeshDataFromHDF5(dcGid, preflight, region);
+    // An ImageGeom is cropped to the region of interest, which fails if the region reaches past the image
+    ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
+    if(err < 0 && nullptr != image.get() && !region.isEmpty() && !region.isTupleRange() && region.getTupleDimensions().size() == 3)
+    {
+      SizeVec3Type dims = image->getDimensions();
+      if(!region.fitsInside({dims[0], dims[1], dims[2]}))
+      {
+        if(nullptr != obs)
+        {
+          std::vector<size_t> offset = region.getOffset();
+          std::vector<size_t> extent = region.getTupleDimensions();
+          QString ss = QObject::tr("The region of interest with offset (%1, %2, %3) and size (%4, %5, %6) does not fit inside the Image Geometry of '%7', whose dimensions are (%8, %9, %10)")
+                           .arg(offset[0])
+                           .arg(offset[1])
+                           .arg(offset[2])
+                           .arg(extent[0])
+                           .arg(extent[1])
+                           .arg(extent[2])
+                           .arg(dcProxy.getName())
+                           .arg(dims[0])
+                           .arg(dims[1])
+                           .arg(dims[2]);
+          obs->setErrorCondition(-198745605, ss);
+        }
+        return -198745605;
+      }
+    }
     if(err < 0)
     {
       if(nullptr != obs)
@@ -279,7 +307,7 @@ int DataContainerArray::readDataContainersFromHDF5(bool preflight, hid_t dcaGid,
       }
       return -198745603;
     }
-    err = this->getDataContainer(dcProxy.getName())->readAttributeMatricesFromHDF5(preflight, dcGid, dcProxy);
+    err = this->getDataContainer(dcProxy.getName())->readAttributeMatricesFromHDF5(preflight, dcGid, dcProxy, region, deferReading);
     if(err < 0)
     {
       if(nullptr != obs)
@@ -455,6 +483,21 @@ DataContainerArray::Pointer DataContainerArray::deepCopy(bool forceNoAllocate)
   return dcaCopy;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer DataContainerArray::createSharedCopy()
+{
+  DataContainerArray::Pointer dcaCopy = DataContainerArray::New();
+  const Container dcs = getDataContainers();
+  for(const auto& dc : dcs)
+  {
+    dcaCopy->push_back(dc->createSharedCopy());
+  }
+
+  return dcaCopy;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
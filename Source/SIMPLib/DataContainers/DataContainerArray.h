@@ -47,6 +47,7 @@
 #include "SIMPLib/DataContainers/DataArrayPath.h"
 #include "SIMPLib/DataContainers/IDataStructureContainerNode.hpp"
 #include "SIMPLib/DataContainers/RenameDataPath.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
 
 
 class DataContainer;
@@ -223,9 +224,12 @@ public:
    * @param dcaGid
    * @param dcaProxy
    * @param obs
+   * @param region The region of interest of the Image geometries and their Cell data. An empty region reads everything.
+   * @param deferReading Read the values of the DataArrays when they are first accessed
    * @return
    */
-  virtual int readDataContainersFromHDF5(bool preflight, hid_t dcaGid, DataContainerArrayProxy& dcaProxy, Observable* obs = nullptr);
+  virtual int readDataContainersFromHDF5(bool preflight, hid_t dcaGid, DataContainerArrayProxy& dcaProxy, Observable* obs = nullptr,
+                                         const H5DataArrayReader::ReadRegion& region = H5DataArrayReader::ReadRegion(), bool deferReading = false);
 
   /**
    * @brief setDataContainerBundles
@@ -570,7 +574,8 @@ public:
      * and an array with the same name cannot already exist
      * @param filter The instance of the filter the filter that is requesting the new array
      * @param attributeArrayName The name of the AttributeArray to create
-     * @param initValue The initial value of all the elements of the array
+     * @param initValue The initial value of all the elements of the array. The elements are left uninitialized
+     * while a DataArrayAllocator::ScopedSkipInitialization is alive on the calling thread.
      * @param size The number of tuples in the Array
      * @param dims The dimensions of the components of the AttributeArray
      * @return A Shared Pointer to the newly created array
@@ -771,6 +776,12 @@ public:
      */
     DataContainerArray::Pointer deepCopy(bool forceNoAllocate = false);
 
+    /**
+     * @brief createSharedCopy Copies the DataContainers with DataContainer::createSharedCopy()
+     * @return
+     */
+    DataContainerArray::Pointer createSharedCopy();
+
   protected:
     DataContainerArray();
 
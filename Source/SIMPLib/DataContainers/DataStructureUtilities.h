@@ -278,7 +278,8 @@ public:
    * and an array with the same name cannot already exist
    * @param filter The instance of the filter the filter that is requesting the new array
    * @param attributeArrayName The name of the AttributeArray to create
-   * @param initValue The initial value of all the elements of the array
+   * @param initValue The initial value of all the elements of the array. The elements are left uninitialized
+   * while a DataArrayAllocator::ScopedSkipInitialization is alive on the calling thread.
    * @param size The number of tuples in the Array
    * @param dims The dimensions of the components of the AttributeArray
    * @return A Shared Pointer to the newly created array
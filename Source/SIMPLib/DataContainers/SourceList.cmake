@@ -42,6 +42,7 @@ set(SIMPLib_${SUBDIR_NAME}_Moc_HDRS
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataArrayPath.h
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/IDataContainerBundle.h
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/DataContainerBundle.h
+  ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/StreamingDataContainerBundle.h
   )
 # --------------------------------------------------------------------
 # Run Qts automoc program to generate some source files that get compiled
@@ -76,6 +77,7 @@ set(SIMPLib_${SUBDIR_NAME}_SRCS
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/IDataContainerBundle.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/IDataStructureNode.cpp
   ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/RenameDataPath.cpp
+  ${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/StreamingDataContainerBundle.cpp
 )
 
 cmp_IDE_SOURCE_PROPERTIES( "${SUBDIR_NAME}" "${SIMPLib_${SUBDIR_NAME}_HDRS};${SIMPLib_${SUBDIR_NAME}_Moc_HDRS}" "${SIMPLib_${SUBDIR_NAME}_SRCS}" "${PROJECT_INSTALL_HEADERS}")
@@ -0,0 +1,617 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "StreamingDataContainerBundle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMap>
+
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/H5Utilities.h"
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/Utilities/SIMPLH5DataReader.h"
+#include "SIMPLib/Utilities/SIMPLH5StructureCache.h"
+
+/**
+ * @brief The part of the bundle that prefetch and write back jobs update from the H5BackgroundWriter thread
+ */
+struct StreamingDataContainerBundle::StreamState
+{
+  struct Entry
+  {
+    DataContainer::Pointer dataContainer;
+    //! A prefetch job for the DataContainer is queued or running
+    bool pending = false;
+    //! The prefetch job, valid while pending is set
+    H5BackgroundWriter::Ticket prefetch;
+    //! The DataContainer was added to the bundle and the file does not have its current contents
+    bool added = false;
+  };
+
+  std::mutex mutex;
+  QMap<QString, Entry> entries;
+  //! The write back jobs that were not waited for yet
+  std::vector<H5BackgroundWriter::Ticket> writes;
+  //! The structure of the file. It is read once and then kept up to date with the DataContainers written to it.
+  DataContainerArrayProxy fileStructure;
+  bool hasFileStructure = false;
+
+  /**
+   * @brief Returns the proxy that selects only the DataContainer name from the file. The structure of the file is
+   * read the first time, and again if it does not know name because some other writer added it.
+   * @param filePath
+   * @param name
+   * @param proxy
+   * @return false if the file does not have the DataContainer
+   */
+  bool findDataContainer(const QString& filePath, const QString& name, DataContainerArrayProxy& proxy)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(hasFileStructure && fileStructure.contains(name))
+      {
+        proxy.insertDataContainer(name, fileStructure.getDataContainerProxy(name));
+        return true;
+      }
+    }
+
+    SIMPLH5DataReader::Pointer reader = SIMPLH5DataReader::New();
+    if(!reader->openFile(filePath))
+    {
+      return false;
+    }
+    int err = 0;
+    DataContainerArrayProxy structure = reader->readDataContainerArrayStructure(nullptr, err);
+    if(err < 0)
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    fileStructure = structure;
+    hasFileStructure = true;
+    if(!fileStructure.contains(name))
+    {
+      return false;
+    }
+    proxy.insertDataContainer(name, fileStructure.getDataContainerProxy(name));
+    return true;
+  }
+
+  /**
+   * @brief Records the structure of a DataContainer that was just written to the file
+   * @param dc
+   */
+  void updateFileStructure(const DataContainer::Pointer& dc)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    dca->addOrReplaceDataContainer(dc);
+    DataContainerArrayProxy written(dca.get());
+    std::lock_guard<std::mutex> lock(mutex);
+    if(hasFileStructure)
+    {
+      fileStructure.insertDataContainer(dc->getName(), written.getDataContainerProxy(dc->getName()));
+    }
+  }
+
+  /**
+   * @brief Forgets the write back jobs that finished successfully. Failed ones are kept until flush() reports them.
+   */
+  void dropFinishedWrites()
+  {
+    auto isDone = [](const H5BackgroundWriter::Ticket& ticket) {
+      return ticket.wait_for(std::chrono::seconds(0)) == std::future_status::ready && ticket.get().code >= 0;
+    };
+    writes.erase(std::remove_if(writes.begin(), writes.end(), isDone), writes.end());
+  }
+};
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Reads the single DataContainer selected by proxy from a .dream3d file
+// -----------------------------------------------------------------------------
+DataContainer::Pointer readDataContainer(const QString& filePath, const QString& name, DataContainerArrayProxy& proxy)
+{
+  SIMPLH5DataReader::Pointer reader = SIMPLH5DataReader::New();
+  if(!reader->openFile(filePath))
+  {
+    return DataContainer::NullPointer();
+  }
+  DataContainerArrayProxy::StorageType& dcProxies = proxy.getDataContainers();
+  for(auto iter = dcProxies.begin(); iter != dcProxies.end(); ++iter)
+  {
+    iter.value().setFlags(Qt::Checked);
+  }
+
+  DataContainerArray::Pointer dca = reader->readSIMPLDataUsingProxy(proxy, false);
+  if(nullptr == dca.get())
+  {
+    return DataContainer::NullPointer();
+  }
+  return dca->getDataContainer(name);
+}
+
+// -----------------------------------------------------------------------------
+// Writes a single DataContainer into a .dream3d file, replacing the one with the same name. HDF5 does not reuse the
+// space of the replaced group, see the class documentation.
+// -----------------------------------------------------------------------------
+int writeDataContainer(const QString& filePath, const DataContainer::Pointer& dc)
+{
+  H5LibraryLock libraryLock;
+  hid_t fileId = -1;
+  if(QFileInfo::exists(filePath))
+  {
+    fileId = QH5Utilities::openFile(filePath, false);
+  }
+  else
+  {
+    fileId = QH5Utilities::createFile(filePath);
+    if(fileId >= 0)
+    {
+      QH5Lite::writeStringAttribute(fileId, "/", SIMPL::HDF5::FileVersionName, SIMPL::HDF5::FileVersion);
+      QH5Lite::writeStringAttribute(fileId, "/", SIMPL::HDF5::DREAM3DVersion, SIMPLib::Version::Complete());
+    }
+  }
+  if(fileId < 0)
+  {
+    return -1;
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+  SIMPLH5StructureCache::Instance()->remove(filePath);
+
+  int err = H5Utilities::createGroupsFromPath(SIMPL::StringConstants::DataContainerGroupName.toLatin1().data(), fileId);
+  if(err < 0)
+  {
+    return err;
+  }
+  hid_t dcaGid = H5Gopen(fileId, SIMPL::StringConstants::DataContainerGroupName.toLatin1().data(), H5P_DEFAULT);
+  sentinel.addGroupId(&dcaGid);
+
+  QByteArray dcName = dc->getName().toLatin1();
+  if(H5Lexists(dcaGid, dcName.data(), H5P_DEFAULT) > 0)
+  {
+    H5Ldelete(dcaGid, dcName.data(), H5P_DEFAULT);
+  }
+  err = H5Utilities::createGroupsFromPath(dcName.data(), dcaGid);
+  if(err < 0)
+  {
+    return err;
+  }
+  hid_t dcGid = H5Gopen(dcaGid, dcName.data(), H5P_DEFAULT);
+  sentinel.addGroupId(&dcGid);
+
+  err = dc->writeAttributeMatricesToHDF5(dcGid);
+  if(err < 0)
+  {
+    return err;
+  }
+  return dc->writeMeshToHDF5(dcGid, false);
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StreamingDataContainerBundle::StreamingDataContainerBundle(const QString& filePath)
+: m_PrefetchCount(2)
+, m_RetainCount(1)
+, m_WriteBackEvicted(false)
+, m_FilePath(filePath)
+, m_State(std::make_shared<StreamState>())
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StreamingDataContainerBundle::~StreamingDataContainerBundle()
+{
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  for(const auto& entry : m_State->entries)
+  {
+    if(entry.added && nullptr != entry.dataContainer.get())
+    {
+      queueWriteBack(entry.dataContainer);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString StreamingDataContainerBundle::getFilePath() const
+{
+  return m_FilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::setDataContainerNames(const QVector<QString>& names)
+{
+  m_Names = names;
+
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  for(auto iter = m_State->entries.begin(); iter != m_State->entries.end();)
+  {
+    if(m_Names.contains(iter.key()))
+    {
+      ++iter;
+      continue;
+    }
+    if(iter.value().added && nullptr != iter.value().dataContainer.get())
+    {
+      queueWriteBack(iter.value().dataContainer);
+    }
+    iter = m_State->entries.erase(iter);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<QString> StreamingDataContainerBundle::getDataContainerNames()
+{
+  return m_Names;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::addOrReplaceDataContainer(DataContainer::Pointer dc)
+{
+  if(nullptr == dc.get())
+  {
+    return;
+  }
+  qint32 index = m_Names.indexOf(dc->getName());
+  if(index < 0)
+  {
+    m_Names.append(dc->getName());
+    index = m_Names.size() - 1;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    StreamState::Entry& entry = m_State->entries[dc->getName()];
+    entry.dataContainer = dc;
+    entry.pending = false;
+    entry.added = true;
+  }
+  moveWindow(index);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::removeDataContainer(DataContainer::Pointer dc)
+{
+  if(nullptr != dc.get())
+  {
+    removeDataContainer(dc->getName());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::removeDataContainer(const QString& name)
+{
+  m_Names.removeAll(name);
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  m_State->entries.remove(name);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::removeDataContainer(qint32 i)
+{
+  if(i >= 0 && i < m_Names.size())
+  {
+    removeDataContainer(m_Names[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainer::Pointer StreamingDataContainerBundle::getDataContainer(qint32 index)
+{
+  if(index < 0 || index >= m_Names.size())
+  {
+    return DataContainer::NullPointer();
+  }
+  const QString name = m_Names[index];
+
+  DataContainer::Pointer dc;
+  bool pending = false;
+  H5BackgroundWriter::Ticket prefetch;
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    auto iter = m_State->entries.find(name);
+    if(iter != m_State->entries.end())
+    {
+      dc = iter.value().dataContainer;
+      pending = iter.value().pending;
+      prefetch = iter.value().prefetch;
+    }
+  }
+  if(nullptr == dc.get() && pending && prefetch.valid())
+  {
+    H5BackgroundWriter::Instance()->wait(prefetch);
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    dc = m_State->entries.value(name).dataContainer;
+  }
+  if(nullptr == dc.get())
+  {
+    // Not prefetched, or the prefetch failed. Reading it here reports the error to the caller.
+    DataContainerArrayProxy proxy;
+    if(m_State->findDataContainer(m_FilePath, name, proxy))
+    {
+      dc = readDataContainer(m_FilePath, name, proxy);
+    }
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    if(nullptr == dc.get())
+    {
+      m_State->entries.remove(name);
+      return dc;
+    }
+    StreamState::Entry& entry = m_State->entries[name];
+    entry.dataContainer = dc;
+    entry.pending = false;
+  }
+
+  moveWindow(index);
+  return dc;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::moveWindow(qint32 index)
+{
+  const qint32 first = index - std::max(m_RetainCount, 0);
+  const qint32 last = index + std::max(m_PrefetchCount, 0);
+
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  for(auto iter = m_State->entries.begin(); iter != m_State->entries.end();)
+  {
+    qint32 position = m_Names.indexOf(iter.key());
+    if(position >= first && position <= last)
+    {
+      ++iter;
+      continue;
+    }
+    const StreamState::Entry& entry = iter.value();
+    if(nullptr != entry.dataContainer.get() && (entry.added || m_WriteBackEvicted))
+    {
+      queueWriteBack(entry.dataContainer);
+    }
+    iter = m_State->entries.erase(iter);
+  }
+
+  std::weak_ptr<StreamState> weakState = m_State;
+  for(qint32 i = index + 1; i <= last && i < m_Names.size(); i++)
+  {
+    const QString name = m_Names[i];
+    if(m_State->entries.contains(name))
+    {
+      continue;
+    }
+    StreamState::Entry& entry = m_State->entries[name];
+    entry.pending = true;
+
+    QString filePath = m_FilePath;
+    entry.prefetch = H5BackgroundWriter::Instance()->enqueue([filePath, name, weakState](QString& message) {
+      std::shared_ptr<StreamState> state = weakState.lock();
+      if(nullptr == state.get())
+      {
+        return 0;
+      }
+      DataContainerArrayProxy proxy;
+      DataContainer::Pointer dc;
+      if(state->findDataContainer(filePath, name, proxy))
+      {
+        dc = readDataContainer(filePath, name, proxy);
+      }
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto iter = state->entries.find(name);
+        // The window may have moved on while the DataContainer was read
+        if(iter != state->entries.end() && iter.value().pending)
+        {
+          iter.value().dataContainer = dc;
+          iter.value().pending = false;
+          iter.value().prefetch = H5BackgroundWriter::Ticket();
+        }
+      }
+      // A failed prefetch is read again, and reported, when the DataContainer is asked for
+      return 0;
+    });
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::queueWriteBack(const DataContainer::Pointer& dc)
+{
+  DataContainer::Pointer snapshot = dc->createSharedCopy();
+  QString filePath = m_FilePath;
+  std::weak_ptr<StreamState> weakState = m_State;
+  H5BackgroundWriter::Ticket ticket = H5BackgroundWriter::Instance()->enqueue([filePath, snapshot, weakState](QString& message) {
+    int err = writeDataContainer(filePath, snapshot);
+    if(err < 0)
+    {
+      message = QObject::tr("Error writing DataContainer '%1' to '%2'").arg(snapshot->getName(), filePath);
+      return err;
+    }
+    std::shared_ptr<StreamState> state = weakState.lock();
+    if(nullptr != state.get())
+    {
+      state->updateFileStructure(snapshot);
+    }
+    return err;
+  });
+  // Called with m_State->mutex held
+  m_State->dropFinishedWrites();
+  m_State->writes.push_back(ticket);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint32 StreamingDataContainerBundle::count()
+{
+  return m_Names.count();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint32 StreamingDataContainerBundle::getNumberOfResidentDataContainers() const
+{
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  qint32 numResident = 0;
+  for(const auto& entry : m_State->entries)
+  {
+    if(nullptr != entry.dataContainer.get())
+    {
+      numResident++;
+    }
+  }
+  return numResident;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StreamingDataContainerBundle::clear()
+{
+  m_Names.clear();
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  m_State->entries.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StreamingDataContainerBundle::flush()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    for(auto& entry : m_State->entries)
+    {
+      if(nullptr != entry.dataContainer.get() && (entry.added || m_WriteBackEvicted))
+      {
+        queueWriteBack(entry.dataContainer);
+        entry.added = false;
+      }
+    }
+  }
+  std::vector<H5BackgroundWriter::Ticket> writes;
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    writes.swap(m_State->writes);
+  }
+
+  // Only this bundle's own jobs are waited for, other pipelines may be using the background writer as well
+  int err = 0;
+  H5BackgroundWriter* backgroundWriter = H5BackgroundWriter::Instance();
+  for(const auto& ticket : writes)
+  {
+    H5BackgroundWriter::JobResult result = backgroundWriter->wait(ticket);
+    if(result.code < 0)
+    {
+      qDebug() << result.message;
+      if(err == 0)
+      {
+        err = result.code;
+      }
+    }
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StreamingDataContainerBundle::writeH5Data(hid_t groupId)
+{
+  hid_t bundleId = QH5Utilities::createGroup(groupId, getName());
+  // This object will make sure the HDF5 Group id is closed when it goes out of scope.
+  H5GroupAutoCloser bundleIdClose(&bundleId);
+
+  QStringList dcNameList = m_Names.toList();
+
+  char sep = 0x1E; // Use the ASCII 'record separator' value (Decimal value 30) to separate the names
+  // Write the Names of the Data Containers that this bundle holds
+  QString nameList = dcNameList.join(QString(sep));
+  int err = QH5Lite::writeStringDataset(bundleId, SIMPL::StringConstants::DataContainerNames, nameList);
+  if(err < 0)
+  {
+    return err;
+  }
+
+  // Write the names of the Meta Data Attribute Arrays that this bundle uses for grouping
+  QString metaNameList = m_MetaDataArrays.join(QString(sep));
+  err = QH5Lite::writeStringDataset(bundleId, SIMPL::StringConstants::MetaDataArrays, metaNameList);
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int StreamingDataContainerBundle::readH5Data(hid_t groupId)
+{
+  int err = -1;
+
+  return err;
+}
@@ -0,0 +1,230 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/IDataContainerBundle.h"
+
+/**
+ * @brief The StreamingDataContainerBundle class is a DataContainerBundle for series that are too long to keep in
+ * memory, for example hundreds of serial sections or time steps. The DataContainers live in a .dream3d file and only
+ * a sliding window of them is resident at any time.
+ *
+ * Asking for the DataContainer at an index makes that index the current position of the window. The bundle keeps
+ * RetainCount DataContainers before the current one and PrefetchCount after it. The ones after it are read on the
+ * H5BackgroundWriter thread while the caller works on the current one. DataContainers that leave the window are
+ * released. DataContainers that were added to the bundle, and all evicted DataContainers when WriteBackEvicted is
+ * set, are written to the file first so that they can be read again later.
+ *
+ * A DataContainer that is written again replaces its group in the file. HDF5 never reuses the space of an unlinked
+ * group, so a file whose DataContainers are written back many times keeps growing. Once the series is done, run
+ * h5repack on the file (h5repack series.dream3d compact.dream3d) to copy only the live objects into a new file.
+ *
+ * The bundle must only be used from one thread at a time.
+ */
+class SIMPLib_EXPORT StreamingDataContainerBundle : public IDataContainerBundle
+{
+    Q_OBJECT
+  public:
+    SIMPL_SHARED_POINTERS(StreamingDataContainerBundle)
+    SIMPL_TYPE_MACRO_SUPER_OVERRIDE(StreamingDataContainerBundle, IDataContainerBundle)
+
+    /**
+     * @brief Writes the DataContainers that were added to the bundle and are still resident to the file
+     */
+    ~StreamingDataContainerBundle() override;
+
+    /**
+     * @brief Creates a new StreamingDataContainerBundle
+     * @param name The Name of the Bundle
+     * @param filePath The .dream3d file that holds the DataContainers. It is created when the first DataContainer
+     * is written to it if it does not exist.
+     * @return
+     */
+    static Pointer New(const QString& name, const QString& filePath)
+    {
+      Pointer sharedPtr(new StreamingDataContainerBundle(filePath));
+      sharedPtr->setName(name);
+      return sharedPtr;
+    }
+
+    /**
+     * @brief The name of this DataContainerBundle
+     */
+    SIMPL_INSTANCE_STRING_PROPERTY_OVERRIDE(Name)
+
+    /**
+     * @brief The names of the arrays in the "Meta Data" AttributeMatrix that define why the DataContainers were grouped
+     * into this bundle. @see DataContainerBundle
+     */
+    SIMPL_INSTANCE_PROPERTY(QStringList, MetaDataArrays)
+
+    /**
+     * @brief Number of DataContainers after the current one that are read ahead of time. Defaults to 2.
+     */
+    SIMPL_INSTANCE_PROPERTY(int, PrefetchCount)
+
+    /**
+     * @brief Number of DataContainers before the current one that stay in memory. Defaults to 1.
+     */
+    SIMPL_INSTANCE_PROPERTY(int, RetainCount)
+
+    /**
+     * @brief Writes every evicted DataContainer back to the file, not only the ones that were added to the bundle.
+     * Set this when the DataContainers read from the file are modified. Defaults to false.
+     */
+    SIMPL_INSTANCE_PROPERTY(bool, WriteBackEvicted)
+
+    /**
+     * @brief Returns the .dream3d file that holds the DataContainers
+     * @return
+     */
+    QString getFilePath() const;
+
+    /**
+     * @brief Sets the order of the series. Each name must be a DataContainer in the file. DataContainers that are
+     * resident and not in the list are released.
+     * @param names
+     */
+    void setDataContainerNames(const QVector<QString>& names);
+    QVector<QString> getDataContainerNames() override;
+
+    /**
+     * @brief Appends a DataContainer to the series, or replaces the one with the same name, and makes it the
+     * current position of the window. It is written to the file when it leaves the window.
+     * @param dc
+     */
+    void addOrReplaceDataContainer(DataContainer::Pointer dc) override;
+
+    /**
+     * @brief Removes a DataContainer from the series. The file is not modified.
+     * @param dc
+     */
+    void removeDataContainer(DataContainer::Pointer dc) override;
+
+    /**
+     * @brief Removes a DataContainer by name from the series. The file is not modified.
+     * @param name
+     */
+    void removeDataContainer(const QString& name) override;
+
+    /**
+     * @brief Removes a DataContainer by index from the series. The file is not modified.
+     * @param i
+     */
+    void removeDataContainer(qint32 i) override;
+
+    /**
+     * @brief Returns the DataContainer at a given index and moves the window there. Waits for the DataContainer if it
+     * is still being prefetched and reads it if it was not. Returns a null pointer if it could not be read.
+     * @param index
+     * @return
+     */
+    DataContainer::Pointer getDataContainer(qint32 index) override;
+
+    /**
+     * @brief Returns the number of DataContainers in the series, resident or not
+     * @return
+     */
+    qint32 count() override;
+
+    /**
+     * @brief Returns the number of DataContainers that are currently held in memory, including the ones that
+     * finished prefetching
+     * @return
+     */
+    qint32 getNumberOfResidentDataContainers() const;
+
+    /**
+     * @brief Forgets the series and releases every resident DataContainer without writing it
+     */
+    void clear() override;
+
+    /**
+     * @brief Writes every resident DataContainer that was added to the bundle, or all of them when WriteBackEvicted
+     * is set, to the file and waits until they and the DataContainers evicted earlier are written
+     * @return 0 on success or the error code of the first write that failed since the last flush
+     */
+    int flush();
+
+    /**
+     * @brief writeH5Data Writes the names of the series to an HDF5 file in the same layout as a DataContainerBundle
+     * @param groupId
+     * @return
+     */
+    int writeH5Data(hid_t groupId) override;
+
+    /**
+     * @brief readH5Data Not supported
+     * @param groupId
+     * @return
+     */
+    int readH5Data(hid_t groupId) override;
+
+  protected:
+    StreamingDataContainerBundle(const QString& filePath);
+
+    /**
+     * @brief Moves the window to index: evicts the DataContainers that fall out of it and prefetches the ones after it
+     * @param index
+     */
+    void moveWindow(qint32 index);
+
+    /**
+     * @brief Queues writing a copy of the DataContainer to the file so that the caller can keep using the original
+     * @param dc
+     */
+    void queueWriteBack(const DataContainer::Pointer& dc);
+
+  private:
+    struct StreamState;
+
+    QString m_FilePath;
+    QVector<QString> m_Names;
+    std::shared_ptr<StreamState> m_State;
+
+  public:
+    StreamingDataContainerBundle(const StreamingDataContainerBundle&) = delete; // Copy Constructor Not Implemented
+    StreamingDataContainerBundle(StreamingDataContainerBundle&&) = delete;      // Move Constructor Not Implemented
+    StreamingDataContainerBundle& operator=(const StreamingDataContainerBundle&) = delete; // Copy Assignment Not Implemented
+    StreamingDataContainerBundle& operator=(StreamingDataContainerBundle&&) = delete;      // Move Assignment Not Implemented
+};
@@ -43,6 +43,8 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainerBundle.h"
+#include "SIMPLib/DataContainers/StreamingDataContainerBundle.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
 #include "SIMPLib/SIMPLib.h"
 
 #include "SIMPLib/Testing/SIMPLTestFileLocations.h"
@@ -125,6 +127,93 @@ public:
     DREAM3D_REQUIRE_EQUAL(count, 2)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainer::Pointer CreateSlice(int32_t slice)
+  {
+    std::vector<size_t> tDims = {8, 6};
+    DataContainer::Pointer dc = DataContainer::New(QString("Slice %1").arg(slice));
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, "CellAttributeMatrix", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer data = Int32ArrayType::CreateArray(tDims, std::vector<size_t>(1, 1), "Slice Index", true);
+    data->initializeWithValue(slice);
+    am->insertOrAssign(data);
+    dc->addOrReplaceAttributeMatrix(am);
+    return dc;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestStreamingBundle()
+  {
+    const int32_t numSlices = 12;
+    QDir dir(UnitTest::DataContainerBundleTest::TestDir);
+    dir.mkpath(".");
+    QFile::remove(UnitTest::DataContainerBundleTest::TestFile);
+
+    // Slices that arrive one after the other are written to the file as they leave the window
+    {
+      StreamingDataContainerBundle::Pointer bundle = StreamingDataContainerBundle::New("Series", UnitTest::DataContainerBundleTest::TestFile);
+      bundle->setRetainCount(2);
+      for(int32_t i = 0; i < numSlices; i++)
+      {
+        bundle->addOrReplaceDataContainer(CreateSlice(i));
+        DREAM3D_REQUIRE(bundle->getNumberOfResidentDataContainers() <= 3)
+      }
+      DREAM3D_REQUIRE_EQUAL(bundle->count(), numSlices)
+      DREAM3D_REQUIRE_EQUAL(bundle->flush(), 0)
+
+      // A slice that was written back is read again through the structure the bundle keeps of its file
+      DataContainer::Pointer dc = bundle->getDataContainer(0);
+      DREAM3D_REQUIRE_VALID_POINTER(dc.get())
+      DREAM3D_REQUIRE_EQUAL(dc->getAttributeMatrix("CellAttributeMatrix")->getAttributeArrayAs<Int32ArrayType>("Slice Index")->getValue(47), 0)
+    }
+
+    // Writes that fail are reported by flush()
+    {
+      StreamingDataContainerBundle::Pointer bundle = StreamingDataContainerBundle::New("Series", UnitTest::DataContainerBundleTest::TestDir + "/Missing/Series.dream3d");
+      bundle->setRetainCount(0);
+      bundle->setPrefetchCount(0);
+      bundle->addOrReplaceDataContainer(CreateSlice(0));
+      bundle->addOrReplaceDataContainer(CreateSlice(1));
+      DREAM3D_REQUIRE(bundle->flush() < 0)
+      DREAM3D_REQUIRE_EQUAL(bundle->flush(), 0)
+      bundle->clear();
+    }
+
+    StreamingDataContainerBundle::Pointer bundle = StreamingDataContainerBundle::New("Series", UnitTest::DataContainerBundleTest::TestFile);
+    QVector<QString> names;
+    for(int32_t i = 0; i < numSlices; i++)
+    {
+      names.push_back(QString("Slice %1").arg(i));
+    }
+    bundle->setDataContainerNames(names);
+    bundle->setPrefetchCount(3);
+    bundle->setRetainCount(1);
+    DREAM3D_REQUIRE_EQUAL(bundle->getNumberOfResidentDataContainers(), 0)
+
+    for(int32_t i = 0; i < numSlices; i++)
+    {
+      DataContainer::Pointer dc = bundle->getDataContainer(i);
+      DREAM3D_REQUIRE_VALID_POINTER(dc.get())
+      DREAM3D_REQUIRE(dc->getName() == names[i])
+      Int32ArrayType::Pointer data = dc->getAttributeMatrix("CellAttributeMatrix")->getAttributeArrayAs<Int32ArrayType>("Slice Index");
+      DREAM3D_REQUIRE_VALID_POINTER(data.get())
+      DREAM3D_REQUIRE_EQUAL(data->getNumberOfTuples(), 48)
+      DREAM3D_REQUIRE_EQUAL(data->getValue(47), i)
+      // The current slice, one before it and up to three prefetched after it
+      DREAM3D_REQUIRE(bundle->getNumberOfResidentDataContainers() <= 5)
+    }
+
+    // Going back reads the slice again
+    DataContainer::Pointer dc = bundle->getDataContainer(0);
+    DREAM3D_REQUIRE_VALID_POINTER(dc.get())
+    DREAM3D_REQUIRE_EQUAL(dc->getAttributeMatrix("CellAttributeMatrix")->getAttributeArrayAs<Int32ArrayType>("Slice Index")->getValue(0), 0)
+    DREAM3D_REQUIRE_NULL_POINTER(bundle->getDataContainer(numSlices).get())
+    H5BackgroundWriter::Instance()->waitForPendingWrites();
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -142,6 +231,7 @@ public:
 #endif
 
     DREAM3D_REGISTER_TEST(TestDataBundleCommonPaths())
+    DREAM3D_REGISTER_TEST(TestStreamingBundle())
 
 #if REMOVE_TEST_FILES
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
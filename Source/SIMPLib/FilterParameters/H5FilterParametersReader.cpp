@@ -50,6 +50,8 @@
 #include "SIMPLib/FilterParameters/H5FilterParametersConstants.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 #include "SIMPLib/Messages/PipelineErrorMessage.h"
 
 // -----------------------------------------------------------------------------
@@ -78,6 +80,9 @@ hid_t H5FilterParametersReader::getCurrentGroupId() const
 // -----------------------------------------------------------------------------
 H5FilterParametersReader::Pointer H5FilterParametersReader::OpenDREAM3DFileForReadingPipeline(QString filePath, hid_t& fid)
 {
+  // The file may still be written in the background and other threads call into HDF5 as well
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+  H5LibraryLock libraryLock;
   fid = -1;
   fid = QH5Utilities::openFile(filePath);
   if(fid < 0)
@@ -102,6 +107,7 @@ H5FilterParametersReader::Pointer H5FilterParametersReader::OpenDREAM3DFileForRe
 // -----------------------------------------------------------------------------
 FilterPipeline::Pointer H5FilterParametersReader::readPipelineFromFile(hid_t fid, IObserver* obs)
 {
+  H5LibraryLock libraryLock;
 
   // Open the Pipeline Group
   hid_t pipelineGroupId = H5Gopen(fid, SIMPL::StringConstants::PipelineGroupName.toLatin1().data(), H5P_DEFAULT);
@@ -190,6 +196,9 @@ FilterPipeline::Pointer H5FilterParametersReader::readPipelineFromFile(hid_t fid
 // -----------------------------------------------------------------------------
 FilterPipeline::Pointer H5FilterParametersReader::readPipelineFromFile(QString filePath, IObserver* obs)
 {
+  // The file may still be written in the background and other threads call into HDF5 as well
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+  H5LibraryLock libraryLock;
   hid_t fid = -1;
   fid = QH5Utilities::openFile(filePath);
   if(fid < 0)
@@ -208,6 +217,9 @@ FilterPipeline::Pointer H5FilterParametersReader::readPipelineFromFile(QString f
 // -----------------------------------------------------------------------------
 QString H5FilterParametersReader::getJsonFromFile(QString filePath, IObserver* obs)
 {
+  // The file may still be written in the background and other threads call into HDF5 as well
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+  H5LibraryLock libraryLock;
   hid_t fid = -1;
   fid = QH5Utilities::openFile(filePath);
   if(fid < 0)
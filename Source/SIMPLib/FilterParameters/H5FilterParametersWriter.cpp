@@ -46,6 +46,8 @@
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/H5FilterParametersConstants.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 #include "SIMPLib/Messages/PipelineErrorMessage.h"
 #include "SIMPLib/Messages/GenericErrorMessage.h"
 #include "SIMPLib/SIMPLibVersion.h"
@@ -91,6 +93,9 @@ int H5FilterParametersWriter::writePipelineToFile(FilterPipeline::Pointer pipeli
   }
 
   // WRITE THE PIPELINE TO THE HDF5 FILE
+  // The file may still be written in the background and other threads call into HDF5 as well
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+  H5LibraryLock libraryLock;
   hid_t fileId = -1;
 
   QFileInfo fi(filePath);
@@ -130,20 +135,31 @@ int H5FilterParametersWriter::writePipelineToFile(FilterPipeline::Pointer pipeli
   QH5Lite::writeStringAttribute(fileId, "/", SIMPL::HDF5::FileVersionName, SIMPL::HDF5::FileVersion);
   QH5Lite::writeStringAttribute(fileId, "/", SIMPL::HDF5::DREAM3DVersion, SIMPLib::Version::Complete());
 
-  hid_t pipelineGroupId = QH5Utilities::createGroup(fileId, SIMPL::StringConstants::PipelineGroupName);
-  scopedFileSentinel.addGroupId(&pipelineGroupId);
-  setGroupId(pipelineGroupId);
-
-  QH5Lite::writeScalarAttribute(pipelineGroupId, "/" + SIMPL::StringConstants::PipelineGroupName, SIMPL::StringConstants::PipelineVersionName, 2);
-  QH5Lite::writeStringAttribute(pipelineGroupId, "/" + SIMPL::StringConstants::PipelineGroupName, SIMPL::StringConstants::PipelineCurrentName, pipelineName);
-
   JsonFilterParametersWriter::Pointer jsonWriter = JsonFilterParametersWriter::New();
   QString jsonString = jsonWriter->writePipelineToString(pipeline, pipelineName, obs);
-  QH5Lite::writeStringDataset(pipelineGroupId, pipelineName, jsonString);
+  WritePipelineJson(fileId, pipelineName, jsonString);
 
   return 0;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5FilterParametersWriter::WritePipelineJson(hid_t fileId, const QString& pipelineName, const QString& jsonString)
+{
+  H5LibraryLock libraryLock;
+  hid_t pipelineGroupId = QH5Utilities::createGroup(fileId, SIMPL::StringConstants::PipelineGroupName);
+  if(pipelineGroupId < 0)
+  {
+    return -1;
+  }
+  H5GroupAutoCloser groupCloser(&pipelineGroupId);
+
+  QH5Lite::writeScalarAttribute(pipelineGroupId, "/" + SIMPL::StringConstants::PipelineGroupName, SIMPL::StringConstants::PipelineVersionName, 2);
+  QH5Lite::writeStringAttribute(pipelineGroupId, "/" + SIMPL::StringConstants::PipelineGroupName, SIMPL::StringConstants::PipelineCurrentName, pipelineName);
+  return QH5Lite::writeStringDataset(pipelineGroupId, pipelineName, jsonString);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
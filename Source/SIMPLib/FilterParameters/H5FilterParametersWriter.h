@@ -68,6 +68,16 @@ class SIMPLib_EXPORT H5FilterParametersWriter : public AbstractFilterParametersW
      */
     int writePipelineToFile(FilterPipeline::Pointer pipeline, QString filePath, QString pipelineName, QList<IObserver*> obs = QList<IObserver*>()) override;
 
+    /**
+     * @brief WritePipelineJson Writes a pipeline that was already converted to Json into the Pipeline group of an open
+     * DREAM3D file
+     * @param fileId The open HDF5 file
+     * @param pipelineName The name of the pipeline
+     * @param jsonString The pipeline as written by JsonFilterParametersWriter::writePipelineToString
+     * @return
+     */
+    static int WritePipelineJson(hid_t fileId, const QString& pipelineName, const QString& jsonString);
+
     SIMPL_INSTANCE_PROPERTY(hid_t, PipelineGroupId)
 
     ~H5FilterParametersWriter() override;
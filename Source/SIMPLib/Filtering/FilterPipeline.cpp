@@ -49,7 +49,9 @@
 #include "SIMPLib/Filtering/FilterManager.h"
 
 #include "SIMPLib/CoreFilters/DataContainerReader.h"
+#include "SIMPLib/CoreFilters/DataContainerWriter.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
 #include "SIMPLib/Utilities/StringOperations.h"
 
 #define RENAME_ENABLED 1
@@ -90,7 +92,8 @@ class PipelineIdleException : public std::exception
 //
 // -----------------------------------------------------------------------------
 FilterPipeline::FilterPipeline()
-: m_PipelineName("")
+: m_MemoryPool(DataArrayMemoryPool::New())
+, m_PipelineName("")
 , m_Dca(nullptr)
 {
 }
@@ -838,6 +841,9 @@ DataContainerArray::Pointer FilterPipeline::execute(DataContainerArray::Pointer
 
   int err = 0;
 
+  // Arrays created and removed by the filters recycle their memory through the pipeline's pool
+  DataArrayMemoryPool::ScopedActivation poolActivation(m_MemoryPool);
+
   connectSignalsSlots();
 
   m_ExecutionResult = FilterPipeline::ExecutionResult::Invalid;
@@ -866,10 +872,25 @@ DataContainerArray::Pointer FilterPipeline::execute(DataContainerArray::Pointer
       disconnectFilterNotifications(filt.get());
       filt->setDataContainerArray(DataContainerArray::NullPointer());
       err = filt->getErrorCode();
-      if(err < 0)
+      // An array read on demand that could not be read would silently hand its initialization value to the next filter
+      DataArrayPath failedRead = (err < 0) ? DataArrayPath() : findFailedDeferredRead();
+      if(err >= 0 && !failedRead.isEmpty())
+      {
+        err = -210;
+        ss = QObject::tr("[%1/%2] %3 accessed the array '%4' whose values could not be read from its file.")
+                 .arg(filtIndex + 1)
+                 .arg(m_Pipeline.size())
+                 .arg(filt->getHumanLabel())
+                 .arg(failedRead.serialize("/"));
+        setErrorCondition(err, ss);
+      }
+      else if(err < 0)
       {
         ss = QObject::tr("[%1/%2] %3 caused an error during execution.").arg(filtIndex+1).arg(m_Pipeline.size()).arg(filt->getHumanLabel());
         setErrorCondition(err, ss);
+      }
+      if(err < 0)
+      {
 
         notifyProgressMessage(100, "");
 
@@ -878,6 +899,8 @@ DataContainerArray::Pointer FilterPipeline::execute(DataContainerArray::Pointer
         disconnectSignalsSlots();
         m_State = FilterPipeline::State::Idle;
         m_ExecutionResult = FilterPipeline::ExecutionResult::Failed;
+        waitForBackgroundWrites();
+        trimMemoryPool();
         return m_Dca;
       }
     }
@@ -897,6 +920,9 @@ DataContainerArray::Pointer FilterPipeline::execute(DataContainerArray::Pointer
 
   disconnectSignalsSlots();
 
+  // Files written in the background must be complete before the pipeline reports that it has finished
+  int numFailedWrites = waitForBackgroundWrites();
+
   switch(m_State)
   {
   case FilterPipeline::State::Canceling:
@@ -912,13 +938,92 @@ DataContainerArray::Pointer FilterPipeline::execute(DataContainerArray::Pointer
     break;
   }
 
+  if(numFailedWrites > 0)
+  {
+    m_ExecutionResult = FilterPipeline::ExecutionResult::Failed;
+  }
+
   m_State = FilterPipeline::State::Idle;
 
+  trimMemoryPool();
+
   emit pipelineFinished();
 
   return m_Dca;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterPipeline::trimMemoryPool()
+{
+  if(nullptr != m_MemoryPool)
+  {
+    m_MemoryPool->trim();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FilterPipeline::waitForBackgroundWrites()
+{
+  // Only the jobs of this pipeline's own filters are waited for, other pipelines may be writing at the same time
+  std::vector<H5BackgroundWriter::Ticket> tickets;
+  for(const auto& filter : m_Pipeline)
+  {
+    DataContainerWriter::Pointer writer = std::dynamic_pointer_cast<DataContainerWriter>(filter);
+    if(nullptr != writer.get())
+    {
+      std::vector<H5BackgroundWriter::Ticket> writerTickets = writer->takeBackgroundWrites();
+      tickets.insert(tickets.end(), writerTickets.begin(), writerTickets.end());
+    }
+  }
+  if(!tickets.empty())
+  {
+    notifyStatusMessage("Waiting for background writes to finish");
+  }
+
+  int numFailures = 0;
+  H5BackgroundWriter* backgroundWriter = H5BackgroundWriter::Instance();
+  for(const auto& ticket : tickets)
+  {
+    H5BackgroundWriter::JobResult result = backgroundWriter->wait(ticket);
+    if(result.code < 0)
+    {
+      setErrorCondition(result.code, result.message);
+      numFailures++;
+    }
+  }
+  return numFailures;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayPath FilterPipeline::findFailedDeferredRead() const
+{
+  if(nullptr == m_Dca.get())
+  {
+    return DataArrayPath();
+  }
+  for(const DataContainer::Pointer& dc : m_Dca->getDataContainers())
+  {
+    for(const AttributeMatrix::Pointer& am : dc->getAttributeMatrices())
+    {
+      for(const QString& daName : am->getAttributeArrayNames())
+      {
+        IDataArray::Pointer array = am->getAttributeArray(daName);
+        if(nullptr != array.get() && array->hasDeferredReadFailed())
+        {
+          return DataArrayPath(dc->getName(), am->getName(), daName);
+        }
+      }
+    }
+  }
+  return DataArrayPath();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -43,6 +43,7 @@
 
 #include "SIMPLib/Common/Observer.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArrayMemoryPool.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
 
@@ -114,6 +115,13 @@ public:
   SIMPL_GET_PROPERTY(int, WarningCode)
   SIMPL_INSTANCE_PROPERTY(AbstractFilter::Pointer, CurrentFilter)
 
+  /**
+   * @brief The memory pool that serves large DataArray allocations made on the executing thread while the
+   * pipeline executes. Cached blocks are trimmed when execution ends. Set a null pointer to allocate straight
+   * from the heap.
+   */
+  SIMPL_INSTANCE_PROPERTY(DataArrayMemoryPool::Pointer, MemoryPool)
+
   /**
    * @brief Returns true if the pipeline is executing
    * @return
@@ -268,6 +276,24 @@ protected:
 
   void updatePrevNextFilters();
 
+  /**
+   * @brief Returns the blocks cached by the memory pool to the system
+   */
+  void trimMemoryPool();
+
+  /**
+   * @brief Waits for the files that the filters of this pipeline queued on the H5BackgroundWriter and reports the writes that failed
+   * @return The number of failed writes
+   */
+  int waitForBackgroundWrites();
+
+  /**
+   * @brief Returns the path of the first DataArray whose values were read on demand and could not be read, or an
+   * empty path if there is none. Such an array holds its initialization value or nothing at all.
+   * @return
+   */
+  DataArrayPath findFailedDeferredRead() const;
+
 signals:
   void messageGenerated(AbstractMessage::Pointer message);
 
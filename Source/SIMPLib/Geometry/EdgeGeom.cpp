@@ -186,6 +186,7 @@ void EdgeGeom::initializeWithZeros()
 {
   m_VertexList->initializeWithZeros();
   m_EdgeList->initializeWithZeros();
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -306,6 +307,27 @@ void EdgeGeom::deleteElementNeighbors()
   m_EdgeNeighbors = ElementDynamicList::NullPointer();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer EdgeGeom::createSpatialIndex()
+{
+  SpatialIndex::Pointer index = SpatialIndex::New();
+  if(index->build(m_VertexList, m_EdgeList) < 0)
+  {
+    return SpatialIndex::NullPointer();
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EdgeGeom::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  return index->isBuiltFrom(m_VertexList, m_EdgeList);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -381,6 +381,19 @@ protected:
    */
   void setElementSizes(FloatArrayType::Pointer elementSizes) override;
 
+  /**
+   * @brief createSpatialIndex
+   * @return
+   */
+  SpatialIndex::Pointer createSpatialIndex() override;
+
+  /**
+   * @brief isSpatialIndexCurrent
+   * @param index
+   * @return
+   */
+  bool isSpatialIndexCurrent(const SpatialIndex::Pointer& index) override;
+
 private:
   SharedVertexList::Pointer m_VertexList;
   SharedEdgeList::Pointer m_EdgeList;
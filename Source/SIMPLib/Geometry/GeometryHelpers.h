@@ -31,9 +31,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
-#include <map>
-#include <set>
 
 #include <QtCore/QString>
 
@@ -46,6 +47,11 @@
 #include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
 
 /**
 * @brief This file contains a namespace with classes for manipulating IGeometry objects
@@ -178,37 +184,258 @@ public:
     {
       return err;
     }
-    int32_t rank = 0;
-    hsize_t dims[2] = {0, 2ULL};
-    size_t total = 0;
-    for(size_t v = 0; v < numElems; ++v)
+
+    // Copy the offsets and indices straight into the interleaved layout the files use
+    std::vector<uint8_t> buffer;
+    dynamicList->serializeLinks(buffer, numElems);
+
+    int32_t rank = 1;
+    hsize_t dims[1] = {buffer.size()};
+    err = QH5Lite::writePointerDataset(parentId, name, rank, dims, buffer.data());
+    return err;
+  }
+};
+
+/**
+ * @brief The CountElementsContainingVertImpl class counts the number of elements that reference each vertex
+ */
+template <typename K> class CountElementsContainingVertImpl
+{
+public:
+  CountElementsContainingVertImpl(const K* elems, size_t numVertsPerElem, std::vector<std::atomic<size_t>>& counts)
+  : m_Elems(elems)
+  , m_NumVertsPerElem(numVertsPerElem)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t elemId = range.min(); elemId < range.max(); elemId++)
+    {
+      const K* verts = m_Elems + elemId * m_NumVertsPerElem;
+      for(size_t j = 0; j < m_NumVertsPerElem; j++)
+      {
+        m_Counts[verts[j]].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  const K* m_Elems;
+  size_t m_NumVertsPerElem;
+  std::vector<std::atomic<size_t>>& m_Counts;
+};
+
+/**
+ * @brief The ScatterElementsContainingVertImpl class places each element into the list of every vertex it references.
+ * The cursors start at the offset of each vertex list and are advanced atomically.
+ */
+template <typename K> class ScatterElementsContainingVertImpl
+{
+public:
+  ScatterElementsContainingVertImpl(const K* elems, size_t numVertsPerElem, std::vector<std::atomic<size_t>>& cursors, K* indices)
+  : m_Elems(elems)
+  , m_NumVertsPerElem(numVertsPerElem)
+  , m_Cursors(cursors)
+  , m_Indices(indices)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t elemId = range.min(); elemId < range.max(); elemId++)
     {
-      total += dynamicList->getNumberOfElements(v);
+      const K* verts = m_Elems + elemId * m_NumVertsPerElem;
+      for(size_t j = 0; j < m_NumVertsPerElem; j++)
+      {
+        m_Indices[m_Cursors[verts[j]].fetch_add(1, std::memory_order_relaxed)] = static_cast<K>(elemId);
+      }
     }
+  }
 
-    size_t totalBytes = numElems * sizeof(T) + total * sizeof(K);
+private:
+  const K* m_Elems;
+  size_t m_NumVertsPerElem;
+  std::vector<std::atomic<size_t>>& m_Cursors;
+  K* m_Indices;
+};
 
-    // Allocate a flat array to copy the data into
-    QVector<uint8_t> buffer(totalBytes, 0);
-    uint8_t* bufPtr = &(buffer.front());
-    size_t offset = 0;
+/**
+ * @brief The SortElementListsImpl class sorts each list so the result does not depend on the order the threads ran in
+ */
+template <typename K> class SortElementListsImpl
+{
+public:
+  SortElementListsImpl(const size_t* offsets, K* indices)
+  : m_Offsets(offsets)
+  , m_Indices(indices)
+  {
+  }
 
-    for(size_t v = 0; v < numElems; ++v)
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t v = range.min(); v < range.max(); v++)
     {
-      T nelems = dynamicList->getNumberOfElements(v);
-      K* elems = dynamicList->getElementListPointer(v);
-      ::memcpy(bufPtr + offset, &nelems, sizeof(T));
-      offset += sizeof(T);
-      ::memcpy(bufPtr + offset, elems, nelems * sizeof(K));
-      offset += nelems * sizeof(K);
+      std::sort(m_Indices + m_Offsets[v], m_Indices + m_Offsets[v + 1]);
     }
+  }
 
-    rank = 1;
-    dims[0] = totalBytes;
+private:
+  const size_t* m_Offsets;
+  K* m_Indices;
+};
 
-    err = QH5Lite::writePointerDataset(parentId, name, rank, dims, bufPtr);
-    return err;
+/**
+ * @brief The FindElementNeighborsImpl class finds the elements that share numSharedVerts vertices with each element,
+ * in the order of the element's vertices and of the lists in elemsContainingVert. The range is over blocks of
+ * blockSize elements. The neighbors of each block are appended to its own buffer and the number of neighbors of
+ * element t is stored at counts[t + 1], so the blocks can be processed in any order.
+ */
+template <typename K> class FindElementNeighborsImpl
+{
+public:
+  FindElementNeighborsImpl(const K* elems, size_t numElems, size_t numVertsPerElem, size_t numSharedVerts, const size_t* vertOffsets, const K* vertIndices, size_t blockSize,
+                           std::vector<std::vector<K>>& blockNeighbors, size_t* counts)
+  : m_Elems(elems)
+  , m_NumElems(numElems)
+  , m_NumVertsPerElem(numVertsPerElem)
+  , m_NumSharedVerts(numSharedVerts)
+  , m_VertOffsets(vertOffsets)
+  , m_VertIndices(vertIndices)
+  , m_BlockSize(blockSize)
+  , m_BlockNeighbors(blockNeighbors)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      std::vector<K>& neighbors = m_BlockNeighbors[block];
+      size_t end = std::min(m_NumElems, (block + 1) * m_BlockSize);
+      for(size_t t = block * m_BlockSize; t < end; t++)
+      {
+        size_t first = neighbors.size();
+        const K* seedElem = m_Elems + t * m_NumVertsPerElem;
+        for(size_t v = 0; v < m_NumVertsPerElem; v++)
+        {
+          const K* vertIdxs = m_VertIndices + m_VertOffsets[seedElem[v]];
+          const K* vertIdxsEnd = m_VertIndices + m_VertOffsets[seedElem[v] + 1];
+          for(; vertIdxs != vertIdxsEnd; ++vertIdxs)
+          {
+            K elemId = *vertIdxs;
+            // Skip the source element and the elements we already added
+            if(elemId == static_cast<K>(t) || std::find(neighbors.begin() + first, neighbors.end(), elemId) != neighbors.end())
+            {
+              continue;
+            }
+            const K* vertCell = m_Elems + static_cast<size_t>(elemId) * m_NumVertsPerElem;
+            size_t vCount = 0;
+            for(size_t i = 0; i < m_NumVertsPerElem; i++)
+            {
+              for(size_t j = 0; j < m_NumVertsPerElem; j++)
+              {
+                if(seedElem[i] == vertCell[j])
+                {
+                  vCount++;
+                }
+              }
+            }
+            if(vCount == m_NumSharedVerts)
+            {
+              neighbors.push_back(elemId);
+            }
+          }
+        }
+        m_Counts[t + 1] = neighbors.size() - first;
+      }
+    }
+  }
+
+private:
+  const K* m_Elems;
+  size_t m_NumElems;
+  size_t m_NumVertsPerElem;
+  size_t m_NumSharedVerts;
+  const size_t* m_VertOffsets;
+  const K* m_VertIndices;
+  size_t m_BlockSize;
+  std::vector<std::vector<K>>& m_BlockNeighbors;
+  size_t* m_Counts;
+};
+
+/**
+ * @brief The CopyBlockNeighborsImpl class moves the neighbors found for each block of elements into the flat index
+ * buffer and releases the block buffer
+ */
+template <typename K> class CopyBlockNeighborsImpl
+{
+public:
+  CopyBlockNeighborsImpl(size_t blockSize, const size_t* offsets, std::vector<std::vector<K>>& blockNeighbors, K* indices)
+  : m_BlockSize(blockSize)
+  , m_Offsets(offsets)
+  , m_BlockNeighbors(blockNeighbors)
+  , m_Indices(indices)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      std::vector<K>& neighbors = m_BlockNeighbors[block];
+      std::copy(neighbors.begin(), neighbors.end(), m_Indices + m_Offsets[block * m_BlockSize]);
+      std::vector<K>().swap(neighbors);
+    }
+  }
+
+private:
+  size_t m_BlockSize;
+  const size_t* m_Offsets;
+  std::vector<std::vector<K>>& m_BlockNeighbors;
+  K* m_Indices;
+};
+
+/**
+ * @brief The GatherElementKeysImpl class writes the sorted vertex ids of every edge or face of each element. Element
+ * i owns the keys starting at i * localKeys.size(), so the threads never write to the same key.
+ */
+template <typename T, size_t N> class GatherElementKeysImpl
+{
+public:
+  GatherElementKeysImpl(const T* elems, size_t numVertsPerElem, const std::vector<std::array<size_t, N>>& localKeys, std::array<T, N>* keys)
+  : m_Elems(elems)
+  , m_NumVertsPerElem(numVertsPerElem)
+  , m_LocalKeys(localKeys)
+  , m_Keys(keys)
+  {
   }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numKeysPerElem = m_LocalKeys.size();
+    for(size_t elemId = range.min(); elemId < range.max(); elemId++)
+    {
+      const T* verts = m_Elems + elemId * m_NumVertsPerElem;
+      std::array<T, N>* keys = m_Keys + elemId * numKeysPerElem;
+      for(size_t k = 0; k < numKeysPerElem; k++)
+      {
+        for(size_t n = 0; n < N; n++)
+        {
+          keys[k][n] = verts[m_LocalKeys[k][n]];
+        }
+        std::sort(keys[k].begin(), keys[k].end());
+      }
+    }
+  }
+
+private:
+  const T* m_Elems;
+  size_t m_NumVertsPerElem;
+  const std::vector<std::array<size_t, N>>& m_LocalKeys;
+  std::array<T, N>* m_Keys;
 };
 
 /**
@@ -231,39 +458,35 @@ public:
   {
     size_t numElems = elemList->getNumberOfTuples();
     size_t numVertsPerElem = elemList->getNumberOfComponents();
+    const K* elems = elemList->getConstPointer(0);
 
-    // Allocate the basic structures
-    QVector<T> linkCount(numVerts, 0);
-    size_t elemId = 0;
-
-    // Fill out lists with number of references to cells
-    typename DataArray<K>::Pointer linkLocPtr = DataArray<K>::CreateArray(numVerts, "_INTERNAL_USE_ONLY_Vertices", true);
-    linkLocPtr->initializeWithValue(0);
-    K* linkLoc = linkLocPtr->getPointer(0);
-    K* verts = nullptr;
-
-    // vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
     // Traverse data to determine number of uses of each point
-    for(elemId = 0; elemId < numElems; elemId++)
+    std::vector<std::atomic<size_t>> counts(numVerts);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numElems);
+    dataAlg.execute(CountElementsContainingVertImpl<K>(elems, numVertsPerElem, counts));
+
+    // Prefix sum the counts into the list offsets. The counts are reused as the scatter cursors.
+    std::vector<size_t> offsets(numVerts + 1, 0);
+    for(size_t v = 0; v < numVerts; v++)
     {
-      verts = elemList->getTuplePointer(elemId);
-      for(size_t j = 0; j < numVertsPerElem; j++)
-      {
-        linkCount[verts[j]]++;
-      }
+      offsets[v + 1] = offsets[v] + counts[v].load(std::memory_order_relaxed);
+      counts[v].store(offsets[v], std::memory_order_relaxed);
     }
 
-    // Now allocate storage for the links
-    dynamicList->allocateLists(linkCount);
+    // Now place every element into the lists of its vertices
+    std::vector<K> indices(offsets[numVerts]);
+    dataAlg.execute(ScatterElementsContainingVertImpl<K>(elems, numVertsPerElem, counts, indices.data()));
 
-    for(elemId = 0; elemId < numElems; elemId++)
+    // A serial scatter already leaves each list in ascending element order
+    if(dataAlg.getParallelizationEnabled())
     {
-      verts = elemList->getTuplePointer(elemId);
-      for(size_t j = 0; j < numVertsPerElem; j++)
-      {
-        dynamicList->insertCellReference(verts[j], (linkLoc[verts[j]])++, elemId);
-      }
+      ParallelDataAlgorithm sortAlg;
+      sortAlg.setRange(0, numVerts);
+      sortAlg.execute(SortElementListsImpl<K>(offsets.data(), indices.data()));
     }
+
+    dynamicList->setLists(offsets, indices);
   }
 
   /**
@@ -281,7 +504,6 @@ public:
     size_t numElems = elemList->getNumberOfTuples();
     size_t numVertsPerElem = elemList->getNumberOfComponents();
     size_t numSharedVerts = 0;
-    QVector<T> linkCount(numElems, 0);
     int err = 0;
 
     switch(geometryType)
@@ -321,191 +543,149 @@ public:
       return -1;
     }
 
-    dynamicList->allocateLists(linkCount);
-
-    // Allocate an array of bools that we use each iteration so that we don't put duplicates into the array
-    typename DataArray<bool>::Pointer visitedPtr = DataArray<bool>::CreateArray(numElems, "_INTERNAL_USE_ONLY_Visited", true);
-    visitedPtr->initializeWithValue(false);
-    bool* visited = visitedPtr->getPointer(0);
-
-    // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
-    QVector<K> loop_neighbors(32, 0);
-
-    // Build up the element adjacency list now that we have the element links
-    for(size_t t = 0; t < numElems; ++t)
+    // The first pass finds the neighbors of fixed size blocks of elements in parallel, the second one moves them into
+    // the flat buffer that is handed to the DynamicListArray. The result does not depend on the number of threads.
+    const size_t blockSize = 4096;
+    size_t numBlocks = (numElems + blockSize - 1) / blockSize;
+    std::vector<std::vector<K>> blockNeighbors(numBlocks);
+    std::vector<size_t> neighborOffsets(numElems + 1, 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute(FindElementNeighborsImpl<K>(elemList->getConstPointer(0), numElems, numVertsPerElem, numSharedVerts, elemsContainingVert->getOffsets().data(),
+                                                elemsContainingVert->getIndices().data(), blockSize, blockNeighbors, neighborOffsets.data()));
+
+    for(size_t t = 0; t < numElems; t++)
     {
-      //   qDebug() << "Analyzing Cell " << t << "\n";
-      K* seedElem = elemList->getTuplePointer(t);
-      for(size_t v = 0; v < numVertsPerElem; ++v)
-      {
-        //   qDebug() << " vert " << v << "\n";
-        T nEs = elemsContainingVert->getNumberOfElements(seedElem[v]);
-        K* vertIdxs = elemsContainingVert->getElementListPointer(seedElem[v]);
+      neighborOffsets[t + 1] += neighborOffsets[t];
+    }
 
-        for(T vt = 0; vt < nEs; ++vt)
-        {
-          if(vertIdxs[vt] == static_cast<K>(t))
-          {
-            continue;
-          } // This is the same element as our "source"
-          if(visited[vertIdxs[vt]] == true)
-          {
-            continue;
-          } // We already added this element so loop again
-          //      qDebug() << "   Comparing Element " << vertIdxs[vt] << "\n";
-          K* vertCell = elemList->getTuplePointer(vertIdxs[vt]);
-          size_t vCount = 0;
-          // Loop over all the vertex indices of this element and try to match numSharedVerts of them to the current loop element
-          // If there is numSharedVerts match then that element is a neighbor of the source. If there are more than numVertsPerElem
-          // matches then there is a real problem with the mesh and the program is going to return an error.
-          for(size_t i = 0; i < numVertsPerElem; i++)
-          {
-            for(size_t j = 0; j < numVertsPerElem; j++)
-            {
-              if(seedElem[i] == vertCell[j])
-              {
-                vCount++;
-              }
-            }
-          }
+    std::vector<K> neighborIndices(neighborOffsets[numElems]);
+    dataAlg.execute(CopyBlockNeighborsImpl<K>(blockSize, neighborOffsets.data(), blockNeighbors, neighborIndices.data()));
 
-          // So if our vertex match count is numSharedVerts and we have not visited the element in question then add this element index
-          // into the list of vertex indices as neighbors for the source element.
-          if(vCount == numSharedVerts)
-          {
-            // qDebug() << "       Neighbor: " << vertIdxs[vt] << "\n";
-            // Use the current count of neighbors as the index
-            // into the loop_neighbors vector and place the value of the vertex element at that index
-            loop_neighbors[linkCount[t]] = vertIdxs[vt];
-            linkCount[t]++; // Increment the count for the next time through
-            if(linkCount[t] >= loop_neighbors.size())
-            {
-              loop_neighbors.resize(loop_neighbors.size() + 10);
-            }
-            visited[vertIdxs[vt]] = true; // Set this element as visited so we do NOT add it again
-          }
-        }
-      }
-      // Reset all the visited cell indexs back to false (zero)
-      for(int64_t k = 0; k < linkCount[t]; ++k)
-      {
-        visited[loop_neighbors[k]] = false;
-      }
-      // Allocate the array storage for the current edge to hold its vertex list
-      dynamicList->setElementList(t, linkCount[t], &(loop_neighbors[0]));
-    }
+    dynamicList->setLists(neighborOffsets, neighborIndices);
 
     return err;
   }
 
   /**
-   * @brief Find2DElementEdges
+   * @brief Collects the sorted vertex ids of the edges or faces of every element and sorts them, so that copies of
+   * the same edge or face end up next to each other. The keys are in a flat buffer and sorted in parallel, which
+   * avoids a node allocation per key and gives the same order as a std::set of the keys.
    * @param elemList
-   * @param edgeList
+   * @param localKeys The element local vertex indices of each edge or face
+   * @return
    */
-  template <typename T> static void Find2DElementEdges(typename DataArray<T>::Pointer elemList, typename DataArray<T>::Pointer edgeList)
+  template <typename T, size_t N>
+  static std::vector<std::array<T, N>> SortElementKeys(typename DataArray<T>::Pointer elemList, const std::vector<std::array<size_t, N>>& localKeys)
   {
     size_t numElems = elemList->getNumberOfTuples();
-    size_t numVertsPerElem = elemList->getNumberOfComponents();
-    T v0 = 0;
-    T v1 = 0;
-
-    std::pair<T, T> edge;
-    std::set<std::pair<T, T>> edgeSet;
-
-    for(size_t i = 0; i < numElems; i++)
+    std::vector<std::array<T, N>> keys(numElems * localKeys.size());
+    if(keys.empty())
     {
-      T* verts = elemList->getTuplePointer(i);
-
-      for(size_t j = 0; j < numVertsPerElem; j++)
-      {
-        if(j == (numVertsPerElem - 1))
-        {
-          if(verts[j] > verts[0])
-          {
-            v0 = verts[0];
-            v1 = verts[j];
-          }
-          else
-          {
-            v0 = verts[j];
-            v1 = verts[0];
-          }
-        }
-        else
-        {
-          if(verts[j] > verts[j + 1])
-          {
-            v0 = verts[j + 1];
-            v1 = verts[j];
-          }
-          else
-          {
-            v0 = verts[j];
-            v1 = verts[j + 1];
-          }
-        }
-        edge = std::make_pair(v0, v1);
-        edgeSet.insert(edge);
-      }
+      return keys;
     }
 
-    typename std::set<std::pair<T, T>>::iterator setIter;
-    edgeList->resizeTuples(edgeSet.size());
-    T* uEdges = edgeList->getPointer(0);
-    T index = 0;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numElems);
+    dataAlg.execute(GatherElementKeysImpl<T, N>(elemList->getConstPointer(0), elemList->getNumberOfComponents(), localKeys, keys.data()));
 
-    for(setIter = edgeSet.begin(); setIter != edgeSet.end(); ++setIter)
-    {
-      uEdges[2 * index] = (*setIter).first;
-      uEdges[2 * index + 1] = (*setIter).second;
-      ++index;
-    }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_sort(keys.begin(), keys.end());
+#else
+    std::sort(keys.begin(), keys.end());
+#endif
+    return keys;
   }
 
   /**
-   * @brief FindTetEdges
-   * @param tetList
-   * @param edgeList
+   * @brief Fills outList with every distinct edge or face of the elements in ascending order
+   * @param elemList
+   * @param localKeys The element local vertex indices of each edge or face
+   * @param outList
    */
-  template <typename T> static void FindTetEdges(typename DataArray<T>::Pointer tetList, typename DataArray<T>::Pointer edgeList)
+  template <typename T, size_t N>
+  static void FindElementKeys(typename DataArray<T>::Pointer elemList, const std::vector<std::array<size_t, N>>& localKeys, typename DataArray<T>::Pointer outList)
   {
-    size_t numElems = tetList->getNumberOfTuples();
-
-    std::pair<T, T> edge;
-    std::set<std::pair<T, T>> edgeSet;
+    std::vector<std::array<T, N>> keys = SortElementKeys<T, N>(elemList, localKeys);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
 
-    for(size_t i = 0; i < numElems; i++)
+    outList->resizeTuples(keys.size());
+    for(size_t i = 0; i < keys.size(); i++)
     {
-      T* verts = tetList->getTuplePointer(i);
+      std::copy(keys[i].begin(), keys[i].end(), outList->getTuplePointer(i));
+    }
+  }
 
-      std::vector<T> edge0 = {verts[0], verts[1]};
-      std::vector<T> edge1 = {verts[0], verts[2]};
-      std::vector<T> edge2 = {verts[1], verts[2]};
-      std::vector<T> edge3 = {verts[0], verts[3]};
-      std::vector<T> edge4 = {verts[1], verts[3]};
-      std::vector<T> edge5 = {verts[2], verts[3]};
-      std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5};
+  /**
+   * @brief Fills outList with the edges or faces that belong to exactly one element in ascending order
+   * @param elemList
+   * @param localKeys The element local vertex indices of each edge or face
+   * @param outList
+   */
+  template <typename T, size_t N>
+  static void FindUnsharedElementKeys(typename DataArray<T>::Pointer elemList, const std::vector<std::array<size_t, N>>& localKeys, typename DataArray<T>::Pointer outList)
+  {
+    std::vector<std::array<T, N>> keys = SortElementKeys<T, N>(elemList, localKeys);
 
-      for(auto&& uEdge : edgeList)
+    // Keep the keys whose run of copies has length one
+    size_t numUnshared = 0;
+    size_t i = 0;
+    while(i < keys.size())
+    {
+      size_t j = i + 1;
+      while(j < keys.size() && keys[j] == keys[i])
+      {
+        j++;
+      }
+      if(j - i == 1)
       {
-        std::sort(uEdge.begin(), uEdge.end());
-        edge = std::make_pair(uEdge[0], uEdge[1]);
-        edgeSet.insert(edge);
+        keys[numUnshared++] = keys[i];
       }
+      i = j;
     }
+    keys.resize(numUnshared);
 
-    typename std::set<std::pair<T, T>>::iterator setIter;
-    edgeList->resizeTuples(edgeSet.size());
-    T* uEdges = edgeList->getPointer(0);
-    T index = 0;
+    outList->resizeTuples(keys.size());
+    for(size_t k = 0; k < keys.size(); k++)
+    {
+      std::copy(keys[k].begin(), keys[k].end(), outList->getTuplePointer(k));
+    }
+  }
 
-    for(setIter = edgeSet.begin(); setIter != edgeSet.end(); ++setIter)
+  /**
+   * @brief Returns the element local vertex indices of the edges of a 2D element with numVertsPerElem vertices
+   * @param numVertsPerElem
+   * @return
+   */
+  static std::vector<std::array<size_t, 2>> Get2DElementLocalEdges(size_t numVertsPerElem)
+  {
+    std::vector<std::array<size_t, 2>> localEdges(numVertsPerElem);
+    for(size_t j = 0; j < numVertsPerElem; j++)
     {
-      uEdges[2 * index] = (*setIter).first;
-      uEdges[2 * index + 1] = (*setIter).second;
-      ++index;
+      localEdges[j] = {{j, (j + 1) % numVertsPerElem}};
     }
+    return localEdges;
+  }
+
+  /**
+   * @brief Find2DElementEdges
+   * @param elemList
+   * @param edgeList
+   */
+  template <typename T> static void Find2DElementEdges(typename DataArray<T>::Pointer elemList, typename DataArray<T>::Pointer edgeList)
+  {
+    FindElementKeys<T, 2>(elemList, Get2DElementLocalEdges(elemList->getNumberOfComponents()), edgeList);
+  }
+
+  /**
+   * @brief FindTetEdges
+   * @param tetList
+   * @param edgeList
+   */
+  template <typename T> static void FindTetEdges(typename DataArray<T>::Pointer tetList, typename DataArray<T>::Pointer edgeList)
+  {
+    static const std::vector<std::array<size_t, 2>> localEdges = {{{0, 1}}, {{0, 2}}, {{1, 2}}, {{0, 3}}, {{1, 3}}, {{2, 3}}};
+    FindElementKeys<T, 2>(tetList, localEdges, edgeList);
   }
 
   /**
@@ -515,52 +695,8 @@ public:
   */
   template <typename T> static void FindHexEdges(typename DataArray<T>::Pointer hexList, typename DataArray<T>::Pointer edge_List)
   {
-    size_t numElems = hexList->getNumberOfTuples();
-
-    std::pair<T, T> edge;
-    std::set<std::pair<T, T>> edgeSet;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = hexList->getTuplePointer(i);
-
-      std::vector<T> edge0 = {verts[0], verts[1]};
-      std::vector<T> edge1 = {verts[1], verts[2]};
-      std::vector<T> edge2 = {verts[2], verts[3]};
-      std::vector<T> edge3 = {verts[3], verts[0]};
-
-      std::vector<T> edge4 = {verts[0], verts[4]};
-      std::vector<T> edge5 = {verts[1], verts[5]};
-      std::vector<T> edge6 = {verts[2], verts[6]};
-      std::vector<T> edge7 = {verts[3], verts[7]};
-
-      std::vector<T> edge8 =  {verts[4], verts[5]};
-      std::vector<T> edge9 =  {verts[5], verts[6]};
-      std::vector<T> edge10 = {verts[6], verts[7]};
-      std::vector<T> edge11 = {verts[7], verts[4]};
-
-      std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5,
-                                            edge6, edge7, edge8, edge9, edge10, edge11};
-
-      for(auto&& uEdge : edgeList)
-      {
-        std::sort(uEdge.begin(), uEdge.end());
-        edge = std::make_pair(uEdge[0], uEdge[1]);
-        edgeSet.insert(edge);
-      }
-    }
-
-    typename std::set<std::pair<T, T>>::iterator setIter;
-    edge_List->resizeTuples(edgeSet.size());
-    T* uEdges = edge_List->getPointer(0);
-    T index = 0;
-
-    for(setIter = edgeSet.begin(); setIter != edgeSet.end(); ++setIter)
-    {
-      uEdges[2 * index] = (*setIter).first;
-      uEdges[2 * index + 1] = (*setIter).second;
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 2>> localEdges = {{{0, 1}}, {{1, 2}}, {{2, 3}}, {{3, 0}}, {{0, 4}}, {{1, 5}}, {{2, 6}}, {{3, 7}}, {{4, 5}}, {{5, 6}}, {{6, 7}}, {{7, 4}}};
+    FindElementKeys<T, 2>(hexList, localEdges, edge_List);
   }
 
   /**
@@ -570,41 +706,8 @@ public:
    */
   template <typename T> static void FindTetFaces(typename DataArray<T>::Pointer tetList, typename DataArray<T>::Pointer faceList)
   {
-    size_t numElems = tetList->getNumberOfTuples();
-
-    std::tuple<T, T, T> face;
-    std::set<std::tuple<T, T, T>> faceSet;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = tetList->getTuplePointer(i);
-
-      std::vector<T> tri0 = {verts[0], verts[1], verts[2]};
-      std::vector<T> tri1 = {verts[1], verts[2], verts[3]};
-      std::vector<T> tri2 = {verts[0], verts[2], verts[3]};
-      std::vector<T> tri3 = {verts[0], verts[1], verts[3]};
-      std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-      for(auto&& tri : triList)
-      {
-        std::sort(tri.begin(), tri.end());
-        face = std::make_tuple(tri[0], tri[1], tri[2]);
-        faceSet.insert(face);
-      }
-    }
-
-    typename std::set<std::tuple<T, T, T>>::iterator setIter;
-    faceList->resizeTuples(faceSet.size());
-    T* uFaces = faceList->getPointer(0);
-    T index = 0;
-
-    for(setIter = faceSet.begin(); setIter != faceSet.end(); ++setIter)
-    {
-      uFaces[3 * index] = std::get<0>(*setIter);
-      uFaces[3 * index + 1] = std::get<1>(*setIter);
-      uFaces[3 * index + 2] = std::get<2>(*setIter);
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 3>> localFaces = {{{0, 1, 2}}, {{1, 2, 3}}, {{0, 2, 3}}, {{0, 1, 3}}};
+    FindElementKeys<T, 3>(tetList, localFaces, faceList);
   }
 
   /**
@@ -614,45 +717,8 @@ public:
   */
   template <typename T> static void FindHexFaces(typename DataArray<T>::Pointer hexList, typename DataArray<T>::Pointer faceList)
   {
-    size_t numElems = hexList->getNumberOfTuples();
-
-    std::tuple<T, T, T, T> face;
-    std::set<std::tuple<T, T, T, T>> faceSet;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = hexList->getTuplePointer(i);
-
-      std::vector<T> quad0 = {verts[0], verts[1], verts[5], verts[4]};
-      std::vector<T> quad1 = {verts[1], verts[2], verts[6], verts[5]};
-      std::vector<T> quad2 = {verts[2], verts[3], verts[7], verts[6]};
-      std::vector<T> quad3 = {verts[3], verts[0], verts[4], verts[7]};
-      std::vector<T> quad4 = {verts[0], verts[1], verts[2], verts[3]};
-      std::vector<T> quad5 = {verts[4], verts[5], verts[6], verts[7]};
-
-      std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-      for(auto&& quad : quadList)
-      {
-        std::sort(quad.begin(), quad.end());
-        face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-        faceSet.insert(face);
-      }
-    }
-
-    typename std::set<std::tuple<T, T, T, T>>::iterator setIter;
-    faceList->resizeTuples(faceSet.size());
-    T* uFaces = faceList->getPointer(0);
-    T index = 0;
-
-    for(setIter = faceSet.begin(); setIter != faceSet.end(); ++setIter)
-    {
-      uFaces[4 * index] = std::get<0>(*setIter);
-      uFaces[4 * index + 1] = std::get<1>(*setIter);
-      uFaces[4 * index + 2] = std::get<2>(*setIter);
-      uFaces[4 * index + 3] = std::get<3>(*setIter);
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 4>> localFaces = {{{0, 1, 5, 4}}, {{1, 2, 6, 5}}, {{2, 3, 7, 6}}, {{3, 0, 4, 7}}, {{0, 1, 2, 3}}, {{4, 5, 6, 7}}};
+    FindElementKeys<T, 4>(hexList, localFaces, faceList);
   }
 
   /**
@@ -662,75 +728,7 @@ public:
    */
   template <typename T> static void Find2DUnsharedEdges(typename DataArray<T>::Pointer elemList, typename DataArray<T>::Pointer edgeList)
   {
-    size_t numElems = elemList->getNumberOfTuples();
-    size_t numVertsPerElem = elemList->getNumberOfComponents();
-    T v0 = 0;
-    T v1 = 0;
-
-    std::pair<T, T> edge;
-    std::map<std::pair<T, T>, T> edgeMap;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = elemList->getTuplePointer(i);
-
-      for(size_t j = 0; j < numVertsPerElem; j++)
-      {
-        if(j == (numVertsPerElem - 1))
-        {
-          if(verts[j] > verts[0])
-          {
-            v0 = verts[0];
-            v1 = verts[j];
-          }
-          else
-          {
-            v0 = verts[j];
-            v1 = verts[0];
-          }
-        }
-        else
-        {
-          if(verts[j] > verts[j + 1])
-          {
-            v0 = verts[j + 1];
-            v1 = verts[j];
-          }
-          else
-          {
-            v0 = verts[j];
-            v1 = verts[j + 1];
-          }
-        }
-        edge = std::make_pair(v0, v1);
-        edgeMap[edge]++;
-      }
-    }
-
-    typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-    while(mapIter != edgeMap.end())
-    {
-      if((*mapIter).second > 1)
-      {
-        edgeMap.erase(mapIter++);
-      }
-      else
-      {
-        ++mapIter;
-      }
-    }
-
-    edgeList->resizeTuples(edgeMap.size());
-    T* bEdges = edgeList->getPointer(0);
-    T index = 0;
-
-    for(mapIter = edgeMap.begin(); mapIter != edgeMap.end(); ++mapIter)
-    {
-      bEdges[2 * index] = (*mapIter).first.first;
-      bEdges[2 * index + 1] = (*mapIter).first.second;
-      ++index;
-    }
+    FindUnsharedElementKeys<T, 2>(elemList, Get2DElementLocalEdges(elemList->getNumberOfComponents()), edgeList);
   }
 
   /**
@@ -740,55 +738,8 @@ public:
   */
   template <typename T> static void FindUnsharedTetEdges(typename DataArray<T>::Pointer tetList, typename DataArray<T>::Pointer edgeList)
   {
-    size_t numElems = tetList->getNumberOfTuples();
-
-    std::pair<T, T> edge;
-    std::map<std::pair<T, T>, T> edgeMap;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = tetList->getTuplePointer(i);
-
-      std::vector<T> edge0 = {verts[0], verts[1]};
-      std::vector<T> edge1 = {verts[0], verts[2]};
-      std::vector<T> edge2 = {verts[1], verts[2]};
-      std::vector<T> edge3 = {verts[0], verts[3]};
-      std::vector<T> edge4 = {verts[1], verts[3]};
-      std::vector<T> edge5 = {verts[2], verts[3]};
-      std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5};
-
-      for(auto&& uEdge : edgeList)
-      {
-        std::sort(uEdge.begin(), uEdge.end());
-        edge = std::make_pair(uEdge[0], uEdge[1]);
-        edgeMap[edge]++;
-      }
-    }
-
-    typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-    while(mapIter != edgeMap.end())
-    {
-      if((*mapIter).second > 1)
-      {
-        edgeMap.erase(mapIter++);
-      }
-      else
-      {
-        ++mapIter;
-      }
-    }
-
-    edgeList->resizeTuples(edgeMap.size());
-    T* bEdges = edgeList->getPointer(0);
-    T index = 0;
-
-    for(mapIter = edgeMap.begin(); mapIter != edgeMap.end(); ++mapIter)
-    {
-      bEdges[2 * index] = (*mapIter).first.first;
-      bEdges[2 * index + 1] = (*mapIter).first.second;
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 2>> localEdges = {{{0, 1}}, {{0, 2}}, {{1, 2}}, {{0, 3}}, {{1, 3}}, {{2, 3}}};
+    FindUnsharedElementKeys<T, 2>(tetList, localEdges, edgeList);
   }
 
   /**
@@ -798,64 +749,8 @@ public:
   */
   template <typename T> static void FindUnsharedHexEdges(typename DataArray<T>::Pointer& hexList, typename DataArray<T>::Pointer& edge_List)
   {
-    size_t numElems = hexList->getNumberOfTuples();
-
-    std::pair<T, T> edge;
-    std::map<std::pair<T, T>, T> edgeMap;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = hexList->getTuplePointer(i);
-
-      std::vector<T> edge0 = {verts[0], verts[1]};
-      std::vector<T> edge1 = {verts[1], verts[2]};
-      std::vector<T> edge2 = {verts[2], verts[3]};
-      std::vector<T> edge3 = {verts[3], verts[0]};
-
-      std::vector<T> edge4 = {verts[0], verts[4]};
-      std::vector<T> edge5 = {verts[1], verts[5]};
-      std::vector<T> edge6 = {verts[2], verts[6]};
-      std::vector<T> edge7 = {verts[3], verts[7]};
-
-      std::vector<T> edge8 = {verts[4], verts[5]};
-      std::vector<T> edge9 = {verts[5], verts[6]};
-      std::vector<T> edge10 = {verts[6], verts[7]};
-      std::vector<T> edge11 = {verts[7], verts[4]};
-
-      std::list<std::vector<T>> edgeList = {edge0, edge1, edge2, edge3, edge4, edge5, edge6, edge7, edge8, edge9, edge10, edge11};
-
-      for(auto&& uEdge : edgeList)
-      {
-        std::sort(uEdge.begin(), uEdge.end());
-        edge = std::make_pair(uEdge[0], uEdge[1]);
-        edgeMap[edge]++;
-      }
-    }
-
-    typename std::map<std::pair<T, T>, T>::iterator mapIter = edgeMap.begin();
-
-    while(mapIter != edgeMap.end())
-    {
-      if((*mapIter).second > 1)
-      {
-        edgeMap.erase(mapIter++);
-      }
-      else
-      {
-        ++mapIter;
-      }
-    }
-
-    edge_List->resizeTuples(edgeMap.size());
-    T* bEdges = edge_List->getPointer(0);
-    T index = 0;
-
-    for(mapIter = edgeMap.begin(); mapIter != edgeMap.end(); ++mapIter)
-    {
-      bEdges[2 * index] = (*mapIter).first.first;
-      bEdges[2 * index + 1] = (*mapIter).first.second;
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 2>> localEdges = {{{0, 1}}, {{1, 2}}, {{2, 3}}, {{3, 0}}, {{0, 4}}, {{1, 5}}, {{2, 6}}, {{3, 7}}, {{4, 5}}, {{5, 6}}, {{6, 7}}, {{7, 4}}};
+    FindUnsharedElementKeys<T, 2>(hexList, localEdges, edge_List);
   }
 
   /**
@@ -865,54 +760,8 @@ public:
    */
   template <typename T> static void FindUnsharedTetFaces(typename DataArray<T>::Pointer tetList, typename DataArray<T>::Pointer faceList)
   {
-    size_t numElems = tetList->getNumberOfTuples();
-
-    std::tuple<T, T, T> face;
-    std::map<std::tuple<T, T, T>, T> faceMap;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = tetList->getTuplePointer(i);
-
-      std::vector<T> tri0 = {verts[0], verts[1], verts[2]};
-      std::vector<T> tri1 = {verts[1], verts[2], verts[3]};
-      std::vector<T> tri2 = {verts[0], verts[2], verts[3]};
-      std::vector<T> tri3 = {verts[0], verts[1], verts[3]};
-      std::list<std::vector<T>> triList = {tri0, tri1, tri2, tri3};
-
-      for(auto&& tri : triList)
-      {
-        std::sort(tri.begin(), tri.end());
-        face = std::make_tuple(tri[0], tri[1], tri[2]);
-        faceMap[face]++;
-      }
-    }
-
-    typename std::map<std::tuple<T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-    while(mapIter != faceMap.end())
-    {
-      if((*mapIter).second > 1)
-      {
-        faceMap.erase(mapIter++);
-      }
-      else
-      {
-        ++mapIter;
-      }
-    }
-
-    faceList->resizeTuples(faceMap.size());
-    T* uFaces = faceList->getPointer(0);
-    T index = 0;
-
-    for(mapIter = faceMap.begin(); mapIter != faceMap.end(); ++mapIter)
-    {
-      uFaces[3 * index] = std::get<0>((*mapIter).first);
-      uFaces[3 * index + 1] = std::get<1>((*mapIter).first);
-      uFaces[3 * index + 2] = std::get<2>((*mapIter).first);
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 3>> localFaces = {{{0, 1, 2}}, {{1, 2, 3}}, {{0, 2, 3}}, {{0, 1, 3}}};
+    FindUnsharedElementKeys<T, 3>(tetList, localFaces, faceList);
   }
 
   /**
@@ -922,58 +771,8 @@ public:
   */
   template <typename T> static void FindUnsharedHexFaces(typename DataArray<T>::Pointer hexList, typename DataArray<T>::Pointer faceList)
   {
-    size_t numElems = hexList->getNumberOfTuples();
-
-    std::tuple<T, T, T, T> face;
-    std::map<std::tuple<T, T, T, T>, T> faceMap;
-
-    for(size_t i = 0; i < numElems; i++)
-    {
-      T* verts = hexList->getTuplePointer(i);
-
-      std::vector<T> quad0 = {verts[0], verts[1], verts[5], verts[4]};
-      std::vector<T> quad1 = {verts[1], verts[2], verts[6], verts[5]};
-      std::vector<T> quad2 = {verts[2], verts[3], verts[7], verts[6]};
-      std::vector<T> quad3 = {verts[3], verts[0], verts[4], verts[7]};
-      std::vector<T> quad4 = {verts[0], verts[1], verts[2], verts[3]};
-      std::vector<T> quad5 = {verts[4], verts[5], verts[6], verts[7]};
-
-      std::list<std::vector<T>> quadList = {quad0, quad1, quad2, quad3, quad4, quad5};
-
-      for(auto&& quad : quadList)
-      {
-        std::sort(quad.begin(), quad.end());
-        face = std::make_tuple(quad[0], quad[1], quad[2], quad[3]);
-        faceMap[face]++;
-      }
-    }
-
-    typename std::map<std::tuple<T, T, T, T>, T>::iterator mapIter = faceMap.begin();
-
-    while(mapIter != faceMap.end())
-    {
-      if((*mapIter).second > 1)
-      {
-        faceMap.erase(mapIter++);
-      }
-      else
-      {
-        ++mapIter;
-      }
-    }
-
-    faceList->resizeTuples(faceMap.size());
-    T* uFaces = faceList->getPointer(0);
-    T index = 0;
-
-    for(mapIter = faceMap.begin(); mapIter != faceMap.end(); ++mapIter)
-    {
-      uFaces[4 * index] = std::get<0>((*mapIter).first);
-      uFaces[4 * index + 1] = std::get<1>((*mapIter).first);
-      uFaces[4 * index + 2] = std::get<2>((*mapIter).first);
-      uFaces[4 * index + 3] = std::get<3>((*mapIter).first);
-      ++index;
-    }
+    static const std::vector<std::array<size_t, 4>> localFaces = {{{0, 1, 5, 4}}, {{1, 2, 6, 5}}, {{2, 3, 7, 6}}, {{3, 0, 4, 7}}, {{0, 1, 2, 3}}, {{4, 5, 6, 7}}};
+    FindUnsharedElementKeys<T, 4>(hexList, localFaces, faceList);
   }
 };
 
@@ -0,0 +1,310 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#include "GridLayout.h"
+
+#include <cstring>
+#include <vector>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+/**
+ * @brief The CopyBricksImpl class copies the tuples of a range of bricks between the RowMajor and the Bricked
+ * layout. Inside a brick every run of cells along x is contiguous in both layouts, so each run is a single memcpy.
+ */
+class CopyBricksImpl
+{
+public:
+  CopyBricksImpl(const GridLayout& bricked, const uint8_t* src, uint8_t* dst, size_t tupleBytes, bool toBricked)
+  : m_Bricked(bricked)
+  , m_Src(src)
+  , m_Dst(dst)
+  , m_TupleBytes(tupleBytes)
+  , m_ToBricked(toBricked)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    SizeVec3Type dims = m_Bricked.getDimensions();
+    size_t numBricks[3];
+    for(size_t a = 0; a < 3; a++)
+    {
+      numBricks[a] = (dims[a] + GridLayout::BrickSize - 1) / GridLayout::BrickSize;
+    }
+    for(size_t brick = range.min(); brick < range.max(); brick++)
+    {
+      size_t x0 = (brick % numBricks[0]) * GridLayout::BrickSize;
+      size_t y0 = ((brick / numBricks[0]) % numBricks[1]) * GridLayout::BrickSize;
+      size_t z0 = (brick / (numBricks[0] * numBricks[1])) * GridLayout::BrickSize;
+      size_t runBytes = std::min(GridLayout::BrickSize, dims[0] - x0) * m_TupleBytes;
+      size_t yEnd = std::min(y0 + GridLayout::BrickSize, dims[1]);
+      size_t zEnd = std::min(z0 + GridLayout::BrickSize, dims[2]);
+      for(size_t z = z0; z < zEnd; z++)
+      {
+        for(size_t y = y0; y < yEnd; y++)
+        {
+          size_t rowMajor = ((z * dims[1] + y) * dims[0] + x0) * m_TupleBytes;
+          size_t bricked = m_Bricked.computeIndex(x0, y, z) * m_TupleBytes;
+          if(m_ToBricked)
+          {
+            std::memcpy(m_Dst + bricked, m_Src + rowMajor, runBytes);
+          }
+          else
+          {
+            std::memcpy(m_Dst + rowMajor, m_Src + bricked, runBytes);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  GridLayout m_Bricked;
+  const uint8_t* m_Src;
+  uint8_t* m_Dst;
+  size_t m_TupleBytes;
+  bool m_ToBricked;
+};
+
+/**
+ * @brief Copies every brick of the grid from src to dst, in parallel
+ */
+void CopyBricks(const SizeVec3Type& dims, const uint8_t* src, uint8_t* dst, size_t tupleBytes, bool toBricked)
+{
+  size_t numBricks = 1;
+  for(size_t a = 0; a < 3; a++)
+  {
+    numBricks *= (dims[a] + GridLayout::BrickSize - 1) / GridLayout::BrickSize;
+  }
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBricks);
+  dataAlg.execute(CopyBricksImpl(GridLayout(dims, GridLayout::Type::Bricked), src, dst, tupleBytes, toBricked));
+}
+
+/**
+ * @brief Returns true if array is a DataArray<T>
+ */
+template <typename T>
+bool IsDataArrayOf(IDataArray* array)
+{
+  return dynamic_cast<DataArray<T>*>(array) != nullptr;
+}
+
+/**
+ * @brief Returns true if array is a DataArray of a primitive type, whose tuples can be moved as plain bytes
+ */
+bool IsPrimitiveDataArray(IDataArray* array)
+{
+  return IsDataArrayOf<int8_t>(array) || IsDataArrayOf<uint8_t>(array) || IsDataArrayOf<int16_t>(array) || IsDataArrayOf<uint16_t>(array) || IsDataArrayOf<int32_t>(array) ||
+         IsDataArrayOf<uint32_t>(array) || IsDataArrayOf<int64_t>(array) || IsDataArrayOf<uint64_t>(array) || IsDataArrayOf<float>(array) || IsDataArrayOf<double>(array) ||
+         IsDataArrayOf<bool>(array) || IsDataArrayOf<size_t>(array);
+}
+
+/**
+ * @brief Sets bytes to the values of array if it is a DataArray<T>
+ * @return false if array is not a DataArray<T>
+ */
+template <typename T>
+bool GetConstBytes(IDataArray* array, const uint8_t*& bytes)
+{
+  auto dataArray = dynamic_cast<DataArray<T>*>(array);
+  if(nullptr == dataArray)
+  {
+    return false;
+  }
+  bytes = reinterpret_cast<const uint8_t*>(dataArray->getConstPointer(0));
+  return true;
+}
+
+/**
+ * @brief Returns the values of a primitive DataArray as bytes. Unlike getVoidPointer() this does not hand out a
+ * mutable pointer, so a copy-on-write array is not duplicated and its cached statistics stay valid.
+ * @return nullptr if array is not a primitive DataArray or its values are not available
+ */
+const uint8_t* GetConstBytes(IDataArray* array)
+{
+  const uint8_t* bytes = nullptr;
+  bool found = GetConstBytes<int8_t>(array, bytes) || GetConstBytes<uint8_t>(array, bytes) || GetConstBytes<int16_t>(array, bytes) || GetConstBytes<uint16_t>(array, bytes) ||
+               GetConstBytes<int32_t>(array, bytes) || GetConstBytes<uint32_t>(array, bytes) || GetConstBytes<int64_t>(array, bytes) || GetConstBytes<uint64_t>(array, bytes) ||
+               GetConstBytes<float>(array, bytes) || GetConstBytes<double>(array, bytes) || GetConstBytes<bool>(array, bytes) || GetConstBytes<size_t>(array, bytes);
+  return found ? bytes : nullptr;
+}
+} // namespace
+
+const size_t GridLayout::BrickSize;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GridLayout::GridLayout() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+GridLayout::GridLayout(const SizeVec3Type& dims, Type type)
+: m_Dims{dims[0], dims[1], dims[2]}
+, m_Type(type)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GridLayout::computeCoords(size_t index, size_t& x, size_t& y, size_t& z) const
+{
+  size_t sliceSize = m_Dims[0] * m_Dims[1];
+  if(m_Type == Type::RowMajor)
+  {
+    z = index / sliceSize;
+    y = (index % sliceSize) / m_Dims[0];
+    x = index % m_Dims[0];
+    return;
+  }
+
+  // Walk down the same nesting computeIndex() builds up: slab of bricks, row of bricks, brick, cell
+  size_t z0 = (index / (BrickSize * sliceSize)) * BrickSize;
+  index -= z0 * sliceSize;
+  size_t zSize = std::min(BrickSize, m_Dims[2] - z0);
+  size_t y0 = (index / (BrickSize * zSize * m_Dims[0])) * BrickSize;
+  index -= y0 * zSize * m_Dims[0];
+  size_t ySize = std::min(BrickSize, m_Dims[1] - y0);
+  size_t x0 = (index / (BrickSize * ySize * zSize)) * BrickSize;
+  index -= x0 * ySize * zSize;
+  size_t xSize = std::min(BrickSize, m_Dims[0] - x0);
+  x = x0 + index % xSize;
+  y = y0 + (index / xSize) % ySize;
+  z = z0 + index / (xSize * ySize);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t GridLayout::fromRowMajor(size_t rowMajorIndex) const
+{
+  if(m_Type == Type::RowMajor)
+  {
+    return rowMajorIndex;
+  }
+  size_t sliceSize = m_Dims[0] * m_Dims[1];
+  size_t z = rowMajorIndex / sliceSize;
+  size_t y = (rowMajorIndex % sliceSize) / m_Dims[0];
+  size_t x = rowMajorIndex % m_Dims[0];
+  return computeIndex(x, y, z);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GridLayout::CanConvertArray(const IDataArray::Pointer& array, const SizeVec3Type& dims)
+{
+  if(array.get() == nullptr || !IsPrimitiveDataArray(array.get()))
+  {
+    return false;
+  }
+  return array->getNumberOfTuples() == dims[0] * dims[1] * dims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int GridLayout::ConvertArray(const IDataArray::Pointer& array, const SizeVec3Type& dims, Type from, Type to)
+{
+  if(array.get() == nullptr || !IsPrimitiveDataArray(array.get()))
+  {
+    return -1;
+  }
+  if(array->getNumberOfTuples() != dims[0] * dims[1] * dims[2])
+  {
+    return -2;
+  }
+  if(from == to || array->getNumberOfTuples() == 0)
+  {
+    return 0;
+  }
+
+  size_t tupleBytes = array->getTypeSize() * static_cast<size_t>(array->getNumberOfComponents());
+  uint8_t* data = static_cast<uint8_t*>(array->getVoidPointer(0));
+  std::vector<uint8_t> source(data, data + array->getNumberOfTuples() * tupleBytes);
+  CopyBricks(dims, source.data(), data, tupleBytes, to == Type::Bricked);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer GridLayout::CreateRowMajorCopy(const IDataArray::Pointer& array, const SizeVec3Type& dims, Type from)
+{
+  if(!CanConvertArray(array, dims))
+  {
+    return IDataArray::NullPointer();
+  }
+  if(from == Type::RowMajor || array->getNumberOfTuples() == 0)
+  {
+    return array;
+  }
+  const uint8_t* source = GetConstBytes(array.get());
+  if(nullptr == source)
+  {
+    return IDataArray::NullPointer();
+  }
+  IDataArray::Pointer copy = array->createNewArray(array->getNumberOfTuples(), array->getComponentDimensions(), array->getName(), true);
+  if(!copy->isAllocated())
+  {
+    return IDataArray::NullPointer();
+  }
+  size_t tupleBytes = array->getTypeSize() * static_cast<size_t>(array->getNumberOfComponents());
+  CopyBricks(dims, source, static_cast<uint8_t*>(copy->getVoidPointer(0)), tupleBytes, false);
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString GridLayout::TypeToString(Type type)
+{
+  switch(type)
+  {
+  case Type::RowMajor:
+    return QString("RowMajor");
+  case Type::Bricked:
+    return QString("Bricked");
+  }
+  return QString("Unknown");
+}
@@ -0,0 +1,186 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The order of the cells of a grid in its arrays, see GridLayout. Declared outside the class so that
+ * headers can forward declare it.
+ */
+enum class GridLayoutType : uint8_t
+{
+  RowMajor = 0,
+  Bricked = 1
+};
+
+/**
+ * @brief The GridLayout class maps the (x, y, z) cell coordinates of an ImageGeom to the tuple index of a cell
+ * array. RowMajor is the canonical x fastest order, (z * dims[1] + y) * dims[0] + x, used by every filter and by
+ * the .dream3d files. Bricked stores the grid as 8x8x8 bricks, the bricks in x fastest order and the cells of each
+ * brick in x fastest order, so the cells around a cell are at most a few bricks away in memory instead of
+ * dims[0] * dims[1] tuples. Bricks on the high faces of the grid are cut to the grid, so both layouts hold exactly
+ * dims[0] * dims[1] * dims[2] tuples.
+ *
+ * AttributeMatrix::setCellLayout() converts the arrays of a cell AttributeMatrix between the layouts. When the
+ * matrix is written it writes a RowMajor copy of each array, so the layout never reaches a file.
+ */
+class SIMPLib_EXPORT GridLayout
+{
+public:
+  using Type = GridLayoutType;
+
+  static const size_t BrickSize = 8;
+
+  GridLayout();
+  GridLayout(const SizeVec3Type& dims, Type type);
+  ~GridLayout() = default;
+
+  GridLayout(const GridLayout&) = default;
+  GridLayout& operator=(const GridLayout&) = default;
+
+  /**
+   * @brief Returns the layout type
+   * @return
+   */
+  Type getType() const
+  {
+    return m_Type;
+  }
+
+  /**
+   * @brief Returns the grid dimensions
+   * @return
+   */
+  SizeVec3Type getDimensions() const
+  {
+    return SizeVec3Type(m_Dims[0], m_Dims[1], m_Dims[2]);
+  }
+
+  /**
+   * @brief Returns the number of cells in the grid
+   * @return
+   */
+  size_t getNumberOfCells() const
+  {
+    return m_Dims[0] * m_Dims[1] * m_Dims[2];
+  }
+
+  /**
+   * @brief Returns the tuple index of cell (x, y, z)
+   */
+  size_t computeIndex(size_t x, size_t y, size_t z) const
+  {
+    if(m_Type == Type::RowMajor)
+    {
+      return (z * m_Dims[1] + y) * m_Dims[0] + x;
+    }
+    size_t x0 = x & ~(BrickSize - 1);
+    size_t y0 = y & ~(BrickSize - 1);
+    size_t z0 = z & ~(BrickSize - 1);
+    size_t xSize = std::min(BrickSize, m_Dims[0] - x0);
+    size_t ySize = std::min(BrickSize, m_Dims[1] - y0);
+    size_t zSize = std::min(BrickSize, m_Dims[2] - z0);
+    return z0 * m_Dims[1] * m_Dims[0] + y0 * zSize * m_Dims[0] + x0 * ySize * zSize + ((z - z0) * ySize + (y - y0)) * xSize + (x - x0);
+  }
+
+  /**
+   * @brief Returns the coordinates of the cell stored at tuple index
+   * @param index
+   * @param x
+   * @param y
+   * @param z
+   */
+  void computeCoords(size_t index, size_t& x, size_t& y, size_t& z) const;
+
+  /**
+   * @brief Returns the tuple index that a cell at rowMajorIndex in the RowMajor layout has in this layout
+   * @param rowMajorIndex
+   * @return
+   */
+  size_t fromRowMajor(size_t rowMajorIndex) const;
+
+  /**
+   * @brief Reorders the tuples of a DataArray in place from one layout to another. The tuples are moved brick
+   * by brick in parallel through a temporary copy of the array.
+   * @param array The array, which must be a DataArray holding one tuple per cell
+   * @param dims The grid dimensions
+   * @param from The current layout of the array
+   * @param to The new layout
+   * @return 0 on success, -1 if the array is not a DataArray of a primitive type and -2 if its number of tuples
+   * does not match dims
+   */
+  static int ConvertArray(const IDataArray::Pointer& array, const SizeVec3Type& dims, Type from, Type to);
+
+  /**
+   * @brief Returns a new array that holds the tuples of array in the RowMajor layout. The array itself is only
+   * read, so it keeps its layout and any memory it shares with copy-on-write copies.
+   * @param array The array, which must be a DataArray holding one tuple per cell
+   * @param dims The grid dimensions
+   * @param from The current layout of the array
+   * @return The copy, array itself if it already is RowMajor, or a null pointer if it can not be converted or
+   * the copy can not be allocated
+   */
+  static IDataArray::Pointer CreateRowMajorCopy(const IDataArray::Pointer& array, const SizeVec3Type& dims, Type from);
+
+  /**
+   * @brief Returns true if ConvertArray can reorder the array
+   * @param array
+   * @param dims
+   * @return
+   */
+  static bool CanConvertArray(const IDataArray::Pointer& array, const SizeVec3Type& dims);
+
+  /**
+   * @brief Returns the name of a layout type
+   * @param type
+   * @return
+   */
+  static QString TypeToString(Type type);
+
+private:
+  size_t m_Dims[3] = {0, 0, 0};
+  Type m_Type = Type::RowMajor;
+};
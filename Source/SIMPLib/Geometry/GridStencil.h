@@ -0,0 +1,299 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "SIMPLib/Common/SIMPLArray.hpp"
+
+/**
+ * @brief The GridConnectivity enum selects the neighbors of a grid cell: the 6 cells that share a face, the 18
+ * cells that share a face or an edge, or all 26 cells that share a face, an edge or a corner.
+ */
+enum class GridConnectivity : uint8_t
+{
+  Face = 6,
+  FaceEdge = 18,
+  FaceEdgeCorner = 26
+};
+
+/**
+ * @brief The GridStencil class visits the neighbors of the cells of an ImageGeom or RectGridGeom without storing
+ * any neighbor lists. Cells are numbered x fastest, (z * dims[1] + y) * dims[0] + x, and each neighbor is found by
+ * adding a precomputed index offset.
+ *
+ * The neighbors are ordered faces first, then edges, then corners, so the Face stencil is a prefix of the larger
+ * ones. The face neighbors come in the order -z, -y, -x, +x, +y, +z. Axes with a single cell, such as z on a 2D
+ * image, never have neighbors and are dropped from the stencil, so size() can be smaller than the connectivity.
+ *
+ * forEachNeighbor<true> is the interior path and does no bounds checks; forEachNeighbor<false> skips neighbors
+ * that fall outside the grid. forEachCell picks the right path for each cell and runs the interior path over
+ * the inner part of every row, which the compiler can unroll over the stencil.
+ *
+ * The stencil holds a few small fixed size arrays and never allocates, so it can be copied into the functors of
+ * a ParallelDataAlgorithm. IGeometryGrid::getStencil() creates one for a geometry.
+ */
+template <GridConnectivity C> class GridStencil
+{
+public:
+  static const size_t MaxSize = static_cast<size_t>(C);
+
+  explicit GridStencil(const SizeVec3Type& dims)
+  : m_Dims{{dims[0], dims[1], dims[2]}}
+  {
+    int64_t strides[3] = {1, static_cast<int64_t>(m_Dims[0]), static_cast<int64_t>(m_Dims[0] * m_Dims[1])};
+    // Faces have one non zero direction component, edges two and corners three
+    size_t maxOrder = (C == GridConnectivity::Face) ? 1 : ((C == GridConnectivity::FaceEdge) ? 2 : 3);
+    for(size_t order = 1; order <= maxOrder; order++)
+    {
+      for(int dz = -1; dz <= 1; dz++)
+      {
+        for(int dy = -1; dy <= 1; dy++)
+        {
+          for(int dx = -1; dx <= 1; dx++)
+          {
+            int dir[3] = {dx, dy, dz};
+            size_t numNonZero = 0;
+            bool active = true;
+            for(size_t a = 0; a < 3; a++)
+            {
+              if(dir[a] != 0)
+              {
+                numNonZero++;
+                active = active && m_Dims[a] > 1;
+              }
+            }
+            if(numNonZero != order || !active)
+            {
+              continue;
+            }
+            m_Directions[m_Size] = {{static_cast<int8_t>(dx), static_cast<int8_t>(dy), static_cast<int8_t>(dz)}};
+            m_Offsets[m_Size] = dx * strides[0] + dy * strides[1] + dz * strides[2];
+            m_Size++;
+          }
+        }
+      }
+    }
+  }
+
+  ~GridStencil() = default;
+
+  /**
+   * @brief Returns the number of neighbors of an interior cell
+   * @return
+   */
+  size_t size() const
+  {
+    return m_Size;
+  }
+
+  /**
+   * @brief Returns the number of cells in the grid
+   * @return
+   */
+  size_t getNumberOfCells() const
+  {
+    return m_Dims[0] * m_Dims[1] * m_Dims[2];
+  }
+
+  /**
+   * @brief Returns the index of cell (x, y, z)
+   */
+  size_t computeIndex(size_t x, size_t y, size_t z) const
+  {
+    return (z * m_Dims[1] + y) * m_Dims[0] + x;
+  }
+
+  /**
+   * @brief Returns the direction of neighbor k, each component being -1, 0 or 1
+   * @param k
+   * @param dir
+   */
+  void getDirection(size_t k, int dir[3]) const
+  {
+    dir[0] = m_Directions[k][0];
+    dir[1] = m_Directions[k][1];
+    dir[2] = m_Directions[k][2];
+  }
+
+  /**
+   * @brief Returns the value added to a cell index to get the index of neighbor k
+   * @param k
+   * @return
+   */
+  int64_t getIndexOffset(size_t k) const
+  {
+    return m_Offsets[k];
+  }
+
+  /**
+   * @brief Returns true if every neighbor of cell (x, y, z) is inside the grid
+   */
+  bool isInterior(size_t x, size_t y, size_t z) const
+  {
+    return isInteriorAlong(x, 0) && isInteriorAlong(y, 1) && isInteriorAlong(z, 2);
+  }
+
+  /**
+   * @brief Calls func(neighborIndex, k) for each neighbor of cell (x, y, z) that is inside the grid, where k is
+   * the position of the neighbor in the stencil. With Interior set the cell must satisfy isInterior() and no
+   * bounds are checked.
+   */
+  template <bool Interior, typename Func> void forEachNeighbor(size_t x, size_t y, size_t z, Func&& func) const
+  {
+    size_t index = computeIndex(x, y, z);
+    size_t coords[3] = {x, y, z};
+    for(size_t k = 0; k < m_Size; k++)
+    {
+      if(!Interior && !contains(coords, k))
+      {
+        continue;
+      }
+      func(static_cast<size_t>(static_cast<int64_t>(index) + m_Offsets[k]), k);
+    }
+  }
+
+  /**
+   * @brief Calls func(neighborIndex, k) for each neighbor of cell (x, y, z) that is inside the grid
+   */
+  template <typename Func> void forEachNeighbor(size_t x, size_t y, size_t z, Func&& func) const
+  {
+    if(isInterior(x, y, z))
+    {
+      forEachNeighbor<true>(x, y, z, func);
+    }
+    else
+    {
+      forEachNeighbor<false>(x, y, z, func);
+    }
+  }
+
+  /**
+   * @brief Stores the indices of the neighbors of cell (x, y, z) that are inside the grid
+   * @param neighbors Receives the neighbor indices
+   * @param positions If not null, receives the stencil position of each neighbor
+   * @return The number of neighbors
+   */
+  size_t getNeighbors(size_t x, size_t y, size_t z, std::array<size_t, MaxSize>& neighbors, std::array<size_t, MaxSize>* positions = nullptr) const
+  {
+    size_t count = 0;
+    forEachNeighbor(x, y, z, [&](size_t neighbor, size_t k) {
+      neighbors[count] = neighbor;
+      if(positions != nullptr)
+      {
+        (*positions)[count] = k;
+      }
+      count++;
+    });
+    return count;
+  }
+
+  /**
+   * @brief Calls func(cellIndex, neighborIndex, k) for every cell in the z slices [zStart, zEnd) and each of its
+   * neighbors that is inside the grid. The neighbors of a cell are visited one after the other. Splitting the z
+   * range lets a ParallelDataAlgorithm run the slices concurrently.
+   */
+  template <typename Func> void forEachCell(size_t zStart, size_t zEnd, Func&& func) const
+  {
+    for(size_t z = zStart; z < zEnd; z++)
+    {
+      for(size_t y = 0; y < m_Dims[1]; y++)
+      {
+        if(!isInteriorAlong(y, 1) || !isInteriorAlong(z, 2) || m_Dims[0] < 3)
+        {
+          for(size_t x = 0; x < m_Dims[0]; x++)
+          {
+            visitCell(x, y, z, func);
+          }
+          continue;
+        }
+        // The first and last cell of the row need bounds checks along x, the rest take the interior path
+        visitCell(0, y, z, func);
+        size_t index = computeIndex(1, y, z);
+        size_t end = computeIndex(m_Dims[0] - 1, y, z);
+        for(; index < end; index++)
+        {
+          for(size_t k = 0; k < m_Size; k++)
+          {
+            func(index, static_cast<size_t>(static_cast<int64_t>(index) + m_Offsets[k]), k);
+          }
+        }
+        visitCell(m_Dims[0] - 1, y, z, func);
+      }
+    }
+  }
+
+  /**
+   * @brief Calls func(cellIndex, neighborIndex, k) for every cell of the grid and each of its neighbors
+   */
+  template <typename Func> void forEachCell(Func&& func) const
+  {
+    forEachCell(0, m_Dims[2], func);
+  }
+
+private:
+  std::array<size_t, 3> m_Dims;
+  size_t m_Size = 0;
+  std::array<std::array<int8_t, 3>, MaxSize> m_Directions = {};
+  std::array<int64_t, MaxSize> m_Offsets = {};
+
+  bool isInteriorAlong(size_t coord, size_t axis) const
+  {
+    return m_Dims[axis] == 1 || (coord > 0 && coord + 1 < m_Dims[axis]);
+  }
+
+  bool contains(const size_t coords[3], size_t k) const
+  {
+    for(size_t a = 0; a < 3; a++)
+    {
+      int8_t d = m_Directions[k][a];
+      if((d < 0 && coords[a] == 0) || (d > 0 && coords[a] + 1 >= m_Dims[a]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename Func> void visitCell(size_t x, size_t y, size_t z, Func& func) const
+  {
+    size_t index = computeIndex(x, y, z);
+    forEachNeighbor(x, y, z, [&](size_t neighbor, size_t k) { func(index, neighbor, k); });
+  }
+};
@@ -155,6 +155,7 @@ void HexahedralGeom::initializeWithZeros()
 {
   m_VertexList->initializeWithZeros();
   m_HexList->initializeWithZeros();
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -328,6 +329,27 @@ void HexahedralGeom::deleteElementNeighbors()
   m_HexNeighbors = ElementDynamicList::NullPointer();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer HexahedralGeom::createSpatialIndex()
+{
+  SpatialIndex::Pointer index = SpatialIndex::New();
+  if(index->build(m_VertexList, m_HexList) < 0)
+  {
+    return SpatialIndex::NullPointer();
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HexahedralGeom::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  return index->isBuiltFrom(m_VertexList, m_HexList);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -515,6 +515,19 @@ class SIMPLib_EXPORT HexahedralGeom : public IGeometry3D
      */
     void setElementSizes(FloatArrayType::Pointer elementSizes) override;
 
+    /**
+     * @brief createSpatialIndex
+     * @return
+     */
+    SpatialIndex::Pointer createSpatialIndex() override;
+
+    /**
+     * @brief isSpatialIndexCurrent
+     * @param index
+     * @return
+     */
+    bool isSpatialIndexCurrent(const SpatialIndex::Pointer& index) override;
+
     /**
      * @brief setEdges
      * @param edges
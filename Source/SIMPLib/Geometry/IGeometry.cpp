@@ -448,6 +448,79 @@ QString IGeometry::getGeometryTypeAsString()
   return m_GeometryTypeName;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int IGeometry::findSpatialIndex()
+{
+  m_SpatialIndexOutOfDate.store(false, std::memory_order_release);
+  SpatialIndex::Pointer index = createSpatialIndex();
+  m_SpatialIndexMutex.lock();
+  m_SpatialIndex = index;
+  m_SpatialIndexMutex.unlock();
+  if(index.get() == nullptr)
+  {
+    return -1;
+  }
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer IGeometry::getSpatialIndex()
+{
+  m_SpatialIndexMutex.lock();
+  // Clear the flag before building, so a write that happens during the build marks the new index out of date
+  bool outOfDate = m_SpatialIndexOutOfDate.exchange(false, std::memory_order_acq_rel);
+  if(m_SpatialIndex.get() == nullptr || outOfDate || !isSpatialIndexCurrent(m_SpatialIndex))
+  {
+    m_SpatialIndex = createSpatialIndex();
+  }
+  SpatialIndex::Pointer index = m_SpatialIndex;
+  m_SpatialIndexMutex.unlock();
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IGeometry::deleteSpatialIndex()
+{
+  m_SpatialIndexMutex.lock();
+  m_SpatialIndex = SpatialIndex::NullPointer();
+  m_SpatialIndexMutex.unlock();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IGeometry::invalidateSpatialIndex()
+{
+  // Most writes find the flag already set, and a plain load keeps them from contending on the cache line
+  if(!m_SpatialIndexOutOfDate.load(std::memory_order_relaxed))
+  {
+    m_SpatialIndexOutOfDate.store(true, std::memory_order_release);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer IGeometry::createSpatialIndex()
+{
+  return SpatialIndex::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool IGeometry::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  Q_UNUSED(index)
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
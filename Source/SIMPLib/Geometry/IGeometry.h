@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <QMutex>
 #include <QtCore/QMap>
 #include <QtCore/QString>
@@ -45,6 +47,7 @@
 #include "SIMPLib/DataArrays/DynamicListArray.hpp"
 #include "SIMPLib/DataContainers/AttributeMatrix.h"
 #include "SIMPLib/Geometry/ITransformContainer.h"
+#include "SIMPLib/Geometry/SpatialIndex.h"
 #include "SIMPLib/SIMPLib.h"
 
 class QTextStream;
@@ -249,6 +252,34 @@ class SIMPLib_EXPORT IGeometry : public Observable
      */
     virtual void deleteElementNeighbors() = 0;
 
+// -----------------------------------------------------------------------------
+// Spatial Index
+// -----------------------------------------------------------------------------
+
+    /**
+     * @brief findSpatialIndex Builds a SpatialIndex over the elements of the geometry. Replacing, resizing or
+     * moving the vertices through the geometry API, or asking for a vertex or element pointer, marks the index as
+     * out of date. Code that keeps such a pointer and writes through it after the index was built, or that writes
+     * the shared lists through the DataArray itself, must call deleteSpatialIndex() afterwards.
+     * @return 1 on success, a negative value if the geometry does not support a spatial index or its element list
+     * refers to vertices that do not exist
+     */
+    virtual int findSpatialIndex() final;
+
+    /**
+     * @brief getSpatialIndex Returns the spatial index, building it first if it does not exist or is out of date.
+     * The index is also rebuilt when the vertex or element list no longer has the buffer or the number of tuples
+     * it was built from. This may be called from several threads at once; the index is built only once and its
+     * queries are thread safe.
+     * @return The index or a null pointer if it could not be built
+     */
+    virtual SpatialIndex::Pointer getSpatialIndex() final;
+
+    /**
+     * @brief deleteSpatialIndex
+     */
+    virtual void deleteSpatialIndex() final;
+
 // -----------------------------------------------------------------------------
 // Topology
 // -----------------------------------------------------------------------------
@@ -440,6 +471,31 @@ class SIMPLib_EXPORT IGeometry : public Observable
     QMutex m_Mutex;
     int64_t m_ProgressCounter;
 
+    SpatialIndex::Pointer m_SpatialIndex;
+    QMutex m_SpatialIndexMutex;
+    std::atomic<bool> m_SpatialIndexOutOfDate{false};
+
+    /**
+     * @brief invalidateSpatialIndex Marks the spatial index as out of date so the next getSpatialIndex() rebuilds
+     * it. This only sets a flag, so it is cheap enough to call on every write to a vertex or element.
+     */
+    void invalidateSpatialIndex();
+
+    /**
+     * @brief isSpatialIndexCurrent Returns whether index was built from the current vertex and element lists. The
+     * default implementation returns true for geometries that do not support an index.
+     * @param index
+     * @return
+     */
+    virtual bool isSpatialIndexCurrent(const SpatialIndex::Pointer& index);
+
+    /**
+     * @brief createSpatialIndex Builds a new spatial index over the elements of the geometry. The default
+     * implementation returns a null pointer for geometries that do not support one.
+     * @return
+     */
+    virtual SpatialIndex::Pointer createSpatialIndex();
+
     /**
      * @brief sendThreadSafeProgressMessage
      * @param counter
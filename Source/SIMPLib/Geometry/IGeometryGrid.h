@@ -39,6 +39,7 @@
 
 #include "SIMPLib/Common/SIMPLArray.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/GridStencil.h"
 #include "SIMPLib/Geometry/IGeometry.h"
 
 
@@ -80,6 +81,16 @@ class SIMPLib_EXPORT IGeometryGrid : public IGeometry
     virtual void getCoords(size_t x, size_t y, size_t z, double coords[3]) = 0;
     virtual void getCoords(size_t idx, double coords[3]) = 0;
 
+    /**
+     * @brief getStencil Returns a GridStencil that visits the face, edge or corner neighbors of the cells of
+     * the grid without materializing neighbor lists
+     * @return
+     */
+    template <GridConnectivity C> GridStencil<C> getStencil() const
+    {
+      return GridStencil<C>(getDimensions());
+    }
+
   public:
     IGeometryGrid(const IGeometryGrid&) = delete;  // Copy Constructor Not Implemented
     IGeometryGrid(IGeometryGrid&&) = delete;       // Move Constructor Not Implemented
@@ -1180,3 +1180,18 @@ ImageGeom::ErrorType ImageGeom::computeCellIndex(const float coords[], size_t& i
   }
   return err;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ImageGeom::ErrorType ImageGeom::computeCellIndex(const float coords[3], const GridLayout& layout, size_t& index)
+{
+  size_t cell[3] = {0, 0, 0};
+  ImageGeom::ErrorType err = computeCellIndex(coords, cell);
+  if(err != ImageGeom::ErrorType::NoError)
+  {
+    return err;
+  }
+  index = layout.computeIndex(cell[0], cell[1], cell[2]);
+  return err;
+}
@@ -37,6 +37,7 @@
 
 #include "SIMPLib/Common/SIMPLArray.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/GridLayout.h"
 #include "SIMPLib/Geometry/IGeometryGrid.h"
 
 /**
@@ -348,6 +349,16 @@ public:
    */
   ErrorType computeCellIndex(const float coords[3], size_t& index);
 
+  /**
+   * @brief computeCellIndex Computes the index into cell arrays stored in the given GridLayout, such as the
+   * layout returned by AttributeMatrix::getGridLayout()
+   * @param coords The Coords to check
+   * @param layout The layout of the cell arrays
+   * @param index The returned index into a scalar array
+   * @return Any return value != ErrorType::NoError is a failure to compute the index.
+   */
+  ErrorType computeCellIndex(const float coords[3], const GridLayout& layout, size_t& index);
+
 protected:
   ImageGeom();
 
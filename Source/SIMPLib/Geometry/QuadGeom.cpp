@@ -189,6 +189,7 @@ void QuadGeom::initializeWithZeros()
 {
   m_VertexList->initializeWithZeros();
   m_QuadList->initializeWithZeros();
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -335,6 +336,27 @@ void QuadGeom::deleteElementNeighbors()
   m_QuadNeighbors = ElementDynamicList::NullPointer();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer QuadGeom::createSpatialIndex()
+{
+  SpatialIndex::Pointer index = SpatialIndex::New();
+  if(index->build(m_VertexList, m_QuadList) < 0)
+  {
+    return SpatialIndex::NullPointer();
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool QuadGeom::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  return index->isBuiltFrom(m_VertexList, m_QuadList);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -476,6 +476,19 @@ protected:
    */
   void setElementSizes(FloatArrayType::Pointer elementSizes) override;
 
+  /**
+   * @brief createSpatialIndex
+   * @return
+   */
+  SpatialIndex::Pointer createSpatialIndex() override;
+
+  /**
+   * @brief isSpatialIndexCurrent
+   * @param index
+   * @return
+   */
+  bool isSpatialIndexCurrent(const SpatialIndex::Pointer& index) override;
+
   /**
    * @brief setEdges
    * @param edges
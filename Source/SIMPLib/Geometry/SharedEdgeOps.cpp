@@ -50,6 +50,7 @@ SharedEdgeList::Pointer GEOM_CLASS_NAME::CreateSharedEdgeList(size_t numEdges, b
 void GEOM_CLASS_NAME::resizeEdgeList(size_t newNumEdges)
 {
   m_EdgeList->resizeTuples(newNumEdges);
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -65,6 +66,7 @@ void GEOM_CLASS_NAME::setEdges(SharedEdgeList::Pointer edges)
     }
   }
   m_EdgeList = edges;
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -83,6 +85,7 @@ void GEOM_CLASS_NAME::setVertsAtEdge(size_t edgeId, size_t verts[2])
   size_t* Edge = m_EdgeList->getTuplePointer(edgeId);
   Edge[0] = verts[0];
   Edge[1] = verts[1];
+  invalidateSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -116,6 +119,7 @@ void GEOM_CLASS_NAME::getVertCoordsAtEdge(size_t edgeId, float vert1[3], float v
 // -----------------------------------------------------------------------------
 size_t* GEOM_CLASS_NAME::getEdgePointer(size_t i)
 {
+  invalidateSpatialIndex();
   return m_EdgeList->getTuplePointer(i);
 }
 
@@ -15,6 +15,7 @@ SharedHexList::Pointer GEOM_CLASS_NAME::CreateSharedHexList(size_t numHexas, boo
 void GEOM_CLASS_NAME::resizeHexList(size_t newNumHexas)
 {
   m_HexList->resizeTuples(newNumHexas);
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -30,6 +31,7 @@ void GEOM_CLASS_NAME::setHexahedra(SharedHexList::Pointer hexas)
     }
   }
   m_HexList = hexas;
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -54,6 +56,7 @@ void GEOM_CLASS_NAME::setVertsAtHex(size_t hexId, size_t verts[8])
   hex[5] = verts[5];
   hex[6] = verts[6];
   hex[7] = verts[7];
+  invalidateSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -117,6 +120,7 @@ void GEOM_CLASS_NAME::getVertCoordsAtHex(size_t hexId, float vert1[3], float ver
 // -----------------------------------------------------------------------------
 size_t* GEOM_CLASS_NAME::getHexPointer(size_t i)
 {
+  invalidateSpatialIndex();
   return m_HexList->getTuplePointer(i);
 }
 
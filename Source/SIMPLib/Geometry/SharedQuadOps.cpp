@@ -50,6 +50,7 @@ SharedQuadList::Pointer GEOM_CLASS_NAME::CreateSharedQuadList(size_t numQuads, b
 void GEOM_CLASS_NAME::resizeQuadList(size_t newNumQuads)
 {
   m_QuadList->resizeTuples(newNumQuads);
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -65,6 +66,7 @@ void GEOM_CLASS_NAME::setQuads(SharedQuadList::Pointer quads)
     }
   }
   m_QuadList = quads;
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -85,6 +87,7 @@ void GEOM_CLASS_NAME::setVertsAtQuad(size_t quadId, size_t verts[4])
   Quad[1] = verts[1];
   Quad[2] = verts[2];
   Quad[3] = verts[3];
+  invalidateSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -128,6 +131,7 @@ void GEOM_CLASS_NAME::getVertCoordsAtQuad(size_t quadId, float vert1[3], float v
 // -----------------------------------------------------------------------------
 size_t* GEOM_CLASS_NAME::getQuadPointer(size_t i)
 {
+  invalidateSpatialIndex();
   return m_QuadList->getTuplePointer(i);
 }
 
@@ -50,6 +50,7 @@ SharedTetList::Pointer GEOM_CLASS_NAME::CreateSharedTetList(size_t numTets, bool
 void GEOM_CLASS_NAME::resizeTetList(size_t newNumTets)
 {
   m_TetList->resizeTuples(newNumTets);
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -65,6 +66,7 @@ void GEOM_CLASS_NAME::setTetrahedra(SharedTetList::Pointer tets)
     }
   }
   m_TetList = tets;
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -85,6 +87,7 @@ void GEOM_CLASS_NAME::setVertsAtTet(size_t tetId, size_t verts[4])
   tet[1] = verts[1];
   tet[2] = verts[2];
   tet[3] = verts[3];
+  invalidateSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -128,6 +131,7 @@ void GEOM_CLASS_NAME::getVertCoordsAtTet(size_t tetId, float vert1[3], float ver
 // -----------------------------------------------------------------------------
 size_t* GEOM_CLASS_NAME::getTetPointer(size_t i)
 {
+  invalidateSpatialIndex();
   return m_TetList->getTuplePointer(i);
 }
 
@@ -50,6 +50,7 @@ SharedTriList::Pointer GEOM_CLASS_NAME::CreateSharedTriList(size_t numTris, bool
 void GEOM_CLASS_NAME::resizeTriList(size_t newNumTris)
 {
   m_TriList->resizeTuples(newNumTris);
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -65,6 +66,7 @@ void GEOM_CLASS_NAME::setTriangles(SharedTriList::Pointer triangles)
     }
   }
   m_TriList = triangles;
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -84,6 +86,7 @@ void GEOM_CLASS_NAME::setVertsAtTri(size_t triId, size_t verts[3])
   Tri[0] = verts[0];
   Tri[1] = verts[1];
   Tri[2] = verts[2];
+  invalidateSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -122,6 +125,7 @@ void GEOM_CLASS_NAME::getVertCoordsAtTri(size_t triId, float vert1[3], float ver
 // -----------------------------------------------------------------------------
 size_t* GEOM_CLASS_NAME::getTriPointer(size_t i)
 {
+  invalidateSpatialIndex();
   return m_TriList->getTuplePointer(i);
 }
 
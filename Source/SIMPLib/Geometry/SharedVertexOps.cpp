@@ -50,6 +50,7 @@ SharedVertexList::Pointer GEOM_CLASS_NAME::CreateSharedVertexList(size_t numVert
 void GEOM_CLASS_NAME::resizeVertexList(size_t newNumVertices)
 {
   m_VertexList->resizeTuples(newNumVertices);
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -65,6 +66,7 @@ void GEOM_CLASS_NAME::setVertices(SharedVertexList::Pointer vertices)
     }
   }
   m_VertexList = vertices;
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -84,6 +86,7 @@ void GEOM_CLASS_NAME::setCoords(size_t vertId, float coords[3])
   Vert[0] = coords[0];
   Vert[1] = coords[1];
   Vert[2] = coords[2];
+  invalidateSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -102,6 +105,7 @@ void GEOM_CLASS_NAME::getCoords(size_t vertId, float coords[3])
 // -----------------------------------------------------------------------------
 float* GEOM_CLASS_NAME::getVertexPointer(size_t i)
 {
+  invalidateSpatialIndex();
   return m_VertexList->getTuplePointer(i);
 }
 
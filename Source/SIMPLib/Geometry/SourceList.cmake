@@ -6,6 +6,8 @@ set(SIMPLib_${SUBDIR_NAME}_HDRS
   ${SIMPLib_SOURCE_DIR}/Geometry/CompositeTransformContainer.h
   ${SIMPLib_SOURCE_DIR}/Geometry/EdgeGeom.h
   ${SIMPLib_SOURCE_DIR}/Geometry/GeometryHelpers.h
+  ${SIMPLib_SOURCE_DIR}/Geometry/GridLayout.h
+  ${SIMPLib_SOURCE_DIR}/Geometry/GridStencil.h
   ${SIMPLib_SOURCE_DIR}/Geometry/HexahedralGeom.h
   ${SIMPLib_SOURCE_DIR}/Geometry/IGeometry.h
   ${SIMPLib_SOURCE_DIR}/Geometry/IGeometry2D.h
@@ -23,6 +25,7 @@ set(SIMPLib_${SUBDIR_NAME}_HDRS
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/EllipsoidOps.h
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/ShapeOps.h
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/SuperEllipsoidOps.h
+  ${SIMPLib_SOURCE_DIR}/Geometry/SpatialIndex.h
   ${SIMPLib_SOURCE_DIR}/Geometry/TetrahedralGeom.h
   ${SIMPLib_SOURCE_DIR}/Geometry/TransformContainer.h
   ${SIMPLib_SOURCE_DIR}/Geometry/TriangleGeom.h
@@ -33,6 +36,7 @@ set(SIMPLib_${SUBDIR_NAME}_SRCS
   ${SIMPLib_SOURCE_DIR}/Geometry/CompositeTransformContainer.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/EdgeGeom.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/GeometryHelpers.cpp
+  ${SIMPLib_SOURCE_DIR}/Geometry/GridLayout.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/HexahedralGeom.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/IGeometry.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/IGeometry2D.cpp
@@ -49,6 +53,7 @@ set(SIMPLib_${SUBDIR_NAME}_SRCS
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/EllipsoidOps.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/ShapeOps.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/SuperEllipsoidOps.cpp
+  ${SIMPLib_SOURCE_DIR}/Geometry/SpatialIndex.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/TetrahedralGeom.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/TransformContainer.cpp
   ${SIMPLib_SOURCE_DIR}/Geometry/TriangleGeom.cpp
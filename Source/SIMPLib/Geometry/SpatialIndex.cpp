@@ -0,0 +1,852 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
+
+namespace
+{
+/**
+ * @brief The ElementBoundsImpl class computes the bounding box of each element and flags elements that refer
+ * to a vertex that does not exist
+ */
+class ElementBoundsImpl
+{
+public:
+  ElementBoundsImpl(const float* vertices, size_t numVertices, const size_t* elements, size_t numVertsPerElement, float* bounds, std::atomic<bool>& invalid)
+  : m_Vertices(vertices)
+  , m_NumVertices(numVertices)
+  , m_Elements(elements)
+  , m_NumVertsPerElement(numVertsPerElement)
+  , m_Bounds(bounds)
+  , m_Invalid(invalid)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t e = range.min(); e < range.max(); e++)
+    {
+      float* bounds = m_Bounds + e * 6;
+      if(m_Elements == nullptr)
+      {
+        const float* vert = m_Vertices + e * 3;
+        std::copy(vert, vert + 3, bounds);
+        std::copy(vert, vert + 3, bounds + 3);
+        continue;
+      }
+      std::fill(bounds, bounds + 3, std::numeric_limits<float>::max());
+      std::fill(bounds + 3, bounds + 6, std::numeric_limits<float>::lowest());
+      const size_t* elem = m_Elements + e * m_NumVertsPerElement;
+      for(size_t v = 0; v < m_NumVertsPerElement; v++)
+      {
+        if(elem[v] >= m_NumVertices)
+        {
+          m_Invalid = true;
+          std::fill(bounds, bounds + 6, 0.0f);
+          break;
+        }
+        const float* vert = m_Vertices + elem[v] * 3;
+        for(size_t a = 0; a < 3; a++)
+        {
+          bounds[a] = std::min(bounds[a], vert[a]);
+          bounds[a + 3] = std::max(bounds[a + 3], vert[a]);
+        }
+      }
+    }
+  }
+
+private:
+  const float* m_Vertices;
+  size_t m_NumVertices;
+  const size_t* m_Elements;
+  size_t m_NumVertsPerElement;
+  float* m_Bounds;
+  std::atomic<bool>& m_Invalid;
+};
+
+/**
+ * @brief The GridCellFunctor class maps coordinates to the cells of the grid
+ */
+struct GridCellFunctor
+{
+  size_t dims[3];
+  float origin[3];
+  float cellSize[3];
+
+  size_t operator()(float coord, size_t axis) const
+  {
+    float cell = (coord - origin[axis]) / cellSize[axis];
+    if(!(cell > 0.0f))
+    {
+      return 0;
+    }
+    return std::min(static_cast<size_t>(cell), dims[axis] - 1);
+  }
+};
+
+/**
+ * @brief The CountElementCellsImpl class stores the number of grid cells overlapped by element e at counts[e + 1]
+ */
+class CountElementCellsImpl
+{
+public:
+  CountElementCellsImpl(const GridCellFunctor& grid, const float* bounds, size_t* counts)
+  : m_Grid(grid)
+  , m_Bounds(bounds)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t e = range.min(); e < range.max(); e++)
+    {
+      const float* bounds = m_Bounds + e * 6;
+      size_t count = 1;
+      for(size_t a = 0; a < 3; a++)
+      {
+        count *= m_Grid(bounds[a + 3], a) - m_Grid(bounds[a], a) + 1;
+      }
+      m_Counts[e + 1] = count;
+    }
+  }
+
+private:
+  GridCellFunctor m_Grid;
+  const float* m_Bounds;
+  size_t* m_Counts;
+};
+
+/**
+ * @brief The GatherCellKeysImpl class writes a (cell, element) pair for every grid cell overlapped by each element,
+ * starting at offsets[e]
+ */
+class GatherCellKeysImpl
+{
+public:
+  GatherCellKeysImpl(const GridCellFunctor& grid, const float* bounds, const size_t* offsets, std::pair<size_t, size_t>* keys)
+  : m_Grid(grid)
+  , m_Bounds(bounds)
+  , m_Offsets(offsets)
+  , m_Keys(keys)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t e = range.min(); e < range.max(); e++)
+    {
+      const float* bounds = m_Bounds + e * 6;
+      size_t lo[3];
+      size_t hi[3];
+      for(size_t a = 0; a < 3; a++)
+      {
+        lo[a] = m_Grid(bounds[a], a);
+        hi[a] = m_Grid(bounds[a + 3], a);
+      }
+      std::pair<size_t, size_t>* key = m_Keys + m_Offsets[e];
+      for(size_t z = lo[2]; z <= hi[2]; z++)
+      {
+        for(size_t y = lo[1]; y <= hi[1]; y++)
+        {
+          for(size_t x = lo[0]; x <= hi[0]; x++)
+          {
+            *key = std::make_pair((z * m_Grid.dims[1] + y) * m_Grid.dims[0] + x, e);
+            ++key;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  GridCellFunctor m_Grid;
+  const float* m_Bounds;
+  const size_t* m_Offsets;
+  std::pair<size_t, size_t>* m_Keys;
+};
+
+/**
+ * @brief Returns the values of t in [tMin, tMax] where the ray origin + t * direction is inside the box, or false
+ * if the ray misses the box
+ */
+bool ClipRayToBox(const double origin[3], const double direction[3], const float* boxMin, const float* boxMax, double& tMin, double& tMax)
+{
+  for(size_t a = 0; a < 3; a++)
+  {
+    if(direction[a] == 0.0)
+    {
+      if(origin[a] < boxMin[a] || origin[a] > boxMax[a])
+      {
+        return false;
+      }
+      continue;
+    }
+    double t0 = (boxMin[a] - origin[a]) / direction[a];
+    double t1 = (boxMax[a] - origin[a]) / direction[a];
+    if(t0 > t1)
+    {
+      std::swap(t0, t1);
+    }
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+    if(tMin > tMax)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::SpatialIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::~SpatialIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SpatialIndex::build(const FloatArrayType::Pointer& vertices, const DataArray<size_t>::Pointer& elements)
+{
+  if(vertices.get() == nullptr || vertices->getNumberOfComponents() != 3)
+  {
+    clear();
+    return -1;
+  }
+  const float* verts = vertices->getNumberOfTuples() > 0 ? vertices->getConstPointer(0) : nullptr;
+  if(elements.get() == nullptr)
+  {
+    return build(verts, vertices->getNumberOfTuples(), nullptr, 0, 0);
+  }
+  const size_t* elems = elements->getNumberOfTuples() > 0 ? elements->getConstPointer(0) : nullptr;
+  return build(verts, vertices->getNumberOfTuples(), elems, elements->getNumberOfTuples(), elements->getNumberOfComponents());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SpatialIndex::build(const float* vertices, size_t numVertices, const size_t* elements, size_t numElements, size_t numVertsPerElement)
+{
+  clear();
+  m_SourceVertices = vertices;
+  m_SourceNumVertices = numVertices;
+  m_SourceElements = elements;
+  m_SourceNumElements = elements != nullptr ? numElements : 0;
+  if(elements == nullptr)
+  {
+    numElements = numVertices;
+  }
+  if(numElements == 0)
+  {
+    return 0;
+  }
+  if(elements != nullptr && numVertsPerElement == 0)
+  {
+    return -2;
+  }
+
+  std::vector<float> elementBounds(numElements * 6);
+  std::atomic<bool> invalid(false);
+  ParallelDataAlgorithm boundsAlg;
+  boundsAlg.setRange(0, numElements);
+  boundsAlg.execute(ElementBoundsImpl(vertices, numVertices, elements, numVertsPerElement, elementBounds.data(), invalid));
+  if(invalid)
+  {
+    return -3;
+  }
+
+  std::fill(m_Min, m_Min + 3, std::numeric_limits<float>::max());
+  std::fill(m_Max, m_Max + 3, std::numeric_limits<float>::lowest());
+  for(size_t e = 0; e < numElements; e++)
+  {
+    const float* bounds = elementBounds.data() + e * 6;
+    for(size_t a = 0; a < 3; a++)
+    {
+      m_Min[a] = std::min(m_Min[a], bounds[a]);
+      m_Max[a] = std::max(m_Max[a], bounds[a + 3]);
+    }
+  }
+
+  // Pick a cubic cell size that gives about two elements per cell. Axes that are thinner than one cell, such as
+  // the z axis of a flat surface mesh, get a single layer of cells and the cell size is recomputed for the rest.
+  double extent[3] = {0.0, 0.0, 0.0};
+  bool spanned[3] = {false, false, false};
+  for(size_t a = 0; a < 3; a++)
+  {
+    extent[a] = static_cast<double>(m_Max[a]) - static_cast<double>(m_Min[a]);
+    spanned[a] = extent[a] > 0.0;
+  }
+  double targetCells = std::max(1.0, static_cast<double>(numElements) / 2.0);
+  double cellSize = 0.0;
+  for(size_t iter = 0; iter < 3; iter++)
+  {
+    double volume = 1.0;
+    double numSpanned = 0.0;
+    for(size_t a = 0; a < 3; a++)
+    {
+      if(spanned[a])
+      {
+        volume *= extent[a];
+        numSpanned += 1.0;
+      }
+    }
+    if(numSpanned == 0.0)
+    {
+      break;
+    }
+    cellSize = std::pow(volume / targetCells, 1.0 / numSpanned);
+    bool changed = false;
+    for(size_t a = 0; a < 3; a++)
+    {
+      if(spanned[a] && extent[a] < cellSize)
+      {
+        spanned[a] = false;
+        changed = true;
+      }
+    }
+    if(!changed)
+    {
+      break;
+    }
+  }
+
+  for(size_t a = 0; a < 3; a++)
+  {
+    m_Origin[a] = m_Min[a];
+    if(spanned[a] && cellSize > 0.0)
+    {
+      m_Dims[a] = std::max(static_cast<size_t>(1), static_cast<size_t>(std::ceil(extent[a] / cellSize)));
+      m_CellSize[a] = static_cast<float>(extent[a] / static_cast<double>(m_Dims[a]));
+    }
+    else
+    {
+      m_Dims[a] = 1;
+      m_CellSize[a] = extent[a] > 0.0 ? static_cast<float>(extent[a]) : 1.0f;
+    }
+  }
+
+  GridCellFunctor grid;
+  std::copy(m_Dims, m_Dims + 3, grid.dims);
+  std::copy(m_Origin, m_Origin + 3, grid.origin);
+  std::copy(m_CellSize, m_CellSize + 3, grid.cellSize);
+
+  // Count the cells overlapped by each element, then write and sort the (cell, element) pairs
+  std::vector<size_t> keyOffsets(numElements + 1, 0);
+  ParallelDataAlgorithm countAlg;
+  countAlg.setRange(0, numElements);
+  countAlg.execute(CountElementCellsImpl(grid, elementBounds.data(), keyOffsets.data()));
+  for(size_t e = 0; e < numElements; e++)
+  {
+    keyOffsets[e + 1] += keyOffsets[e];
+  }
+
+  std::vector<std::pair<size_t, size_t>> keys(keyOffsets[numElements]);
+  ParallelDataAlgorithm keysAlg;
+  keysAlg.setRange(0, numElements);
+  keysAlg.execute(GatherCellKeysImpl(grid, elementBounds.data(), keyOffsets.data(), keys.data()));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(keys.begin(), keys.end());
+#else
+  std::sort(keys.begin(), keys.end());
+#endif
+
+  size_t numCells = m_Dims[0] * m_Dims[1] * m_Dims[2];
+  m_CellOffsets.assign(numCells + 1, 0);
+  m_CellElements.resize(keys.size());
+  for(size_t i = 0; i < keys.size(); i++)
+  {
+    m_CellOffsets[keys[i].first + 1]++;
+    m_CellElements[i] = keys[i].second;
+  }
+  for(size_t c = 0; c < numCells; c++)
+  {
+    m_CellOffsets[c + 1] += m_CellOffsets[c];
+  }
+
+  m_ElementBounds.swap(elementBounds);
+  m_NumElements = numElements;
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpatialIndex::clear()
+{
+  m_NumElements = 0;
+  std::fill(m_Dims, m_Dims + 3, 0);
+  std::fill(m_Origin, m_Origin + 3, 0.0f);
+  std::fill(m_CellSize, m_CellSize + 3, 1.0f);
+  std::fill(m_Min, m_Min + 3, 0.0f);
+  std::fill(m_Max, m_Max + 3, 0.0f);
+  std::vector<float>().swap(m_ElementBounds);
+  std::vector<size_t>().swap(m_CellOffsets);
+  std::vector<size_t>().swap(m_CellElements);
+  m_SourceVertices = nullptr;
+  m_SourceNumVertices = 0;
+  m_SourceElements = nullptr;
+  m_SourceNumElements = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SpatialIndex::isBuiltFrom(const FloatArrayType::Pointer& vertices, const DataArray<size_t>::Pointer& elements) const
+{
+  if(vertices.get() == nullptr)
+  {
+    return false;
+  }
+  const float* verts = vertices->getNumberOfTuples() > 0 ? vertices->getConstPointer(0) : nullptr;
+  if(verts != m_SourceVertices || vertices->getNumberOfTuples() != m_SourceNumVertices)
+  {
+    return false;
+  }
+  if(elements.get() == nullptr)
+  {
+    return m_SourceElements == nullptr && m_SourceNumElements == 0;
+  }
+  const size_t* elems = elements->getNumberOfTuples() > 0 ? elements->getConstPointer(0) : nullptr;
+  return elems == m_SourceElements && elements->getNumberOfTuples() == m_SourceNumElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SpatialIndex::getNumberOfElements() const
+{
+  return m_NumElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpatialIndex::getGridDimensions(size_t dims[3]) const
+{
+  std::copy(m_Dims, m_Dims + 3, dims);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpatialIndex::getBounds(float min[3], float max[3]) const
+{
+  std::copy(m_Min, m_Min + 3, min);
+  std::copy(m_Max, m_Max + 3, max);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SpatialIndex::getElementBounds(size_t elementId, float min[3], float max[3]) const
+{
+  const float* bounds = m_ElementBounds.data() + elementId * 6;
+  std::copy(bounds, bounds + 3, min);
+  std::copy(bounds + 3, bounds + 6, max);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SpatialIndex::cellIndex(float coord, size_t axis) const
+{
+  float cell = (coord - m_Origin[axis]) / m_CellSize[axis];
+  if(!(cell > 0.0f))
+  {
+    return 0;
+  }
+  return std::min(static_cast<size_t>(cell), m_Dims[axis] - 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float SpatialIndex::squaredDistanceToElement(const float point[3], size_t elementId) const
+{
+  const float* bounds = m_ElementBounds.data() + elementId * 6;
+  float dist2 = 0.0f;
+  for(size_t a = 0; a < 3; a++)
+  {
+    float d = 0.0f;
+    if(point[a] < bounds[a])
+    {
+      d = bounds[a] - point[a];
+    }
+    else if(point[a] > bounds[a + 3])
+    {
+      d = point[a] - bounds[a + 3];
+    }
+    dist2 += d * d;
+  }
+  return dist2;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> SpatialIndex::findElementsInBox(const float min[3], const float max[3]) const
+{
+  std::vector<size_t> found;
+  if(m_NumElements == 0)
+  {
+    return found;
+  }
+  for(size_t a = 0; a < 3; a++)
+  {
+    if(min[a] > max[a] || min[a] > m_Max[a] || max[a] < m_Min[a])
+    {
+      return found;
+    }
+  }
+
+  size_t lo[3];
+  size_t hi[3];
+  for(size_t a = 0; a < 3; a++)
+  {
+    lo[a] = cellIndex(min[a], a);
+    hi[a] = cellIndex(max[a], a);
+  }
+  for(size_t z = lo[2]; z <= hi[2]; z++)
+  {
+    for(size_t y = lo[1]; y <= hi[1]; y++)
+    {
+      for(size_t x = lo[0]; x <= hi[0]; x++)
+      {
+        size_t cell = (z * m_Dims[1] + y) * m_Dims[0] + x;
+        size_t cellCoords[3] = {x, y, z};
+        for(size_t i = m_CellOffsets[cell]; i < m_CellOffsets[cell + 1]; i++)
+        {
+          size_t e = m_CellElements[i];
+          const float* bounds = m_ElementBounds.data() + e * 6;
+          bool overlaps = true;
+          bool owned = true;
+          for(size_t a = 0; a < 3 && overlaps; a++)
+          {
+            overlaps = bounds[a] <= max[a] && bounds[a + 3] >= min[a];
+            // An element that spans several cells is only reported by the cell holding the lower corner of its
+            // overlap with the query box, so no bookkeeping is needed to skip duplicates
+            owned = owned && cellIndex(std::max(bounds[a], min[a]), a) == cellCoords[a];
+          }
+          if(overlaps && owned)
+          {
+            found.push_back(e);
+          }
+        }
+      }
+    }
+  }
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> SpatialIndex::findElementsInRadius(const float center[3], float radius) const
+{
+  if(radius < 0.0f)
+  {
+    return std::vector<size_t>();
+  }
+  float min[3] = {center[0] - radius, center[1] - radius, center[2] - radius};
+  float max[3] = {center[0] + radius, center[1] + radius, center[2] + radius};
+  std::vector<size_t> found = findElementsInBox(min, max);
+  float radius2 = radius * radius;
+  found.erase(std::remove_if(found.begin(), found.end(), [&](size_t e) { return squaredDistanceToElement(center, e) > radius2; }), found.end());
+  return found;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> SpatialIndex::findNearestElements(const float point[3], size_t k, std::vector<float>* distances) const
+{
+  std::vector<size_t> found;
+  if(distances != nullptr)
+  {
+    distances->clear();
+  }
+  if(m_NumElements == 0 || k == 0)
+  {
+    return found;
+  }
+
+  // Visit shells of cells around the cell holding the point until the closest unvisited cell is further away than
+  // the k-th closest element found so far. The heap holds the k best (squared distance, element) pairs.
+  using Candidate = std::pair<float, size_t>;
+  std::priority_queue<Candidate> best;
+  size_t center[3];
+  size_t maxRing = 0;
+  for(size_t a = 0; a < 3; a++)
+  {
+    center[a] = cellIndex(point[a], a);
+    maxRing = std::max(maxRing, std::max(center[a], m_Dims[a] - 1 - center[a]));
+  }
+
+  auto visitCell = [&](size_t x, size_t y, size_t z) {
+    size_t cell = (z * m_Dims[1] + y) * m_Dims[0] + x;
+    size_t cellCoords[3] = {x, y, z};
+    for(size_t i = m_CellOffsets[cell]; i < m_CellOffsets[cell + 1]; i++)
+    {
+      size_t e = m_CellElements[i];
+      const float* bounds = m_ElementBounds.data() + e * 6;
+      // Only the cell holding the closest point of the element's box considers it
+      bool owned = true;
+      for(size_t a = 0; a < 3 && owned; a++)
+      {
+        owned = cellIndex(std::min(std::max(point[a], bounds[a]), bounds[a + 3]), a) == cellCoords[a];
+      }
+      if(!owned)
+      {
+        continue;
+      }
+      Candidate candidate(squaredDistanceToElement(point, e), e);
+      if(best.size() < k)
+      {
+        best.push(candidate);
+      }
+      else if(candidate < best.top())
+      {
+        best.pop();
+        best.push(candidate);
+      }
+    }
+  };
+
+  for(size_t ring = 0; ring <= maxRing; ring++)
+  {
+    size_t lo[3];
+    size_t hi[3];
+    for(size_t a = 0; a < 3; a++)
+    {
+      lo[a] = center[a] >= ring ? center[a] - ring : 0;
+      hi[a] = std::min(center[a] + ring, m_Dims[a] - 1);
+    }
+    for(size_t z = lo[2]; z <= hi[2]; z++)
+    {
+      bool zShell = (z + ring == center[2]) || (z == center[2] + ring);
+      for(size_t y = lo[1]; y <= hi[1]; y++)
+      {
+        if(zShell || y + ring == center[1] || y == center[1] + ring)
+        {
+          for(size_t x = lo[0]; x <= hi[0]; x++)
+          {
+            visitCell(x, y, z);
+          }
+          continue;
+        }
+        // Inside the shell only the first and last cell of the row are new
+        if(center[0] >= ring)
+        {
+          visitCell(center[0] - ring, y, z);
+        }
+        if(ring > 0 && center[0] + ring < m_Dims[0])
+        {
+          visitCell(center[0] + ring, y, z);
+        }
+      }
+    }
+
+    if(best.size() < k)
+    {
+      continue;
+    }
+    // Distance from the point to the closest cell outside the visited block
+    float bound = std::numeric_limits<float>::max();
+    for(size_t a = 0; a < 3; a++)
+    {
+      if(lo[a] > 0)
+      {
+        bound = std::min(bound, point[a] - (m_Origin[a] + static_cast<float>(lo[a]) * m_CellSize[a]));
+      }
+      if(hi[a] + 1 < m_Dims[a])
+      {
+        bound = std::min(bound, m_Origin[a] + static_cast<float>(hi[a] + 1) * m_CellSize[a] - point[a]);
+      }
+    }
+    if(bound == std::numeric_limits<float>::max())
+    {
+      break;
+    }
+    // Allow for the rounding of the cell lookups near cell faces
+    bound -= 1.0e-4f * std::min(m_CellSize[0], std::min(m_CellSize[1], m_CellSize[2]));
+    if(bound > 0.0f && bound * bound > best.top().first)
+    {
+      break;
+    }
+  }
+
+  found.resize(best.size());
+  std::vector<float> dists(best.size());
+  for(size_t i = best.size(); i > 0; i--)
+  {
+    found[i - 1] = best.top().second;
+    dists[i - 1] = std::sqrt(best.top().first);
+    best.pop();
+  }
+  if(distances != nullptr)
+  {
+    distances->swap(dists);
+  }
+  return found;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> SpatialIndex::findElementsAlongRay(const float origin[3], const float direction[3], float maxDistance, std::vector<float>* distances) const
+{
+  std::vector<size_t> found;
+  if(distances != nullptr)
+  {
+    distances->clear();
+  }
+  if(m_NumElements == 0 || maxDistance < 0.0f)
+  {
+    return found;
+  }
+
+  double o[3] = {origin[0], origin[1], origin[2]};
+  double d[3] = {direction[0], direction[1], direction[2]};
+  double tEnter = 0.0;
+  double tExit = maxDistance;
+  if(!ClipRayToBox(o, d, m_Min, m_Max, tEnter, tExit))
+  {
+    return found;
+  }
+
+  // Walk the cells pierced by the ray (Amanatides & Woo) starting where it enters the grid
+  size_t cell[3];
+  int64_t step[3];
+  double tNext[3];
+  double tDelta[3];
+  for(size_t a = 0; a < 3; a++)
+  {
+    cell[a] = cellIndex(static_cast<float>(o[a] + tEnter * d[a]), a);
+    if(d[a] > 0.0)
+    {
+      step[a] = 1;
+      tNext[a] = (m_Origin[a] + static_cast<double>(cell[a] + 1) * m_CellSize[a] - o[a]) / d[a];
+      tDelta[a] = m_CellSize[a] / d[a];
+    }
+    else if(d[a] < 0.0)
+    {
+      step[a] = -1;
+      tNext[a] = (m_Origin[a] + static_cast<double>(cell[a]) * m_CellSize[a] - o[a]) / d[a];
+      tDelta[a] = -m_CellSize[a] / d[a];
+    }
+    else
+    {
+      step[a] = 0;
+      tNext[a] = std::numeric_limits<double>::max();
+      tDelta[a] = std::numeric_limits<double>::max();
+    }
+  }
+
+  std::vector<std::pair<double, size_t>> hits;
+  while(true)
+  {
+    size_t c = (cell[2] * m_Dims[1] + cell[1]) * m_Dims[0] + cell[0];
+    for(size_t i = m_CellOffsets[c]; i < m_CellOffsets[c + 1]; i++)
+    {
+      size_t e = m_CellElements[i];
+      const float* bounds = m_ElementBounds.data() + e * 6;
+      double tMin = 0.0;
+      double tMax = maxDistance;
+      if(ClipRayToBox(o, d, bounds, bounds + 3, tMin, tMax))
+      {
+        hits.emplace_back(tMin, e);
+      }
+    }
+
+    size_t axis = 0;
+    if(tNext[1] < tNext[axis])
+    {
+      axis = 1;
+    }
+    if(tNext[2] < tNext[axis])
+    {
+      axis = 2;
+    }
+    if(step[axis] == 0 || tNext[axis] > tExit)
+    {
+      break;
+    }
+    if((step[axis] < 0 && cell[axis] == 0) || (step[axis] > 0 && cell[axis] + 1 >= m_Dims[axis]))
+    {
+      break;
+    }
+    cell[axis] = static_cast<size_t>(static_cast<int64_t>(cell[axis]) + step[axis]);
+    tNext[axis] += tDelta[axis];
+  }
+
+  // Elements that span several cells are hit once per cell
+  std::sort(hits.begin(), hits.end(), [](const std::pair<double, size_t>& lhs, const std::pair<double, size_t>& rhs) { return lhs.second < rhs.second; });
+  hits.erase(std::unique(hits.begin(), hits.end(), [](const std::pair<double, size_t>& lhs, const std::pair<double, size_t>& rhs) { return lhs.second == rhs.second; }), hits.end());
+  std::sort(hits.begin(), hits.end());
+
+  found.resize(hits.size());
+  std::vector<float> dists(hits.size());
+  for(size_t i = 0; i < hits.size(); i++)
+  {
+    found[i] = hits[i].second;
+    dists[i] = static_cast<float>(hits[i].first);
+  }
+  if(distances != nullptr)
+  {
+    distances->swap(dists);
+  }
+  return found;
+}
@@ -0,0 +1,204 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The SpatialIndex class is a uniform grid over the axis aligned bounding boxes of the elements of an
+ * unstructured geometry. Each grid cell holds the elements whose bounding box overlaps it, stored as flat CSR
+ * buffers, and the cell size is chosen so a cell holds about two elements on average. The queries only look at
+ * the cells that overlap the query region. For elements that are spread evenly a query costs about the number of
+ * elements it returns instead of O(M); elements clustered into a few cells, or elements much larger than a cell,
+ * make it approach O(M) again.
+ *
+ * The index works on element bounding boxes. For vertices the bounding box is the vertex itself and the query
+ * results are exact. For edges, triangles and the other cell types the results are the candidates whose
+ * bounding box satisfies the query; callers that need an exact answer (point in tetrahedron, ray/triangle
+ * intersection) test the candidates with GeometryMath.
+ *
+ * build() runs in parallel. Once built the index is never modified, so any number of threads may query it at
+ * the same time. IGeometry builds the index on demand, see IGeometry::getSpatialIndex().
+ */
+class SIMPLib_EXPORT SpatialIndex
+{
+public:
+  SIMPL_SHARED_POINTERS(SpatialIndex)
+  SIMPL_STATIC_NEW_MACRO(SpatialIndex)
+  SIMPL_TYPE_MACRO(SpatialIndex)
+
+  virtual ~SpatialIndex();
+
+  /**
+   * @brief Builds the index over the elements of a geometry. Passing a null element list indexes the vertices
+   * themselves, so element i is vertex i.
+   * @param vertices The shared vertex list (3 components)
+   * @param elements The element list, each tuple holding the vertex ids of one element. May be null.
+   * @return 0 on success, a negative value if an element refers to a vertex that does not exist
+   */
+  int build(const FloatArrayType::Pointer& vertices, const DataArray<size_t>::Pointer& elements);
+
+  /**
+   * @brief Builds the index from raw buffers.
+   * @param vertices numVertices * 3 coordinates
+   * @param numVertices
+   * @param elements numElements * numVertsPerElement vertex ids, or nullptr to index the vertices
+   * @param numElements Ignored when elements is nullptr
+   * @param numVertsPerElement Ignored when elements is nullptr
+   * @return 0 on success, a negative value if an element refers to a vertex that does not exist
+   */
+  int build(const float* vertices, size_t numVertices, const size_t* elements, size_t numElements, size_t numVertsPerElement);
+
+  /**
+   * @brief Removes every element from the index
+   */
+  void clear();
+
+  /**
+   * @brief Returns whether the index was built from these lists in their current memory. This compares the
+   * buffers and the number of tuples only, so it does not see values that were changed in place.
+   * @param vertices
+   * @param elements May be null
+   * @return
+   */
+  bool isBuiltFrom(const FloatArrayType::Pointer& vertices, const DataArray<size_t>::Pointer& elements) const;
+
+  /**
+   * @brief Returns the number of indexed elements
+   * @return
+   */
+  size_t getNumberOfElements() const;
+
+  /**
+   * @brief Returns the number of grid cells along each axis
+   * @param dims
+   */
+  void getGridDimensions(size_t dims[3]) const;
+
+  /**
+   * @brief Returns the bounding box of all the indexed elements
+   * @param min
+   * @param max
+   */
+  void getBounds(float min[3], float max[3]) const;
+
+  /**
+   * @brief Returns the bounding box of one element
+   * @param elementId
+   * @param min
+   * @param max
+   */
+  void getElementBounds(size_t elementId, float min[3], float max[3]) const;
+
+  /**
+   * @brief Finds the elements whose bounding box overlaps the box [min, max]. Touching boxes overlap.
+   * @param min
+   * @param max
+   * @return The element ids in ascending order
+   */
+  std::vector<size_t> findElementsInBox(const float min[3], const float max[3]) const;
+
+  /**
+   * @brief Finds the elements whose bounding box is no further than radius from center
+   * @param center
+   * @param radius
+   * @return The element ids in ascending order
+   */
+  std::vector<size_t> findElementsInRadius(const float center[3], float radius) const;
+
+  /**
+   * @brief Finds the k elements whose bounding box is closest to point. Elements at the same distance are
+   * ordered by id.
+   * @param point
+   * @param k
+   * @param distances If not null, receives the distance of each returned element
+   * @return The element ids ordered by distance, at most k of them
+   */
+  std::vector<size_t> findNearestElements(const float point[3], size_t k, std::vector<float>* distances = nullptr) const;
+
+  /**
+   * @brief Finds the elements whose bounding box is hit by the ray origin + t * direction, 0 <= t <= maxDistance.
+   * The direction does not need to be normalized; t is measured in units of its length.
+   * @param origin
+   * @param direction
+   * @param maxDistance
+   * @param distances If not null, receives the value of t where the ray enters each returned bounding box
+   * @return The element ids ordered by the distance at which the ray enters their bounding box
+   */
+  std::vector<size_t> findElementsAlongRay(const float origin[3], const float direction[3], float maxDistance, std::vector<float>* distances = nullptr) const;
+
+protected:
+  SpatialIndex();
+
+private:
+  size_t m_NumElements = 0;
+  size_t m_Dims[3] = {0, 0, 0};
+  float m_Origin[3] = {0.0f, 0.0f, 0.0f};
+  float m_CellSize[3] = {1.0f, 1.0f, 1.0f};
+  float m_Min[3] = {0.0f, 0.0f, 0.0f};
+  float m_Max[3] = {0.0f, 0.0f, 0.0f};
+  std::vector<float> m_ElementBounds; //!< min xyz, max xyz of each element
+  std::vector<size_t> m_CellOffsets;  //!< Start of the element list of each cell, with a final entry for the end
+  std::vector<size_t> m_CellElements;
+  const void* m_SourceVertices = nullptr; //!< Only compared against, never dereferenced
+  size_t m_SourceNumVertices = 0;
+  const void* m_SourceElements = nullptr;
+  size_t m_SourceNumElements = 0;
+
+  /**
+   * @brief Returns the grid cell along axis that contains the coordinate, clamped to the grid
+   */
+  size_t cellIndex(float coord, size_t axis) const;
+
+  /**
+   * @brief Returns the squared distance between point and the bounding box of elementId
+   */
+  float squaredDistanceToElement(const float point[3], size_t elementId) const;
+
+public:
+  SpatialIndex(const SpatialIndex&) = delete;            // Copy Constructor Not Implemented
+  SpatialIndex(SpatialIndex&&) = delete;                 // Move Constructor Not Implemented
+  SpatialIndex& operator=(const SpatialIndex&) = delete; // Copy Assignment Not Implemented
+  SpatialIndex& operator=(SpatialIndex&&) = delete;      // Move Assignment Not Implemented
+};
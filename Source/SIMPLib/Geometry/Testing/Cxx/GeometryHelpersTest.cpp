@@ -0,0 +1,206 @@
+#include <cstdlib>
+
+#include <iostream>
+
+#include "SIMPLib/Geometry/GeometryHelpers.h"
+#include "SIMPLib/Testing/SIMPLTestFileLocations.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+class GeometryHelpersTest
+{
+public:
+  GeometryHelpersTest() = default;
+
+  virtual ~GeometryHelpersTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int64ArrayType::Pointer createTriangleStrip(size_t numTris)
+  {
+    // Triangle i uses vertices i, i + 1 and i + 2 so every interior vertex is shared by three triangles
+    std::vector<size_t> cDims = {3};
+    Int64ArrayType::Pointer tris = Int64ArrayType::CreateArray(numTris, cDims, "Triangles", true);
+    for(size_t i = 0; i < numTris; i++)
+    {
+      tris->setComponent(i, 0, static_cast<int64_t>(i));
+      tris->setComponent(i, 1, static_cast<int64_t>(i + 1));
+      tris->setComponent(i, 2, static_cast<int64_t>(i + 2));
+    }
+    return tris;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFindElementsContainingVert()
+  {
+    const size_t numTris = 100000;
+    const size_t numVerts = numTris + 2;
+    Int64ArrayType::Pointer tris = createTriangleStrip(numTris);
+
+    UInt16Int64DynamicListArray::Pointer elemsContainingVert = UInt16Int64DynamicListArray::New();
+    GeometryHelpers::Connectivity::FindElementsContainingVert<uint16_t, int64_t>(tris, elemsContainingVert, numVerts);
+
+    DREAM3D_REQUIRE_EQUAL(elemsContainingVert->size(), numVerts)
+    DREAM3D_REQUIRE_EQUAL(elemsContainingVert->getIndices().size(), numTris * 3)
+    for(size_t v = 0; v < numVerts; v++)
+    {
+      // Vertex v is used by triangles v - 2, v - 1 and v, in ascending order
+      std::vector<int64_t> expected;
+      for(int64_t t = static_cast<int64_t>(v) - 2; t <= static_cast<int64_t>(v); t++)
+      {
+        if(t >= 0 && t < static_cast<int64_t>(numTris))
+        {
+          expected.push_back(t);
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(elemsContainingVert->getNumberOfElements(v), expected.size())
+      int64_t* elems = elemsContainingVert->getElementListPointer(v);
+      for(size_t i = 0; i < expected.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(elems[i], expected[i])
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFindElementNeighbors()
+  {
+    const size_t numTris = 1000;
+    Int64ArrayType::Pointer tris = createTriangleStrip(numTris);
+
+    UInt16Int64DynamicListArray::Pointer elemsContainingVert = UInt16Int64DynamicListArray::New();
+    GeometryHelpers::Connectivity::FindElementsContainingVert<uint16_t, int64_t>(tris, elemsContainingVert, numTris + 2);
+    UInt16Int64DynamicListArray::Pointer neighbors = UInt16Int64DynamicListArray::New();
+    int err = GeometryHelpers::Connectivity::FindElementNeighbors<uint16_t, int64_t>(tris, elemsContainingVert, neighbors, IGeometry::Type::Triangle);
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    DREAM3D_REQUIRE_EQUAL(neighbors->size(), numTris)
+
+    // Neighboring triangles in the strip share an edge
+    for(size_t t = 0; t < numTris; t++)
+    {
+      std::vector<int64_t> expected;
+      if(t > 0)
+      {
+        expected.push_back(static_cast<int64_t>(t - 1));
+      }
+      if(t + 1 < numTris)
+      {
+        expected.push_back(static_cast<int64_t>(t + 1));
+      }
+      DREAM3D_REQUIRE_EQUAL(neighbors->getNumberOfElements(t), expected.size())
+      int64_t* elems = neighbors->getElementListPointer(t);
+      std::vector<int64_t> found(elems, elems + neighbors->getNumberOfElements(t));
+      std::sort(found.begin(), found.end());
+      DREAM3D_REQUIRE(found == expected)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFindEdgesAndFaces()
+  {
+    const size_t numTris = 10000;
+    Int64ArrayType::Pointer tris = createTriangleStrip(numTris);
+    std::vector<size_t> edgeDims = {2};
+
+    // The strip has the edges (i, i + 1) and (i, i + 2). Only the first and last (i, i + 1) edges are shared by one triangle.
+    Int64ArrayType::Pointer edges = Int64ArrayType::CreateArray(0, edgeDims, "Edges", true);
+    GeometryHelpers::Connectivity::Find2DElementEdges<int64_t>(tris, edges);
+    DREAM3D_REQUIRE_EQUAL(edges->getNumberOfTuples(), 2 * numTris + 1)
+    for(size_t e = 1; e < edges->getNumberOfTuples(); e++)
+    {
+      int64_t* prev = edges->getTuplePointer(e - 1);
+      int64_t* cur = edges->getTuplePointer(e);
+      DREAM3D_REQUIRE(cur[0] < cur[1])
+      DREAM3D_REQUIRE(prev[0] < cur[0] || (prev[0] == cur[0] && prev[1] < cur[1]))
+    }
+    GeometryHelpers::Connectivity::Find2DUnsharedEdges<int64_t>(tris, edges);
+    DREAM3D_REQUIRE_EQUAL(edges->getNumberOfTuples(), numTris + 2)
+    DREAM3D_REQUIRE_EQUAL(edges->getComponent(0, 0), 0)
+    DREAM3D_REQUIRE_EQUAL(edges->getComponent(0, 1), 1)
+    DREAM3D_REQUIRE_EQUAL(edges->getComponent(1, 1), 2)
+
+    // Two tetrahedra that share the face (1, 2, 3)
+    std::vector<size_t> tetDims = {4};
+    Int64ArrayType::Pointer tets = Int64ArrayType::CreateArray(2, tetDims, "Tets", true);
+    int64_t tetVerts[8] = {3, 1, 2, 0, 4, 2, 1, 3};
+    std::copy(tetVerts, tetVerts + 8, tets->getPointer(0));
+    GeometryHelpers::Connectivity::FindTetEdges<int64_t>(tets, edges);
+    DREAM3D_REQUIRE_EQUAL(edges->getNumberOfTuples(), 9)
+    GeometryHelpers::Connectivity::FindUnsharedTetEdges<int64_t>(tets, edges);
+    DREAM3D_REQUIRE_EQUAL(edges->getNumberOfTuples(), 6)
+
+    std::vector<size_t> faceDims = {3};
+    Int64ArrayType::Pointer faces = Int64ArrayType::CreateArray(0, faceDims, "Faces", true);
+    GeometryHelpers::Connectivity::FindTetFaces<int64_t>(tets, faces);
+    DREAM3D_REQUIRE_EQUAL(faces->getNumberOfTuples(), 7)
+    GeometryHelpers::Connectivity::FindUnsharedTetFaces<int64_t>(tets, faces);
+    DREAM3D_REQUIRE_EQUAL(faces->getNumberOfTuples(), 6)
+    for(size_t f = 0; f < faces->getNumberOfTuples(); f++)
+    {
+      int64_t* face = faces->getTuplePointer(f);
+      DREAM3D_REQUIRE(!(face[0] == 1 && face[1] == 2 && face[2] == 3))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDynamicListArraySerialization()
+  {
+    const size_t numTris = 50;
+    Int64ArrayType::Pointer tris = createTriangleStrip(numTris);
+    UInt16Int64DynamicListArray::Pointer elemsContainingVert = UInt16Int64DynamicListArray::New();
+    GeometryHelpers::Connectivity::FindElementsContainingVert<uint16_t, int64_t>(tris, elemsContainingVert, numTris + 2);
+
+    std::vector<uint8_t> buffer;
+    elemsContainingVert->serializeLinks(buffer, elemsContainingVert->size());
+    DREAM3D_REQUIRE_EQUAL(buffer.size(), (numTris + 2) * sizeof(uint16_t) + numTris * 3 * sizeof(int64_t))
+
+    UInt16Int64DynamicListArray::Pointer readBack = UInt16Int64DynamicListArray::New();
+    readBack->deserializeLinks(buffer, numTris + 2);
+    DREAM3D_REQUIRE(readBack->getOffsets() == elemsContainingVert->getOffsets())
+    DREAM3D_REQUIRE(readBack->getIndices() == elemsContainingVert->getIndices())
+
+    // A truncated buffer must not be read past its end
+    buffer.resize(buffer.size() - 1);
+    readBack->deserializeLinks(buffer, numTris + 2);
+    DREAM3D_REQUIRE_EQUAL(readBack->size(), 0)
+
+    // Changing the length of one list shifts the lists that follow it
+    UInt16Int64DynamicListArray::Pointer copy = elemsContainingVert->deepCopy();
+    int64_t values[5] = {10, 11, 12, 13, 14};
+    DREAM3D_REQUIRE(copy->setElementList(4, 5, values))
+    DREAM3D_REQUIRE_EQUAL(copy->getNumberOfElements(4), 5)
+    DREAM3D_REQUIRE_EQUAL(copy->getElementListPointer(4)[4], 14)
+    DREAM3D_REQUIRE_EQUAL(copy->getElementListPointer(5)[0], 3)
+    DREAM3D_REQUIRE_EQUAL(copy->getIndices().size(), numTris * 3 + 2)
+    DREAM3D_REQUIRE(copy->setElementList(4, 1, values))
+    DREAM3D_REQUIRE_EQUAL(copy->getNumberOfElements(4), 1)
+    DREAM3D_REQUIRE_EQUAL(copy->getElementListPointer(5)[0], 3)
+    DREAM3D_REQUIRE_EQUAL(elemsContainingVert->getNumberOfElements(4), 3)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### GeometryHelpersTest Starting ####" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFindElementsContainingVert());
+    DREAM3D_REGISTER_TEST(TestFindElementNeighbors());
+    DREAM3D_REGISTER_TEST(TestFindEdgesAndFaces());
+    DREAM3D_REGISTER_TEST(TestDynamicListArraySerialization());
+  }
+
+private:
+  GeometryHelpersTest(const GeometryHelpersTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const GeometryHelpersTest&) = delete;      // Move assignment Not Implemented
+};
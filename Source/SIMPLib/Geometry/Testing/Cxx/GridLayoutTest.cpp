@@ -0,0 +1,280 @@
+#include <cstdlib>
+
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Geometry/GridLayout.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
+#include "SIMPLib/Testing/SIMPLTestFileLocations.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+class GridLayoutTest
+{
+public:
+  GridLayoutTest() = default;
+
+  virtual ~GridLayoutTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString testFile()
+  {
+    return UnitTest::TestTempDir + QString("/GridLayoutTest.h5");
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(testFile());
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer createIndexArray(const SizeVec3Type& dims)
+  {
+    size_t numCells = dims[0] * dims[1] * dims[2];
+    std::vector<size_t> cDims = {3};
+    Int32ArrayType::Pointer array = Int32ArrayType::CreateArray(numCells, cDims, "Coords", true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          array->setComponent(index, 0, static_cast<int32_t>(x));
+          array->setComponent(index, 1, static_cast<int32_t>(y));
+          array->setComponent(index, 2, static_cast<int32_t>(z));
+        }
+      }
+    }
+    return array;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void checkIndexArray(const Int32ArrayType::Pointer& array, const GridLayout& layout)
+  {
+    SizeVec3Type dims = layout.getDimensions();
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = layout.computeIndex(x, y, z);
+          DREAM3D_REQUIRE_EQUAL(array->getComponent(index, 0), static_cast<int32_t>(x))
+          DREAM3D_REQUIRE_EQUAL(array->getComponent(index, 1), static_cast<int32_t>(y))
+          DREAM3D_REQUIRE_EQUAL(array->getComponent(index, 2), static_cast<int32_t>(z))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestIndexing()
+  {
+    std::vector<SizeVec3Type> allDims = {SizeVec3Type(17, 9, 11), SizeVec3Type(8, 8, 8), SizeVec3Type(5, 1, 1), SizeVec3Type(20, 13, 1)};
+    std::vector<GridLayout::Type> types = {GridLayout::Type::RowMajor, GridLayout::Type::Bricked};
+    for(const SizeVec3Type& dims : allDims)
+    {
+      for(GridLayout::Type type : types)
+      {
+        GridLayout layout(dims, type);
+        size_t numCells = layout.getNumberOfCells();
+        DREAM3D_REQUIRE_EQUAL(numCells, dims[0] * dims[1] * dims[2])
+        std::vector<bool> used(numCells, false);
+        for(size_t z = 0; z < dims[2]; z++)
+        {
+          for(size_t y = 0; y < dims[1]; y++)
+          {
+            for(size_t x = 0; x < dims[0]; x++)
+            {
+              size_t index = layout.computeIndex(x, y, z);
+              DREAM3D_REQUIRE(index < numCells)
+              DREAM3D_REQUIRE(!used[index])
+              used[index] = true;
+              DREAM3D_REQUIRE_EQUAL(layout.fromRowMajor((z * dims[1] + y) * dims[0] + x), index)
+
+              size_t cx = 0;
+              size_t cy = 0;
+              size_t cz = 0;
+              layout.computeCoords(index, cx, cy, cz);
+              DREAM3D_REQUIRE_EQUAL(cx, x)
+              DREAM3D_REQUIRE_EQUAL(cy, y)
+              DREAM3D_REQUIRE_EQUAL(cz, z)
+            }
+          }
+        }
+      }
+    }
+
+    // The first brick is stored first and is contiguous
+    GridLayout bricked(SizeVec3Type(20, 20, 20), GridLayout::Type::Bricked);
+    DREAM3D_REQUIRE_EQUAL(bricked.computeIndex(7, 7, 7), 511)
+    DREAM3D_REQUIRE_EQUAL(bricked.computeIndex(8, 0, 0), 512)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestConvertArray()
+  {
+    SizeVec3Type dims(19, 10, 9);
+    Int32ArrayType::Pointer array = createIndexArray(dims);
+    DREAM3D_REQUIRE(GridLayout::CanConvertArray(array, dims))
+    DREAM3D_REQUIRE_EQUAL(GridLayout::ConvertArray(array, dims, GridLayout::Type::RowMajor, GridLayout::Type::Bricked), 0)
+    checkIndexArray(array, GridLayout(dims, GridLayout::Type::Bricked));
+    DREAM3D_REQUIRE_EQUAL(GridLayout::ConvertArray(array, dims, GridLayout::Type::Bricked, GridLayout::Type::RowMajor), 0)
+    checkIndexArray(array, GridLayout(dims, GridLayout::Type::RowMajor));
+
+    FloatArrayType::Pointer values = FloatArrayType::CreateArray(dims[0] * dims[1] * dims[2], "Values", true);
+    for(size_t i = 0; i < values->getNumberOfTuples(); i++)
+    {
+      values->setValue(i, static_cast<float>(i) * 0.5f);
+    }
+    DREAM3D_REQUIRE_EQUAL(GridLayout::ConvertArray(values, dims, GridLayout::Type::RowMajor, GridLayout::Type::Bricked), 0)
+    GridLayout layout(dims, GridLayout::Type::Bricked);
+    for(size_t i = 0; i < values->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(values->getValue(layout.fromRowMajor(i)), static_cast<float>(i) * 0.5f)
+    }
+
+    // Arrays that can not be reordered
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(dims[0] * dims[1] * dims[2], "Strings", true);
+    DREAM3D_REQUIRE(!GridLayout::CanConvertArray(strings, dims))
+    DREAM3D_REQUIRE_EQUAL(GridLayout::ConvertArray(strings, dims, GridLayout::Type::RowMajor, GridLayout::Type::Bricked), -1)
+    DREAM3D_REQUIRE_EQUAL(GridLayout::ConvertArray(values, SizeVec3Type(5, 5, 5), GridLayout::Type::Bricked, GridLayout::Type::RowMajor), -2)
+    DREAM3D_REQUIRE(GridLayout::CreateRowMajorCopy(strings, dims, GridLayout::Type::Bricked).get() == nullptr)
+
+    // A RowMajor copy leaves the bricked array as it is
+    const float* bricked = values->getConstPointer(0);
+    IDataArray::Pointer copy = GridLayout::CreateRowMajorCopy(values, dims, GridLayout::Type::Bricked);
+    FloatArrayType::Pointer rowMajor = std::dynamic_pointer_cast<FloatArrayType>(copy);
+    DREAM3D_REQUIRE_VALID_POINTER(rowMajor.get())
+    DREAM3D_REQUIRE(rowMajor != values)
+    DREAM3D_REQUIRE(values->getConstPointer(0) == bricked)
+    for(size_t i = 0; i < values->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(rowMajor->getValue(i), static_cast<float>(i) * 0.5f)
+      DREAM3D_REQUIRE_EQUAL(values->getValue(layout.fromRowMajor(i)), static_cast<float>(i) * 0.5f)
+    }
+    DREAM3D_REQUIRE(GridLayout::CreateRowMajorCopy(rowMajor, dims, GridLayout::Type::RowMajor) == copy)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAttributeMatrixLayout()
+  {
+    SizeVec3Type dims(12, 17, 10);
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    attrMat->insertOrAssign(createIndexArray(dims));
+    DREAM3D_REQUIRE(attrMat->getCellLayout() == GridLayout::Type::RowMajor)
+
+    DREAM3D_REQUIRE_EQUAL(attrMat->setCellLayout(GridLayout::Type::Bricked), 0)
+    DREAM3D_REQUIRE(attrMat->getCellLayout() == GridLayout::Type::Bricked)
+    GridLayout layout = attrMat->getGridLayout();
+    DREAM3D_REQUIRE(layout.getType() == GridLayout::Type::Bricked)
+    DREAM3D_REQUIRE_EQUAL(layout.getNumberOfCells(), dims[0] * dims[1] * dims[2])
+    Int32ArrayType::Pointer coords = attrMat->getAttributeArrayAs<Int32ArrayType>("Coords");
+    checkIndexArray(coords, layout);
+
+    AttributeMatrix::Pointer copy = attrMat->deepCopy(false);
+    DREAM3D_REQUIRE(copy->getCellLayout() == GridLayout::Type::Bricked)
+    checkIndexArray(copy->getAttributeArrayAs<Int32ArrayType>("Coords"), copy->getGridLayout());
+
+    // The index helper on the geometry follows the layout of the arrays
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry("Image");
+    image->setDimensions(dims);
+    float point[3] = {9.5f, 16.5f, 3.5f};
+    size_t index = 0;
+    DREAM3D_REQUIRE(image->computeCellIndex(point, layout, index) == ImageGeom::ErrorType::NoError)
+    DREAM3D_REQUIRE_EQUAL(index, layout.computeIndex(9, 16, 3))
+    DREAM3D_REQUIRE_EQUAL(coords->getComponent(index, 0), 9)
+    DREAM3D_REQUIRE_EQUAL(coords->getComponent(index, 1), 16)
+    DREAM3D_REQUIRE_EQUAL(coords->getComponent(index, 2), 3)
+
+    // A matrix holding an array that can not be reordered keeps its layout
+    attrMat->insertOrAssign(StringDataArray::CreateArray(dims[0] * dims[1] * dims[2], "Strings", true));
+    DREAM3D_REQUIRE(attrMat->setCellLayout(GridLayout::Type::RowMajor) < 0)
+    DREAM3D_REQUIRE(attrMat->getCellLayout() == GridLayout::Type::Bricked)
+    checkIndexArray(coords, layout);
+    attrMat->removeAttributeArray("Strings");
+
+    DREAM3D_REQUIRE_EQUAL(attrMat->setCellLayout(GridLayout::Type::RowMajor), 0)
+    checkIndexArray(coords, attrMat->getGridLayout());
+
+    // Resizing converts the arrays back to RowMajor, so the cells that are kept keep their values
+    DREAM3D_REQUIRE_EQUAL(attrMat->setCellLayout(GridLayout::Type::Bricked), 0)
+    std::vector<size_t> croppedDims = {dims[0], dims[1], 5};
+    attrMat->resizeAttributeArrays(croppedDims);
+    DREAM3D_REQUIRE(attrMat->getCellLayout() == GridLayout::Type::RowMajor)
+    checkIndexArray(coords, attrMat->getGridLayout());
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestWriteBrickedMatrix()
+  {
+    SizeVec3Type dims(11, 9, 10);
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    attrMat->insertOrAssign(createIndexArray(dims));
+    DREAM3D_REQUIRE_EQUAL(attrMat->setCellLayout(GridLayout::Type::Bricked), 0)
+    Int32ArrayType::Pointer bricked = attrMat->getAttributeArrayAs<Int32ArrayType>("Coords");
+    const int32_t* brickedValues = bricked->getConstPointer(0);
+
+    hid_t fileId = QH5Utilities::createFile(testFile());
+    DREAM3D_REQUIRE(fileId > 0)
+    int err = attrMat->writeAttributeArraysToHDF5(fileId);
+    DREAM3D_REQUIRE(err >= 0)
+
+    // The file holds the RowMajor layout and the arrays of the matrix were not touched by the write
+    IDataArray::Pointer read = H5DataArrayReader::ReadIDataArray(fileId, "Coords");
+    QH5Utilities::closeFile(fileId);
+    Int32ArrayType::Pointer coords = std::dynamic_pointer_cast<Int32ArrayType>(read);
+    DREAM3D_REQUIRE_VALID_POINTER(coords.get())
+    checkIndexArray(coords, GridLayout(dims, GridLayout::Type::RowMajor));
+    DREAM3D_REQUIRE(bricked->getConstPointer(0) == brickedValues)
+    checkIndexArray(bricked, attrMat->getGridLayout());
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### GridLayoutTest Starting ####" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestIndexing());
+    DREAM3D_REGISTER_TEST(TestConvertArray());
+    DREAM3D_REGISTER_TEST(TestAttributeMatrixLayout());
+    DREAM3D_REGISTER_TEST(TestWriteBrickedMatrix());
+    DREAM3D_REGISTER_TEST(RemoveTestFiles());
+  }
+
+private:
+  GridLayoutTest(const GridLayoutTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const GridLayoutTest&) = delete; // Move assignment Not Implemented
+};
@@ -0,0 +1,184 @@
+#include <cstdlib>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/Geometry/GridStencil.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/RectGridGeom.h"
+#include "SIMPLib/Testing/SIMPLTestFileLocations.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The CountNeighborsImpl class counts the neighbors of each cell in a range of z slices
+ */
+template <GridConnectivity C> class CountNeighborsImpl
+{
+public:
+  CountNeighborsImpl(const GridStencil<C>& stencil, std::vector<size_t>& counts)
+  : m_Stencil(stencil)
+  , m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    m_Stencil.forEachCell(range.min(), range.max(), [this](size_t cell, size_t /* neighbor */, size_t /* k */) { m_Counts[cell]++; });
+  }
+
+private:
+  GridStencil<C> m_Stencil;
+  std::vector<size_t>& m_Counts;
+};
+
+class GridStencilTest
+{
+public:
+  GridStencilTest() = default;
+
+  virtual ~GridStencilTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<size_t> bruteForceNeighbors(const SizeVec3Type& dims, int64_t x, int64_t y, int64_t z, int maxOrder)
+  {
+    std::vector<size_t> neighbors;
+    for(int64_t dz = -1; dz <= 1; dz++)
+    {
+      for(int64_t dy = -1; dy <= 1; dy++)
+      {
+        for(int64_t dx = -1; dx <= 1; dx++)
+        {
+          int order = (dx != 0) + (dy != 0) + (dz != 0);
+          int64_t nx = x + dx;
+          int64_t ny = y + dy;
+          int64_t nz = z + dz;
+          if(order == 0 || order > maxOrder || nx < 0 || ny < 0 || nz < 0 || nx >= static_cast<int64_t>(dims[0]) || ny >= static_cast<int64_t>(dims[1]) || nz >= static_cast<int64_t>(dims[2]))
+          {
+            continue;
+          }
+          neighbors.push_back(static_cast<size_t>((nz * static_cast<int64_t>(dims[1]) + ny) * static_cast<int64_t>(dims[0]) + nx));
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <GridConnectivity C> void checkStencil(const SizeVec3Type& dims, int maxOrder)
+  {
+    GridStencil<C> stencil(dims);
+    size_t numCells = stencil.getNumberOfCells();
+    std::vector<std::vector<size_t>> visited(numCells);
+    stencil.forEachCell([&](size_t cell, size_t neighbor, size_t k) {
+      visited[cell].push_back(neighbor);
+      int dir[3] = {0, 0, 0};
+      stencil.getDirection(k, dir);
+      int64_t offset = dir[0] + static_cast<int64_t>(dims[0]) * (dir[1] + static_cast<int64_t>(dims[1]) * dir[2]);
+      DREAM3D_REQUIRE_EQUAL(static_cast<int64_t>(neighbor) - static_cast<int64_t>(cell), offset)
+      DREAM3D_REQUIRE_EQUAL(stencil.getIndexOffset(k), offset)
+    });
+
+    std::array<size_t, GridStencil<C>::MaxSize> neighbors;
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t cell = stencil.computeIndex(x, y, z);
+          std::vector<size_t> expected = bruteForceNeighbors(dims, x, y, z, maxOrder);
+          std::vector<size_t> found = visited[cell];
+          std::sort(found.begin(), found.end());
+          DREAM3D_REQUIRE(found == expected)
+
+          size_t count = stencil.getNeighbors(x, y, z, neighbors);
+          found.assign(neighbors.begin(), neighbors.begin() + count);
+          std::sort(found.begin(), found.end());
+          DREAM3D_REQUIRE(found == expected)
+          if(stencil.isInterior(x, y, z))
+          {
+            DREAM3D_REQUIRE_EQUAL(count, stencil.size())
+          }
+        }
+      }
+    }
+
+    // The slices can be split across threads
+    std::vector<size_t> counts(numCells, 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, dims[2]);
+    dataAlg.execute(CountNeighborsImpl<C>(stencil, counts));
+    for(size_t cell = 0; cell < numCells; cell++)
+    {
+      DREAM3D_REQUIRE_EQUAL(counts[cell], visited[cell].size())
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestNeighbors()
+  {
+    std::vector<SizeVec3Type> allDims = {SizeVec3Type(7, 5, 4), SizeVec3Type(6, 5, 1), SizeVec3Type(2, 2, 2), SizeVec3Type(1, 6, 1), SizeVec3Type(1, 1, 1)};
+    for(const SizeVec3Type& dims : allDims)
+    {
+      checkStencil<GridConnectivity::Face>(dims, 1);
+      checkStencil<GridConnectivity::FaceEdge>(dims, 2);
+      checkStencil<GridConnectivity::FaceEdgeCorner>(dims, 3);
+    }
+
+    // Face neighbors come first, in the order -z, -y, -x, +x, +y, +z
+    GridStencil<GridConnectivity::FaceEdgeCorner> stencil(SizeVec3Type(10, 20, 30));
+    DREAM3D_REQUIRE_EQUAL(stencil.size(), 26)
+    std::vector<int64_t> faceOffsets = {-200, -10, -1, 1, 10, 200};
+    for(size_t k = 0; k < faceOffsets.size(); k++)
+    {
+      DREAM3D_REQUIRE_EQUAL(stencil.getIndexOffset(k), faceOffsets[k])
+    }
+
+    // A 2D image drops the z neighbors
+    GridStencil<GridConnectivity::Face> flat(SizeVec3Type(10, 20, 1));
+    DREAM3D_REQUIRE_EQUAL(flat.size(), 4)
+    DREAM3D_REQUIRE(flat.isInterior(5, 5, 0))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestGeometryStencil()
+  {
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry("Image");
+    image->setDimensions(SizeVec3Type(8, 9, 10));
+    GridStencil<GridConnectivity::Face> imageStencil = image->getStencil<GridConnectivity::Face>();
+    DREAM3D_REQUIRE_EQUAL(imageStencil.getNumberOfCells(), 720)
+    DREAM3D_REQUIRE_EQUAL(imageStencil.computeIndex(3, 4, 5), (5 * 9 + 4) * 8 + 3)
+
+    RectGridGeom::Pointer rectGrid = RectGridGeom::CreateGeometry("RectGrid");
+    rectGrid->setDimensions(SizeVec3Type(4, 3, 2));
+    IGeometryGrid::Pointer grid = rectGrid;
+    DREAM3D_REQUIRE_EQUAL(grid->getStencil<GridConnectivity::FaceEdgeCorner>().getNumberOfCells(), 24)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### GridStencilTest Starting ####" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestNeighbors());
+    DREAM3D_REGISTER_TEST(TestGeometryStencil());
+  }
+
+private:
+  GridStencilTest(const GridStencilTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const GridStencilTest&) = delete;  // Move assignment Not Implemented
+};
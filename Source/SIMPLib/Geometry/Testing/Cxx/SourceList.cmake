@@ -1,6 +1,10 @@
 
 set(TEST_${SUBDIR_NAME}_NAMES
   ImageGeomTest
+  GeometryHelpersTest
+  SpatialIndexTest
+  GridStencilTest
+  GridLayoutTest
 )
 
 SIMPL_ADD_UNIT_TEST("${TEST_${SUBDIR_NAME}_NAMES}" "${SIMPLib_SOURCE_DIR}/${SUBDIR_NAME}/Testing/Cxx")
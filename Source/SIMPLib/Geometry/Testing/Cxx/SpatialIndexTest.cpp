@@ -0,0 +1,272 @@
+#include <cstdlib>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <utility>
+
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/SpatialIndex.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Testing/SIMPLTestFileLocations.h"
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+class SpatialIndexTest
+{
+public:
+  SpatialIndexTest() = default;
+
+  virtual ~SpatialIndexTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  SharedVertexList::Pointer createPointCloud(size_t numVerts, float zExtent)
+  {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    SharedVertexList::Pointer vertices = VertexGeom::CreateSharedVertexList(numVerts, true);
+    for(size_t v = 0; v < numVerts; v++)
+    {
+      float* vert = vertices->getTuplePointer(v);
+      vert[0] = distribution(generator);
+      vert[1] = distribution(generator) * 0.5f;
+      vert[2] = distribution(generator) * zExtent;
+    }
+    return vertices;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  float squaredDistanceToBox(const float* point, const float* min, const float* max)
+  {
+    float dist2 = 0.0f;
+    for(size_t a = 0; a < 3; a++)
+    {
+      float d = std::max(std::max(min[a] - point[a], point[a] - max[a]), 0.0f);
+      dist2 += d * d;
+    }
+    return dist2;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void checkQueries(const SpatialIndex::Pointer& index)
+  {
+    size_t numElems = index->getNumberOfElements();
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-12.0f, 12.0f);
+    for(size_t q = 0; q < 50; q++)
+    {
+      float point[3] = {distribution(generator), distribution(generator) * 0.5f, distribution(generator) * 0.5f};
+      float halfWidth = 0.05f * static_cast<float>(q);
+      float boxMin[3] = {point[0] - halfWidth, point[1] - halfWidth, point[2] - halfWidth};
+      float boxMax[3] = {point[0] + 2.0f * halfWidth, point[1] + halfWidth, point[2] + halfWidth};
+
+      std::vector<size_t> expectedBox;
+      std::vector<size_t> expectedRadius;
+      std::vector<std::pair<float, size_t>> byDistance;
+      for(size_t e = 0; e < numElems; e++)
+      {
+        float min[3] = {0.0f, 0.0f, 0.0f};
+        float max[3] = {0.0f, 0.0f, 0.0f};
+        index->getElementBounds(e, min, max);
+        bool overlaps = true;
+        for(size_t a = 0; a < 3; a++)
+        {
+          overlaps = overlaps && min[a] <= boxMax[a] && max[a] >= boxMin[a];
+        }
+        if(overlaps)
+        {
+          expectedBox.push_back(e);
+        }
+        float dist2 = squaredDistanceToBox(point, min, max);
+        if(dist2 <= halfWidth * halfWidth)
+        {
+          expectedRadius.push_back(e);
+        }
+        byDistance.emplace_back(dist2, e);
+      }
+      std::sort(byDistance.begin(), byDistance.end());
+
+      DREAM3D_REQUIRE(index->findElementsInBox(boxMin, boxMax) == expectedBox)
+      DREAM3D_REQUIRE(index->findElementsInRadius(point, halfWidth) == expectedRadius)
+
+      size_t k = std::min(q + 1, numElems);
+      std::vector<float> distances;
+      std::vector<size_t> nearest = index->findNearestElements(point, k, &distances);
+      DREAM3D_REQUIRE_EQUAL(nearest.size(), k)
+      DREAM3D_REQUIRE_EQUAL(distances.size(), k)
+      for(size_t i = 0; i < k; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(nearest[i], byDistance[i].second)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPointQueries()
+  {
+    // A 3D cloud and a flat cloud, which gets a single layer of grid cells in z
+    std::vector<float> zExtents = {0.5f, 0.0f};
+    for(float zExtent : zExtents)
+    {
+      SharedVertexList::Pointer vertices = createPointCloud(20000, zExtent);
+      SpatialIndex::Pointer index = SpatialIndex::New();
+      DREAM3D_REQUIRE_EQUAL(index->build(vertices, MeshIndexArrayType::NullPointer()), 0)
+      DREAM3D_REQUIRE_EQUAL(index->getNumberOfElements(), 20000)
+      size_t dims[3] = {0, 0, 0};
+      index->getGridDimensions(dims);
+      DREAM3D_REQUIRE(dims[0] * dims[1] * dims[2] <= 20000)
+      if(zExtent == 0.0f)
+      {
+        DREAM3D_REQUIRE_EQUAL(dims[2], 1)
+      }
+      checkQueries(index);
+    }
+
+    // Queries that miss the cloud or ask for nothing
+    SpatialIndex::Pointer index = SpatialIndex::New();
+    DREAM3D_REQUIRE_EQUAL(index->build(createPointCloud(100, 0.5f), MeshIndexArrayType::NullPointer()), 0)
+    float farMin[3] = {100.0f, 100.0f, 100.0f};
+    float farMax[3] = {101.0f, 101.0f, 101.0f};
+    DREAM3D_REQUIRE(index->findElementsInBox(farMin, farMax).empty())
+    DREAM3D_REQUIRE(index->findNearestElements(farMin, 0).empty())
+    DREAM3D_REQUIRE_EQUAL(index->findNearestElements(farMin, 1000).size(), 100)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestElementQueries()
+  {
+    // Triangles of very different sizes so many of them span several grid cells
+    SharedVertexList::Pointer vertices = createPointCloud(3000, 0.5f);
+    std::vector<size_t> cDims = {3};
+    size_t numTris = 2000;
+    SharedTriList::Pointer tris = SharedTriList::CreateArray(numTris, cDims, SIMPL::Geometry::SharedTriList, true);
+    for(size_t t = 0; t < numTris; t++)
+    {
+      tris->setComponent(t, 0, t);
+      tris->setComponent(t, 1, t + 1);
+      tris->setComponent(t, 2, (t % 7 == 0) ? (t * 31) % 3000 : t + 2);
+    }
+
+    SpatialIndex::Pointer index = SpatialIndex::New();
+    DREAM3D_REQUIRE_EQUAL(index->build(vertices, tris), 0)
+    DREAM3D_REQUIRE_EQUAL(index->getNumberOfElements(), numTris)
+    checkQueries(index);
+
+    // Rays along the x axis through the middle of the mesh
+    for(size_t r = 0; r < 20; r++)
+    {
+      float origin[3] = {-15.0f, -5.0f + 0.5f * static_cast<float>(r), 0.1f};
+      float direction[3] = {1.0f, 0.01f, 0.0f};
+      std::vector<std::pair<float, size_t>> expected;
+      for(size_t t = 0; t < numTris; t++)
+      {
+        float min[3] = {0.0f, 0.0f, 0.0f};
+        float max[3] = {0.0f, 0.0f, 0.0f};
+        index->getElementBounds(t, min, max);
+        if(origin[2] < min[2] || origin[2] > max[2])
+        {
+          continue;
+        }
+        float tMin = std::max((min[0] - origin[0]) / direction[0], (min[1] - origin[1]) / direction[1]);
+        float tMax = std::min((max[0] - origin[0]) / direction[0], (max[1] - origin[1]) / direction[1]);
+        if(tMin <= tMax && tMin <= 30.0f && tMax >= 0.0f)
+        {
+          expected.emplace_back(tMin, t);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+
+      std::vector<float> distances;
+      std::vector<size_t> hits = index->findElementsAlongRay(origin, direction, 30.0f, &distances);
+      DREAM3D_REQUIRE_EQUAL(hits.size(), expected.size())
+      for(size_t i = 0; i < hits.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(hits[i], expected[i].second)
+      }
+      DREAM3D_REQUIRE(std::is_sorted(distances.begin(), distances.end()))
+    }
+
+    // An element that refers to a missing vertex
+    tris->setComponent(5, 1, 3000);
+    DREAM3D_REQUIRE(index->build(vertices, tris) < 0)
+    DREAM3D_REQUIRE_EQUAL(index->getNumberOfElements(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestGeometrySpatialIndex()
+  {
+    VertexGeom::Pointer geom = VertexGeom::CreateGeometry(createPointCloud(1000, 0.5f), "Vertices");
+    SpatialIndex::Pointer index = geom->getSpatialIndex();
+    DREAM3D_REQUIRE_VALID_POINTER(index.get())
+    DREAM3D_REQUIRE_EQUAL(index->getNumberOfElements(), 1000)
+    DREAM3D_REQUIRE(geom->getSpatialIndex() == index)
+
+    // Moving a vertex invalidates the index and the rebuilt index sees the new position
+    float coords[3] = {50.0f, 50.0f, 50.0f};
+    geom->setCoords(17, coords);
+    SpatialIndex::Pointer rebuilt = geom->getSpatialIndex();
+    DREAM3D_REQUIRE(rebuilt != index)
+    std::vector<size_t> nearest = rebuilt->findNearestElements(coords, 1);
+    DREAM3D_REQUIRE_EQUAL(nearest.size(), 1)
+    DREAM3D_REQUIRE_EQUAL(nearest[0], 17)
+
+    // Writing through a vertex pointer
+    float* vertex = geom->getVertexPointer(23);
+    vertex[0] = -50.0f;
+    vertex[1] = -50.0f;
+    vertex[2] = -50.0f;
+    index = geom->getSpatialIndex();
+    DREAM3D_REQUIRE(index != rebuilt)
+    nearest = index->findNearestElements(vertex, 1);
+    DREAM3D_REQUIRE_EQUAL(nearest[0], 23)
+
+    // Resizing the vertex list through the DataArray bypasses the geometry
+    geom->getVertices()->resizeTuples(2000);
+    rebuilt = geom->getSpatialIndex();
+    DREAM3D_REQUIRE(rebuilt != index)
+    DREAM3D_REQUIRE_EQUAL(rebuilt->getNumberOfElements(), 2000)
+    DREAM3D_REQUIRE(geom->getSpatialIndex() == rebuilt)
+
+    geom->deleteSpatialIndex();
+    DREAM3D_REQUIRE_EQUAL(geom->findSpatialIndex(), 1)
+
+    TriangleGeom::Pointer triGeom = TriangleGeom::CreateGeometry(1, createPointCloud(3, 0.5f), "Triangles", true);
+    size_t verts[3] = {0, 1, 2};
+    triGeom->setVertsAtTri(0, verts);
+    DREAM3D_REQUIRE_EQUAL(triGeom->getSpatialIndex()->getNumberOfElements(), 1)
+
+    // Grid geometries have implicit topology and do not build an index
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry("Image");
+    DREAM3D_REQUIRE(image->getSpatialIndex().get() == nullptr)
+    DREAM3D_REQUIRE(image->findSpatialIndex() < 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### SpatialIndexTest Starting ####" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPointQueries());
+    DREAM3D_REGISTER_TEST(TestElementQueries());
+    DREAM3D_REGISTER_TEST(TestGeometrySpatialIndex());
+  }
+
+private:
+  SpatialIndexTest(const SpatialIndexTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const SpatialIndexTest&) = delete;   // Move assignment Not Implemented
+};
@@ -190,6 +190,7 @@ void TetrahedralGeom::initializeWithZeros()
 {
   m_VertexList->initializeWithZeros();
   m_TetList->initializeWithZeros();
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -363,6 +364,27 @@ void TetrahedralGeom::deleteElementNeighbors()
   m_TetNeighbors = ElementDynamicList::NullPointer();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer TetrahedralGeom::createSpatialIndex()
+{
+  SpatialIndex::Pointer index = SpatialIndex::New();
+  if(index->build(m_VertexList, m_TetList) < 0)
+  {
+    return SpatialIndex::NullPointer();
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TetrahedralGeom::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  return index->isBuiltFrom(m_VertexList, m_TetList);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -188,6 +188,7 @@ void TriangleGeom::initializeWithZeros()
 {
   m_VertexList->initializeWithZeros();
   m_TriList->initializeWithZeros();
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -334,6 +335,27 @@ void TriangleGeom::deleteElementNeighbors()
   m_TriangleNeighbors = ElementDynamicList::NullPointer();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer TriangleGeom::createSpatialIndex()
+{
+  SpatialIndex::Pointer index = SpatialIndex::New();
+  if(index->build(m_VertexList, m_TriList) < 0)
+  {
+    return SpatialIndex::NullPointer();
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TriangleGeom::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  return index->isBuiltFrom(m_VertexList, m_TriList);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
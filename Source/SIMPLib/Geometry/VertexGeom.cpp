@@ -107,6 +107,7 @@ VertexGeom::Pointer VertexGeom::CreateGeometry(const SharedVertexList::Pointer&
 void VertexGeom::initializeWithZeros()
 {
   m_VertexList->initializeWithZeros();
+  deleteSpatialIndex();
 }
 
 // -----------------------------------------------------------------------------
@@ -200,6 +201,27 @@ void VertexGeom::deleteElementNeighbors()
 {
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SpatialIndex::Pointer VertexGeom::createSpatialIndex()
+{
+  SpatialIndex::Pointer index = SpatialIndex::New();
+  if(index->build(m_VertexList, MeshIndexArrayType::NullPointer()) < 0)
+  {
+    return SpatialIndex::NullPointer();
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VertexGeom::isSpatialIndexCurrent(const SpatialIndex::Pointer& index)
+{
+  return index->isBuiltFrom(m_VertexList, MeshIndexArrayType::NullPointer());
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
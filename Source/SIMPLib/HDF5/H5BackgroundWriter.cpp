@@ -0,0 +1,176 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "H5BackgroundWriter.h"
+
+#include "SIMPLib/HDF5/H5LibraryLock.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5BackgroundWriter::H5BackgroundWriter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5BackgroundWriter::~H5BackgroundWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_JobQueued.notify_all();
+  if(m_Thread.joinable())
+  {
+    m_Thread.join();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5BackgroundWriter* H5BackgroundWriter::Instance()
+{
+  static H5BackgroundWriter s_Writer;
+  return &s_Writer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5BackgroundWriter::Ticket H5BackgroundWriter::enqueue(WriteJob job)
+{
+  Ticket ticket;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(!m_Thread.joinable())
+    {
+      m_Thread = std::thread(&H5BackgroundWriter::run, this);
+    }
+    QueuedJob queuedJob;
+    queuedJob.job = std::move(job);
+    ticket = queuedJob.result.get_future().share();
+    m_Jobs.push_back(std::move(queuedJob));
+    m_NumPending++;
+  }
+  m_JobQueued.notify_one();
+  return ticket;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5BackgroundWriter::JobResult H5BackgroundWriter::wait(const Ticket& ticket)
+{
+  if(!ticket.valid())
+  {
+    return JobResult();
+  }
+  // The job needs the library lock to run
+  int depth = H5LibraryLock::ReleaseAll();
+  ticket.wait();
+  H5LibraryLock::Relock(depth);
+  return ticket.get();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5BackgroundWriter::waitForPendingWrites()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  if(std::this_thread::get_id() == m_Thread.get_id())
+  {
+    // A running job can not wait for itself
+    return;
+  }
+  if(m_NumPending == 0)
+  {
+    return;
+  }
+  // The jobs need the library lock to run
+  lock.unlock();
+  int depth = H5LibraryLock::ReleaseAll();
+  lock.lock();
+  m_JobsFinished.wait(lock, [this] { return m_NumPending == 0; });
+  lock.unlock();
+  H5LibraryLock::Relock(depth);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5BackgroundWriter::getNumberOfPendingWrites() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumPending;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5BackgroundWriter::run()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while(true)
+  {
+    m_JobQueued.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+    if(m_Jobs.empty())
+    {
+      // Only stop once everything that was queued has been written
+      break;
+    }
+
+    QueuedJob queuedJob = std::move(m_Jobs.front());
+    m_Jobs.pop_front();
+    lock.unlock();
+
+    JobResult result;
+    {
+      H5LibraryLock libraryLock;
+      result.code = queuedJob.job(result.message);
+      // Release whatever the job captured before it is reported as finished
+      queuedJob.job = WriteJob();
+    }
+    queuedJob.result.set_value(result);
+
+    lock.lock();
+    m_NumPending--;
+    if(m_NumPending == 0)
+    {
+      m_JobsFinished.notify_all();
+    }
+  }
+}
@@ -0,0 +1,148 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The H5BackgroundWriter class runs HDF5 write jobs one at a time on a dedicated thread so that a pipeline
+ * can continue with its next filters while a file is being written. Jobs run in the order they were queued.
+ * Other background HDF5 work, such as the prefetching of a StreamingDataContainerBundle, is queued here as well.
+ *
+ * Each job runs while holding the H5LibraryLock, which every other thread holds around its own HDF5 calls, so
+ * only one thread calls into HDF5 at a time. enqueue() returns a Ticket that completes with the result of the job,
+ * so that the code that queued a job can wait for it and see its failure without affecting anybody else's jobs.
+ */
+class SIMPLib_EXPORT H5BackgroundWriter
+{
+public:
+  /**
+   * @brief A write job returns 0 or a positive value on success. On failure it returns a negative error code
+   * and may describe the failure in message.
+   */
+  using WriteJob = std::function<int(QString& message)>;
+
+  /**
+   * @brief The result of a write job. A negative code means the job failed.
+   */
+  struct JobResult
+  {
+    int code = 0;
+    QString message;
+  };
+
+  /**
+   * @brief Completes with the result of the job it was returned for
+   */
+  using Ticket = std::shared_future<JobResult>;
+
+  /**
+   * @brief Returns the writer shared by the whole process. The writer thread is started the first time a job is queued.
+   * @return
+   */
+  static H5BackgroundWriter* Instance();
+
+  /**
+   * @brief Finishes the queued jobs and stops the writer thread
+   */
+  virtual ~H5BackgroundWriter();
+
+  /**
+   * @brief Queues a job. Anything the job uses must be owned by the job itself, for example by capturing shared pointers.
+   * @param job
+   * @return The ticket of the job
+   */
+  Ticket enqueue(WriteJob job);
+
+  /**
+   * @brief Blocks until the job of ticket has finished and returns its result. The H5LibraryLock held by the calling
+   * thread is released while waiting. Must not be called from a job for a job that was queued after it.
+   * @param ticket
+   * @return
+   */
+  JobResult wait(const Ticket& ticket);
+
+  /**
+   * @brief Blocks until every job queued so far has finished. Readers use this before they open a file that a
+   * job may still be writing. Returns immediately when called from a job. The H5LibraryLock held by the calling
+   * thread is released while waiting.
+   */
+  void waitForPendingWrites();
+
+  /**
+   * @brief Returns the number of jobs that are queued or running
+   * @return
+   */
+  size_t getNumberOfPendingWrites() const;
+
+protected:
+  H5BackgroundWriter();
+
+  /**
+   * @brief Body of the writer thread
+   */
+  void run();
+
+private:
+  struct QueuedJob
+  {
+    WriteJob job;
+    std::promise<JobResult> result;
+  };
+
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_JobQueued;
+  std::condition_variable m_JobsFinished;
+  std::deque<QueuedJob> m_Jobs;
+  std::thread m_Thread;
+  size_t m_NumPending = 0;
+  bool m_Stop = false;
+
+public:
+  H5BackgroundWriter(const H5BackgroundWriter&) = delete;            // Copy Constructor Not Implemented
+  H5BackgroundWriter(H5BackgroundWriter&&) = delete;                 // Move Constructor Not Implemented
+  H5BackgroundWriter& operator=(const H5BackgroundWriter&) = delete; // Copy Assignment Not Implemented
+  H5BackgroundWriter& operator=(H5BackgroundWriter&&) = delete;      // Move Assignment Not Implemented
+};
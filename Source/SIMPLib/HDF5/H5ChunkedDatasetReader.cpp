@@ -0,0 +1,459 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "H5ChunkedDatasetReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef SIMPL_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "H5Support/H5Macros.h"
+#include "H5Support/H5ScopedSentinel.h"
+
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
+
+// Reading raw chunks needs H5Dread_chunk() and H5Dget_chunk_storage_size() as they are in 1.10.5 and only pays off
+// if the chunks can be decoded on other threads
+#if defined(SIMPL_USE_PARALLEL_ALGORITHMS) && H5_VERSION_GE(1, 10, 5)
+#define SIMPL_H5_PARALLEL_CHUNK_READS
+#endif
+
+namespace
+{
+/**
+ * @brief A filter of the pipeline of a dataset
+ */
+struct ChunkFilter
+{
+  H5Z_filter_t id = H5Z_FILTER_NONE;
+  size_t elementSize = 0;
+};
+
+/**
+ * @brief What is needed to decode the chunks of a dataset and put them in place
+ */
+struct DatasetLayout
+{
+  std::vector<hsize_t> dims;
+  std::vector<hsize_t> chunkDims;
+  std::vector<ChunkFilter> filters;
+  size_t typeSize = 0;
+  size_t chunkBytes = 0;
+  bool swapBytes = false;
+};
+
+/**
+ * @brief The bytes of one chunk as they are stored in the file
+ */
+struct RawChunk
+{
+  std::vector<hsize_t> offset;
+  std::vector<uint8_t> bytes;
+  uint32_t filterMask = 0;
+  //! The chunk was never written and bytes holds the fill value in the memory type
+  bool isFill = false;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool inflateChunk(const std::vector<uint8_t>& compressed, std::vector<uint8_t>& chunk, size_t chunkBytes)
+{
+#ifdef SIMPL_USE_ZLIB
+  chunk.resize(chunkBytes);
+  uLongf numBytes = static_cast<uLongf>(chunkBytes);
+  int err = uncompress(chunk.data(), &numBytes, compressed.data(), static_cast<uLong>(compressed.size()));
+  return err == Z_OK && numBytes == chunkBytes;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// The shuffle filter stores the first byte of every value, then the second byte of every value and so on
+// -----------------------------------------------------------------------------
+void unshuffleChunk(const std::vector<uint8_t>& shuffled, std::vector<uint8_t>& chunk, size_t elementSize)
+{
+  chunk.resize(shuffled.size());
+  size_t numElements = shuffled.size() / elementSize;
+  for(size_t b = 0; b < elementSize; b++)
+  {
+    const uint8_t* source = shuffled.data() + b * numElements;
+    for(size_t i = 0; i < numElements; i++)
+    {
+      chunk[i * elementSize + b] = source[i];
+    }
+  }
+  // Trailing bytes that do not make up a whole value are not shuffled
+  std::copy(shuffled.begin() + numElements * elementSize, shuffled.end(), chunk.begin() + numElements * elementSize);
+}
+
+// -----------------------------------------------------------------------------
+// Copies the part of a decoded chunk that lies inside the dataset to its place in data
+// -----------------------------------------------------------------------------
+void copyChunk(const DatasetLayout& layout, const std::vector<hsize_t>& offset, const uint8_t* chunk, uint8_t* data)
+{
+  const size_t rank = layout.dims.size();
+  std::vector<hsize_t> extent(rank);
+  for(size_t d = 0; d < rank; d++)
+  {
+    extent[d] = std::min(layout.chunkDims[d], layout.dims[d] - offset[d]);
+  }
+  const size_t rowBytes = extent[rank - 1] * layout.typeSize;
+
+  // Copy one row of the fastest dimension at a time
+  std::vector<hsize_t> index(rank, 0);
+  while(true)
+  {
+    size_t source = 0;
+    size_t destination = 0;
+    for(size_t d = 0; d < rank; d++)
+    {
+      source = source * layout.chunkDims[d] + index[d];
+      destination = destination * layout.dims[d] + offset[d] + index[d];
+    }
+    std::memcpy(data + destination * layout.typeSize, chunk + source * layout.typeSize, rowBytes);
+
+    // Step to the next row, the fastest dimension is covered by the row itself
+    size_t d = rank - 1;
+    for(; d > 0; d--)
+    {
+      if(++index[d - 1] < extent[d - 1])
+      {
+        break;
+      }
+      index[d - 1] = 0;
+    }
+    if(d == 0)
+    {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Decodes one chunk and copies it into the output. Runs on a worker thread and must not call into HDF5.
+ */
+class DecodeChunkTask
+{
+public:
+  DecodeChunkTask(const DatasetLayout* layout, std::shared_ptr<RawChunk> chunk, uint8_t* data, std::atomic<bool>* failed)
+  : m_Layout(layout)
+  , m_Chunk(std::move(chunk))
+  , m_Data(data)
+  , m_Failed(failed)
+  {
+  }
+
+  void operator()() const
+  {
+    std::vector<uint8_t> buffer;
+    buffer.swap(m_Chunk->bytes);
+    if(!m_Chunk->isFill)
+    {
+      // The filters were applied in pipeline order when writing, so they are undone in reverse order
+      std::vector<uint8_t> decoded;
+      for(size_t i = m_Layout->filters.size(); i > 0; i--)
+      {
+        if((m_Chunk->filterMask & (1u << (i - 1))) != 0)
+        {
+          continue; // The filter was skipped for this chunk
+        }
+        const ChunkFilter& filter = m_Layout->filters[i - 1];
+        if(filter.id == H5Z_FILTER_DEFLATE)
+        {
+          if(!inflateChunk(buffer, decoded, m_Layout->chunkBytes))
+          {
+            *m_Failed = true;
+            return;
+          }
+        }
+        else
+        {
+          unshuffleChunk(buffer, decoded, filter.elementSize);
+        }
+        buffer.swap(decoded);
+      }
+      if(m_Layout->swapBytes)
+      {
+        for(size_t i = 0; i + m_Layout->typeSize <= buffer.size(); i += m_Layout->typeSize)
+        {
+          std::reverse(buffer.begin() + i, buffer.begin() + i + m_Layout->typeSize);
+        }
+      }
+    }
+    if(buffer.size() != m_Layout->chunkBytes)
+    {
+      *m_Failed = true;
+      return;
+    }
+    copyChunk(*m_Layout, m_Chunk->offset, buffer.data(), m_Data);
+  }
+
+private:
+  const DatasetLayout* m_Layout;
+  std::shared_ptr<RawChunk> m_Chunk;
+  uint8_t* m_Data;
+  std::atomic<bool>* m_Failed;
+};
+
+#ifdef SIMPL_H5_PARALLEL_CHUNK_READS
+// -----------------------------------------------------------------------------
+// Fills layout from the dataset. Returns false if the dataset is not chunked, uses a filter that can not be undone
+// here or the values need a conversion other than swapping their bytes.
+// -----------------------------------------------------------------------------
+bool readDatasetLayout(hid_t did, hid_t memType, DatasetLayout& layout)
+{
+  H5T_class_t typeClass = H5Tget_class(memType);
+  if(typeClass != H5T_INTEGER && typeClass != H5T_FLOAT)
+  {
+    return false;
+  }
+  hid_t fileType = H5Dget_type(did);
+  bool sameType = (H5Tequal(fileType, memType) > 0);
+  if(!sameType)
+  {
+    hid_t swappedType = H5Tcopy(memType);
+    H5Tset_order(swappedType, H5Tget_order(memType) == H5T_ORDER_LE ? H5T_ORDER_BE : H5T_ORDER_LE);
+    layout.swapBytes = (H5Tequal(fileType, swappedType) > 0);
+    H5Tclose(swappedType);
+  }
+  H5Tclose(fileType);
+  if(!sameType && !layout.swapBytes)
+  {
+    return false;
+  }
+  layout.typeSize = H5Tget_size(memType);
+
+  hid_t spaceId = H5Dget_space(did);
+  int rank = H5Sget_simple_extent_ndims(spaceId);
+  if(rank > 0)
+  {
+    layout.dims.resize(rank);
+    H5Sget_simple_extent_dims(spaceId, layout.dims.data(), nullptr);
+  }
+  H5Sclose(spaceId);
+  if(rank <= 0)
+  {
+    return false;
+  }
+
+  hid_t dcpl = H5Dget_create_plist(did);
+  bool supported = (H5Pget_layout(dcpl) == H5D_CHUNKED);
+  if(supported)
+  {
+    layout.chunkDims.resize(rank);
+    supported = (H5Pget_chunk(dcpl, rank, layout.chunkDims.data()) == rank);
+  }
+  int numFilters = supported ? H5Pget_nfilters(dcpl) : 0;
+  for(int i = 0; i < numFilters && supported; i++)
+  {
+    unsigned int flags = 0;
+    size_t numValues = 1;
+    unsigned int values[1] = {0};
+    unsigned int filterConfig = 0;
+    ChunkFilter filter;
+    filter.id = H5Pget_filter2(dcpl, static_cast<unsigned>(i), &flags, &numValues, values, 0, nullptr, &filterConfig);
+    filter.elementSize = (numValues > 0 && values[0] > 0) ? values[0] : layout.typeSize;
+#ifdef SIMPL_USE_ZLIB
+    supported = (filter.id == H5Z_FILTER_DEFLATE || filter.id == H5Z_FILTER_SHUFFLE);
+#else
+    supported = (filter.id == H5Z_FILTER_SHUFFLE);
+#endif
+    layout.filters.push_back(filter);
+  }
+  H5Pclose(dcpl);
+  if(!supported)
+  {
+    return false;
+  }
+
+  layout.chunkBytes = layout.typeSize;
+  for(const auto& dim : layout.chunkDims)
+  {
+    layout.chunkBytes *= dim;
+  }
+  return true;
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5ChunkedDatasetReader::H5ChunkedDatasetReader() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5ChunkedDatasetReader::IsAvailable()
+{
+#ifdef SIMPL_H5_PARALLEL_CHUNK_READS
+  return true;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5ChunkedDatasetReader::IsDeflateAvailable()
+{
+#if defined(SIMPL_H5_PARALLEL_CHUNK_READS) && defined(SIMPL_USE_ZLIB)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+herr_t H5ChunkedDatasetReader::ReadDataset(hid_t locId, const QString& datasetPath, hid_t memType, void* data)
+{
+#ifndef SIMPL_H5_PARALLEL_CHUNK_READS
+  return 0;
+#else
+  hid_t did = H5Dopen(locId, datasetPath.toLatin1().constData(), H5P_DEFAULT);
+  if(did < 0)
+  {
+    return 0;
+  }
+  H5ScopedObjectSentinel sentinel(&did, false);
+
+  DatasetLayout layout;
+  if(!readDatasetLayout(did, memType, layout))
+  {
+    return 0;
+  }
+  // Without filters or byte swapping there is nothing for the other threads to do
+  if(layout.filters.empty() && !layout.swapBytes)
+  {
+    return 0;
+  }
+
+  const size_t rank = layout.dims.size();
+  std::vector<hsize_t> numChunks(rank);
+  size_t totalChunks = 1;
+  for(size_t d = 0; d < rank; d++)
+  {
+    if(layout.dims[d] == 0)
+    {
+      return 0;
+    }
+    numChunks[d] = (layout.dims[d] + layout.chunkDims[d] - 1) / layout.chunkDims[d];
+    totalChunks *= numChunks[d];
+  }
+  if(totalChunks < 2)
+  {
+    return 0;
+  }
+
+  // Chunks that were never written read as the fill value
+  std::vector<uint8_t> fillValue(layout.typeSize, 0);
+  hid_t dcpl = H5Dget_create_plist(did);
+  H5Pget_fill_value(dcpl, memType, fillValue.data());
+  H5Pclose(dcpl);
+
+  uint8_t* output = static_cast<uint8_t*>(data);
+  std::atomic<bool> failed(false);
+  herr_t err = 1;
+  {
+    // The task algorithm waits for its running tasks whenever every thread has one, which bounds the raw chunks held
+    ParallelTaskAlgorithm taskAlg;
+    std::vector<hsize_t> chunkIndex(rank, 0);
+    for(size_t c = 0; c < totalChunks && !failed; c++)
+    {
+      std::shared_ptr<RawChunk> chunk = std::make_shared<RawChunk>();
+      chunk->offset.resize(rank);
+      for(size_t d = 0; d < rank; d++)
+      {
+        chunk->offset[d] = chunkIndex[d] * layout.chunkDims[d];
+      }
+
+      // Asking for the size of a chunk that was never allocated is an error we expect
+      hsize_t storageSize = 0;
+      herr_t sizeErr = 0;
+      {
+        HDF_ERROR_HANDLER_OFF
+        sizeErr = H5Dget_chunk_storage_size(did, chunk->offset.data(), &storageSize);
+        HDF_ERROR_HANDLER_ON
+      }
+      if(sizeErr < 0 || storageSize == 0)
+      {
+        chunk->isFill = true;
+        chunk->bytes.resize(layout.chunkBytes);
+        for(size_t i = 0; i < layout.chunkBytes; i += layout.typeSize)
+        {
+          std::memcpy(chunk->bytes.data() + i, fillValue.data(), layout.typeSize);
+        }
+      }
+      else
+      {
+        chunk->bytes.resize(storageSize);
+        if(H5Dread_chunk(did, H5P_DEFAULT, chunk->offset.data(), &chunk->filterMask, chunk->bytes.data()) < 0)
+        {
+          err = -1;
+          break;
+        }
+      }
+      taskAlg.execute(DecodeChunkTask(&layout, chunk, output, &failed));
+
+      // Step to the next chunk with the fastest dimension changing fastest, which follows the order in the file
+      for(size_t d = rank; d > 0; d--)
+      {
+        if(++chunkIndex[d - 1] < numChunks[d - 1])
+        {
+          break;
+        }
+        chunkIndex[d - 1] = 0;
+      }
+    }
+    taskAlg.wait();
+  }
+  if(failed)
+  {
+    return -1;
+  }
+  return err;
+#endif
+}
@@ -0,0 +1,87 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The H5ChunkedDatasetReader class reads whole chunked datasets with the CPU bound work spread over all cores.
+ * The HDF5 library is not thread-safe, so the raw chunks are read one after the other on the calling thread. Undoing
+ * the deflate and shuffle filters, swapping the bytes of values stored with the other byte order and copying each
+ * chunk to its place in the output run as parallel tasks while the next chunks are being read.
+ *
+ * Datasets that are contiguous, use other filters or need a conversion other than swapping bytes are left to H5Dread.
+ */
+class SIMPLib_EXPORT H5ChunkedDatasetReader
+{
+public:
+  /**
+   * @brief Reads all values of the dataset datasetPath below locId into data, which has room for all of them as memType.
+   * Returns 1 if the dataset was read, 0 if this reader does not handle the dataset, in which case data is untouched and
+   * the caller reads it with H5Dread, and a negative value on error.
+   * @param locId
+   * @param datasetPath
+   * @param memType A native integer or floating point type
+   * @param data
+   * @return
+   */
+  static herr_t ReadDataset(hid_t locId, const QString& datasetPath, hid_t memType, void* data);
+
+  /**
+   * @brief Returns true if this build can read chunked datasets in parallel
+   * @return
+   */
+  static bool IsAvailable();
+
+  /**
+   * @brief Returns true if this build can also inflate deflate compressed chunks itself, which needs zlib
+   * @return
+   */
+  static bool IsDeflateAvailable();
+
+protected:
+  H5ChunkedDatasetReader();
+
+public:
+  H5ChunkedDatasetReader(const H5ChunkedDatasetReader&) = delete;            // Copy Constructor Not Implemented
+  H5ChunkedDatasetReader(H5ChunkedDatasetReader&&) = delete;                 // Move Constructor Not Implemented
+  H5ChunkedDatasetReader& operator=(const H5ChunkedDatasetReader&) = delete; // Copy Assignment Not Implemented
+  H5ChunkedDatasetReader& operator=(H5ChunkedDatasetReader&&) = delete;      // Move Assignment Not Implemented
+};
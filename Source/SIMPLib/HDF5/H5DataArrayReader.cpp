@@ -35,14 +35,25 @@
 
 #include "H5DataArrayReader.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <vector>
 
+#include <QtCore/QFileInfo>
+
+#include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/QH5Lite.h"
 #include "H5Support/QH5Utilities.h"
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5ChunkedDatasetReader.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 
 #define MIKESTEMP 1
 
@@ -58,19 +69,210 @@ H5DataArrayReader::~H5DataArrayReader() = default;
 
 namespace Detail
 {
+/**
+ * @brief A rectangular block of a dataset given as offset and count in the slowest to fastest order of HDF5
+ */
+struct HyperslabBlock
+{
+  std::vector<hsize_t> offset;
+  std::vector<hsize_t> count;
+};
+
+// -----------------------------------------------------------------------------
+// Splits the tuples [start, end) of a dataset with the dimensions dims into the smallest list of rectangular
+// blocks. The blocks come out in file order so reading them one after the other fills a contiguous buffer.
+// -----------------------------------------------------------------------------
+std::vector<HyperslabBlock> splitTupleRange(const std::vector<hsize_t>& dims, hsize_t start, hsize_t end)
+{
+  std::vector<HyperslabBlock> blocks;
+  const size_t rank = dims.size();
+  while(start < end)
+  {
+    // Find how many of the fastest dimensions can be taken whole from the current position
+    size_t level = rank;
+    hsize_t stride = 1;
+    while(level > 0 && start % (stride * dims[level - 1]) == 0 && start + stride * dims[level - 1] <= end)
+    {
+      stride *= dims[level - 1];
+      level--;
+    }
+
+    HyperslabBlock block;
+    block.offset.resize(rank, 0);
+    block.count.resize(rank, 1);
+    hsize_t index = start;
+    for(size_t d = rank; d > 0; d--)
+    {
+      block.offset[d - 1] = index % dims[d - 1];
+      index /= dims[d - 1];
+    }
+    for(size_t d = level; d < rank; d++)
+    {
+      block.count[d] = dims[d];
+    }
+
+    hsize_t numSlabs = 1;
+    if(level > 0)
+    {
+      // Take as many slabs of the next slower dimension as the range and that dimension allow
+      numSlabs = std::min((end - start) / stride, dims[level - 1] - block.offset[level - 1]);
+      block.count[level - 1] = numSlabs;
+    }
+    blocks.push_back(block);
+    start += numSlabs * stride;
+  }
+  return blocks;
+}
+
+// -----------------------------------------------------------------------------
+// Reads the values selected by region from the dataset into data, which has room for the tuples of the region
+// -----------------------------------------------------------------------------
+template <typename T>
+herr_t readH5DatasetValues(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims, const H5DataArrayReader::ReadRegion& region, T* data)
+{
+  if(region.isEmpty())
+  {
+    // Compressed or byte swapped chunks are decoded in parallel when possible
+    herr_t err = H5ChunkedDatasetReader::ReadDataset(locId, datasetPath, H5Lite::HDFTypeForPrimitive(T(0)), data);
+    if(err != 0)
+    {
+      return err < 0 ? err : 0;
+    }
+    return QH5Lite::readPointerDataset(locId, datasetPath, data);
+  }
+
+  // HDF5 stores the dimensions slowest to fastest which is the reverse of the XYZ order of the tuple and component dimensions
+  std::vector<hsize_t> h5TDims(tDims.rbegin(), tDims.rend());
+  std::vector<hsize_t> h5CDims(cDims.rbegin(), cDims.rend());
+  std::vector<size_t> regionOffset = region.getOffset();
+  std::vector<size_t> regionTDims = region.getTupleDimensions();
+  std::vector<HyperslabBlock> blocks;
+  if(region.isTupleRange())
+  {
+    blocks = splitTupleRange(h5TDims, regionOffset[0], regionOffset[0] + regionTDims[0]);
+  }
+  else
+  {
+    HyperslabBlock block;
+    block.offset.assign(regionOffset.rbegin(), regionOffset.rend());
+    block.count.assign(regionTDims.rbegin(), regionTDims.rend());
+    blocks.push_back(block);
+  }
+
+  size_t numComps = std::accumulate(cDims.begin(), cDims.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  for(auto& block : blocks)
+  {
+    hsize_t numTuples = 1;
+    for(const auto& c : block.count)
+    {
+      numTuples *= c;
+    }
+    if(numTuples == 0)
+    {
+      continue;
+    }
+    block.offset.insert(block.offset.end(), h5CDims.size(), 0);
+    block.count.insert(block.count.end(), h5CDims.begin(), h5CDims.end());
+    herr_t err = QH5Lite::readPointerDatasetHyperslab(locId, datasetPath, block.offset, block.count, data);
+    if(err < 0)
+    {
+      return err;
+    }
+    data += numTuples * numComps;
+  }
+  return 0;
+}
+
+/**
+ * @brief The arrays still waiting to be read from each file. The loaders only hold weak references to the arrays.
+ */
+struct DeferredArrayRegistry
+{
+  std::mutex mutex;
+  std::map<QString, std::vector<std::pair<std::weak_ptr<IDataArray>, std::function<bool()>>>> arrays;
+};
+
+DeferredArrayRegistry& deferredArrayRegistry()
+{
+  static DeferredArrayRegistry s_Registry;
+  return s_Registry;
+}
+
+// -----------------------------------------------------------------------------
+// Opens the group groupPath of the file read only and passes it to readValues
+// -----------------------------------------------------------------------------
+bool readDeferredValues(const QString& filePath, const QString& groupPath, const std::function<herr_t(hid_t)>& readValues)
+{
+  // The file may still be written by a DataContainerWriter running in the background
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+
+  // Arrays can be first accessed from several threads at once and the HDF5 library may not be thread-safe
+  H5LibraryLock libraryLock;
+
+  hid_t fileId = QH5Utilities::openFile(filePath, true);
+  if(fileId < 0)
+  {
+    return false;
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+  hid_t gid = H5Gopen(fileId, groupPath.toLatin1().data(), H5P_DEFAULT);
+  if(gid < 0)
+  {
+    return false;
+  }
+  sentinel.addGroupId(&gid);
+  return readValues(gid) >= 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims)
+IDataArray::Pointer createDeferredArray(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims, const H5DataArrayReader::ReadRegion& region)
 {
-  herr_t err = -1;
-  IDataArray::Pointer ptr;
+  typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(region.isEmpty() ? tDims : region.getTupleDimensions(), cDims, datasetPath, false);
+  QString filePath = QH5Utilities::absoluteFilePathFromFileId(locId);
+  QString groupPath = QH5Utilities::getObjectPath(locId);
+  array->setDeferredLoader([=](T* data) {
+    return readDeferredValues(filePath, groupPath, [&](hid_t gid) { return readH5DatasetValues<T>(gid, datasetPath, tDims, cDims, region, data); });
+  });
 
-  ptr = DataArray<T>::CreateArray(tDims, cDims, datasetPath, true);
+  std::weak_ptr<DataArray<T>> weakArray = array;
+  DeferredArrayRegistry& registry = deferredArrayRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& fileArrays = registry.arrays[filePath];
+  if(fileArrays.size() % 256 == 255)
+  {
+    auto isExpired = [](const std::pair<std::weak_ptr<IDataArray>, std::function<bool()>>& entry) { return entry.first.expired(); };
+    fileArrays.erase(std::remove_if(fileArrays.begin(), fileArrays.end(), isExpired), fileArrays.end());
+  }
+  fileArrays.emplace_back(array, [weakArray]() {
+    typename DataArray<T>::Pointer deferredArray = weakArray.lock();
+    return nullptr == deferredArray.get() || deferredArray->loadDeferredValues();
+  });
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims, const H5DataArrayReader::ReadRegion& region,
+                                  bool deferReading)
+{
+  if(deferReading)
+  {
+    return createDeferredArray<T>(locId, datasetPath, tDims, cDims, region);
+  }
+
+  IDataArray::Pointer ptr = DataArray<T>::CreateArray(region.isEmpty() ? tDims : region.getTupleDimensions(), cDims, datasetPath, true);
+  if(!region.isEmpty() && ptr->getNumberOfTuples() == 0)
+  {
+    return ptr;
+  }
 
-  T* data = (T*)(ptr->getVoidPointer(0));
-  err = QH5Lite::readPointerDataset(locId, datasetPath, data);
+  T* data = reinterpret_cast<T*>(ptr->getVoidPointer(0));
+  herr_t err = readH5DatasetValues<T>(locId, datasetPath, tDims, cDims, region, data);
   if(err < 0)
   {
     qDebug() << "readH5Data read error: " << __FILE__ << "(" << __LINE__ << ")";
@@ -78,6 +280,198 @@ IDataArray::Pointer readH5Dataset(hid_t locId, const QString& datasetPath, const
   }
   return ptr;
 }
+
+// -----------------------------------------------------------------------------
+// Reads into array if it is a DataArray<T>. Returns 1 if array has a different type.
+// -----------------------------------------------------------------------------
+template <typename T>
+herr_t readIntoDataArray(hid_t locId, const QString& datasetPath, IDataArray* array, size_t destTupleOffset, const std::vector<size_t>& tDims, const std::vector<size_t>& cDims,
+                         const H5DataArrayReader::ReadRegion& region)
+{
+  DataArray<T>* dataArray = dynamic_cast<DataArray<T>*>(array);
+  if(nullptr == dataArray)
+  {
+    return 1;
+  }
+  return readH5DatasetValues<T>(locId, datasetPath, tDims, cDims, region, dataArray->getTuplePointer(destTupleOffset));
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5ReadRegion H5ReadRegion::TupleRange(size_t startTuple, size_t numTuples)
+{
+  H5ReadRegion region;
+  region.m_TupleRange = true;
+  region.m_Offset = {startTuple};
+  region.m_Extent = {numTuples};
+  return region;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5ReadRegion H5ReadRegion::Box(const std::vector<size_t>& min, const std::vector<size_t>& max)
+{
+  H5ReadRegion region;
+  if(min.size() != max.size())
+  {
+    return region;
+  }
+  for(size_t i = 0; i < min.size(); i++)
+  {
+    if(max[i] < min[i])
+    {
+      return region;
+    }
+  }
+  region.m_Offset = min;
+  region.m_Extent.resize(min.size());
+  for(size_t i = 0; i < min.size(); i++)
+  {
+    region.m_Extent[i] = max[i] - min[i] + 1;
+  }
+  return region;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5ReadRegion::isEmpty() const
+{
+  return m_Extent.empty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5ReadRegion::isTupleRange() const
+{
+  return m_TupleRange;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> H5ReadRegion::getOffset() const
+{
+  return m_Offset;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<size_t> H5ReadRegion::getTupleDimensions() const
+{
+  return m_Extent;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5ReadRegion::fitsInside(const std::vector<size_t>& tDims) const
+{
+  if(isEmpty())
+  {
+    return true;
+  }
+  if(m_TupleRange)
+  {
+    size_t numTuples = tDims.empty() ? 0 : 1;
+    for(const auto& dim : tDims)
+    {
+      numTuples *= dim;
+    }
+    return m_Offset[0] + m_Extent[0] <= numTuples;
+  }
+  if(m_Offset.size() != tDims.size())
+  {
+    return false;
+  }
+  for(size_t i = 0; i < tDims.size(); i++)
+  {
+    if(m_Offset[i] + m_Extent[i] > tDims[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::TupleRuns H5ReadRegion::getTupleRuns(const std::vector<size_t>& tDims) const
+{
+  IDataArray::TupleRuns runs;
+  if(isEmpty() || !fitsInside(tDims))
+  {
+    return runs;
+  }
+  if(m_TupleRange)
+  {
+    if(m_Extent[0] > 0)
+    {
+      runs.push_back({m_Offset[0], 0, m_Extent[0]});
+    }
+    return runs;
+  }
+
+  size_t numRows = 1;
+  for(size_t d = 1; d < m_Extent.size(); d++)
+  {
+    numRows *= m_Extent[d];
+  }
+  if(m_Extent[0] == 0 || numRows == 0)
+  {
+    return runs;
+  }
+
+  // Every row of the box along the fastest (X) dimension is one run
+  runs.reserve(numRows);
+  for(size_t row = 0; row < numRows; row++)
+  {
+    size_t index = row;
+    size_t srcTuple = 0;
+    size_t stride = tDims[0];
+    for(size_t d = 1; d < m_Extent.size(); d++)
+    {
+      srcTuple += (m_Offset[d] + index % m_Extent[d]) * stride;
+      index /= m_Extent[d];
+      stride *= tDims[d];
+    }
+    runs.push_back({srcTuple + m_Offset[0], row * m_Extent[0], m_Extent[0]});
+  }
+  return runs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5DataArrayReader::ReadDeferredArrays(const QString& filePath)
+{
+  std::vector<std::pair<std::weak_ptr<IDataArray>, std::function<bool()>>> fileArrays;
+  {
+    Detail::DeferredArrayRegistry& registry = Detail::deferredArrayRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto iter = registry.arrays.find(QFileInfo(filePath).absoluteFilePath());
+    if(iter == registry.arrays.end())
+    {
+      return 0;
+    }
+    fileArrays.swap(iter->second);
+    registry.arrays.erase(iter);
+  }
+  int err = 0;
+  for(const auto& entry : fileArrays)
+  {
+    if(!entry.second())
+    {
+      err = -1;
+    }
+  }
+  return err;
 }
 
 // -----------------------------------------------------------------------------
@@ -172,18 +566,12 @@ IDataArray::Pointer H5DataArrayReader::ReadStringDataArray(hid_t gid, const QStr
   }
   // Strings are stored as variable length arrays so trying to match the component
   // dimensions does not make sense.
-  StringDataArray::Pointer strTemp = StringDataArray::CreateArray(dims[0], name, true);
-
-  std::vector<std::string> strings;
-  err = H5Lite::readVectorOfStringDataset(gid, name.toStdString(), strings);
-  // Copy the data into
-  for(std::vector<std::string>::size_type i = 0; i < strings.size(); i++)
-  {
-    strTemp->setValue(i, QString::fromStdString(strings[i]));
-  }
+  // The strings are read directly into the packed layout of the array
+  StringDataArray::Pointer strTemp = StringDataArray::CreateArray(0, name, true);
+  err = strTemp->readH5Data(gid);
+  H5Tclose(typeId);
   if(err < 0)
   {
-    err = H5Tclose(typeId);
     return ptr;
   }
 
@@ -197,7 +585,14 @@ IDataArray::Pointer H5DataArrayReader::ReadStringDataArray(hid_t gid, const QStr
 // -----------------------------------------------------------------------------
 IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString& name, bool metaDataOnly)
 {
+  return ReadIDataArray(gid, name, ReadRegion(), metaDataOnly);
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString& name, const ReadRegion& region, bool metaDataOnly, bool deferReading)
+{
   herr_t err = -1;
   // herr_t retErr = 1;
   hid_t typeId = -1;
@@ -232,16 +627,24 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
       return ptr;
     }
 
+    if(!region.isEmpty() && !region.fitsInside(tDims))
+    {
+      qDebug() << "The requested region does not fit inside the tuple dimensions of " << name;
+      err = H5Tclose(typeId);
+      return ptr;
+    }
+    std::vector<size_t> regionTDims = region.isEmpty() ? tDims : region.getTupleDimensions();
+
     // Check to see if we are reading a bool array and if so read it and return
     if(classType.compare("DataArray<bool>") == 0)
     {
       if(!metaDataOnly)
       {
-        ptr = Detail::readH5Dataset<bool>(gid, name, tDims, cDims);
+        ptr = Detail::readH5Dataset<bool>(gid, name, tDims, cDims, region, deferReading);
       }
       else
       {
-        ptr = DataArray<bool>::CreateArray(tDims, cDims, name, false);
+        ptr = DataArray<bool>::CreateArray(regionTDims, cDims, name, false);
       }
       err = H5Tclose(typeId);
       return ptr; // <== Note early return here.
@@ -258,88 +661,88 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint8_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint8_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<uint8_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<uint8_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_U16BE) != 0) || (H5Tequal(typeId, H5T_STD_U16LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint16_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint16_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<uint16_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<uint16_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_U32BE) != 0) || (H5Tequal(typeId, H5T_STD_U32LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint32_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint32_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<uint32_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<uint32_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_U64BE) != 0) || (H5Tequal(typeId, H5T_STD_U64LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<uint64_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<uint64_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<uint64_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<uint64_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_I8BE) != 0) || (H5Tequal(typeId, H5T_STD_I8LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int8_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int8_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<int8_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<int8_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_I16BE) != 0) || (H5Tequal(typeId, H5T_STD_I16LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int16_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int16_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<int16_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<int16_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_I32BE) != 0) || (H5Tequal(typeId, H5T_STD_I32LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int32_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int32_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<int32_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<int32_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if((H5Tequal(typeId, H5T_STD_I64BE) != 0) || (H5Tequal(typeId, H5T_STD_I64LE) != 0))
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<int64_t>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<int64_t>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<int64_t>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<int64_t>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else
@@ -353,22 +756,22 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<float>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<float>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<float>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<float>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else if(attr_size == 8)
       {
         if(!metaDataOnly)
         {
-          ptr = Detail::readH5Dataset<double>(gid, name, tDims, cDims);
+          ptr = Detail::readH5Dataset<double>(gid, name, tDims, cDims, region, deferReading);
         }
         else
         {
-          ptr = DataArray<double>::CreateArray(tDims, cDims, name, false);
+          ptr = DataArray<double>::CreateArray(regionTDims, cDims, name, false);
         }
       }
       else
@@ -388,6 +791,130 @@ IDataArray::Pointer H5DataArrayReader::ReadIDataArray(hid_t gid, const QString&
   return ptr;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5DataArrayReader::ReadIntoDataArray(hid_t gid, const QString& name, IDataArray* array, size_t destTupleOffset)
+{
+  return ReadIntoDataArray(gid, name, array, destTupleOffset, ReadRegion());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5DataArrayReader::ReadIntoDataArray(hid_t gid, const QString& name, IDataArray* array, size_t destTupleOffset, const ReadRegion& region, bool ignoreDimensionAttributes)
+{
+  if(nullptr == array || !array->isAllocated())
+  {
+    return -1;
+  }
+
+  QVector<hsize_t> dims;
+  H5T_class_t typeClass;
+  size_t typeSize = 0;
+  herr_t err = QH5Lite::getDatasetInfo(gid, name, dims, typeClass, typeSize);
+  if(err < 0)
+  {
+    return err;
+  }
+  if(typeClass != H5T_INTEGER && typeClass != H5T_FLOAT)
+  {
+    qDebug() << "Only integer and floating point data sets can be read into a DataArray: " << name;
+    return -2;
+  }
+  size_t numElements = std::accumulate(dims.begin(), dims.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  size_t numComps = static_cast<size_t>(array->getNumberOfComponents());
+
+  std::vector<size_t> tDims;
+  std::vector<size_t> cDims;
+  QByteArray datasetName = name.toLatin1();
+  bool hasDimensions = !ignoreDimensionAttributes && H5Aexists_by_name(gid, datasetName.constData(), SIMPL::HDF5::TupleDimensions.toLatin1().constData(), H5P_DEFAULT) > 0 &&
+                       H5Aexists_by_name(gid, datasetName.constData(), SIMPL::HDF5::ComponentDimensions.toLatin1().constData(), H5P_DEFAULT) > 0;
+  if(hasDimensions)
+  {
+    hasDimensions = QH5Lite::readVectorAttribute(gid, name, SIMPL::HDF5::TupleDimensions, tDims) >= 0 && QH5Lite::readVectorAttribute(gid, name, SIMPL::HDF5::ComponentDimensions, cDims) >= 0;
+  }
+  if(!hasDimensions)
+  {
+    // A plain data set written by some other application, or one whose layout the caller chooses
+    if(numComps == 0 || numElements % numComps != 0)
+    {
+      qDebug() << "The data set does not hold a whole number of tuples of the array: " << name;
+      return -3;
+    }
+    // Use the fastest dimensions of the data set that hold exactly one tuple as the components so a region can be
+    // selected in the data set with its own rank
+    int split = dims.size();
+    size_t splitComps = 1;
+    while(split > 0 && splitComps < numComps)
+    {
+      splitComps *= dims[split - 1];
+      split--;
+    }
+    if(splitComps == numComps)
+    {
+      tDims.assign(dims.rend() - split, dims.rend());
+      cDims.assign(dims.rbegin(), dims.rend() - split);
+    }
+    else if(region.isEmpty())
+    {
+      tDims = std::vector<size_t>(1, numElements / numComps);
+      cDims = array->getComponentDimensions();
+    }
+    else
+    {
+      qDebug() << "The dimensions of the data set can not be split into tuples of " << numComps << " components to read a region: " << name;
+      return -5;
+    }
+  }
+  size_t fileComps = std::accumulate(cDims.begin(), cDims.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  if(fileComps != numComps)
+  {
+    qDebug() << "The data set has " << fileComps << " components but the array has " << numComps << ": " << name;
+    return -4;
+  }
+
+  if(!region.isEmpty() && !region.fitsInside(tDims))
+  {
+    qDebug() << "The requested region does not fit inside the tuple dimensions of " << name;
+    return -5;
+  }
+  std::vector<size_t> readTDims = region.isEmpty() ? tDims : region.getTupleDimensions();
+  size_t numTuples = std::accumulate(readTDims.begin(), readTDims.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  if(destTupleOffset + numTuples > array->getNumberOfTuples())
+  {
+    qDebug() << "Reading " << numTuples << " tuples at tuple " << destTupleOffset << " overruns the array: " << name;
+    return -6;
+  }
+  if(numTuples == 0)
+  {
+    return 0;
+  }
+
+  // The first read that matches the type of the array does the work
+  err = Detail::readIntoDataArray<float>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<double>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<int8_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<uint8_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<int16_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<uint16_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<int32_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<uint32_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<int64_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<uint64_t>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  err = (err != 1) ? err : Detail::readIntoDataArray<bool>(gid, name, array, destTupleOffset, tDims, cDims, region);
+  if(err == 1)
+  {
+    qDebug() << "Arrays of type " << array->getTypeAsString() << " can not be read into: " << name;
+    return -7;
+  }
+  if(err < 0)
+  {
+    qDebug() << "readH5Data read error: " << __FILE__ << "(" << __LINE__ << ")";
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
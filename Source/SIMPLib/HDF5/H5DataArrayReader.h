@@ -36,6 +36,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <hdf5.h>
 
 #include <QtCore/QString>
@@ -44,6 +46,79 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 
+/**
+ * @brief The H5ReadRegion class describes the subset of the tuples of a DataArray that should be read from
+ * the file. A region is either a contiguous range of tuples or a box given in the (x,y,z) tuple dimensions of
+ * the array, which is how the Cell arrays of an ImageGeom are stored. A default constructed region is empty and
+ * selects the whole array.
+ */
+class SIMPLib_EXPORT H5ReadRegion
+{
+  public:
+    H5ReadRegion() = default;
+
+    /**
+     * @brief Creates a region holding numTuples consecutive tuples starting at startTuple
+     * @param startTuple
+     * @param numTuples
+     * @return
+     */
+    static H5ReadRegion TupleRange(size_t startTuple, size_t numTuples);
+
+    /**
+     * @brief Creates a region holding the voxels between min and max (both inclusive). The indices are in
+     * the same XYZ order as the tuple dimensions of the array.
+     * @param min
+     * @param max
+     * @return
+     */
+    static H5ReadRegion Box(const std::vector<size_t>& min, const std::vector<size_t>& max);
+
+    /**
+     * @brief Returns true if the region does not restrict anything and the whole array should be read
+     * @return
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Returns true if this region is a range of tuples instead of a box
+     * @return
+     */
+    bool isTupleRange() const;
+
+    /**
+     * @brief Returns the first tuple index of the region along each of its dimensions
+     * @return
+     */
+    std::vector<size_t> getOffset() const;
+
+    /**
+     * @brief Returns the tuple dimensions of a DataArray read with this region
+     * @return
+     */
+    std::vector<size_t> getTupleDimensions() const;
+
+    /**
+     * @brief Returns true if the region lies inside an array with the given tuple dimensions
+     * @param tDims
+     * @return
+     */
+    bool fitsInside(const std::vector<size_t>& tDims) const;
+
+    /**
+     * @brief Returns the runs of consecutive tuples that the region selects from an array with the given tuple
+     * dimensions. They can be passed to IDataArray::compactTuples() to crop an array that was read completely.
+     * @param tDims
+     * @return
+     */
+    IDataArray::TupleRuns getTupleRuns(const std::vector<size_t>& tDims) const;
+
+  private:
+    bool m_TupleRange = false;
+    std::vector<size_t> m_Offset;
+    std::vector<size_t> m_Extent;
+};
+
 /**
  * @class H5DataArrayReader H5DataArrayReader.h DREAM3DLib/HDF5/H5DataArrayReader.h
  * @brief This class handles reading DataArray<T> objects from an HDF5 file
@@ -57,6 +132,19 @@ class SIMPLib_EXPORT H5DataArrayReader
     virtual ~H5DataArrayReader();
 
 
+    /**
+     * @brief The region type taken by the read methods, see H5ReadRegion
+     */
+    using ReadRegion = H5ReadRegion;
+
+    /**
+     * @brief Reads the values of every DataArray that is still waiting to be read from filePath. This has to be
+     * done before the file is overwritten.
+     * @param filePath
+     * @return 0 on success, -1 if the values of any of the arrays could not be read
+     */
+    static int ReadDeferredArrays(const QString& filePath);
+
     /**
      * @brief readRequiredAttributes Reads the required attributes from an HDF5 Data set
      * @param objType The type (subclass) of IDataArray that is stored in the HDF5 file
@@ -76,6 +164,48 @@ class SIMPLib_EXPORT H5DataArrayReader
      */
     static IDataArray::Pointer ReadIDataArray(hid_t gid, const QString& name, bool metaDataOnly = false);
 
+    /**
+     * @brief ReadIDataArray Reads the part of an IDataArray subclass selected by region from the HDF5 file. Only
+     * the selected tuples are read from the file using HDF5 hyperslab selections.
+     * @param gid The HDF5 Group to read the data array from
+     * @param name The name of the data set
+     * @param region The tuples to read. An empty region reads the whole array.
+     * @param metaDataOnly Read just the meta data about the DataArray or actually read all the data
+     * @param deferReading The DataArray only remembers the file and dataset it came from and reads its values the
+     * first time they are accessed. DataContainerReader uses this to read arrays on demand.
+     * @return The DataArray, whose tuple dimensions are those of the region, or a null pointer if the region does
+     * not fit inside the array
+     */
+    static IDataArray::Pointer ReadIDataArray(hid_t gid, const QString& name, const ReadRegion& region, bool metaDataOnly = false, bool deferReading = false);
+
+    /**
+     * @brief ReadIntoDataArray Reads a numeric dataset straight into the buffer of an existing array, starting at tuple
+     * destTupleOffset. HDF5 converts the values from the type in the file to the type of the array while reading, so
+     * no temporary copy of the data is made. Datasets without the SIMPL tuple and component dimension attributes
+     * are treated as a list of tuples with the components of the array.
+     * @param gid The HDF5 Group to read the data set from
+     * @param name The name of the data set
+     * @param array The allocated array to read into. It must have the same number of components as the data set.
+     * @param destTupleOffset The tuple of the array that receives the first tuple read
+     * @return 0 on success or a negative value if the data set could not be read or does not fit into the array
+     */
+    static int ReadIntoDataArray(hid_t gid, const QString& name, IDataArray* array, size_t destTupleOffset = 0);
+
+    /**
+     * @brief ReadIntoDataArray Reads the tuples of a numeric dataset selected by region straight into the buffer of an
+     * existing array, starting at tuple destTupleOffset. @see ReadIntoDataArray(hid_t, const QString&, IDataArray*, size_t)
+     * @param gid The HDF5 Group to read the data set from
+     * @param name The name of the data set
+     * @param array The allocated array to read into. It must have the same number of components as the data set.
+     * @param destTupleOffset The tuple of the array that receives the first tuple read
+     * @param region The tuples of the data set to read. An empty region reads all of them.
+     * @param ignoreDimensionAttributes Treat the data set as a plain data set even if it has the SIMPL tuple and
+     * component dimension attributes, so that its values can be read with another component layout as long as the
+     * number of values fits. ImportHDF5Dataset uses this to import any data set with the layout the user entered.
+     * @return 0 on success or a negative value if the data set could not be read or does not fit into the array
+     */
+    static int ReadIntoDataArray(hid_t gid, const QString& name, IDataArray* array, size_t destTupleOffset, const ReadRegion& region, bool ignoreDimensionAttributes = false);
+
     /**
      * @brief ReadNeighborListData
      * @param gid The HDF5 Group to read the data array from
@@ -53,11 +53,48 @@
  * @date Jan 22, 2012
  * @version 1.0
  */
-class H5DataArrayWriter
+class SIMPLib_EXPORT H5DataArrayWriter
 {
   public:
     virtual ~H5DataArrayWriter() = default;
 
+    /**
+     * @brief Sets the dataset options used on the calling thread for arrays without write hints while it is in
+     * scope. DataContainerWriter uses this to apply its chunking and compression settings to every array it writes.
+     */
+    class SIMPLib_EXPORT ScopedDatasetOptions
+    {
+      public:
+        explicit ScopedDatasetOptions(const H5DatasetCreationOptions& options);
+        ~ScopedDatasetOptions();
+
+      private:
+        H5DatasetCreationOptions m_PreviousOptions;
+
+      public:
+        ScopedDatasetOptions(const ScopedDatasetOptions&) = delete;            // Copy Constructor Not Implemented
+        ScopedDatasetOptions(ScopedDatasetOptions&&) = delete;                 // Move Constructor Not Implemented
+        ScopedDatasetOptions& operator=(const ScopedDatasetOptions&) = delete; // Copy Assignment Not Implemented
+        ScopedDatasetOptions& operator=(ScopedDatasetOptions&&) = delete;      // Move Assignment Not Implemented
+    };
+
+    /**
+     * @brief Returns the dataset options set on the calling thread by ScopedDatasetOptions
+     * @return
+     */
+    static H5DatasetCreationOptions GetDefaultDatasetOptions();
+
+    /**
+     * @brief Returns the write hints of dataArray if it has any, otherwise the default dataset options
+     * @param dataArray
+     * @return
+     */
+    template <typename IDataArrayType>
+    static H5DatasetCreationOptions GetDatasetOptions(IDataArrayType* dataArray)
+    {
+      return dataArray->hasWriteHints() ? dataArray->getWriteHints() : GetDefaultDatasetOptions();
+    }
+
     /**
      * @brief writeDataArrayAttributes
      * @param gid
@@ -163,9 +200,10 @@ class H5DataArrayWriter
         h5Dims[i + tDims.size()] = cDims[i];
       }
 #endif
+      H5DatasetCreationOptions options = GetDatasetOptions(dataArray);
       if (QH5Lite::datasetExists(gid, dataArray->getName()) == false)
       {
-        err = QH5Lite::writePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getPointer(0));
+        err = QH5Lite::writePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getConstPointer(0), options);
         if(err < 0)
         {
           return err;
@@ -173,7 +211,7 @@ class H5DataArrayWriter
       }
       else
       {
-        err = QH5Lite::replacePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getPointer(0));
+        err = QH5Lite::replacePointerDataset(gid, dataArray->getName(), h5Rank, h5Dims.data(), dataArray->getConstPointer(0), options);
         if(err < 0)
         {
           return err;
@@ -0,0 +1,75 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The H5LibraryLock class serializes the calls into the HDF5 library of the whole process. The
+ * H5BackgroundWriter holds it while a job runs, so code on any other thread has to hold it around every block of
+ * HDF5 calls, from opening a file to closing it again. The lock is recursive. A thread that holds it may still
+ * wait for background jobs through H5BackgroundWriter, which releases the lock while it waits.
+ */
+class SIMPLib_EXPORT H5LibraryLock
+{
+public:
+  H5LibraryLock();
+  ~H5LibraryLock();
+
+  /**
+   * @brief Returns true if the calling thread holds the lock
+   * @return
+   */
+  static bool IsHeldByCurrentThread();
+
+  /**
+   * @brief Releases every level of the lock the calling thread holds
+   * @return The number of levels that were released, to be passed to Relock()
+   */
+  static int ReleaseAll();
+
+  /**
+   * @brief Acquires the lock again the number of times that ReleaseAll() returned
+   * @param depth
+   */
+  static void Relock(int depth);
+
+public:
+  H5LibraryLock(const H5LibraryLock&) = delete;            // Copy Constructor Not Implemented
+  H5LibraryLock(H5LibraryLock&&) = delete;                 // Move Constructor Not Implemented
+  H5LibraryLock& operator=(const H5LibraryLock&) = delete; // Copy Assignment Not Implemented
+  H5LibraryLock& operator=(H5LibraryLock&&) = delete;      // Move Assignment Not Implemented
+};
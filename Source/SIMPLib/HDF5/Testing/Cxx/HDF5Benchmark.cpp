@@ -0,0 +1,542 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+/**
+ * @brief Measures the throughput of the HDF5 layer that SIMPL uses. Every case writes its data to a new file in the
+ * output directory, closes it, opens it again and reads the data back. The median time of the repetitions is
+ * reported as one CSV row so results can be compared between builds and releases. A case where any repetition
+ * failed is reported with the status "failed" and no timing, and the program then exits with a non-zero code.
+ *
+ * Usage: HDF5Benchmark [--dir <directory>] [--output <results.csv>] [--repeat <count>] [--max-mib <MiB>]
+ *
+ * The reads usually come from the page cache of the operating system, so they measure the HDF5 and SIMPL overhead
+ * rather than the disk. Point --dir at a tmpfs to take the disk out of the writes as well.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QString>
+
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5Utilities.h"
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
+#include "SIMPLib/HDF5/H5DataArrayWriter.hpp"
+
+namespace
+{
+const size_t k_MiB = 1024 * 1024;
+
+/**
+ * @brief Command line settings
+ */
+struct BenchmarkSettings
+{
+  std::string directory;
+  std::string output;
+  int repeat = 3;
+  size_t maxBytes = 64 * k_MiB;
+};
+
+/**
+ * @brief A named set of dataset creation options
+ */
+struct BenchmarkLayout
+{
+  std::string name;
+  H5DatasetCreationOptions options;
+};
+
+/**
+ * @brief One row of the results
+ */
+struct BenchmarkResult
+{
+  std::string benchmark;
+  std::string operation;
+  std::string type;
+  std::string layout;
+  size_t elements = 0;
+  size_t bytes = 0;
+  size_t operations = 0;
+  size_t fileBytes = 0;
+  double seconds = 0.0;
+  bool failed = false;
+};
+
+/**
+ * @brief Writes the results as CSV
+ */
+class ResultWriter
+{
+public:
+  explicit ResultWriter(std::ostream& out)
+  : m_Out(out)
+  {
+    m_Out << "benchmark,operation,type,layout,elements,bytes,operations,status,file_bytes,seconds,mib_per_sec,ops_per_sec" << std::endl;
+  }
+
+  void write(const BenchmarkResult& result)
+  {
+    m_Out << result.benchmark << "," << result.operation << "," << result.type << "," << result.layout << "," << result.elements << "," << result.bytes << "," << result.operations << ",";
+    if(result.failed)
+    {
+      // Leave the timing columns empty so a failed case can not be mistaken for a very fast one
+      m_Out << "failed,,,," << std::endl;
+      m_FailureCount++;
+      return;
+    }
+    double seconds = std::max(result.seconds, 1.0e-9);
+    m_Out << "ok," << result.fileBytes << "," << result.seconds << "," << (static_cast<double>(result.bytes) / k_MiB / seconds) << "," << (static_cast<double>(result.operations) / seconds)
+          << std::endl;
+  }
+
+  /**
+   * @brief Returns the number of rows written with the status "failed"
+   * @return
+   */
+  size_t getFailureCount() const
+  {
+    return m_FailureCount;
+  }
+
+private:
+  std::ostream& m_Out;
+  size_t m_FailureCount = 0;
+};
+
+/**
+ * @brief Runs func settings.repeat times and stores the median wall clock time in seconds in result. If any run
+ * fails, result is marked as failed and the remaining runs are skipped.
+ * @param settings
+ * @param result
+ * @param func Returns false if the operation failed
+ */
+void measure(const BenchmarkSettings& settings, BenchmarkResult& result, const std::function<bool()>& func)
+{
+  std::vector<double> times;
+  result.failed = false;
+  result.seconds = 0.0;
+  for(int i = 0; i < settings.repeat; i++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    if(!func())
+    {
+      result.failed = true;
+      return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration<double>(end - start).count());
+  }
+  std::sort(times.begin(), times.end());
+  result.seconds = times[times.size() / 2];
+}
+
+/**
+ * @brief Returns the size of a file on disk
+ * @param filePath
+ * @return
+ */
+size_t fileSize(const std::string& filePath)
+{
+  std::ifstream in(filePath, std::ios::binary | std::ios::ate);
+  return in ? static_cast<size_t>(in.tellg()) : 0;
+}
+
+/**
+ * @brief Fills values with data that compresses about as well as typical SIMPL arrays: long runs of the same
+ * integer, like FeatureIds, or smoothly varying floating point values with some noise.
+ * @param values
+ */
+template <typename T>
+void fillValues(std::vector<T>& values)
+{
+  uint32_t seed = 12345;
+  for(size_t i = 0; i < values.size(); i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    if(std::is_floating_point<T>::value)
+    {
+      values[i] = static_cast<T>(std::sin(static_cast<double>(i) * 0.001) * 100.0 + static_cast<double>(seed >> 24) * 0.001);
+    }
+    else
+    {
+      values[i] = static_cast<T>(i / 7);
+    }
+  }
+}
+
+/**
+ * @brief Returns the name used for T in the results
+ * @return
+ */
+template <typename T>
+std::string typeName()
+{
+  return H5Lite::HDFTypeForPrimitiveAsStr(T(0));
+}
+
+/**
+ * @brief Writes and reads a dataset with H5Lite
+ * @param settings
+ * @param layout
+ * @param numElements
+ * @param results
+ */
+template <typename T>
+void benchmarkH5Lite(const BenchmarkSettings& settings, const BenchmarkLayout& layout, size_t numElements, ResultWriter& results)
+{
+  std::string filePath = settings.directory + "/HDF5Benchmark_H5Lite.h5";
+  std::vector<T> values(numElements);
+  fillValues(values);
+  std::vector<T> readValues(numElements);
+  hsize_t dims[1] = {static_cast<hsize_t>(numElements)};
+
+  BenchmarkResult result;
+  result.benchmark = "H5Lite";
+  result.type = typeName<T>();
+  result.layout = layout.name;
+  result.elements = numElements;
+  result.bytes = numElements * sizeof(T);
+  result.operations = 1;
+
+  result.operation = "write";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::createFile(filePath);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    herr_t err = H5Lite::writePointerDataset(fileId, "Data", 1, dims, values.data(), layout.options);
+    H5Utilities::closeFile(fileId);
+    return err >= 0;
+  });
+  result.fileBytes = fileSize(filePath);
+  results.write(result);
+
+  result.operation = "read";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::openFile(filePath, true);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    herr_t err = H5Lite::readPointerDataset(fileId, "Data", readValues.data());
+    H5Utilities::closeFile(fileId);
+    return err >= 0 && readValues.back() == values.back();
+  });
+  results.write(result);
+
+  std::remove(filePath.c_str());
+}
+
+/**
+ * @brief Writes a DataArray with H5DataArrayWriter and reads it with H5DataArrayReader, both into a new DataArray
+ * and into an existing one
+ * @param settings
+ * @param layout
+ * @param numElements
+ * @param results
+ */
+template <typename T>
+void benchmarkDataArray(const BenchmarkSettings& settings, const BenchmarkLayout& layout, size_t numElements, ResultWriter& results)
+{
+  std::string filePath = settings.directory + "/HDF5Benchmark_DataArray.h5";
+  std::vector<T> values(numElements);
+  fillValues(values);
+  typename DataArray<T>::Pointer array = DataArray<T>::CreateArray(numElements, "Data", true);
+  std::copy(values.begin(), values.end(), array->begin());
+  typename DataArray<T>::Pointer readArray = DataArray<T>::CreateArray(numElements, "Data", true);
+  std::vector<size_t> tDims = {numElements};
+
+  BenchmarkResult result;
+  result.benchmark = "DataArray";
+  result.type = typeName<T>();
+  result.layout = layout.name;
+  result.elements = numElements;
+  result.bytes = numElements * sizeof(T);
+  result.operations = 1;
+
+  result.operation = "write";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::createFile(filePath);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    int err = 0;
+    {
+      H5DataArrayWriter::ScopedDatasetOptions scopedOptions(layout.options);
+      err = array->writeH5Data(fileId, tDims);
+    }
+    H5Utilities::closeFile(fileId);
+    return err >= 0;
+  });
+  result.fileBytes = fileSize(filePath);
+  results.write(result);
+
+  result.operation = "read";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::openFile(filePath, true);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    IDataArray::Pointer data = H5DataArrayReader::ReadIDataArray(fileId, "Data");
+    H5Utilities::closeFile(fileId);
+    return nullptr != data.get() && data->getNumberOfTuples() == numElements;
+  });
+  results.write(result);
+
+  result.operation = "read_into";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::openFile(filePath, true);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    int err = H5DataArrayReader::ReadIntoDataArray(fileId, "Data", readArray.get());
+    H5Utilities::closeFile(fileId);
+    return err >= 0 && readArray->getValue(numElements - 1) == values.back();
+  });
+  results.write(result);
+
+  std::remove(filePath.c_str());
+}
+
+/**
+ * @brief Writes and reads many small attributes spread over many groups, which is what the structure of a
+ * .dream3d file with many DataContainers and arrays looks like
+ * @param settings
+ * @param numGroups
+ * @param results
+ */
+void benchmarkAttributes(const BenchmarkSettings& settings, size_t numGroups, ResultWriter& results)
+{
+  const size_t numScalarAttributes = 8;
+  std::string filePath = settings.directory + "/HDF5Benchmark_Attributes.h5";
+
+  BenchmarkResult result;
+  result.benchmark = "Attributes";
+  result.type = "mixed";
+  result.layout = "groups";
+  result.elements = numGroups;
+  result.operations = numGroups * (numScalarAttributes + 1);
+  result.bytes = numGroups * numScalarAttributes * sizeof(int32_t);
+
+  result.operation = "write";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::createFile(filePath);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    herr_t err = 0;
+    for(size_t g = 0; g < numGroups && err >= 0; g++)
+    {
+      std::string groupName = "Group_" + std::to_string(g);
+      hid_t gid = H5Utilities::createGroup(fileId, groupName);
+      for(size_t a = 0; a < numScalarAttributes && err >= 0; a++)
+      {
+        err = H5Lite::writeScalarAttribute(fileId, groupName, "Attribute_" + std::to_string(a), static_cast<int32_t>(g + a));
+      }
+      if(err >= 0)
+      {
+        err = H5Lite::writeStringAttribute(fileId, groupName, "ObjectType", "DataArray<int32_t>");
+      }
+      H5Utilities::closeHDF5Object(gid);
+    }
+    H5Utilities::closeFile(fileId);
+    return err >= 0;
+  });
+  result.fileBytes = fileSize(filePath);
+  results.write(result);
+
+  result.operation = "read";
+  measure(settings, result, [&]() {
+    hid_t fileId = H5Utilities::openFile(filePath, true);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    herr_t err = 0;
+    int32_t value = 0;
+    std::string objectType;
+    for(size_t g = 0; g < numGroups && err >= 0; g++)
+    {
+      std::string groupName = "Group_" + std::to_string(g);
+      for(size_t a = 0; a < numScalarAttributes && err >= 0; a++)
+      {
+        err = H5Lite::readScalarAttribute(fileId, groupName, "Attribute_" + std::to_string(a), value);
+      }
+      if(err >= 0)
+      {
+        err = H5Lite::readStringAttribute(fileId, groupName, "ObjectType", objectType);
+      }
+    }
+    H5Utilities::closeFile(fileId);
+    return err >= 0;
+  });
+  results.write(result);
+
+  std::remove(filePath.c_str());
+}
+
+/**
+ * @brief Runs the dataset benchmarks for one type over every size and layout
+ * @param settings
+ * @param layouts
+ * @param results
+ */
+template <typename T>
+void benchmarkType(const BenchmarkSettings& settings, const std::vector<BenchmarkLayout>& layouts, ResultWriter& results)
+{
+  for(size_t bytes = 64 * 1024; bytes <= settings.maxBytes; bytes *= 16)
+  {
+    size_t numElements = bytes / sizeof(T);
+    for(const BenchmarkLayout& layout : layouts)
+    {
+      benchmarkH5Lite<T>(settings, layout, numElements, results);
+      benchmarkDataArray<T>(settings, layout, numElements, results);
+    }
+  }
+}
+
+/**
+ * @brief Parses the command line
+ * @param argc
+ * @param argv
+ * @param settings
+ * @return false if the arguments are invalid
+ */
+bool parseArguments(int argc, char* argv[], BenchmarkSettings& settings)
+{
+  settings.directory = QDir::tempPath().toStdString();
+  for(int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    if(i + 1 >= argc)
+    {
+      return false;
+    }
+    std::string value = argv[++i];
+    if(arg == "--dir")
+    {
+      settings.directory = value;
+    }
+    else if(arg == "--output")
+    {
+      settings.output = value;
+    }
+    else if(arg == "--repeat")
+    {
+      settings.repeat = std::max(1, std::atoi(value.c_str()));
+    }
+    else if(arg == "--max-mib")
+    {
+      settings.maxBytes = static_cast<size_t>(std::max(1, std::atoi(value.c_str()))) * k_MiB;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  BenchmarkSettings settings;
+  if(!parseArguments(argc, argv, settings))
+  {
+    std::cout << "Usage: " << argv[0] << " [--dir <directory>] [--output <results.csv>] [--repeat <count>] [--max-mib <MiB>]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream outFile;
+  if(!settings.output.empty())
+  {
+    outFile.open(settings.output);
+    if(!outFile)
+    {
+      std::cout << "Could not open " << settings.output << " for writing" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  ResultWriter results(settings.output.empty() ? std::cout : outFile);
+
+  std::vector<BenchmarkLayout> layouts(4);
+  layouts[0].name = "contiguous";
+  layouts[1].name = "chunked";
+  layouts[1].options.chunked = true;
+  layouts[2].name = "deflate1_shuffle";
+  layouts[2].options.deflateLevel = 1;
+  layouts[2].options.shuffle = true;
+  layouts[3].name = "deflate6_shuffle";
+  layouts[3].options.deflateLevel = 6;
+  layouts[3].options.shuffle = true;
+
+  benchmarkType<uint8_t>(settings, layouts, results);
+  benchmarkType<int32_t>(settings, layouts, results);
+  benchmarkType<float>(settings, layouts, results);
+  benchmarkType<double>(settings, layouts, results);
+
+  benchmarkAttributes(settings, 100, results);
+  benchmarkAttributes(settings, 2000, results);
+
+  if(results.getFailureCount() > 0)
+  {
+    std::cerr << results.getFailureCount() << " benchmark cases failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
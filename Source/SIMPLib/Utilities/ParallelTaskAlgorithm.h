@@ -105,6 +105,10 @@ public:
         wait();
       }
     }
+    else
+    {
+      body();
+    }
 #else
     body();
 #endif
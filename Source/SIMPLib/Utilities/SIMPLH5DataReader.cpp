@@ -37,7 +37,10 @@
 #include "SIMPLib/Common/IObserver.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainerBundle.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 #include "SIMPLib/Utilities/SIMPLH5DataReaderRequirements.h"
+#include "SIMPLib/Utilities/SIMPLH5StructureCache.h"
 
 #include "H5Support/QH5Utilities.h"
 #include "H5Support/H5ScopedSentinel.h"
@@ -72,6 +75,11 @@ bool SIMPLH5DataReader::openFile(const QString &filePath)
     return false;
   }
 
+  // The file may still be written by a DataContainerWriter running in the background
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
   m_FileId = QH5Utilities::openFile(filePath, true); // Open the file Read Only
   if(m_FileId < 0)
   {
@@ -90,6 +98,8 @@ bool SIMPLH5DataReader::openFile(const QString &filePath)
 // -----------------------------------------------------------------------------
 bool SIMPLH5DataReader::closeFile()
 {
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
   herr_t err = QH5Utilities::closeFile(m_FileId); // Open the file Read Only
   if(err < 0)
   {
@@ -107,6 +117,14 @@ bool SIMPLH5DataReader::closeFile()
 //
 // -----------------------------------------------------------------------------
 DataContainerArray::Pointer SIMPLH5DataReader::readSIMPLDataUsingProxy(DataContainerArrayProxy& proxy, bool preflight)
+{
+  return readSIMPLDataUsingProxy(proxy, preflight, H5DataArrayReader::ReadRegion());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer SIMPLH5DataReader::readSIMPLDataUsingProxy(DataContainerArrayProxy& proxy, bool preflight, const H5DataArrayReader::ReadRegion& regionOfInterest, bool deferReading)
 {
   if (m_FileId < 0)
   {
@@ -115,6 +133,8 @@ DataContainerArray::Pointer SIMPLH5DataReader::readSIMPLDataUsingProxy(DataConta
     return DataContainerArray::NullPointer();
   }
 
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
   QString ss;
   int32_t err = 0;
   QString m_FileVersion;
@@ -155,7 +175,7 @@ DataContainerArray::Pointer SIMPLH5DataReader::readSIMPLDataUsingProxy(DataConta
     return DataContainerArray::NullPointer();
   }
 
-  err = dca->readDataContainersFromHDF5(preflight, dcaGid, proxy, this);
+  err = dca->readDataContainersFromHDF5(preflight, dcaGid, proxy, this, regionOfInterest, deferReading);
   if(err < 0)
   {
     QString ss = QObject::tr("Error trying to read the DataContainers from the file '%1'").arg(m_CurrentFilePath);
@@ -189,6 +209,15 @@ DataContainerArrayProxy SIMPLH5DataReader::readDataContainerArrayStructure(SIMPL
     return DataContainerArrayProxy();
   }
 
+  // The structure of a file that did not change since it was last read does not have to be read again
+  if(SIMPLH5StructureCache::Instance()->find(m_CurrentFilePath, req, proxy))
+  {
+    err = 0;
+    return proxy;
+  }
+
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
   // Check the DREAM3D File Version to make sure we are reading the proper version
   QString d3dVersion;
   err = QH5Lite::readStringAttribute(m_FileId, "/", SIMPL::HDF5::DREAM3DVersion, d3dVersion);
@@ -229,6 +258,8 @@ DataContainerArrayProxy SIMPLH5DataReader::readDataContainerArrayStructure(SIMPL
   DataContainer::ReadDataContainerStructure(dcArrayGroupId, proxy, req, h5InternalPath);
 
   QH5Utilities::closeHDF5Object(dcArrayGroupId);
+
+  SIMPLH5StructureCache::Instance()->insert(m_CurrentFilePath, req, proxy);
   return proxy;
 }
 
@@ -237,6 +268,8 @@ DataContainerArrayProxy SIMPLH5DataReader::readDataContainerArrayStructure(SIMPL
 // -----------------------------------------------------------------------------
 bool SIMPLH5DataReader::readPipelineJson(QString &json)
 {
+  // Other threads and the background writer call into HDF5 as well
+  H5LibraryLock libraryLock;
   herr_t err = 0;
 
   // Check to see if version of .dream3d file is prior to new data container names
@@ -278,6 +311,7 @@ bool SIMPLH5DataReader::readPipelineJson(QString &json)
 // -----------------------------------------------------------------------------
 bool SIMPLH5DataReader::readDataContainerBundles(hid_t fileId, const DataContainerArray::Pointer& dca)
 {
+  H5LibraryLock libraryLock;
   herr_t err = 0;
   hid_t dcbGroupId = H5Gopen(fileId, SIMPL::StringConstants::DataContainerBundleGroupName.toLatin1().constData(), H5P_DEFAULT);
   if(dcbGroupId < 0)
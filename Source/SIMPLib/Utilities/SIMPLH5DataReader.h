@@ -36,6 +36,7 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/Observable.h"
 #include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
 
 
 class IObserver;
@@ -91,6 +92,18 @@ class SIMPLib_EXPORT SIMPLH5DataReader : public Observable
      */
     DataContainerArrayShPtrType readSIMPLDataUsingProxy(DataContainerArrayProxy& proxy, bool preflight);
 
+    /**
+     * @brief readSIMPLDataUsingProxy Reads the data selected by the proxy but only the voxels inside regionOfInterest
+     * of the Cell AttributeMatrices of every ImageGeom DataContainer. Those geometries are cropped to the region.
+     * @param proxy
+     * @param preflight
+     * @param regionOfInterest An (x,y,z) box. An empty region reads everything.
+     * @param deferReading The DataArrays only remember where their values are stored and read them when they are
+     * first accessed. NeighborLists and StringDataArrays are always read immediately.
+     * @return
+     */
+    DataContainerArrayShPtrType readSIMPLDataUsingProxy(DataContainerArrayProxy& proxy, bool preflight, const H5DataArrayReader::ReadRegion& regionOfInterest, bool deferReading = false);
+
     /**
      * @brief readPipelineJson
      * @param json
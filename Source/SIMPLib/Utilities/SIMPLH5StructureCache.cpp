@@ -0,0 +1,365 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "SIMPLH5StructureCache.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/Utilities/SIMPLH5DataReaderRequirements.h"
+
+namespace
+{
+// Bounds the memory held for files that are no longer used
+const size_t k_MaxNumberOfFiles = 64;
+
+const QString k_FileSize("File Size");
+const QString k_LastModified("Last Modified");
+const QString k_Structures("Structures");
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SIMPLH5StructureCache::SIMPLH5StructureCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SIMPLH5StructureCache::~SIMPLH5StructureCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SIMPLH5StructureCache* SIMPLH5StructureCache::Instance()
+{
+  static SIMPLH5StructureCache s_Cache;
+  return &s_Cache;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SIMPLH5StructureCache::SidecarFilePath(const QString& filePath)
+{
+  return filePath + ".structure.json";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLH5StructureCache::find(const QString& filePath, SIMPLH5DataReaderRequirements* req, DataContainerArrayProxy& proxy)
+{
+  FileStamp stamp;
+  if(!ReadFileStamp(filePath, stamp))
+  {
+    return false;
+  }
+  QString absoluteFilePath = QFileInfo(filePath).absoluteFilePath();
+  QString key = RequirementsKey(req);
+
+  bool useSidecarFiles = false;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = m_Entries.find(absoluteFilePath);
+    if(iter != m_Entries.end())
+    {
+      if(!(iter->second.stamp == stamp))
+      {
+        m_Entries.erase(iter);
+      }
+      else if(iter->second.structures.contains(key))
+      {
+        iter->second.lastUsed = ++m_UseCounter;
+        proxy = iter->second.structures.value(key);
+        return true;
+      }
+    }
+    useSidecarFiles = m_UseSidecarFiles;
+  }
+  if(!useSidecarFiles)
+  {
+    return false;
+  }
+
+  Entry sidecarEntry;
+  if(!ReadSidecarFile(absoluteFilePath, stamp, sidecarEntry) || !sidecarEntry.structures.contains(key))
+  {
+    return false;
+  }
+  proxy = sidecarEntry.structures.value(key);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  Entry& entry = m_Entries[absoluteFilePath];
+  if(!(entry.stamp == stamp))
+  {
+    entry = sidecarEntry;
+  }
+  else
+  {
+    entry.structures.insert(key, proxy);
+  }
+  entry.lastUsed = ++m_UseCounter;
+  evictLeastRecentlyUsed();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLH5StructureCache::insert(const QString& filePath, SIMPLH5DataReaderRequirements* req, const DataContainerArrayProxy& proxy)
+{
+  FileStamp stamp;
+  if(!ReadFileStamp(filePath, stamp))
+  {
+    return;
+  }
+  QString absoluteFilePath = QFileInfo(filePath).absoluteFilePath();
+
+  bool useSidecarFiles = false;
+  Entry sidecarEntry;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Entry& entry = m_Entries[absoluteFilePath];
+    if(!(entry.stamp == stamp))
+    {
+      entry.stamp = stamp;
+      entry.structures.clear();
+    }
+    entry.structures.insert(RequirementsKey(req), proxy);
+    entry.lastUsed = ++m_UseCounter;
+
+    useSidecarFiles = m_UseSidecarFiles;
+    if(useSidecarFiles)
+    {
+      sidecarEntry = entry;
+    }
+    evictLeastRecentlyUsed();
+  }
+  if(useSidecarFiles)
+  {
+    WriteSidecarFile(absoluteFilePath, sidecarEntry);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLH5StructureCache::remove(const QString& filePath)
+{
+  QString absoluteFilePath = QFileInfo(filePath).absoluteFilePath();
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.erase(absoluteFilePath);
+  }
+  QString sidecarFilePath = SidecarFilePath(absoluteFilePath);
+  if(QFile::exists(sidecarFilePath))
+  {
+    QFile::remove(sidecarFilePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLH5StructureCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SIMPLH5StructureCache::getNumberOfFiles() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLH5StructureCache::setUseSidecarFiles(bool value)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_UseSidecarFiles = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLH5StructureCache::getUseSidecarFiles() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_UseSidecarFiles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLH5StructureCache::evictLeastRecentlyUsed()
+{
+  if(m_Entries.size() <= k_MaxNumberOfFiles)
+  {
+    return;
+  }
+  auto oldest = m_Entries.begin();
+  for(auto iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if(iter->second.lastUsed < oldest->second.lastUsed)
+    {
+      oldest = iter;
+    }
+  }
+  m_Entries.erase(oldest);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLH5StructureCache::ReadFileStamp(const QString& filePath, FileStamp& stamp)
+{
+  QFileInfo fi(filePath);
+  if(!fi.exists())
+  {
+    return false;
+  }
+  stamp.size = fi.size();
+  stamp.lastModified = fi.lastModified().toMSecsSinceEpoch();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// The requirements only change which parts of the structure are checked, so each set is cached separately
+// -----------------------------------------------------------------------------
+QString SIMPLH5StructureCache::RequirementsKey(SIMPLH5DataReaderRequirements* req)
+{
+  if(nullptr == req)
+  {
+    return QString("None");
+  }
+
+  QStringList geometryTypes;
+  for(const auto& type : req->getDCGeometryTypes())
+  {
+    geometryTypes << QString::number(static_cast<int>(type));
+  }
+  QStringList amTypes;
+  for(const auto& type : req->getAMTypes())
+  {
+    amTypes << QString::number(static_cast<int>(type));
+  }
+  QStringList componentDims;
+  for(const auto& cDims : req->getComponentDimensions())
+  {
+    QStringList dims;
+    for(const auto& dim : cDims)
+    {
+      dims << QString::number(dim);
+    }
+    componentDims << dims.join("x");
+  }
+  QStringList daTypes;
+  for(const auto& type : req->getDATypes())
+  {
+    daTypes << type;
+  }
+  return QString("%1|%2|%3|%4").arg(geometryTypes.join(","), amTypes.join(","), componentDims.join(","), daTypes.join(","));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLH5StructureCache::ReadSidecarFile(const QString& filePath, const FileStamp& stamp, Entry& entry)
+{
+  QFile sidecarFile(SidecarFilePath(filePath));
+  if(!sidecarFile.exists() || !sidecarFile.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  QJsonDocument doc = QJsonDocument::fromJson(sidecarFile.readAll());
+  sidecarFile.close();
+
+  QJsonObject root = doc.object();
+  entry.stamp.size = static_cast<qint64>(root[k_FileSize].toDouble(-1.0));
+  entry.stamp.lastModified = static_cast<qint64>(root[k_LastModified].toDouble(-1.0));
+  if(!(entry.stamp == stamp))
+  {
+    return false;
+  }
+
+  QJsonObject structures = root[k_Structures].toObject();
+  for(const auto& key : structures.keys())
+  {
+    QJsonObject json = structures[key].toObject();
+    DataContainerArrayProxy proxy;
+    if(proxy.readJson(json))
+    {
+      entry.structures.insert(key, proxy);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLH5StructureCache::WriteSidecarFile(const QString& filePath, const Entry& entry)
+{
+  QJsonObject structures;
+  for(auto iter = entry.structures.begin(); iter != entry.structures.end(); ++iter)
+  {
+    QJsonObject json;
+    iter.value().writeJson(json);
+    structures[iter.key()] = json;
+  }
+  QJsonObject root;
+  root[k_FileSize] = static_cast<double>(entry.stamp.size);
+  root[k_LastModified] = static_cast<double>(entry.stamp.lastModified);
+  root[k_Structures] = structures;
+
+  // The directory may not be writable, in which case only the memory cache is used
+  QFile sidecarFile(SidecarFilePath(filePath));
+  if(sidecarFile.open(QIODevice::WriteOnly))
+  {
+    sidecarFile.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    sidecarFile.close();
+  }
+}
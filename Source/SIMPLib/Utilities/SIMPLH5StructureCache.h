@@ -0,0 +1,172 @@
+/* ============================================================================
+ * Copyright (c) 2019 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-15-D-5231
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
+
+class SIMPLH5DataReaderRequirements;
+
+/**
+ * @brief The SIMPLH5StructureCache class remembers the DataContainerArrayProxy read from each .dream3d file so that
+ * the structure of a file that has not changed is not read from HDF5 again. Preflighting a DataContainerReader reads
+ * the structure every time, which takes seconds for files with thousands of arrays on network file systems.
+ *
+ * A file is considered unchanged while its size and modification time are the same as when its structure was read.
+ * DataContainerWriter removes the files it writes from the cache. Optionally the structure is also stored in a
+ * sidecar file next to the .dream3d file so that it survives restarting the application.
+ */
+class SIMPLib_EXPORT SIMPLH5StructureCache
+{
+public:
+  /**
+   * @brief Returns the cache shared by the whole process
+   * @return
+   */
+  static SIMPLH5StructureCache* Instance();
+
+  virtual ~SIMPLH5StructureCache();
+
+  /**
+   * @brief Returns the name of the sidecar file of filePath
+   * @param filePath
+   * @return
+   */
+  static QString SidecarFilePath(const QString& filePath);
+
+  /**
+   * @brief Looks up the structure of filePath that was read with the requirements req. Returns false if the
+   * structure is not cached or the file changed since it was read.
+   * @param filePath
+   * @param req May be nullptr
+   * @param proxy Receives the structure
+   * @return
+   */
+  bool find(const QString& filePath, SIMPLH5DataReaderRequirements* req, DataContainerArrayProxy& proxy);
+
+  /**
+   * @brief Stores the structure of filePath that was just read with the requirements req
+   * @param filePath
+   * @param req May be nullptr
+   * @param proxy
+   */
+  void insert(const QString& filePath, SIMPLH5DataReaderRequirements* req, const DataContainerArrayProxy& proxy);
+
+  /**
+   * @brief Forgets the structure of filePath and deletes its sidecar file
+   * @param filePath
+   */
+  void remove(const QString& filePath);
+
+  /**
+   * @brief Forgets every structure held in memory. Sidecar files are kept.
+   */
+  void clear();
+
+  /**
+   * @brief Returns the number of files whose structure is held in memory
+   * @return
+   */
+  size_t getNumberOfFiles() const;
+
+  /**
+   * @brief Sets whether structures are also stored in and read from sidecar files. This is off by default.
+   * @param value
+   */
+  void setUseSidecarFiles(bool value);
+
+  /**
+   * @brief getUseSidecarFiles
+   * @return
+   */
+  bool getUseSidecarFiles() const;
+
+protected:
+  SIMPLH5StructureCache();
+
+private:
+  /**
+   * @brief What identifies a version of a file
+   */
+  struct FileStamp
+  {
+    qint64 size = -1;
+    qint64 lastModified = -1;
+
+    bool operator==(const FileStamp& rhs) const
+    {
+      return size == rhs.size && lastModified == rhs.lastModified;
+    }
+  };
+
+  /**
+   * @brief The structures read from one version of a file, one for each set of requirements
+   */
+  struct Entry
+  {
+    FileStamp stamp;
+    QMap<QString, DataContainerArrayProxy> structures;
+    uint64_t lastUsed = 0;
+  };
+
+  static bool ReadFileStamp(const QString& filePath, FileStamp& stamp);
+  static QString RequirementsKey(SIMPLH5DataReaderRequirements* req);
+  static bool ReadSidecarFile(const QString& filePath, const FileStamp& stamp, Entry& entry);
+  static void WriteSidecarFile(const QString& filePath, const Entry& entry);
+
+  /**
+   * @brief Forgets the file that was used the longest time ago once too many files are cached. m_Mutex must be locked.
+   */
+  void evictLeastRecentlyUsed();
+
+  mutable std::mutex m_Mutex;
+  std::map<QString, Entry> m_Entries;
+  uint64_t m_UseCounter = 0;
+  bool m_UseSidecarFiles = false;
+
+public:
+  SIMPLH5StructureCache(const SIMPLH5StructureCache&) = delete;            // Copy Constructor Not Implemented
+  SIMPLH5StructureCache(SIMPLH5StructureCache&&) = delete;                 // Move Constructor Not Implemented
+  SIMPLH5StructureCache& operator=(const SIMPLH5StructureCache&) = delete; // Copy Assignment Not Implemented
+  SIMPLH5StructureCache& operator=(SIMPLH5StructureCache&&) = delete;      // Move Assignment Not Implemented
+};
@@ -52,6 +52,8 @@
 
 #include "SIMPLib/CoreFilters/ImportHDF5Dataset.h"
 #include "SIMPLib/FilterParameters/ImportHDF5DatasetFilterParameter.h"
+#include "SIMPLib/HDF5/H5BackgroundWriter.h"
+#include "SIMPLib/HDF5/H5LibraryLock.h"
 #include "SIMPLib/Utilities/SIMPLDataPathValidator.h"
 
 #include "SVWidgetsLib/FilterParameterWidgets/FilterParameterWidgetsDialogs.h"
@@ -106,6 +108,7 @@ ImportHDF5DatasetWidget::~ImportHDF5DatasetWidget()
 {
   if(m_FileId > 0)
   {
+    H5LibraryLock libraryLock;
     H5Fclose(m_FileId);
   }
 }
@@ -463,6 +466,10 @@ bool ImportHDF5DatasetWidget::initWithFile(const QString& hdf5File)
     return false;
   }
 
+  // The file may still be written in the background and pipelines call into HDF5 on their own threads
+  H5BackgroundWriter::Instance()->waitForPendingWrites();
+  H5LibraryLock libraryLock;
+
   // If there is current file open, close it.
   if(m_FileId >= 0)
   {
@@ -585,6 +592,7 @@ herr_t ImportHDF5DatasetWidget::updateGeneralTable(const QString& path)
   std::string objName = H5Utilities::extractObjectName(datasetPath);
   QString objType;
 
+  H5LibraryLock libraryLock;
   herr_t err = 0;
   if(m_FileId < 0)
   {
@@ -741,6 +749,7 @@ herr_t ImportHDF5DatasetWidget::updateAttributeTable(const QString& path)
 {
   QString objName = QH5Utilities::extractObjectName(path);
   setErrorText("");
+  H5LibraryLock libraryLock;
   herr_t err = 0;
   if(m_FileId < 0)
   {
@@ -934,6 +943,7 @@ std::tuple<herr_t, QString> ImportHDF5DatasetWidget::bestGuessCDims(const QStrin
   }
 
   // Test for Dataset Existance
+  H5LibraryLock libraryLock;
   H5O_info_t statbuf;
   err = H5Oget_info_by_name(m_FileId, path.toStdString().c_str(), &statbuf, H5P_DEFAULT);
   if(err < 0)
@@ -35,6 +35,8 @@
 
 #include "H5Support/H5Utilities.h"
 
+#include "SIMPLib/HDF5/H5LibraryLock.h"
+
 ImportHDF5TreeModelItem::ImportHDF5TreeModelItem(hid_t fileId, const QString& data, ImportHDF5TreeModelItem* parent)
 : m_ItemData(QVariant(data))
 , m_ParentItem(parent)
@@ -228,6 +230,8 @@ void ImportHDF5TreeModelItem::initializeChildCount()
 
   QString path = generateHDFPath();
 
+  // Pipelines call into HDF5 on their own threads
+  H5LibraryLock libraryLock;
   hid_t obj_id = H5Utilities::openHDF5Object(m_FileId, path.toStdString());
   if(obj_id > 0)
   {
@@ -283,6 +287,8 @@ void ImportHDF5TreeModelItem::initializeChildItems()
 
   QString path = generateHDFPath();
 
+  // Pipelines call into HDF5 on their own threads
+  H5LibraryLock libraryLock;
   // std::cout << "ImportHDF5TreeModelItem::initializeChildItems() - Generated Path as: " << path.toStdString() << std::endl;
   // Check to see if the path is a group or data set
   if(H5Utilities::isGroup(m_FileId, path.toStdString()))